@@ -4,11 +4,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "mcc/arena.h"
 #include "mcc/asm.h"
 #include "mcc/asm_print.h"
 #include "mcc/ast.h"
+#include "mcc/intern.h"
 #include "mcc/ir.h"
 #include "mcc/parser.h"
+#include "mcc/pass_manager.h"
 #include "mcc/semantic_checks.h"
 #include "mcc/symbol_table.h"
 
@@ -38,6 +41,21 @@ int main(int argc, char *argv[])
 		return EXIT_FAILURE;
 	}
 
+	// The data structures of the compilation are allocated from one region, which is released at once on exit
+	register_arena_cleanup(command_line->options->print_stats);
+
+	// Identifiers are interned and shared by all data structures below
+	register_intern_cleanup(command_line->options->print_stats);
+
+	// ---------------------------------------------------------------------- Set up optimization passes
+
+	struct mc_cl_parser_options *options = command_line->options;
+	struct mcc_pass_manager passes;
+	if (!mcc_pass_manager_init(&passes, options->opt_level, options->print_after, stderr, options->time_passes)) {
+		fprintf(stderr, "Unknown optimization pass '%s'.\n", command_line->options->print_after);
+		return EXIT_FAILURE;
+	}
+
 	// ---------------------------------------------------------------------- Parsing provided input and create AST
 
 	// Declare struct that will hold the result of the parser and corresponding pointer
@@ -45,16 +63,15 @@ int main(int argc, char *argv[])
 
 	switch (command_line->argument_status) {
 	case MC_CL_PARSER_ARGSTAT_STDIN:
-		result = get_ast_from_stdin(command_line->options->quiet);
+		result = get_ast_from_stdin(command_line->options->quiet, true);
 		break;
 	case MC_CL_PARSER_ARGSTAT_FILES:
-		result = get_ast_from_files(command_line);
+		result = get_ast_from_files(command_line, true);
 		break;
 	default:
 		return EXIT_FAILURE;
 	}
 	register_cleanup(result.error_buffer);
-	register_cleanup(result.program);
 
 	if (result.status != MCC_PARSER_STATUS_OK) {
 		if (result.error_buffer) {
@@ -67,12 +84,11 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Create Symbol Table
 
-	struct mcc_symbol_table *table = mcc_symbol_table_create((&result)->program);
+	struct mcc_symbol_table *table = get_symbol_table(&result);
 	if (!table) {
 		fprintf(stderr, "Symbol table generation failed. Unknown error.\n");
 		return EXIT_FAILURE;
 	}
-	register_cleanup(table);
 
 	// ---------------------------------------------------------------------- Run semantic checks
 
@@ -90,12 +106,20 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Generate IR
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&result)->program);
 	if (!ir) {
 		fprintf(stderr, "IR generation failed. Unknwon error.\n");
 		return EXIT_FAILURE;
 	}
-	register_cleanup(ir);
+
+	// ---------------------------------------------------------------------- Optimize IR
+
+	for (struct mcc_ir_function *function = ir; function; function = function->next) {
+		if (!mcc_pass_manager_run_ir(&passes, function)) {
+			fprintf(stderr, "Optimization failed. Unknown error.\n");
+			return EXIT_FAILURE;
+		}
+	}
 
 	// ---------------------------------------------------------------------- Generate ASM
 
@@ -104,7 +128,18 @@ int main(int argc, char *argv[])
 		fprintf(stderr, "Assembly code generation failed. Unknown error.\n");
 		return EXIT_FAILURE;
 	}
-	register_cleanup(code);
+
+	// ---------------------------------------------------------------------- Optimize ASM
+
+	for (struct mcc_asm_function *function = code->text_section->function; function; function = function->next) {
+		if (!mcc_pass_manager_run_asm(&passes, function)) {
+			fprintf(stderr, "Optimization failed. Unknown error.\n");
+			return EXIT_FAILURE;
+		}
+	}
+	if (passes.time_passes) {
+		mcc_pass_manager_print_timings(&passes, stderr);
+	}
 
 	// ---------------------------------------------------------------------- Print ASM
 
@@ -3,8 +3,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "mcc/arena.h"
 #include "mcc/ast.h"
 #include "mcc/ast_print.h"
+#include "mcc/intern.h"
 #include "mcc/parser.h"
 
 #include "mc_cl_parser.inc"
@@ -34,6 +36,12 @@ int main(int argc, char *argv[])
 		return EXIT_FAILURE;
 	}
 
+	// The data structures of the compilation are allocated from one region, which is released at once on exit
+	register_arena_cleanup(command_line->options->print_stats);
+
+	// Identifiers are interned and shared by all data structures below
+	register_intern_cleanup(command_line->options->print_stats);
+
 	// ---------------------------------------------------------------------- Parsing provided input and create AST
 
 	// Declare struct that will hold the result of the parser and corresponding pointer
@@ -41,16 +49,15 @@ int main(int argc, char *argv[])
 
 	switch (command_line->argument_status) {
 	case MC_CL_PARSER_ARGSTAT_STDIN:
-		result = get_ast_from_stdin(command_line->options->quiet);
+		result = get_ast_from_stdin(command_line->options->quiet, false);
 		break;
 	case MC_CL_PARSER_ARGSTAT_FILES:
-		result = get_ast_from_files(command_line);
+		result = get_ast_from_files(command_line, false);
 		break;
 	default:
 		return EXIT_FAILURE;
 	}
 	register_cleanup(result.error_buffer);
-	register_cleanup(result.program);
 
 	if (result.status != MCC_PARSER_STATUS_OK) {
 		if (result.error_buffer) {
@@ -3,9 +3,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "mcc/arena.h"
 #include "mcc/ast.h"
 #include "mcc/cfg.h"
+#include "mcc/cfg_analysis.h"
 #include "mcc/cfg_print.h"
+#include "mcc/intern.h"
 #include "mcc/ir.h"
 #include "mcc/parser.h"
 #include "mcc/semantic_checks.h"
@@ -38,6 +41,12 @@ int main(int argc, char *argv[])
 		return EXIT_FAILURE;
 	}
 
+	// The data structures of the compilation are allocated from one region, which is released at once on exit
+	register_arena_cleanup(command_line->options->print_stats);
+
+	// Identifiers are interned and shared by all data structures below
+	register_intern_cleanup(command_line->options->print_stats);
+
 	// ---------------------------------------------------------------------- Parsing provided input and create AST
 
 	// Declare struct that will hold the result of the parser and corresponding pointer
@@ -45,16 +54,15 @@ int main(int argc, char *argv[])
 
 	switch (command_line->argument_status) {
 	case MC_CL_PARSER_ARGSTAT_STDIN:
-		result = get_ast_from_stdin(command_line->options->quiet);
+		result = get_ast_from_stdin(command_line->options->quiet, true);
 		break;
 	case MC_CL_PARSER_ARGSTAT_FILES:
-		result = get_ast_from_files(command_line);
+		result = get_ast_from_files(command_line, true);
 		break;
 	default:
 		return EXIT_FAILURE;
 	}
 	register_cleanup(result.error_buffer);
-	register_cleanup(result.program);
 
 	if (result.status != MCC_PARSER_STATUS_OK) {
 		if (result.error_buffer) {
@@ -67,12 +75,11 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Create Symbol Table
 
-	struct mcc_symbol_table *table = mcc_symbol_table_create((&result)->program);
+	struct mcc_symbol_table *table = get_symbol_table(&result);
 	if (!table) {
 		fprintf(stderr, "Symbol table generation failed. Unknown error.\n");
 		return EXIT_FAILURE;
 	}
-	register_cleanup(table);
 
 	// ---------------------------------------------------------------------- Run semantic checks
 
@@ -90,7 +97,7 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Generate IR
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&result)->program);
 	if (!ir) {
 		fprintf(stderr, "IR generation failed. Unknwon error.\n");
 		return EXIT_FAILURE;
@@ -98,25 +105,32 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Get CFG
 
-	struct mcc_basic_block *cfg = mcc_cfg_generate(ir);
+	// Only the CFG of the printed function is built
+	char *function_identifier = command_line->options->limited_scope ? command_line->options->function : "main";
+	struct mcc_ir_function *function = mcc_cfg_find_function(ir, function_identifier);
+	if (!function) {
+		mcc_ir_delete_ir(ir);
+		fprintf(stderr, "Specified function does not exist.\n");
+		return EXIT_FAILURE;
+	}
+	struct mcc_basic_block *cfg = mcc_cfg_generate_function(function);
 	if (!cfg) {
 		mcc_ir_delete_ir(ir);
 		fprintf(stderr, "CFG generation failed. Unknown error.\n");
 		return EXIT_FAILURE;
 	}
-	if (command_line->options->limited_scope) {
-		cfg = mcc_cfg_limit_to_function(command_line->options->function, cfg);
-		if (!cfg) {
-			fprintf(stderr, "Specified function does not exist.\n");
+
+	// Dominators and loops are only computed for marking the loops
+	struct mcc_cfg_analysis *analysis = NULL;
+	if (command_line->options->print_loops) {
+		analysis = mcc_cfg_analyze(cfg);
+		if (!analysis) {
+			mcc_ir_delete_ir(ir);
+			fprintf(stderr, "CFG analysis failed. Unknown error.\n");
 			return EXIT_FAILURE;
 		}
-	} else {
-		cfg = mcc_cfg_limit_to_function("main", cfg);
-		if (!cfg) {
-			fprintf(stderr, "Limiting CFG to main function failed.\n");
-		}
+		register_cleanup(analysis);
 	}
-	register_cleanup(cfg);
 
 	// ---------------------------------------------------------------------- Print CFG
 
@@ -127,10 +141,10 @@ int main(int argc, char *argv[])
 			mcc_ir_delete_ir(ir);
 			return EXIT_FAILURE;
 		}
-		mcc_cfg_print_dot_cfg(out, cfg);
+		mcc_cfg_print_dot_cfg(out, cfg, analysis);
 		fclose(out);
 	} else {
-		mcc_cfg_print_dot_cfg(stdout, cfg);
+		mcc_cfg_print_dot_cfg(stdout, cfg, analysis);
 	}
 
 	return EXIT_SUCCESS;
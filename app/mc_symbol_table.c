@@ -3,7 +3,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "mcc/arena.h"
 #include "mcc/ast.h"
+#include "mcc/intern.h"
 #include "mcc/ir.h"
 #include "mcc/parser.h"
 #include "mcc/symbol_table.h"
@@ -37,6 +39,12 @@ int main(int argc, char *argv[])
 		return EXIT_FAILURE;
 	}
 
+	// The data structures of the compilation are allocated from one region, which is released at once on exit
+	register_arena_cleanup(command_line->options->print_stats);
+
+	// Identifiers are interned and shared by all data structures below
+	register_intern_cleanup(command_line->options->print_stats);
+
 	// ---------------------------------------------------------------------- Parsing provided input and create AST
 
 	// Declare struct that will hold the result of the parser and corresponding pointer
@@ -44,16 +52,15 @@ int main(int argc, char *argv[])
 
 	switch (command_line->argument_status) {
 	case MC_CL_PARSER_ARGSTAT_STDIN:
-		result = get_ast_from_stdin(command_line->options->quiet);
+		result = get_ast_from_stdin(command_line->options->quiet, true);
 		break;
 	case MC_CL_PARSER_ARGSTAT_FILES:
-		result = get_ast_from_files(command_line);
+		result = get_ast_from_files(command_line, true);
 		break;
 	default:
 		return EXIT_FAILURE;
 	}
 	register_cleanup(result.error_buffer);
-	register_cleanup(result.program);
 
 	if (result.status != MCC_PARSER_STATUS_OK) {
 		if (result.error_buffer) {
@@ -66,12 +73,11 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Generate symbol table
 
-	struct mcc_symbol_table *table = mcc_symbol_table_create((&result)->program);
+	struct mcc_symbol_table *table = get_symbol_table(&result);
 	if (!table) {
 		fprintf(stderr, "Symbol table generation failed. Unknown error.\n");
 		return EXIT_FAILURE;
 	}
-	register_cleanup(table);
 
 	// ---------------------------------------------------------------------- Print symbol table
 
@@ -6,11 +6,14 @@
 #include <string.h>
 #include <sys/wait.h>
 
+#include "mcc/arena.h"
 #include "mcc/asm.h"
 #include "mcc/asm_print.h"
 #include "mcc/ast.h"
+#include "mcc/intern.h"
 #include "mcc/ir.h"
 #include "mcc/parser.h"
+#include "mcc/pass_manager.h"
 #include "mcc/semantic_checks.h"
 #include "mcc/symbol_table.h"
 
@@ -42,6 +45,23 @@ int main(int argc, char *argv[])
 		return EXIT_FAILURE;
 	}
 
+	// The data structures of the compilation are allocated from one region, which is released at once on exit
+	register_arena_cleanup(command_line->options->print_stats);
+
+	// Identifiers are interned and shared by all data structures below
+	register_intern_cleanup(command_line->options->print_stats);
+
+	// ---------------------------------------------------------------------- Set up optimization passes
+
+	struct mc_cl_parser_options *options = command_line->options;
+	struct mcc_pass_manager passes;
+	if (!mcc_pass_manager_init(&passes, options->opt_level, options->print_after, stderr, options->time_passes)) {
+		if (!command_line->options->quiet) {
+			fprintf(stderr, "Unknown optimization pass '%s'.\n", command_line->options->print_after);
+		}
+		return EXIT_FAILURE;
+	}
+
 	// ---------------------------------------------------------------------- Parsing provided input and create AST
 
 	// Declare struct that will hold the result of the parser and corresponding pointer
@@ -49,16 +69,15 @@ int main(int argc, char *argv[])
 
 	switch (command_line->argument_status) {
 	case MC_CL_PARSER_ARGSTAT_STDIN:
-		result = get_ast_from_stdin(command_line->options->quiet);
+		result = get_ast_from_stdin(command_line->options->quiet, true);
 		break;
 	case MC_CL_PARSER_ARGSTAT_FILES:
-		result = get_ast_from_files(command_line);
+		result = get_ast_from_files(command_line, true);
 		break;
 	default:
 		return EXIT_FAILURE;
 	}
 	register_cleanup(result.error_buffer);
-	register_cleanup(result.program);
 
 	if (result.status != MCC_PARSER_STATUS_OK) {
 		if (result.error_buffer) {
@@ -75,14 +94,13 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Create Symbol Table
 
-	struct mcc_symbol_table *table = mcc_symbol_table_create((&result)->program);
+	struct mcc_symbol_table *table = get_symbol_table(&result);
 	if (!table) {
 		if (!command_line->options->quiet) {
 			fprintf(stderr, "Symbol table generation failed. Unknown error.\n");
 		}
 		return EXIT_FAILURE;
 	}
-	register_cleanup(table);
 
 	// ---------------------------------------------------------------------- Run semantic checks
 
@@ -102,40 +120,28 @@ int main(int argc, char *argv[])
 		return EXIT_FAILURE;
 	}
 
-	// ---------------------------------------------------------------------- Generate IR
+	// ---------------------------------------------------------------------- Generate assembly and save it to file
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&result)->program);
-	if (!ir) {
+	// The functions are lowered to IR and assembly one at a time, optimized and printed right away, so that only
+	// the IR and assembly code of one function are kept in memory
+	FILE *assembly_out = fopen("a.s", "w");
+	if (!assembly_out) {
 		if (!command_line->options->quiet) {
-			fprintf(stderr, "IR generation failed. Unknwon error.\n");
+			fprintf(stderr, "Failed to open file a.s for writing.\n");
 		}
 		return EXIT_FAILURE;
 	}
-	register_cleanup(ir);
-
-	// ---------------------------------------------------------------------- Generate Assembly
-
-	struct mcc_asm *code = mcc_asm_generate(ir);
-	if (!code) {
+	bool generated = mcc_asm_print_program(assembly_out, (&result)->program, &passes);
+	fclose(assembly_out);
+	if (!generated) {
 		if (!command_line->options->quiet) {
 			fprintf(stderr, "Assembly code generation failed. Unknown error.\n");
 		}
 		return EXIT_FAILURE;
 	}
-	register_cleanup(code);
-
-	// ---------------------------------------------------------------------- Save assembly to file
-
-	// Print assembly to file
-	FILE *assembly_out = fopen("a.s", "w");
-	if (!assembly_out) {
-		if (!command_line->options->quiet) {
-			fprintf(stderr, "Failed to open file a.s for writing.\n");
-		}
-		return EXIT_FAILURE;
+	if (passes.time_passes) {
+		mcc_pass_manager_print_timings(&passes, stderr);
 	}
-	mcc_asm_print_asm(assembly_out, code);
-	fclose(assembly_out);
 
 	// ---------------------------------------------------------------------- Call gcc to assemble and link
 
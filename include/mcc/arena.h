@@ -0,0 +1,65 @@
+// Compilation Region
+//
+// The AST, symbol table, IR, control flow graph and assembly code of a compilation are allocated with mcc_alloc.
+// After mcc_arena_enable was called, these allocations are bumped from large blocks, mcc_free does nothing, and
+// mcc_arena_release frees everything at once at the end of the compilation instead of deleting each object.
+// Without mcc_arena_enable, the functions fall back to malloc and free, so that the delete functions of the
+// individual data structures keep working, e.g. in the unit tests.
+//
+// Data that only lives while a part of the program is compiled can be allocated from a separate scratch region, so
+// that the memory is reused for the next part instead of being kept until the end of the compilation.
+
+#ifndef MCC_ARENA_H
+#define MCC_ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// --------------------------------------------------------------------------------------- Data structure
+
+struct mcc_arena_stats {
+	// Number of allocations served by the region, each was a malloc before
+	size_t allocations;
+	// Total size of these allocations in bytes, including alignment
+	size_t bytes;
+	// Number of blocks allocated with malloc to store them
+	size_t blocks;
+	// Calls of mcc_free that were skipped, since the memory is released together
+	size_t frees;
+};
+
+// --------------------------------------------------------------------------------------- Functions
+
+// Allocates from the region from now on. It has to be called before the first mcc_alloc of data that is freed later:
+// mcc_free does nothing once the region is enabled, so memory allocated with malloc before would never be freed.
+void mcc_arena_enable(void);
+
+bool mcc_arena_is_enabled(void);
+
+// Same as malloc, calloc and strdup, but allocates from the region if it is enabled
+void *mcc_alloc(size_t size);
+
+void *mcc_calloc(size_t count, size_t size);
+
+char *mcc_strdup(const char *string);
+
+// Same as free if the region is disabled, does nothing otherwise
+void mcc_free(void *ptr);
+
+struct mcc_arena_stats mcc_arena_get_stats(void);
+
+void mcc_arena_print_stats(FILE *out);
+
+// Frees all memory allocated from the region and resets the statistics. The region stays enabled.
+void mcc_arena_release(void);
+
+// While use is true, allocations are bumped from a separate scratch region instead, which can be freed on its own
+// with mcc_arena_release_scratch, e.g. after each function of a program. Returns the previous setting, so that
+// long-lived data can be allocated from the main region in between.
+bool mcc_arena_use_scratch(bool use);
+
+// Frees all memory allocated from the scratch region, the setting of mcc_arena_use_scratch is kept
+void mcc_arena_release_scratch(void);
+
+#endif // MCC_ARENA_H
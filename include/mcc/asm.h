@@ -16,6 +16,46 @@ struct mcc_asm_data {
 	bool has_failed;
 	struct mcc_asm_data_section *data_section;
 	struct mcc_asm_line *current;
+	// Stack slots of the function that is currently generated. Built once per function by
+	// mcc_asm_generate_function, so that operands don't need to rescan the IR.
+	struct mcc_asm_slot_map *slots;
+	// Lookup tables for the declarations of the data section. Populated by mcc_asm_generate_data_section.
+	struct mcc_asm_data_index *data_index;
+	// Last declaration of the data section and number of declarations so far, which is part of their names
+	struct mcc_asm_declaration *last_declaration;
+	int num_declarations;
+};
+
+// The maps are keyed by interned identifiers and compare them by pointer
+struct mcc_asm_slot_map {
+	// Function label of the current function, function[i] is the annotated row with index i of the function
+	struct mcc_annotated_ir *function;
+	// Identifier -> first assignment to that identifier
+	struct mcc_hash_map *identifiers;
+	// Temporary $tmpN -> first assignment to $tmpN or tmpN
+	struct mcc_hash_map *temporaries;
+	// Array name -> array declaration
+	struct mcc_hash_map *arrays;
+	// Array name -> array declaration or first assignment (in case of array parameters)
+	struct mcc_hash_map *declarations;
+};
+
+struct mcc_asm_data_index {
+	// Variable name -> any declaration of that variable (declarations of x are named x_0, x_1, ...)
+	struct mcc_hash_map *variables;
+	// Identifier -> float declaration
+	struct mcc_hash_map *floats;
+	// Interned string value -> first string declaration with that value
+	struct mcc_hash_map *strings;
+	// (Variable name or identifier, bit pattern of value) -> first float declaration, see mcc_asm_float_key
+	struct mcc_hash_map *float_values;
+	struct mcc_asm_float_key *float_keys;
+};
+
+struct mcc_asm_float_key {
+	const char *name;
+	double value;
+	struct mcc_asm_float_key *next;
 };
 
 //---------------------------------------------------------------------------------------- Data structure: ASM
@@ -43,6 +83,7 @@ struct mcc_asm_declaration {
 	enum mcc_asm_declaration_type type;
 	union {
 		double float_value;
+		// Interned, see mcc/intern.h
 		char *string_value;
 	};
 	struct mcc_asm_declaration *next;
@@ -191,6 +232,11 @@ struct mcc_asm_operand *mcc_asm_new_computed_offset_operand(int offset_initial,
 
 struct mcc_asm_operand *mcc_asm_new_data_operand(struct mcc_asm_declaration *decl, struct mcc_asm_data *data);
 
+// Collects the stack slots of the function starting at the given function label
+struct mcc_asm_slot_map *mcc_asm_new_slot_map(struct mcc_annotated_ir *function, struct mcc_asm_data *data);
+
+struct mcc_asm_data_index *mcc_asm_new_data_index(struct mcc_asm_data *data);
+
 //------------------------------------------------------------------------------------ Functions: Delete data structures
 
 void mcc_asm_delete_asm(struct mcc_asm *head);
@@ -213,6 +259,10 @@ void mcc_asm_delete_line(struct mcc_asm_line *line);
 
 void mcc_asm_delete_operand(struct mcc_asm_operand *operand);
 
+void mcc_asm_delete_slot_map(struct mcc_asm_slot_map *slots);
+
+void mcc_asm_delete_data_index(struct mcc_asm_data_index *index);
+
 //---------------------------------------------------------------------------------------- Functions: ASM generation
 
 void mcc_asm_generate_asm_from_ir(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data);
@@ -231,7 +281,19 @@ void mcc_asm_generate_data_section(struct mcc_asm_data_section *data_section,
                                    struct mcc_annotated_ir *an_ir,
                                    struct mcc_asm_data *data);
 
-struct mcc_asm *mcc_asm_generate(struct mcc_ir_row *ir);
+struct mcc_asm *mcc_asm_generate(struct mcc_ir_function *ir);
+
+// Generation of the assembly code one function at a time, so that the IR and assembly code of a function can be freed
+// before the next one is generated. Only the data section is kept for the whole program. mcc_asm_new_data returns the
+// generation data with an empty data section, which then collects the declarations of each function passed to
+// mcc_asm_generate_next_function. A declaration is only known to the functions that follow it.
+struct mcc_asm_data *mcc_asm_new_data(void);
+
+// ir is the IR of a single function, see mcc_ir_generate_function
+struct mcc_asm_function *mcc_asm_generate_next_function(struct mcc_ir_function *ir, struct mcc_asm_data *data);
+
+// Deletes data together with its data section
+void mcc_asm_delete_data(struct mcc_asm_data *data);
 
 #endif // MCC_ASM_H
 
@@ -6,6 +6,7 @@
 #define MCC_ASM_PRINT_H
 
 #include "mcc/asm.h"
+#include "mcc/pass_manager.h"
 
 //---------------------------------------------------------------------------------------- Functions: Print ASM
 
@@ -21,6 +22,13 @@ void mcc_asm_print_data_sec(FILE *out, struct mcc_asm_data_section *data);
 
 void mcc_asm_print_asm(FILE *out, struct mcc_asm *head);
 
+// Generates the assembly code of a checked program function by function and prints each function right away, the
+// output is the same as of mcc_asm_print_asm. The IR and assembly code of a function are allocated from the scratch
+// region of the arena and freed before the next function is generated, so the memory needed for them is bounded by
+// the largest function. The passes of the pass manager run on each function before it is printed, passes may be NULL
+// to run none. Returns false if the generation failed, the output is incomplete then.
+bool mcc_asm_print_program(FILE *out, struct mcc_ast_program *program, struct mcc_pass_manager *passes);
+
 void mcc_asm_print_end(FILE *out);
 
 #endif // MCC_ASM_PRINT_H
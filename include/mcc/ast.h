@@ -6,6 +6,10 @@
 // In addition to the node type specific members, each node features a common
 // member `mmc_ast_node` which serves as a *base-class*. It holds data
 // independent from the actual node type, like the source location.
+//
+// Statements of a compound statement, parameters and arguments are stored in
+// contiguous arrays instead of linked lists. Parentheses are not kept as nodes,
+// the structure of the tree already reflects them.
 
 #ifndef MCC_AST_H
 #define MCC_AST_H
@@ -22,13 +26,22 @@ struct mcc_ast_source_location {
 	int start_col;
 	int end_line;
 	int end_col;
-	char *filename;
+	// Index of the source file, see mcc_ast_get_filename
+	unsigned file;
 };
 
 struct mcc_ast_node {
 	struct mcc_ast_source_location sloc;
 };
 
+// Source files are stored once, so that each node only needs the index of its file. Returns the index of filename,
+// which has to stay valid until mcc_ast_delete_filenames is called, or 0 if memory allocation failed.
+unsigned mcc_ast_add_filename(char *filename);
+
+char *mcc_ast_get_filename(struct mcc_ast_node node);
+
+void mcc_ast_delete_filenames(void);
+
 // ------------------------------------------------------------------ Operators
 
 enum mcc_ast_binary_op {
@@ -56,7 +69,6 @@ enum mcc_ast_unary_op {
 enum mcc_ast_expression_type {
 	MCC_AST_EXPRESSION_TYPE_LITERAL,
 	MCC_AST_EXPRESSION_TYPE_BINARY_OP,
-	MCC_AST_EXPRESSION_TYPE_PARENTH,
 	MCC_AST_EXPRESSION_TYPE_UNARY_OP,
 	MCC_AST_EXPRESSION_TYPE_VARIABLE,
 	MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT,
@@ -78,9 +90,6 @@ struct mcc_ast_expression {
 			struct mcc_ast_expression *rhs;
 		};
 
-		// MCC_AST_EXPRESSION_TYPE_PARENTH
-		struct mcc_ast_expression *expression;
-
 		// MCC_AST_EXPRESSION_TYPE_UNARY_OP
 		struct {
 			enum mcc_ast_unary_op u_op;
@@ -115,8 +124,6 @@ struct mcc_ast_expression *mcc_ast_new_expression_binary_op(enum mcc_ast_binary_
                                                             struct mcc_ast_expression *lhs,
                                                             struct mcc_ast_expression *rhs);
 
-struct mcc_ast_expression *mcc_ast_new_expression_parenth(struct mcc_ast_expression *expression);
-
 struct mcc_ast_expression *mcc_ast_new_expression_unary_op(enum mcc_ast_unary_op u_op,
                                                            struct mcc_ast_expression *expression);
 
@@ -231,6 +238,7 @@ void mcc_ast_delete_array_assignment(struct mcc_ast_assignment *assignment);
 struct mcc_ast_identifier {
 
 	struct mcc_ast_node node;
+	// interned, see mcc/intern.h
 	char *identifier_name;
 };
 
@@ -315,15 +323,16 @@ void mcc_ast_delete_statement(struct mcc_ast_statement *statement);
 
 struct mcc_ast_compound_statement {
 	struct mcc_ast_node node;
-	bool is_empty;
-	bool has_next_statement;
-	struct mcc_ast_compound_statement *next_compound_statement;
-	struct mcc_ast_statement *statement;
+	unsigned num_statements;
+	unsigned capacity;
+	struct mcc_ast_statement **statements;
 };
 
-struct mcc_ast_compound_statement *mcc_ast_new_compound_stmt(bool is_empty,
-                                                             struct mcc_ast_statement *statement,
-                                                             struct mcc_ast_compound_statement *next_compound_stmt);
+struct mcc_ast_compound_statement *mcc_ast_new_compound_stmt(void);
+
+// Appends statement. Returns compound_statement, or NULL if memory allocation failed.
+struct mcc_ast_compound_statement *mcc_ast_add_statement(struct mcc_ast_compound_statement *compound_statement,
+                                                         struct mcc_ast_statement *statement);
 
 void mcc_ast_delete_compound_statement(struct mcc_ast_compound_statement *compound_statement);
 
@@ -411,15 +420,16 @@ void mcc_ast_delete_program(struct mcc_ast_program *program);
 
 struct mcc_ast_parameters {
 	struct mcc_ast_node node;
-	bool has_next_parameter;
-	bool is_empty;
-	struct mcc_ast_parameters *next_parameters;
-	struct mcc_ast_declaration *declaration;
+	unsigned num_parameters;
+	unsigned capacity;
+	struct mcc_ast_declaration **declarations;
 };
 
-struct mcc_ast_parameters *mcc_ast_new_parameters(bool is_empty,
-                                                  struct mcc_ast_declaration *declaration,
-                                                  struct mcc_ast_parameters *next_parameters);
+struct mcc_ast_parameters *mcc_ast_new_parameters(void);
+
+// Appends declaration. Returns parameters, or NULL if memory allocation failed.
+struct mcc_ast_parameters *mcc_ast_add_parameter(struct mcc_ast_parameters *parameters,
+                                                 struct mcc_ast_declaration *declaration);
 
 void mcc_ast_delete_parameters(struct mcc_ast_parameters *parameters);
 
@@ -427,22 +437,38 @@ void mcc_ast_delete_parameters(struct mcc_ast_parameters *parameters);
 
 struct mcc_ast_arguments {
 	struct mcc_ast_node node;
-	bool has_next_expression;
-	bool is_empty;
-	struct mcc_ast_arguments *next_arguments;
-	struct mcc_ast_expression *expression;
+	unsigned num_arguments;
+	unsigned capacity;
+	struct mcc_ast_expression **expressions;
 };
 
-struct mcc_ast_arguments *
-mcc_ast_new_arguments(bool is_empty, struct mcc_ast_expression *expression, struct mcc_ast_arguments *next_arguments);
+struct mcc_ast_arguments *mcc_ast_new_arguments(void);
+
+// Appends expression. Returns arguments, or NULL if memory allocation failed.
+struct mcc_ast_arguments *mcc_ast_add_argument(struct mcc_ast_arguments *arguments,
+                                               struct mcc_ast_expression *expression);
 
 void mcc_ast_delete_arguments(struct mcc_ast_arguments *arguments);
 
-// ------------------------------------------------------------------- Add built_ins
+// ------------------------------------------------------------------- Built_ins
+
+// Signature of a function that every program can call without defining it. The symbol table and the semantic checks
+// add them behind the functions of the program, the AST never contains them.
+struct mcc_ast_built_in {
+	const char *name;
+	enum mcc_ast_types return_type;
+	// The built_ins take at most one parameter, VOID if they take none
+	enum mcc_ast_types parameter_type;
+	const char *parameter_name;
+};
+
+#define MCC_AST_NUM_BUILT_INS 6
 
-bool mcc_ast_add_built_ins(struct mcc_ast_program *program);
+// print, print_nl, print_int, print_float, read_int and read_float in this order
+extern const struct mcc_ast_built_in mcc_ast_built_ins[MCC_AST_NUM_BUILT_INS];
 
-struct mcc_ast_program *mcc_ast_remove_built_ins(struct mcc_ast_program *program);
+// Returns the built_in with the given name, otherwise NULL
+const struct mcc_ast_built_in *mcc_ast_get_built_in(const char *name);
 
 // ------------------------------------------------------------------- Transforming the complete AST
 
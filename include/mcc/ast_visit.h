@@ -4,6 +4,9 @@
 //
 // Instantiate the `mcc_ast_visitor` struct with the desired configuration and callbacks.
 // Use this instance with the functions declared below. Each callback is optional, just set it to NULL.
+//
+// The traversal only recurses up to a fixed depth. Below it, the path to the current node is kept on a stack that moves
+// to the heap when the AST is deep, so that deeply nested expressions and statements do not overflow the C stack.
 
 #ifndef MCC_AST_VISIT_H
 #define MCC_AST_VISIT_H
@@ -39,7 +42,6 @@ struct mcc_ast_visitor {
 	mcc_ast_visit_expression_cb expression;
 	mcc_ast_visit_expression_cb expression_literal;
 	mcc_ast_visit_expression_cb expression_binary_op;
-	mcc_ast_visit_expression_cb expression_parenth;
 	mcc_ast_visit_expression_cb expression_unary_op;
 	mcc_ast_visit_expression_cb expression_variable;
 	mcc_ast_visit_expression_cb expression_array_element;
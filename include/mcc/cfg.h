@@ -5,6 +5,7 @@
 // of the graph.
 // In order to make traversing easier, each node also contains a pointer to the next basic block, inferred from the
 // order they appear in the IR. This essentially enables traversing the CFG as if it was a linked list.
+// Each node also lists its predecessors, dominators and loops are computed on top of the CFG, see mcc/cfg_analysis.h.
 
 #ifndef MCC_CFG_H
 #define MCC_CFG_H
@@ -14,28 +15,42 @@
 //---------------------------------------------------------------------------------------- Data structure: CFG
 
 struct mcc_basic_block {
-	struct mcc_ir_row *leader;
+	// The block holds the rows leader to leader + num_rows - 1 of function
+	struct mcc_ir_function *function;
+	unsigned leader;
+	unsigned num_rows;
+	// Position of the block among the blocks of its function, the first block of a function has index 0
+	unsigned index;
 	struct mcc_basic_block *child_left;
 	struct mcc_basic_block *child_right;
+	// Blocks that have this block as a child, in the order of the blocks
+	struct mcc_basic_block **predecessors;
+	unsigned num_predecessors;
 	struct mcc_basic_block *next;
 };
 
 //---------------------------------------------------------------------------------------- Functions: CFG
 
-// Gives the cfg as directed tree
-struct mcc_basic_block *mcc_cfg_generate(struct mcc_ir_row *ir);
+// Gives the CFG of one function. The CFG refers to row ranges of the function, which is not modified, so it can be
+// built whenever an analysis needs it and deleted with mcc_delete_cfg afterwards. The first block is the entry block,
+// the blocks are linked by next in the order of the rows.
+struct mcc_basic_block *mcc_cfg_generate_function(struct mcc_ir_function *function);
 
-// Restrict the CFG to just one function
-struct mcc_basic_block *mcc_cfg_limit_to_function(char *function_identifier, struct mcc_basic_block *cfg_first);
+// Gives the CFG of all functions of ir, the CFGs of the functions are linked by next in the order of the functions
+struct mcc_basic_block *mcc_cfg_generate(struct mcc_ir_function *ir);
+
+// Returns the function of ir with the given name or NULL if there is none
+struct mcc_ir_function *mcc_cfg_find_function(struct mcc_ir_function *ir, const char *function_identifier);
 
 //---------------------------------------------------------------------------------------- Functions: Set up datastructs
 
-struct mcc_basic_block *mcc_cfg_new_basic_block(struct mcc_ir_row *leader,
+struct mcc_basic_block *mcc_cfg_new_basic_block(struct mcc_ir_function *function,
+                                                unsigned leader,
                                                 struct mcc_basic_block *child_left,
                                                 struct mcc_basic_block *child_right);
 
-// Delete CFG and contained IR
-void mcc_delete_cfg_and_ir(struct mcc_basic_block *head);
+// Delete CFG, the IR it refers to is kept
+void mcc_delete_cfg(struct mcc_basic_block *head);
 
 #endif // MCC_CFG_H
 
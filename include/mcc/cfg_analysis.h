@@ -0,0 +1,112 @@
+// CFG Analysis
+//
+// This module computes dominators and natural loops on the CFG of one function, see mcc/cfg.h.
+//
+// The dominator tree is computed with the algorithm of Cooper, Harvey and Kennedy, "A Simple, Fast Dominance
+// Algorithm". A block a dominates a block b if every path from the entry block to b passes through a. The dominance
+// frontier of a holds the blocks where the dominance of a ends, i.e. the blocks that a does not strictly dominate
+// although a dominates one of their predecessors.
+//
+// An edge from a block to a block that dominates it is a back edge. The natural loop of a back edge consists of its
+// target, the loop header, and all blocks that reach the source of the back edge without passing through the header.
+// The natural loops of back edges with the same header are merged into one loop. Loops with different headers are
+// either disjoint or nested, the depth of an outermost loop is 1. Cycles that are entered at more than one block
+// (irreducible control flow) have no back edge and are not detected as loops.
+//
+// The analysis refers to the blocks of the CFG, which is not modified, and has to be deleted before the CFG.
+
+#ifndef MCC_CFG_ANALYSIS_H
+#define MCC_CFG_ANALYSIS_H
+
+#include <stdbool.h>
+
+#include "mcc/cfg.h"
+
+//---------------------------------------------------------------------------------------- Data structure
+
+struct mcc_loop {
+	struct mcc_basic_block *header;
+	// The only predecessor of header outside of the loop if header is its only child, NULL otherwise. Code that is
+	// moved out of the loop can be placed at the end of the preheader.
+	struct mcc_basic_block *preheader;
+	// Innermost loop containing this loop, NULL for an outermost loop
+	struct mcc_loop *parent;
+	unsigned depth;
+
+	// Blocks of the loop including the blocks of nested loops, the header comes first
+	struct mcc_basic_block **blocks;
+	unsigned num_blocks;
+	// Sources of the back edges to header
+	struct mcc_basic_block **latches;
+	unsigned num_latches;
+};
+
+// Indexed by mcc_basic_block.index
+struct mcc_cfg_block_info {
+	// Position of the block in reverse postorder, UINT_MAX if the block cannot be reached from the entry block
+	unsigned rpo_number;
+
+	// Immediate dominator, NULL for the entry block and unreachable blocks
+	struct mcc_basic_block *idom;
+	// Children of the block in the dominator tree are linked by dom_sibling
+	struct mcc_basic_block *dom_child;
+	struct mcc_basic_block *dom_sibling;
+	// Numbers of the block in a preorder and a postorder walk of the dominator tree, used by mcc_cfg_dominates
+	unsigned dom_pre;
+	unsigned dom_post;
+
+	struct mcc_basic_block **frontier;
+	unsigned num_frontier;
+
+	// Innermost loop containing the block, NULL if the block is in no loop
+	struct mcc_loop *loop;
+};
+
+struct mcc_cfg_analysis {
+	struct mcc_basic_block *entry;
+	// The blocks of the function, indexed by mcc_basic_block.index
+	struct mcc_basic_block **blocks;
+	struct mcc_cfg_block_info *info;
+	unsigned num_blocks;
+
+	// The blocks that can be reached from entry in reverse postorder, entry comes first
+	struct mcc_basic_block **rpo;
+	unsigned num_reachable;
+
+	// Outer loops come before the loops nested in them
+	struct mcc_loop *loops;
+	unsigned num_loops;
+
+	// Storage of all dominance frontiers
+	struct mcc_basic_block **frontiers;
+};
+
+//---------------------------------------------------------------------------------------- Functions
+
+// Analyzes the CFG of the function of entry, which has to be the first block of the function. Returns NULL if memory
+// allocation failed.
+struct mcc_cfg_analysis *mcc_cfg_analyze(struct mcc_basic_block *entry);
+
+bool mcc_cfg_is_reachable(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *block);
+
+// True if a dominates b, every block dominates itself. Unreachable blocks dominate and are dominated by no block.
+bool mcc_cfg_dominates(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *a, struct mcc_basic_block *b);
+
+struct mcc_basic_block *mcc_cfg_get_idom(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *block);
+
+// Returns the innermost loop containing the block or NULL
+struct mcc_loop *mcc_cfg_get_loop(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *block);
+
+// Number of loops containing the block, 0 outside of loops
+unsigned mcc_cfg_loop_depth(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *block);
+
+bool mcc_cfg_is_loop_header(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *block);
+
+bool mcc_cfg_is_back_edge(struct mcc_cfg_analysis *analysis,
+                          struct mcc_basic_block *from,
+                          struct mcc_basic_block *to);
+
+void mcc_cfg_delete_analysis(struct mcc_cfg_analysis *analysis);
+
+#endif // MCC_CFG_ANALYSIS_H
+
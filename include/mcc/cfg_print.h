@@ -7,6 +7,7 @@
 #define MCC_CFG_PRINT_H
 
 #include "mcc/cfg.h"
+#include "mcc/cfg_analysis.h"
 
 //---------------------------------------------------------------------------------------- Functions: Print CFT as .dot
 
@@ -14,13 +15,16 @@ void mcc_cfg_print_dot_begin(FILE *out);
 
 void mcc_cfg_print_dot_end(FILE *out);
 
-void mcc_cfg_print_dot_bb(FILE *out, struct mcc_basic_block *block);
+// Marks loop headers and back edges if analysis is not NULL
+void mcc_cfg_print_dot_bb(FILE *out, struct mcc_basic_block *block, struct mcc_cfg_analysis *analysis);
 
-void mcc_cfg_print_dot_ir_row(FILE *out, struct mcc_ir_row *leader);
+// Prints the row with the given index of the function of block
+void mcc_cfg_print_dot_ir_row(FILE *out, struct mcc_basic_block *block, unsigned row);
 
-void mcc_cfg_print_dot_ir(FILE *out, struct mcc_ir_row *leader);
+void mcc_cfg_print_dot_ir(FILE *out, struct mcc_basic_block *block);
 
-void mcc_cfg_print_dot_cfg(FILE *out, struct mcc_basic_block *head);
+// Prints the CFG, with loop headers and back edges marked if analysis is not NULL
+void mcc_cfg_print_dot_cfg(FILE *out, struct mcc_basic_block *head, struct mcc_cfg_analysis *analysis);
 
 #endif // MCC_CFG_PRINT_H
 
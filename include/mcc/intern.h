@@ -0,0 +1,49 @@
+// String Interning
+//
+// This module stores each distinct identifier exactly once. The scanner interns every identifier it reads, and the AST,
+// symbol table, IR and assembly code share these strings instead of copying them.
+// Two interned strings are equal iff their pointers are equal, so identifiers are compared with mcc_intern_equal
+// instead of strcmp.
+// Interned strings must not be modified or freed. They stay valid until mcc_intern_delete_all is called at the end of
+// the compilation.
+
+#ifndef MCC_INTERN_H
+#define MCC_INTERN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// --------------------------------------------------------------------------------------- Data structure
+
+struct mcc_intern_stats {
+	// Number of calls to mcc_intern
+	size_t requests;
+	// Calls of mcc_intern that returned an existing string, each would have been a strdup before
+	size_t hits;
+	// Number of distinct strings and their total size in bytes
+	size_t strings;
+	size_t bytes;
+	// Number of blocks allocated to store the strings
+	size_t blocks;
+};
+
+// --------------------------------------------------------------------------------------- Functions
+
+// Returns the interned copy of string, or NULL if memory allocation failed
+char *mcc_intern(const char *string);
+
+// Returns the interned copy of string or NULL if string was never interned. Does not allocate.
+char *mcc_intern_lookup(const char *string);
+
+// Compares two interned strings
+bool mcc_intern_equal(const char *interned_a, const char *interned_b);
+
+struct mcc_intern_stats mcc_intern_get_stats(void);
+
+void mcc_intern_print_stats(FILE *out);
+
+// Frees all interned strings and resets the statistics
+void mcc_intern_delete_all(void);
+
+#endif // MCC_INTERN_H
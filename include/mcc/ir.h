@@ -17,16 +17,19 @@
 //---------------------------------------------------------------------------------------- IR generation
 
 struct ir_generation_userdata {
-	// First row of IR
-	struct mcc_ir_row *head;
-	// Current (last) row of IR, set during execution
-	struct mcc_ir_row *current;
+	// Rows of the function that is currently generated. The array grows while the function is generated and is
+	// copied to its mcc_ir_function afterwards, so that it can be reused for the next function.
+	struct mcc_ir_row *rows;
+	unsigned num_rows;
+	unsigned capacity;
 	// Flag for indicating errors
 	bool has_failed;
 	// Counts number of (non-function) labels
 	unsigned label_counter;
 	// Counts float temporaries
 	unsigned tmp_counter;
+	// Counts rows that are printed as temporaries, see mcc_ir_row.row_no
+	unsigned row_counter;
 };
 
 //---------------------------------------------------------------------------------------- Data structure: IR
@@ -60,6 +63,8 @@ enum mcc_ir_instruction {
 };
 
 enum mcc_ir_arg_type {
+	// Absent argument, e.g. the second argument of a jump
+	MCC_IR_TYPE_NONE,
 	MCC_IR_TYPE_LIT_INT,
 	MCC_IR_TYPE_LIT_FLOAT,
 	MCC_IR_TYPE_LIT_BOOL,
@@ -71,6 +76,20 @@ enum mcc_ir_arg_type {
 	MCC_IR_TYPE_FUNC_LABEL,
 };
 
+// Index of an array element: MCC_IR_TYPE_LIT_INT, MCC_IR_TYPE_IDENTIFIER or MCC_IR_TYPE_ROW. An index that is an
+// array element itself is assigned to a temporary first.
+struct mcc_ir_index {
+	enum mcc_ir_arg_type type;
+
+	union {
+		long lit_int;
+		char *ident;
+		unsigned row;
+	};
+};
+
+// Arguments are immutable values stored in their row. Identifiers, function labels and string literals are interned,
+// so two arguments are equal iff their type and bits are equal, see mcc_ir_arg_equal.
 struct mcc_ir_arg {
 	enum mcc_ir_arg_type type;
 
@@ -79,12 +98,13 @@ struct mcc_ir_arg {
 		double lit_float;
 		bool lit_bool;
 		char *lit_string;
-		struct mcc_ir_row *row;
+		// Index of the row in the rows of its function
+		unsigned row;
 		unsigned label;
 		char *ident;
 		struct {
 			char *arr_ident;
-			struct mcc_ir_arg *index;
+			struct mcc_ir_index index;
 		};
 		char *func_label;
 	};
@@ -104,17 +124,30 @@ struct mcc_ir_row_type {
 };
 
 struct mcc_ir_row {
+	// Number of the temporary holding the value of the row, counted across the functions
 	unsigned row_no;
 	enum mcc_ir_instruction instr;
-	struct mcc_ir_row_type *type;
+	struct mcc_ir_row_type type;
 
-	struct mcc_ir_arg *arg1;
-	struct mcc_ir_arg *arg2;
+	struct mcc_ir_arg arg1;
+	struct mcc_ir_arg arg2;
+};
 
-	struct mcc_ir_row *prev_row;
-	struct mcc_ir_row *next_row;
+// IR of one function. The first row is the function label, rows refer to each other by their index in rows.
+struct mcc_ir_function {
+	struct mcc_ir_row *rows;
+	unsigned num_rows;
+
+	// Next function of the program
+	struct mcc_ir_function *next;
 };
 
+// True for arithmetic, comparison and logical operations of two arguments
+bool is_binary_instr(struct mcc_ir_row *row);
+
+// Compares two arguments without comparing strings, names and string literals are compared by their pointers
+bool mcc_ir_arg_equal(const struct mcc_ir_arg *arg_a, const struct mcc_ir_arg *arg_b);
+
 //---------------------------------------------------------------------------------------- Generate IR datastructures
 
 void mcc_ir_generate_arguments(struct mcc_ast_arguments *arguments, struct ir_generation_userdata *data);
@@ -139,36 +172,43 @@ void mcc_ir_generate_program(struct mcc_ast_program *program, struct ir_generati
 
 void mcc_ir_generate_function_definition(struct mcc_ast_function_definition *def, struct ir_generation_userdata *data);
 
-struct mcc_ir_arg *mcc_ir_generate_arg_lit(struct mcc_ast_literal *literal, struct ir_generation_userdata *data);
-
-struct mcc_ir_arg *mcc_ir_generate_expression_binary_op(struct mcc_ast_expression *expression,
-                                                        struct ir_generation_userdata *data);
+struct mcc_ir_arg mcc_ir_generate_arg_lit(struct mcc_ast_literal *literal, struct ir_generation_userdata *data);
 
-struct mcc_ir_arg *mcc_ir_generate_expression_unary_op(struct mcc_ast_expression *expression,
+struct mcc_ir_arg mcc_ir_generate_expression_binary_op(struct mcc_ast_expression *expression,
                                                        struct ir_generation_userdata *data);
 
-struct mcc_ir_arg *mcc_ir_generate_expression_var(struct mcc_ast_expression *expression,
-                                                  struct ir_generation_userdata *data);
+struct mcc_ir_arg mcc_ir_generate_expression_unary_op(struct mcc_ast_expression *expression,
+                                                      struct ir_generation_userdata *data);
 
-struct mcc_ir_arg *mcc_ir_generate_expression_func_call(struct mcc_ast_expression *expression,
-                                                        struct ir_generation_userdata *data);
+struct mcc_ir_arg mcc_ir_generate_expression_var(struct mcc_ast_expression *expression,
+                                                 struct ir_generation_userdata *data);
 
-struct mcc_ir_arg *mcc_ir_generate_expression(struct mcc_ast_expression *expression,
-                                              struct ir_generation_userdata *data);
+struct mcc_ir_arg mcc_ir_generate_expression_func_call(struct mcc_ast_expression *expression,
+                                                       struct ir_generation_userdata *data);
+
+struct mcc_ir_arg mcc_ir_generate_expression(struct mcc_ast_expression *expression,
+                                             struct ir_generation_userdata *data);
 
 //---------------------------------------------------------------------------------------- Generate IR
 
-struct mcc_ir_row *mcc_ir_generate(struct mcc_ast_program *ast);
+// Returns the IR of all functions of the program
+struct mcc_ir_function *mcc_ir_generate(struct mcc_ast_program *ast);
 
-//---------------------------------------------------------------------------------------- Cleanup
+// Generation of the IR one function at a time. mcc_ir_generate_prepare adds the missing returns of void functions and
+// renames shadowing declarations in the whole AST once, then mcc_ir_generate_function returns the IR of the function
+// of each program entry. Labels, temporaries and rows are numbered across the functions like in mcc_ir_generate.
+// mcc_ir_generate_finish frees the generation data afterwards.
+bool mcc_ir_generate_prepare(struct mcc_ast_program *ast, struct ir_generation_userdata *data);
 
-void mcc_ir_delete_ir_arg(struct mcc_ir_arg *arg);
+struct mcc_ir_function *mcc_ir_generate_function(struct mcc_ast_program *program,
+                                                 struct ir_generation_userdata *data);
 
-void mcc_ir_delete_ir_row_type(struct mcc_ir_row_type *type);
+void mcc_ir_generate_finish(struct ir_generation_userdata *data);
 
-void mcc_ir_delete_ir_row(struct mcc_ir_row *row);
+//---------------------------------------------------------------------------------------- Cleanup
 
-void mcc_ir_delete_ir(struct mcc_ir_row *head);
+// Deletes the function and all functions following it
+void mcc_ir_delete_ir(struct mcc_ir_function *head);
 
 #endif
 
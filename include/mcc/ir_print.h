@@ -17,9 +17,17 @@ void mcc_ir_print_table_begin(FILE *out);
 
 void mcc_ir_print_table_end(FILE *out);
 
-void mcc_ir_print_ir(FILE *out, struct mcc_ir_row *head, bool escape_quotes, bool doubly_escaped);
+void mcc_ir_print_ir(FILE *out, struct mcc_ir_function *head, bool escape_quotes, bool doubly_escaped);
 
-void mcc_ir_print_ir_row(FILE *out, struct mcc_ir_row *row, bool escape_quotes, bool doubly_escaped);
+// Prints the rows of one function, without the table around them
+void mcc_ir_print_function(FILE *out, struct mcc_ir_function *function, bool escape_quotes, bool doubly_escaped);
+
+// Prints a row of the given function
+void mcc_ir_print_ir_row(FILE *out,
+                         struct mcc_ir_function *function,
+                         struct mcc_ir_row *row,
+                         bool escape_quotes,
+                         bool doubly_escaped);
 
 #endif
 
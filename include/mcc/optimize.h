@@ -0,0 +1,32 @@
+// Optimizations
+//
+// This module provides the optimization passes that the pass manager runs, see mcc/pass_manager.h. Each pass
+// transforms a single function in place and returns false if it failed, e.g. because memory allocation failed.
+//
+// The IR passes remove the rows they fold or simplify. The uses of a removed row are replaced by its value and the
+// remaining rows are moved together, so the IR stays a dense array of rows that refer to each other by index.
+
+#ifndef MCC_OPTIMIZE_H
+#define MCC_OPTIMIZE_H
+
+#include <stdbool.h>
+
+#include "mcc/asm.h"
+#include "mcc/ir.h"
+
+//---------------------------------------------------------------------------------------- IR passes
+
+// Computes int and bool operations of literals, e.g. 2 * 3 becomes 6. Integers wrap around like the 32-bit integers
+// of the generated code, a division by zero is left to the program.
+bool mcc_optimize_fold_constants(struct mcc_ir_function *function);
+
+// Removes operations that give one of their operands or a constant, e.g. x * 1, x - 0, x && true or x || true, and
+// conditional jumps on a literal. Only operands that cannot change in between, i.e. rows and literals, are forwarded.
+bool mcc_optimize_simplify(struct mcc_ir_function *function);
+
+//---------------------------------------------------------------------------------------- Assembly passes
+
+// Removes a load of a register from the memory that the register was just stored to
+bool mcc_optimize_peephole(struct mcc_asm_function *function);
+
+#endif // MCC_OPTIMIZE_H
@@ -12,6 +12,8 @@
 
 #include "mcc/ast.h"
 
+struct mcc_symbol_table;
+
 enum mcc_parser_status {
 	MCC_PARSER_STATUS_OK,
 	MCC_PARSER_STATUS_UNABLE_TO_OPEN_STREAM,
@@ -29,6 +31,9 @@ enum mcc_parser_entry_point {
 	MCC_PARSER_ENTRY_POINT_PARAMETERS,
 	MCC_PARSER_ENTRY_POINT_ARGUMENTS,
 	MCC_PARSER_ENTRY_POINT_COMPOUND_STATEMENT,
+	// Parses a program and builds its symbol table while parsing, the result has the entry point
+	// MCC_PARSER_ENTRY_POINT_PROGRAM
+	MCC_PARSER_ENTRY_POINT_PROGRAM_WITH_SYMBOL_TABLE,
 };
 
 struct mcc_parser_result {
@@ -37,6 +42,8 @@ struct mcc_parser_result {
 
 	char *error_buffer;
 	char *filename;
+	// Index of filename, see mcc_ast_add_filename
+	unsigned file;
 
 	union {
 		// MCC_PARSER_ENTRY_POINT_EXPRESSION
@@ -53,10 +60,19 @@ struct mcc_parser_result {
 		struct mcc_ast_arguments *arguments;
 		struct mcc_ast_compound_statement *compound_statement;
 	};
+
+	// MCC_PARSER_ENTRY_POINT_PROGRAM_WITH_SYMBOL_TABLE: the table of program, which then contains the built_ins
+	// like after mcc_symbol_table_create. NULL if the table could not be built, the caller owns it.
+	struct mcc_symbol_table *symbol_table;
 };
 
 struct mcc_parser_result mcc_parse_string(const char *input, enum mcc_parser_entry_point entry_point, char *name);
 
+// Parses size bytes of buffer in place, without copying them. buffer[size] and buffer[size + 1] have to be NULL
+// characters and the scanner temporarily modifies the buffer, so it must be writable.
+struct mcc_parser_result
+mcc_parse_buffer(char *buffer, size_t size, enum mcc_parser_entry_point entry_point, char *name);
+
 struct mcc_parser_result mcc_parse_file(FILE *input, enum mcc_parser_entry_point entry_point, char *name);
 
 void mcc_ast_delete_result(struct mcc_parser_result *result);
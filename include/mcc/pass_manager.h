@@ -0,0 +1,89 @@
+// Pass Manager
+//
+// The pass manager runs the optimization passes of an optimization level on the IR and on the assembly code of each
+// function. The passes are listed in one table, in the order in which they run, together with the lowest level that
+// runs them:
+//
+//   -O0  no passes
+//   -O1  fold-constants (IR), peephole (assembly)
+//   -O2  fold-constants, simplify (IR), peephole (assembly)
+//
+// The time of each pass is measured if requested, and the function can be printed after a given pass in order to
+// see what the pass did.
+
+#ifndef MCC_PASS_MANAGER_H
+#define MCC_PASS_MANAGER_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "mcc/asm.h"
+#include "mcc/ir.h"
+
+#define MCC_PASS_MANAGER_MAX_LEVEL 2
+
+// Upper bound of the number of passes, so that the pass manager needs no allocation
+#define MCC_PASS_MANAGER_MAX_PASSES 16
+
+// --------------------------------------------------------------------------------------- Data structure
+
+enum mcc_pass_kind {
+	MCC_PASS_KIND_IR,
+	MCC_PASS_KIND_ASM,
+};
+
+struct mcc_pass {
+	const char *name;
+	enum mcc_pass_kind kind;
+	// Lowest optimization level that runs the pass
+	int level;
+	union {
+		// MCC_PASS_KIND_IR
+		bool (*run_ir)(struct mcc_ir_function *function);
+		// MCC_PASS_KIND_ASM
+		bool (*run_asm)(struct mcc_asm_function *function);
+	};
+};
+
+struct mcc_pass_timing {
+	// Number of functions the pass ran on
+	unsigned runs;
+	double seconds;
+};
+
+struct mcc_pass_manager {
+	int level;
+	// Name of the pass after which each function is printed, NULL for none
+	const char *print_after;
+	FILE *print_out;
+	bool time_passes;
+	// Indexed like the table of passes, see mcc_pass_get_passes
+	struct mcc_pass_timing timings[MCC_PASS_MANAGER_MAX_PASSES];
+};
+
+// --------------------------------------------------------------------------------------- Functions
+
+// Returns the table of all passes and sets count to its length
+const struct mcc_pass *mcc_pass_get_passes(unsigned *count);
+
+// Returns the pass with the given name or NULL if there is none
+const struct mcc_pass *mcc_pass_find(const char *name);
+
+// Sets up manager for the given level. The functions are printed to print_out after the pass print_after, if it is not
+// NULL. Returns false if level or print_after are invalid.
+bool mcc_pass_manager_init(struct mcc_pass_manager *manager,
+                           int level,
+                           const char *print_after,
+                           FILE *print_out,
+                           bool time_passes);
+
+// Run the passes of the level on one function. manager may be NULL, then nothing is done. Returns false if a pass
+// failed, the function may be partially transformed then.
+bool mcc_pass_manager_run_ir(struct mcc_pass_manager *manager, struct mcc_ir_function *function);
+
+bool mcc_pass_manager_run_asm(struct mcc_pass_manager *manager, struct mcc_asm_function *function);
+
+// Prints the number of runs and the time of each pass of the level
+void mcc_pass_manager_print_timings(struct mcc_pass_manager *manager, FILE *out);
+
+#endif // MCC_PASS_MANAGER_H
@@ -29,6 +29,8 @@ struct mcc_semantic_check {
 	enum mcc_semantic_check_status status;
 	// error_buffer is set to NULL if status is OK
 	char *error_buffer;
+	// Signatures of all functions, built by the first check that needs them
+	struct mcc_semantic_check_function_table *functions;
 };
 
 // ------------------------------------------------------------ Data structure: Data type for type checking
@@ -68,10 +70,21 @@ enum mcc_semantic_check_error_code mcc_semantic_check_raise_error(int num,
 // Generate struct for semantic check
 struct mcc_semantic_check *mcc_semantic_check_initialize_check();
 
-// Run all semantic checks
+// Run all semantic checks. The checks of the AST share a single traversal, the first error is the same as the one
+// reported by mcc_semantic_check_run_all_separately.
 struct mcc_semantic_check *mcc_semantic_check_run_all(struct mcc_ast_program *ast,
                                                       struct mcc_symbol_table *symbol_table);
 
+// Run all semantic checks one after another, each of them traverses the AST on its own
+struct mcc_semantic_check *mcc_semantic_check_run_all_separately(struct mcc_ast_program *ast,
+                                                                 struct mcc_symbol_table *symbol_table);
+
+// Run all semantic checks with a single traversal of the AST and write the result to check. The error is the first one
+// mcc_semantic_check_run_all_separately reports.
+enum mcc_semantic_check_error_code mcc_semantic_check_run_fused(struct mcc_ast_program *ast,
+                                                                struct mcc_symbol_table *symbol_table,
+                                                                struct mcc_semantic_check *check);
+
 // ------------------------------------------------------------- Functions: Implementation of the individual semantic
 // checks
 
@@ -1,7 +1,8 @@
 // Stack Size
 //
 // This module annotates the IR with additional info in order to ease the generation of x86 assembly code.
-// It provides a wrapper for the IR, and returns a doubly-linked list.
+// It provides a wrapper for the IR, and returns an array with one entry per row of the IR. The rows of the functions
+// follow each other, so the entry of a row is found by adding its index to the entry of its function label.
 // Each entry contains the size on the hardware stack that the line needs, and if it's possible to determine, the offset
 // to the base pointer on the stack.
 // Also string definitions are renamed, so that each string can be declared in the data section of the asm code.
@@ -20,24 +21,15 @@ struct mcc_annotated_ir {
 	// If line is func label, holds stack size of that function
 	int stack_size;
 	int stack_position;
-	struct mcc_annotated_ir *next;
-	struct mcc_annotated_ir *prev;
+	// Row of the IR, NULL in the entry following the last row
 	struct mcc_ir_row *row;
 };
 
-struct mcc_annotated_ir *mcc_new_annotated_ir(struct mcc_ir_row *row, int stack_size);
+void mcc_delete_annotated_ir(struct mcc_annotated_ir *an_ir);
 
-void mcc_delete_annotated_ir(struct mcc_annotated_ir *head);
-
-// Annotate IR to determine stack size of each IR line. Returned struct needs to be deleted with mcc_delete_annotated_ir
-struct mcc_annotated_ir *mcc_annotate_ir(struct mcc_ir_row *ir);
-
-// Returns pointer to first IR line of function. Use existing mcc_annotated_ir struct with this function.
-struct mcc_annotated_ir *mcc_get_function_label(struct mcc_annotated_ir *an_ir);
-
-int mcc_get_array_base_stack_loc(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *array_base);
-
-int mcc_get_array_element_stack_loc(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *array_element);
+// Annotate the IR of all functions of ir to determine stack size of each IR line. Returned array needs to be deleted
+// with mcc_delete_annotated_ir
+struct mcc_annotated_ir *mcc_annotate_ir(struct mcc_ir_function *ir);
 
 #endif
 
@@ -2,11 +2,14 @@
 //
 // This module defines the  data structure for the symbol table.
 // The symbol table is a tree of tables, where sub-scopes are children. Each node represents a scope.
-// Within a scope, linked lists represent entries in the symbol table.
+// Within a scope, linked lists represent entries in the symbol table. Each scope additionally indexes its rows by name,
+// so that a name is resolved with one hash lookup per scope level and redefinitions are found while inserting rows.
 
 #ifndef MCC_SYMBOL_TABLE_H
 #define MCC_SYMBOL_TABLE_H
 
+#include <stdbool.h>
+
 #include "mcc/ast.h"
 
 // ------------------------------------------------------------ Data structure: Symbol Table row
@@ -30,6 +33,7 @@ struct mcc_symbol_table_row {
 	enum mcc_symbol_table_row_structure row_structure;
 	enum mcc_symbol_table_row_type row_type;
 	long array_size; //-1 if no array
+	// interned, see mcc/intern.h
 	char *name;
 
 	struct mcc_symbol_table_row *prev_row;
@@ -37,16 +41,21 @@ struct mcc_symbol_table_row {
 	struct mcc_symbol_table_scope *scope;
 	struct mcc_symbol_table_scope *child_scope;
 
+	// Position of the row in its scope, starting at 0
+	unsigned position;
+	// Previous row of the same scope with the same name. If set, this row is a redefinition.
+	struct mcc_symbol_table_row *prev_declaration;
+
 	struct mcc_ast_node *node;
 };
 
 // ------------------------------------------------------------ Functions: Symbol Table row
 
 struct mcc_symbol_table_row *
-mcc_symbol_table_new_row_variable(char *name, enum mcc_symbol_table_row_type type, struct mcc_ast_node *node);
+mcc_symbol_table_new_row_variable(const char *name, enum mcc_symbol_table_row_type type, struct mcc_ast_node *node);
 
 struct mcc_symbol_table_row *
-mcc_symbol_table_new_row_function(char *name, enum mcc_symbol_table_row_type type, struct mcc_ast_node *node);
+mcc_symbol_table_new_row_function(const char *name, enum mcc_symbol_table_row_type type, struct mcc_ast_node *node);
 
 struct mcc_symbol_table_row *mcc_symbol_table_new_row_array(char *name,
                                                             long array_size,
@@ -59,6 +68,9 @@ void mcc_symbol_table_delete_all_rows(struct mcc_symbol_table_row *head);
 
 void mcc_symbol_table_row_append_child_scope(struct mcc_symbol_table_row *row, struct mcc_symbol_table_scope *child);
 
+// Changes the name of a row and updates the index of its scope. Returns 0 on success.
+int mcc_symbol_table_rename_row(struct mcc_symbol_table_row *row, const char *name);
+
 // ------------------------------------------------------------- Data structure: Symbol Table scope
 
 enum mcc_symbol_table_scope_type {
@@ -72,6 +84,10 @@ struct mcc_symbol_table_scope {
 	struct mcc_symbol_table_row *parent_row;
 	struct mcc_symbol_table_scope *next_scope;
 	struct mcc_symbol_table_scope *prev_scope;
+
+	struct mcc_symbol_table_row *last_row;
+	// Interned name -> last row with that name, earlier rows are reached by prev_declaration. Created on first insert.
+	struct mcc_hash_map *index;
 };
 
 // ------------------------------------------------------------ Functions: Symbol Table scope
@@ -80,7 +96,12 @@ struct mcc_symbol_table_scope *mcc_symbol_table_new_scope();
 
 struct mcc_symbol_table_row *mcc_symbol_table_scope_get_last_row(struct mcc_symbol_table_scope *scope);
 
-void mcc_symbol_table_scope_append_row(struct mcc_symbol_table_scope *scope, struct mcc_symbol_table_row *row);
+// Appends row to the scope and indexes it by its name. Returns 0 on success.
+int mcc_symbol_table_scope_append_row(struct mcc_symbol_table_scope *scope, struct mcc_symbol_table_row *row);
+
+// Returns the last row with the given name and position <= max_position in the scope, otherwise NULL
+struct mcc_symbol_table_row *
+mcc_symbol_table_scope_find_row(struct mcc_symbol_table_scope *scope, const char *name, unsigned max_position);
 
 void mcc_symbol_table_delete_scope(struct mcc_symbol_table_scope *scope);
 
@@ -109,5 +130,49 @@ struct mcc_symbol_table_row *mcc_symbol_table_check_for_function_declaration(con
 
 struct mcc_symbol_table *mcc_symbol_table_create(struct mcc_ast_program *program);
 
+// --------------------------------------------------------------- Functions: create symbol table while parsing
+
+// Builds the same symbol table as mcc_symbol_table_create from the actions of the parser, which call the functions
+// below in source order. All of them do nothing if builder is NULL or building already failed.
+struct mcc_symbol_table_builder {
+	struct mcc_symbol_table *table;
+	// Innermost open scope, NULL outside of function definitions
+	struct mcc_symbol_table_scope *scope;
+	// Row of the function definition that is parsed
+	struct mcc_symbol_table_row *function_row;
+	// Set if a row or scope could not be created
+	bool failed;
+};
+
+// Returns 0 on success
+int mcc_symbol_table_builder_init(struct mcc_symbol_table_builder *builder);
+
+// Creates the row of a function after its name was parsed and opens the scope of its parameters and body
+void mcc_symbol_table_builder_open_function(struct mcc_symbol_table_builder *builder,
+                                            enum mcc_ast_types type,
+                                            struct mcc_ast_identifier *identifier);
+
+void mcc_symbol_table_builder_close_function(struct mcc_symbol_table_builder *builder,
+                                             struct mcc_ast_function_definition *function_definition);
+
+// Opens the scope of a nested compound statement at its opening brace
+void mcc_symbol_table_builder_open_scope(struct mcc_symbol_table_builder *builder);
+
+void mcc_symbol_table_builder_close_scope(struct mcc_symbol_table_builder *builder);
+
+void mcc_symbol_table_builder_declare(struct mcc_symbol_table_builder *builder,
+                                      struct mcc_ast_declaration *declaration);
+
+void mcc_symbol_table_builder_link_assignment(struct mcc_symbol_table_builder *builder,
+                                              struct mcc_ast_assignment *assignment);
+
+// Links variables, array elements and function calls. Other expressions only need the innermost scope to have a row.
+void mcc_symbol_table_builder_link_expression(struct mcc_symbol_table_builder *builder,
+                                              struct mcc_ast_expression *expression);
+
+// Adds the rows of the built_ins and returns the table. Returns NULL and deletes the table if parsing or building
+// failed.
+struct mcc_symbol_table *mcc_symbol_table_builder_finish(struct mcc_symbol_table_builder *builder, bool parsed);
+
 #endif // MCC_SYMBOL_TABLE_H
 
@@ -0,0 +1,171 @@
+#include "mcc/arena.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK_SIZE (64 * 1024)
+
+// Allocations larger than this get a block of their own, so that they do not waste the rest of the current block
+#define LARGE_ALLOCATION (BLOCK_SIZE / 4)
+
+#define ALIGNMENT _Alignof(max_align_t)
+
+struct block {
+	struct block *next;
+	size_t used;
+	size_t size;
+	max_align_t data[];
+};
+
+static struct {
+	bool enabled;
+	// The first block is the one that is currently bumped
+	struct block *blocks;
+	// Blocks of the scratch region, see mcc_arena_use_scratch
+	bool scratch;
+	struct block *scratch_blocks;
+	struct mcc_arena_stats stats;
+} arena;
+
+static struct block *new_block(size_t size)
+{
+	struct block *block = malloc(sizeof(*block) + size);
+	if (!block)
+		return NULL;
+	block->used = 0;
+	block->size = size;
+	arena.stats.blocks++;
+	return block;
+}
+
+static void free_blocks(struct block *block)
+{
+	while (block) {
+		struct block *next = block->next;
+		free(block);
+		block = next;
+	}
+}
+
+static void *bump(size_t size)
+{
+	size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	if (size == 0)
+		size = ALIGNMENT;
+
+	struct block **blocks = arena.scratch ? &arena.scratch_blocks : &arena.blocks;
+	struct block *block = *blocks;
+	if (size > LARGE_ALLOCATION) {
+		block = new_block(size);
+		if (!block)
+			return NULL;
+		// Keep bumping the current block afterwards
+		if (*blocks) {
+			block->next = (*blocks)->next;
+			(*blocks)->next = block;
+		} else {
+			block->next = NULL;
+			*blocks = block;
+		}
+	} else if (!block || block->size - block->used < size) {
+		block = new_block(BLOCK_SIZE);
+		if (!block)
+			return NULL;
+		block->next = *blocks;
+		*blocks = block;
+	}
+
+	void *ptr = (char *)block->data + block->used;
+	block->used += size;
+	arena.stats.allocations++;
+	arena.stats.bytes += size;
+	return ptr;
+}
+
+void mcc_arena_enable(void)
+{
+	arena.enabled = true;
+}
+
+bool mcc_arena_is_enabled(void)
+{
+	return arena.enabled;
+}
+
+void *mcc_alloc(size_t size)
+{
+	if (!arena.enabled)
+		return malloc(size);
+	return bump(size);
+}
+
+void *mcc_calloc(size_t count, size_t size)
+{
+	if (!arena.enabled)
+		return calloc(count, size);
+	if (size && count > SIZE_MAX / size)
+		return NULL;
+	void *ptr = bump(count * size);
+	if (!ptr)
+		return NULL;
+	memset(ptr, 0, count * size);
+	return ptr;
+}
+
+char *mcc_strdup(const char *string)
+{
+	size_t length = strlen(string) + 1;
+	char *copy = mcc_alloc(length);
+	if (!copy)
+		return NULL;
+	memcpy(copy, string, length);
+	return copy;
+}
+
+void mcc_free(void *ptr)
+{
+	if (!arena.enabled) {
+		free(ptr);
+	} else if (ptr) {
+		arena.stats.frees++;
+	}
+}
+
+struct mcc_arena_stats mcc_arena_get_stats(void)
+{
+	return arena.stats;
+}
+
+void mcc_arena_print_stats(FILE *out)
+{
+	struct mcc_arena_stats stats = arena.stats;
+	fprintf(out, "region allocations:        %zu (%zu bytes in %zu blocks)\n", stats.allocations, stats.bytes,
+	        stats.blocks);
+	// Each allocation used to be a malloc and each skipped free a call of free
+	fprintf(out, "mallocs saved:             %zu\n", stats.allocations - stats.blocks);
+	fprintf(out, "frees saved:               %zu\n", stats.frees);
+}
+
+bool mcc_arena_use_scratch(bool use)
+{
+	bool previous = arena.scratch;
+	arena.scratch = use;
+	return previous;
+}
+
+void mcc_arena_release_scratch(void)
+{
+	free_blocks(arena.scratch_blocks);
+	arena.scratch_blocks = NULL;
+}
+
+void mcc_arena_release(void)
+{
+	free_blocks(arena.blocks);
+	free_blocks(arena.scratch_blocks);
+	arena.blocks = NULL;
+	arena.scratch_blocks = NULL;
+	arena.scratch = false;
+	memset(&arena.stats, 0, sizeof(arena.stats));
+}
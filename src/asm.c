@@ -1,94 +1,86 @@
 #include "mcc/asm.h"
 
 #include <assert.h>
-#include <math.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/arena.h"
+#include "mcc/intern.h"
 #include "mcc/ir.h"
 #include "mcc/stack_size.h"
+#include "utils/hash_map.h"
 #include "utils/length_of_int.h"
 
-#define EPSILON 1e-06;
-
 //---------------------------------------------------------------------------------------- Implementation
 
-static bool arg_is_local_array(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg)
+static bool arg_is_local_array(struct mcc_ir_arg *arg, struct mcc_asm_data *data)
 {
+	assert(arg);
 	if (arg->type != MCC_IR_TYPE_IDENTIFIER) {
 		return false;
 	}
-	an_ir = mcc_get_function_label(an_ir);
-	an_ir = an_ir->next;
-	while (an_ir && an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
-		if (an_ir->row->instr == MCC_IR_INSTR_ARRAY) {
-			if (strcmp(an_ir->row->arg1->ident, arg->ident) == 0)
-				return true;
-		}
-		an_ir = an_ir->next;
-	}
-	return false;
+	return mcc_hash_map_get(data->slots->arrays, arg->ident) != NULL;
 }
 
-static int get_identifier_offset(struct mcc_annotated_ir *first, char *ident)
+static int get_identifier_offset(char *ident, struct mcc_asm_data *data)
 {
-	assert(first);
 	assert(ident);
 
-	first = mcc_get_function_label(first);
-	first = first->next;
-
-	while (first && first->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
-		if (first->row->instr == MCC_IR_INSTR_ASSIGN) {
-			// if ident is of form $tmp_xx only compare starting from position 1
-			if (strncmp(ident, "$tmp", 4) == 0) {
-				const char *tmp = &ident[1];
-				if (strcmp(first->row->arg1->ident, tmp) == 0) {
-					return first->stack_position;
-				}
-			}
-			if (strcmp(first->row->arg1->ident, ident) == 0) {
-				return first->stack_position;
-			}
-		}
-		first = first->next;
+	struct mcc_annotated_ir *assignment = NULL;
+	if (strncmp(ident, "$tmp", 4) == 0) {
+		assignment = mcc_hash_map_get(data->slots->temporaries, ident);
+	} else {
+		assignment = mcc_hash_map_get(data->slots->identifiers, ident);
 	}
-	return 0;
+	if (!assignment) {
+		return 0;
+	}
+	return assignment->stack_position;
 }
 
-static int get_row_offset(struct mcc_annotated_ir *an_ir, struct mcc_ir_row *row)
+// row is the index of a row of the current function
+static int get_row_offset(unsigned row, struct mcc_asm_data *data)
 {
-	assert(an_ir);
-	assert(row);
+	return data->slots->function[row].stack_position;
+}
 
-	an_ir = mcc_get_function_label(an_ir);
-	an_ir = an_ir->next;
+static int get_array_base_offset(struct mcc_ir_arg *arg, struct mcc_asm_data *data)
+{
+	assert(arg);
 
-	while (an_ir && an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
-		if (an_ir->row == row) {
-			return an_ir->stack_position;
-		}
-		an_ir = an_ir->next;
+	struct mcc_annotated_ir *array = mcc_hash_map_get(data->slots->arrays, arg->arr_ident);
+	if (!array) {
+		// Not declared in this function, e.g. an array parameter, which is accessed through its reference
+		data->has_failed = true;
+		return 0;
 	}
-	return 0;
+	return array->stack_position;
 }
 
-static int get_offset_of(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg)
+static int get_array_element_offset(struct mcc_ir_arg *arg, struct mcc_asm_data *data)
 {
-	assert(an_ir);
 	assert(arg);
-	struct mcc_annotated_ir *first = an_ir;
-	struct mcc_annotated_ir *prev = first->prev;
-	while (prev) {
-		if (prev->row->instr == MCC_IR_INSTR_FUNC_LABEL) {
-			first = prev;
-			break;
-		}
-		prev = prev->prev;
+
+	// Array index is not int literal -> computed during runtime
+	if (arg->index.type != MCC_IR_TYPE_LIT_INT) {
+		return 0;
+	}
+	struct mcc_annotated_ir *array = mcc_hash_map_get(data->slots->arrays, arg->arr_ident);
+	if (!array) {
+		data->has_failed = true;
+		return 0;
 	}
-	if (arg_is_local_array(an_ir, arg))
-		return mcc_get_array_base_stack_loc(an_ir, arg);
+	return array->stack_position + arg->index.lit_int * DWORD_SIZE;
+}
+
+static int get_offset_of(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg, struct mcc_asm_data *data)
+{
+	assert(an_ir);
+	assert(arg);
+
+	if (arg_is_local_array(arg, data))
+		return get_array_base_offset(arg, data);
 
 	switch (arg->type) {
 	case MCC_IR_TYPE_LIT_INT:
@@ -99,11 +91,11 @@ static int get_offset_of(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg)
 	case MCC_IR_TYPE_FUNC_LABEL:
 		return 0;
 	case MCC_IR_TYPE_ARR_ELEM:
-		return mcc_get_array_element_stack_loc(an_ir, arg);
+		return get_array_element_offset(arg, data);
 	case MCC_IR_TYPE_IDENTIFIER:
-		return get_identifier_offset(first, arg->ident);
+		return get_identifier_offset(arg->ident, data);
 	case MCC_IR_TYPE_ROW:
-		return get_row_offset(first, arg->row);
+		return get_row_offset(arg->row, data);
 	default:
 		return 0;
 	}
@@ -114,7 +106,7 @@ static int get_offset_of(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg)
 struct mcc_asm *
 mcc_asm_new_asm(struct mcc_asm_data_section *data_section, struct mcc_asm_text_section *text, struct mcc_asm_data *data)
 {
-	struct mcc_asm *new = malloc(sizeof(*new));
+	struct mcc_asm *new = mcc_alloc(sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
@@ -126,7 +118,7 @@ mcc_asm_new_asm(struct mcc_asm_data_section *data_section, struct mcc_asm_text_s
 
 struct mcc_asm_data_section *mcc_asm_new_data_section(struct mcc_asm_declaration *head, struct mcc_asm_data *data)
 {
-	struct mcc_asm_data_section *new = malloc(sizeof(*new));
+	struct mcc_asm_data_section *new = mcc_alloc(sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
@@ -137,7 +129,7 @@ struct mcc_asm_data_section *mcc_asm_new_data_section(struct mcc_asm_declaration
 
 struct mcc_asm_text_section *mcc_asm_new_text_section(struct mcc_asm_function *function, struct mcc_asm_data *data)
 {
-	struct mcc_asm_text_section *new = malloc(sizeof(*new));
+	struct mcc_asm_text_section *new = mcc_alloc(sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
@@ -153,12 +145,12 @@ struct mcc_asm_declaration *mcc_asm_new_float_declaration(char *identifier,
 {
 	if (data->has_failed || !identifier)
 		return NULL;
-	struct mcc_asm_declaration *new = malloc(sizeof(*new));
-	char *id_new = strdup(identifier);
+	struct mcc_asm_declaration *new = mcc_alloc(sizeof(*new));
+	char *id_new = mcc_strdup(identifier);
 	if (!new || !id_new) {
 		data->has_failed = true;
-		free(new);
-		free(id_new);
+		mcc_free(new);
+		mcc_free(id_new);
 		return NULL;
 	}
 	new->identifier = id_new;
@@ -175,15 +167,16 @@ struct mcc_asm_declaration *mcc_asm_new_string_declaration(char *identifier,
 {
 	if (data->has_failed || !identifier)
 		return NULL;
-	struct mcc_asm_declaration *new = malloc(sizeof(*new));
-	char *id_new = strdup(identifier);
+	struct mcc_asm_declaration *new = mcc_alloc(sizeof(*new));
+	char *id_new = mcc_strdup(identifier);
 	if (!new || !id_new) {
 		data->has_failed = true;
-		free(new);
-		free(id_new);
+		mcc_free(new);
+		mcc_free(id_new);
 		return NULL;
 	}
 	new->identifier = id_new;
+	// Interned, so it outlives the IR of the function, see mcc_asm_generate_next_function
 	new->string_value = string_value;
 	new->next = next;
 	new->type = MCC_ASM_DECLARATION_TYPE_STRING;
@@ -195,11 +188,11 @@ mcc_asm_new_function(char *label, struct mcc_asm_line *head, struct mcc_asm_func
 {
 	if (data->has_failed)
 		return NULL;
-	struct mcc_asm_function *new = malloc(sizeof(*new));
-	char *lab_new = strdup(label);
+	struct mcc_asm_function *new = mcc_alloc(sizeof(*new));
+	char *lab_new = mcc_strdup(label);
 	if (!new || !lab_new) {
-		free(new);
-		free(lab_new);
+		mcc_free(new);
+		mcc_free(lab_new);
 		data->has_failed = true;
 		return NULL;
 	}
@@ -217,7 +210,7 @@ void mcc_asm_new_line(enum mcc_asm_opcode opcode,
 	if (data->has_failed) {
 		return;
 	}
-	struct mcc_asm_line *new = malloc(sizeof(*new));
+	struct mcc_asm_line *new = mcc_alloc(sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		mcc_asm_delete_operand(first);
@@ -238,7 +231,7 @@ void mcc_asm_new_label(enum mcc_asm_opcode opcode, unsigned label, struct mcc_as
 	if (data->has_failed) {
 		return;
 	}
-	struct mcc_asm_line *new = malloc(sizeof(*new));
+	struct mcc_asm_line *new = mcc_alloc(sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return;
@@ -253,11 +246,11 @@ void mcc_asm_new_label(enum mcc_asm_opcode opcode, unsigned label, struct mcc_as
 
 struct mcc_asm_operand *mcc_asm_new_function_operand(char *function_name, struct mcc_asm_data *data)
 {
-	struct mcc_asm_operand *new = malloc(sizeof(*new));
-	char *func_name_new = strdup(function_name);
+	struct mcc_asm_operand *new = mcc_alloc(sizeof(*new));
+	char *func_name_new = mcc_strdup(function_name);
 	if (!new || !func_name_new) {
-		free(new);
-		free(func_name_new);
+		mcc_free(new);
+		mcc_free(func_name_new);
 		data->has_failed = true;
 		return NULL;
 	}
@@ -269,7 +262,7 @@ struct mcc_asm_operand *mcc_asm_new_function_operand(char *function_name, struct
 
 struct mcc_asm_operand *mcc_asm_new_literal_operand(int literal, struct mcc_asm_data *data)
 {
-	struct mcc_asm_operand *new = malloc(sizeof(*new));
+	struct mcc_asm_operand *new = mcc_alloc(sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
@@ -282,7 +275,7 @@ struct mcc_asm_operand *mcc_asm_new_literal_operand(int literal, struct mcc_asm_
 
 struct mcc_asm_operand *mcc_asm_new_register_operand(enum mcc_asm_register reg, int offset, struct mcc_asm_data *data)
 {
-	struct mcc_asm_operand *new = malloc(sizeof(*new));
+	struct mcc_asm_operand *new = mcc_alloc(sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
@@ -299,7 +292,7 @@ struct mcc_asm_operand *mcc_asm_new_computed_offset_operand(int offset_initial,
                                                             int offset_size,
                                                             struct mcc_asm_data *data)
 {
-	struct mcc_asm_operand *new = malloc(sizeof(*new));
+	struct mcc_asm_operand *new = mcc_alloc(sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
@@ -314,7 +307,7 @@ struct mcc_asm_operand *mcc_asm_new_computed_offset_operand(int offset_initial,
 
 struct mcc_asm_operand *mcc_asm_new_data_operand(struct mcc_asm_declaration *decl, struct mcc_asm_data *data)
 {
-	struct mcc_asm_operand *new = malloc(sizeof(*new));
+	struct mcc_asm_operand *new = mcc_alloc(sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
@@ -325,6 +318,106 @@ struct mcc_asm_operand *mcc_asm_new_data_operand(struct mcc_asm_declaration *dec
 	return new;
 }
 
+// Returns the interned temporary $tmpN of an identifier tmpN, or NULL if there is no such temporary
+static char *dollar_temporary(const char *ident)
+{
+	char temporary[32];
+	if (snprintf(temporary, sizeof(temporary), "$%s", ident) >= (int)sizeof(temporary))
+		return NULL;
+	return mcc_intern_lookup(temporary);
+}
+
+static bool add_slots_of_row(struct mcc_asm_slot_map *slots, struct mcc_annotated_ir *an_ir)
+{
+	char *ident = NULL;
+	switch (an_ir->row->instr) {
+	case MCC_IR_INSTR_ASSIGN:
+		// Only the first assignment to a variable allocates its slot
+		ident = an_ir->row->arg1.ident;
+		if (!mcc_hash_map_set_if_absent(slots->identifiers, ident, an_ir) ||
+		    !mcc_hash_map_set_if_absent(slots->declarations, ident, an_ir))
+			return false;
+		// Temporaries are renamed from $tmpN to tmpN when the data section is generated, but references to
+		// them still use $tmpN. Register both spellings under $tmpN.
+		if (strncmp(ident, "tmp", 3) == 0)
+			ident = dollar_temporary(ident);
+		if (ident && strncmp(ident, "$tmp", 4) == 0)
+			return mcc_hash_map_set_if_absent(slots->temporaries, ident, an_ir);
+		return true;
+	case MCC_IR_INSTR_ARRAY:
+		return mcc_hash_map_set_if_absent(slots->arrays, an_ir->row->arg1.ident, an_ir) &&
+		       mcc_hash_map_set_if_absent(slots->declarations, an_ir->row->arg1.ident, an_ir);
+	default:
+		return true;
+	}
+}
+
+struct mcc_asm_slot_map *mcc_asm_new_slot_map(struct mcc_annotated_ir *function, struct mcc_asm_data *data)
+{
+	assert(function);
+	assert(function->row->instr == MCC_IR_INSTR_FUNC_LABEL);
+
+	struct mcc_asm_slot_map *new = mcc_alloc(sizeof(*new));
+	if (!new) {
+		data->has_failed = true;
+		return NULL;
+	}
+	new->function = function;
+	new->identifiers = mcc_hash_map_new_pointer();
+	new->temporaries = mcc_hash_map_new_pointer();
+	new->arrays = mcc_hash_map_new_pointer();
+	new->declarations = mcc_hash_map_new_pointer();
+	if (!new->identifiers || !new->temporaries || !new->arrays || !new->declarations) {
+		mcc_asm_delete_slot_map(new);
+		data->has_failed = true;
+		return NULL;
+	}
+
+	for (struct mcc_annotated_ir *an_ir = function + 1;
+	     an_ir->row && an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL; an_ir++) {
+		if (!add_slots_of_row(new, an_ir)) {
+			mcc_asm_delete_slot_map(new);
+			data->has_failed = true;
+			return NULL;
+		}
+	}
+	return new;
+}
+
+static size_t hash_float_key(const void *key)
+{
+	const struct mcc_asm_float_key *float_key = key;
+	return mcc_hash_map_hash_string(float_key->name) ^
+	       mcc_hash_map_hash_bytes(&float_key->value, sizeof(float_key->value));
+}
+
+static bool equal_float_key(const void *key_a, const void *key_b)
+{
+	const struct mcc_asm_float_key *a = key_a;
+	const struct mcc_asm_float_key *b = key_b;
+	return memcmp(&a->value, &b->value, sizeof(a->value)) == 0 && strcmp(a->name, b->name) == 0;
+}
+
+struct mcc_asm_data_index *mcc_asm_new_data_index(struct mcc_asm_data *data)
+{
+	struct mcc_asm_data_index *new = mcc_alloc(sizeof(*new));
+	if (!new) {
+		data->has_failed = true;
+		return NULL;
+	}
+	new->variables = mcc_hash_map_new_string();
+	new->floats = mcc_hash_map_new_string();
+	new->strings = mcc_hash_map_new_pointer();
+	new->float_values = mcc_hash_map_new(hash_float_key, equal_float_key);
+	new->float_keys = NULL;
+	if (!new->variables || !new->floats || !new->strings || !new->float_values) {
+		mcc_asm_delete_data_index(new);
+		data->has_failed = true;
+		return NULL;
+	}
+	return new;
+}
+
 //------------------------------------------------------------------------------------ Functions: Registers
 
 static struct mcc_asm_operand *eax(struct mcc_asm_data *data)
@@ -375,7 +468,7 @@ void mcc_asm_delete_asm(struct mcc_asm *head)
 		return;
 	mcc_asm_delete_text_section(head->text_section);
 	mcc_asm_delete_data_section(head->data_section);
-	free(head);
+	mcc_free(head);
 }
 
 void mcc_asm_delete_text_section(struct mcc_asm_text_section *text_section)
@@ -383,7 +476,7 @@ void mcc_asm_delete_text_section(struct mcc_asm_text_section *text_section)
 	if (!text_section)
 		return;
 	mcc_asm_delete_all_functions(text_section->function);
-	free(text_section);
+	mcc_free(text_section);
 }
 
 void mcc_asm_delete_data_section(struct mcc_asm_data_section *data_section)
@@ -391,15 +484,16 @@ void mcc_asm_delete_data_section(struct mcc_asm_data_section *data_section)
 	if (!data_section)
 		return;
 	mcc_asm_delete_all_declarations(data_section->head);
-	free(data_section);
+	mcc_free(data_section);
 }
 
 void mcc_asm_delete_all_declarations(struct mcc_asm_declaration *decl)
 {
-	if (!decl)
-		return;
-	mcc_asm_delete_all_declarations(decl->next);
-	mcc_asm_delete_declaration(decl);
+	while (decl) {
+		struct mcc_asm_declaration *next = decl->next;
+		mcc_asm_delete_declaration(decl);
+		decl = next;
+	}
 }
 
 void mcc_asm_delete_declaration(struct mcc_asm_declaration *decl)
@@ -407,17 +501,18 @@ void mcc_asm_delete_declaration(struct mcc_asm_declaration *decl)
 	if (!decl)
 		return;
 	if (decl->type == MCC_ASM_DECLARATION_TYPE_STRING || decl->type == MCC_ASM_DECLARATION_TYPE_FLOAT) {
-		free(decl->identifier);
+		mcc_free(decl->identifier);
 	}
-	free(decl);
+	mcc_free(decl);
 }
 
 void mcc_asm_delete_all_functions(struct mcc_asm_function *function)
 {
-	if (!function)
-		return;
-	mcc_asm_delete_all_functions(function->next);
-	mcc_asm_delete_function(function);
+	while (function) {
+		struct mcc_asm_function *next = function->next;
+		mcc_asm_delete_function(function);
+		function = next;
+	}
 }
 
 void mcc_asm_delete_function(struct mcc_asm_function *function)
@@ -425,16 +520,17 @@ void mcc_asm_delete_function(struct mcc_asm_function *function)
 	if (!function)
 		return;
 	mcc_asm_delete_all_lines(function->head);
-	free(function->label);
-	free(function);
+	mcc_free(function->label);
+	mcc_free(function);
 }
 
 void mcc_asm_delete_all_lines(struct mcc_asm_line *line)
 {
-	if (!line)
-		return;
-	mcc_asm_delete_all_lines(line->next);
-	mcc_asm_delete_line(line);
+	while (line) {
+		struct mcc_asm_line *next = line->next;
+		mcc_asm_delete_line(line);
+		line = next;
+	}
 }
 
 void mcc_asm_delete_line(struct mcc_asm_line *line)
@@ -445,7 +541,7 @@ void mcc_asm_delete_line(struct mcc_asm_line *line)
 		mcc_asm_delete_operand(line->first);
 		mcc_asm_delete_operand(line->second);
 	}
-	free(line);
+	mcc_free(line);
 }
 
 void mcc_asm_delete_operand(struct mcc_asm_operand *operand)
@@ -453,48 +549,61 @@ void mcc_asm_delete_operand(struct mcc_asm_operand *operand)
 	if (!operand)
 		return;
 	if (operand->type == MCC_ASM_OPERAND_FUNCTION) {
-		free(operand->func_name);
+		mcc_free(operand->func_name);
 	}
-	free(operand);
+	mcc_free(operand);
+}
+
+void mcc_asm_delete_slot_map(struct mcc_asm_slot_map *slots)
+{
+	if (!slots)
+		return;
+	mcc_hash_map_delete(slots->identifiers);
+	mcc_hash_map_delete(slots->temporaries);
+	mcc_hash_map_delete(slots->arrays);
+	mcc_hash_map_delete(slots->declarations);
+	mcc_free(slots);
+}
+
+void mcc_asm_delete_data_index(struct mcc_asm_data_index *index)
+{
+	if (!index)
+		return;
+	mcc_hash_map_delete(index->variables);
+	mcc_hash_map_delete(index->floats);
+	mcc_hash_map_delete(index->strings);
+	mcc_hash_map_delete(index->float_values);
+	struct mcc_asm_float_key *key = index->float_keys;
+	while (key) {
+		struct mcc_asm_float_key *next = key->next;
+		mcc_free(key);
+		key = next;
+	}
+	mcc_free(index);
 }
 
 //---------------------------------------------------------------------------------------- Functions: ASM generation
 
-static struct mcc_annotated_ir *
-get_array_element_declaration(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg, struct mcc_asm_data *data)
+static struct mcc_annotated_ir *get_array_element_declaration(struct mcc_ir_arg *arg, struct mcc_asm_data *data)
 {
-	assert(an_ir);
+	assert(arg);
 	if (data->has_failed)
 		return NULL;
-	an_ir = mcc_get_function_label(an_ir);
-	an_ir = an_ir->next;
-	while (an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
-		if (an_ir->row->instr == MCC_IR_INSTR_ARRAY) {
-			if (strcmp(an_ir->row->arg1->ident, arg->ident) == 0) {
-				return an_ir;
-			}
-		}
-		if (an_ir->row->instr == MCC_IR_INSTR_ASSIGN) {
-			if (strcmp(an_ir->row->arg1->ident, arg->ident) == 0) {
-				return an_ir;
-			}
-		}
-		an_ir = an_ir->next;
-		continue;
+	struct mcc_annotated_ir *an_ir = mcc_hash_map_get(data->slots->declarations, arg->ident);
+	if (!an_ir) {
+		data->has_failed = true;
 	}
-	data->has_failed = true;
-	return NULL;
+	return an_ir;
 }
 
-static bool array_is_reference(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg, struct mcc_asm_data *data)
+static bool array_is_reference(struct mcc_ir_arg *arg, struct mcc_asm_data *data)
 {
-	assert(an_ir);
 	assert(arg);
 
-	an_ir = get_array_element_declaration(an_ir, arg, data);
+	struct mcc_annotated_ir *an_ir = get_array_element_declaration(arg, data);
 	if (data->has_failed)
 		return false;
-	return (an_ir->prev->row->instr == MCC_IR_INSTR_POP);
+	return ((an_ir - 1)->row->instr == MCC_IR_INSTR_POP);
 }
 
 static struct mcc_asm_operand *
@@ -509,22 +618,22 @@ get_array_element_operand(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg
 
 	int index_offset;
 	int offset;
-	bool is_reference = array_is_reference(an_ir, arg, data);
+	bool is_reference = array_is_reference(arg, data);
 
 	if (is_reference)
-		offset = get_identifier_offset(an_ir, arg->arr_ident);
+		offset = get_identifier_offset(arg->arr_ident, data);
 
-	switch (arg->index->type) {
+	switch (arg->index.type) {
 	case MCC_IR_TYPE_LIT_INT:
-		index_offset = arg->index->lit_int;
+		index_offset = arg->index.lit_int;
 		mcc_asm_new_line(MCC_ASM_MOVL, mcc_asm_new_literal_operand(index_offset, data), ebx(data), data);
 		break;
 	case MCC_IR_TYPE_IDENTIFIER:
-		index_offset = get_identifier_offset(an_ir, arg->index->ident);
+		index_offset = get_identifier_offset(arg->index.ident, data);
 		mcc_asm_new_line(MCC_ASM_MOVL, ebp(index_offset, data), ebx(data), data);
 		break;
 	case MCC_IR_TYPE_ROW:
-		index_offset = get_row_offset(an_ir, arg->index->row);
+		index_offset = get_row_offset(arg->index.row, data);
 		mcc_asm_new_line(MCC_ASM_MOVL, ebp(index_offset, data), ebx(data), data);
 		break;
 	default:
@@ -536,60 +645,19 @@ get_array_element_operand(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg
 		mcc_asm_new_line(MCC_ASM_MOVL, ebp(offset, data), ecx(data), data);
 		return mcc_asm_new_computed_offset_operand(0, MCC_ASM_ECX, MCC_ASM_EBX, DWORD_SIZE, data);
 	} else {
-		return mcc_asm_new_computed_offset_operand(mcc_get_array_base_stack_loc(an_ir, arg), MCC_ASM_EBP,
+		return mcc_asm_new_computed_offset_operand(get_array_base_offset(arg, data), MCC_ASM_EBP,
 		                                           MCC_ASM_EBX, DWORD_SIZE, data);
 	}
 }
 
-// function to check if 'prefix' is a proper prefix of 'string'. It is proper if 'prefix' followed by _x is equal to
-// 'string', where x is an arbitrary number
-static bool is_proper_prefix(char *prefix, char *string)
-{
-	assert(prefix);
-	assert(string);
-
-	if (strlen(prefix) >= strlen(string)) {
-		return false;
-	}
-
-	unsigned len_p = strlen(prefix);
-	if (strncmp(prefix, string, len_p) != 0) {
-		return false;
-	}
-	if ('_' != string[len_p]) {
-		return false;
-	}
-	for (unsigned i = len_p + 1; i < strlen(string); i++) {
-		// check if all characters after the character '_' are digits
-		if (string[i] < '0' || string[i] > '9') {
-			return false;
-		}
-	}
-	return true;
-}
-
 static bool is_in_data_section(char *ident, struct mcc_asm_data *data)
 {
-	struct mcc_asm_declaration *decl = data->data_section->head;
-	bool looking_for_tmp = false;
-	// if ident is '$tmpXX' look for declaration starting from position 1
+	// if ident is '$tmpXX' look for a float declaration named 'tmpXX'
 	if (strncmp(ident, "$tmp", 4) == 0) {
-		ident = &ident[1];
-		looking_for_tmp = true;
+		return mcc_hash_map_get(data->data_index->floats, &ident[1]) != NULL;
 	}
-	while (decl) {
-		if (looking_for_tmp) {
-			if (strcmp(decl->identifier, ident) == 0 && decl->type == MCC_ASM_DECLARATION_TYPE_FLOAT) {
-				return true;
-			}
-		} else { // if not looking for tmp: check if ident is proper prefix of decl->identifier
-			if (is_proper_prefix(ident, decl->identifier)) {
-				return true;
-			}
-		}
-		decl = decl->next;
-	}
-	return false;
+	// otherwise look for any declaration 'ident_x', where x is the counter added by rename_identifier
+	return mcc_hash_map_get(data->data_index->variables, ident) != NULL;
 }
 
 static bool is_float(struct mcc_ir_arg *arg, struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
@@ -607,12 +675,14 @@ static bool is_float(struct mcc_ir_arg *arg, struct mcc_annotated_ir *an_ir, str
 	case MCC_IR_TYPE_LIT_STRING:
 		return false;
 	case MCC_IR_TYPE_ROW:
-		return (arg->row->type->type == MCC_IR_ROW_FLOAT);
+		return (data->slots->function[arg->row].row->type.type == MCC_IR_ROW_FLOAT);
 	case MCC_IR_TYPE_IDENTIFIER:
 		return is_in_data_section(arg->ident, data);
 	case MCC_IR_TYPE_ARR_ELEM:
-		an_ir = get_array_element_declaration(an_ir, arg, data);
-		return (an_ir->row->type->type == MCC_IR_ROW_FLOAT);
+		an_ir = get_array_element_declaration(arg, data);
+		if (!an_ir)
+			return false;
+		return (an_ir->row->type.type == MCC_IR_ROW_FLOAT);
 	default:
 		return false;
 	}
@@ -621,11 +691,11 @@ static bool is_float(struct mcc_ir_arg *arg, struct mcc_annotated_ir *an_ir, str
 static int count_pushes(struct mcc_annotated_ir *an_ir)
 {
 	assert(an_ir->row->instr == MCC_IR_INSTR_CALL);
-	an_ir = an_ir->prev;
+	an_ir--;
 	int num_pushes = 0;
 	while (an_ir->row->instr == MCC_IR_INSTR_PUSH) {
 		num_pushes += 1;
-		an_ir = an_ir->prev;
+		an_ir--;
 	}
 	return num_pushes;
 }
@@ -648,7 +718,7 @@ arg_to_op(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg, struct mcc_asm
 		break;
 	case MCC_IR_TYPE_ROW:
 	case MCC_IR_TYPE_IDENTIFIER:
-		operand = mcc_asm_new_register_operand(MCC_ASM_EBP, get_offset_of(an_ir, arg), data);
+		operand = mcc_asm_new_register_operand(MCC_ASM_EBP, get_offset_of(an_ir, arg, data), data);
 		break;
 	case MCC_IR_TYPE_ARR_ELEM:
 		operand = get_array_element_operand(an_ir, arg, data);
@@ -664,90 +734,85 @@ static struct mcc_asm_operand *find_string_identifier(struct mcc_annotated_ir *a
 {
 	assert(an_ir);
 	assert(an_ir->row->instr == MCC_IR_INSTR_ASSIGN);
-	assert(an_ir->row->arg2->type == MCC_IR_TYPE_LIT_STRING);
+	assert(an_ir->row->arg2.type == MCC_IR_TYPE_LIT_STRING);
 	assert(data);
 	if (data->has_failed)
 		return NULL;
 
-	struct mcc_asm_operand *op = malloc(sizeof(*op));
+	struct mcc_asm_operand *op = mcc_alloc(sizeof(*op));
 	if (!op) {
 		data->has_failed = true;
 		return NULL;
 	}
 
-	char *wanted_string = an_ir->row->arg2->lit_string;
-	struct mcc_asm_declaration *head = data->data_section->head;
-	while (head) {
-		if (head->type != MCC_ASM_DECLARATION_TYPE_STRING) {
-			head = head->next;
-			continue;
-		}
-		if (strcmp(wanted_string, head->string_value) != 0) {
-			head = head->next;
-			continue;
-		}
-		op->decl = head;
-		op->type = MCC_ASM_OPERAND_DATA;
-		op->offset = 0;
-		return op;
+	struct mcc_asm_declaration *decl = mcc_hash_map_get(data->data_index->strings, an_ir->row->arg2.lit_string);
+	if (!decl) {
+		mcc_free(op);
+		return NULL;
 	}
-
-	free(op);
-	return NULL;
+	op->decl = decl;
+	op->type = MCC_ASM_OPERAND_DATA;
+	op->offset = 0;
+	return op;
 }
 
 static struct mcc_asm_operand *find_float_identifier(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
 {
 	assert(an_ir);
 	assert(an_ir->row->instr == MCC_IR_INSTR_ASSIGN);
-	assert(an_ir->row->arg2->type == MCC_IR_TYPE_LIT_FLOAT);
+	assert(an_ir->row->arg2.type == MCC_IR_TYPE_LIT_FLOAT);
 	assert(data);
 	if (data->has_failed)
 		return NULL;
 
-	struct mcc_asm_operand *op = malloc(sizeof(*op));
+	struct mcc_asm_operand *op = mcc_alloc(sizeof(*op));
 	if (!op) {
 		data->has_failed = true;
 		return NULL;
 	}
 
-	double wanted_float = an_ir->row->arg2->lit_float;
-	double epsilon = EPSILON;
-	struct mcc_asm_declaration *head = data->data_section->head;
-	while (head) {
-		if (head->type == MCC_ASM_DECLARATION_TYPE_FLOAT &&
-		    (fabs(wanted_float - head->float_value) < epsilon) &&
-		    (is_proper_prefix(an_ir->row->arg1->ident, head->identifier) ||
-		     strcmp(an_ir->row->arg1->ident, head->identifier) == 0)) {
-			op->decl = head;
-			op->type = MCC_ASM_OPERAND_DATA;
-			op->offset = 0;
-			return op;
-		}
-		head = head->next;
+	// Declaration of this variable (or temporary) with exactly this value
+	struct mcc_asm_float_key wanted = {
+	    .name = an_ir->row->arg1.ident,
+	    .value = an_ir->row->arg2.lit_float,
+	};
+	struct mcc_asm_declaration *decl = mcc_hash_map_get(data->data_index->float_values, &wanted);
+	if (!decl) {
+		mcc_free(op);
+		return NULL;
 	}
-	free(op);
-	return NULL;
+	op->decl = decl;
+	op->type = MCC_ASM_OPERAND_DATA;
+	op->offset = 0;
+	return op;
 }
 
 static void generate_string_assignment(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
 {
 	struct mcc_asm_operand *string_id = find_string_identifier(an_ir, data);
 	mcc_asm_new_line(MCC_ASM_LEAL, string_id, eax(data), data);
-	mcc_asm_new_line(MCC_ASM_MOVL, eax(data), ebp(an_ir->stack_position, data), data);
+	struct mcc_ir_arg *dest = &an_ir->row->arg1;
+	if (dest->type == MCC_IR_TYPE_ARR_ELEM &&
+	    (dest->index.type != MCC_IR_TYPE_LIT_INT || array_is_reference(dest, data))) {
+		// The slot of the element is not known statically: the index is computed at runtime or the array is
+		// a parameter, whose elements are stored through the reference
+		mcc_asm_new_line(MCC_ASM_MOVL, eax(data), arg_to_op(an_ir, dest, data), data);
+	} else {
+		mcc_asm_new_line(MCC_ASM_MOVL, eax(data), ebp(an_ir->stack_position, data), data);
+	}
 }
 
 static void generate_assign_row_ident(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
 {
 	assert(an_ir);
-	mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, an_ir->row->arg2, data), eax(data), data);
-	mcc_asm_new_line(MCC_ASM_MOVL, eax(data), arg_to_op(an_ir, an_ir->row->arg1, data), data);
+	mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, &an_ir->row->arg2, data), eax(data), data);
+	mcc_asm_new_line(MCC_ASM_MOVL, eax(data), arg_to_op(an_ir, &an_ir->row->arg1, data), data);
 }
 
 static void generate_float_assign(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
 {
 	mcc_asm_new_line(MCC_ASM_FLDS, find_float_identifier(an_ir, data), NULL, data);
-	mcc_asm_new_line(MCC_ASM_FSTPS, arg_to_op(an_ir, an_ir->row->arg1, data), NULL, data);
+	mcc_asm_new_line(MCC_ASM_FSTPS, arg_to_op(an_ir, &an_ir->row->arg1, data), NULL, data);
 }
 
 static void generate_instr_assign(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
@@ -758,11 +823,11 @@ static void generate_instr_assign(struct mcc_annotated_ir *an_ir, struct mcc_asm
 	if (data->has_failed)
 		return;
 
-	switch (an_ir->row->arg2->type) {
+	switch (an_ir->row->arg2.type) {
 	case MCC_IR_TYPE_LIT_INT:
 	case MCC_IR_TYPE_LIT_BOOL:
-		mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, an_ir->row->arg2, data),
-		                 arg_to_op(an_ir, an_ir->row->arg1, data), data);
+		mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, &an_ir->row->arg2, data),
+		                 arg_to_op(an_ir, &an_ir->row->arg1, data), data);
 		break;
 	case MCC_IR_TYPE_LIT_FLOAT:
 		generate_float_assign(an_ir, data);
@@ -788,15 +853,15 @@ generate_arithm_int_op(struct mcc_annotated_ir *an_ir, enum mcc_asm_opcode opcod
 		return;
 	}
 
-	mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, an_ir->row->arg1, data), eax(data), data);
+	mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, &an_ir->row->arg1, data), eax(data), data);
 
 	if (opcode == MCC_ASM_IDIVL) {
-		mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, an_ir->row->arg2, data), ebx(data), data);
+		mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, &an_ir->row->arg2, data), ebx(data), data);
 		// line to clear EDX
 		mcc_asm_new_line(MCC_ASM_XORL, edx(data), edx(data), data);
 		mcc_asm_new_line(opcode, ebx(data), NULL, data);
 	} else {
-		mcc_asm_new_line(opcode, arg_to_op(an_ir, an_ir->row->arg2, data), eax(data), data);
+		mcc_asm_new_line(opcode, arg_to_op(an_ir, &an_ir->row->arg2, data), eax(data), data);
 	}
 	mcc_asm_new_line(MCC_ASM_MOVL, eax(data), ebp(an_ir->stack_position, data), data);
 }
@@ -807,7 +872,7 @@ static void generate_unary(struct mcc_annotated_ir *an_ir, enum mcc_asm_opcode o
 	if (data->has_failed)
 		return;
 
-	mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, an_ir->row->arg1, data), eax(data), data);
+	mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, &an_ir->row->arg1, data), eax(data), data);
 	if (opcode == MCC_ASM_XORL) {
 		struct mcc_asm_operand *lit_1 = mcc_asm_new_literal_operand((int)1, data);
 		mcc_asm_new_line(MCC_ASM_XORL, lit_1, eax(data), data);
@@ -823,24 +888,24 @@ static void generate_cmp_op_int(struct mcc_annotated_ir *an_ir, struct mcc_asm_d
 	if (data->has_failed)
 		return;
 
-	if ((an_ir->row->arg1->type == MCC_IR_TYPE_ROW || an_ir->row->arg1->type == MCC_IR_TYPE_IDENTIFIER ||
-	     an_ir->row->arg1->type == MCC_IR_TYPE_ARR_ELEM) &&
-	    (an_ir->row->arg2->type == MCC_IR_TYPE_ROW || an_ir->row->arg2->type == MCC_IR_TYPE_IDENTIFIER ||
-	     an_ir->row->arg2->type == MCC_IR_TYPE_ARR_ELEM)) {
+	if ((an_ir->row->arg1.type == MCC_IR_TYPE_ROW || an_ir->row->arg1.type == MCC_IR_TYPE_IDENTIFIER ||
+	     an_ir->row->arg1.type == MCC_IR_TYPE_ARR_ELEM) &&
+	    (an_ir->row->arg2.type == MCC_IR_TYPE_ROW || an_ir->row->arg2.type == MCC_IR_TYPE_IDENTIFIER ||
+	     an_ir->row->arg2.type == MCC_IR_TYPE_ARR_ELEM)) {
 		// 1a. move arg1 in eax
-		mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, an_ir->row->arg1, data), eax(data), data);
+		mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, &an_ir->row->arg1, data), eax(data), data);
 		// 1b. cmp eax and arg2
-		mcc_asm_new_line(MCC_ASM_CMPL, arg_to_op(an_ir, an_ir->row->arg2, data), eax(data), data);
+		mcc_asm_new_line(MCC_ASM_CMPL, arg_to_op(an_ir, &an_ir->row->arg2, data), eax(data), data);
 
-	} else if (an_ir->row->arg1->type == MCC_IR_TYPE_ROW || an_ir->row->arg1->type == MCC_IR_TYPE_IDENTIFIER) {
+	} else if (an_ir->row->arg1.type == MCC_IR_TYPE_ROW || an_ir->row->arg1.type == MCC_IR_TYPE_IDENTIFIER) {
 		// 1. cmp arg1 arg2
-		mcc_asm_new_line(MCC_ASM_CMPL, arg_to_op(an_ir, an_ir->row->arg2, data),
-		                 arg_to_op(an_ir, an_ir->row->arg1, data), data);
+		mcc_asm_new_line(MCC_ASM_CMPL, arg_to_op(an_ir, &an_ir->row->arg2, data),
+		                 arg_to_op(an_ir, &an_ir->row->arg1, data), data);
 	} else {
 		// 1.a mov lit eax
-		mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, an_ir->row->arg1, data), eax(data), data);
+		mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, &an_ir->row->arg1, data), eax(data), data);
 		// 1b. cmp arg1 arg2
-		mcc_asm_new_line(MCC_ASM_CMPL, arg_to_op(an_ir, an_ir->row->arg2, data), eax(data), data);
+		mcc_asm_new_line(MCC_ASM_CMPL, arg_to_op(an_ir, &an_ir->row->arg2, data), eax(data), data);
 	}
 }
 
@@ -852,16 +917,16 @@ static void generate_return(struct mcc_annotated_ir *an_ir, struct mcc_asm_data
 	if (data->has_failed)
 		return;
 
-	if (an_ir->row->arg1) {
-		if (an_ir->row->type->type == MCC_IR_ROW_FLOAT) {
-			mcc_asm_new_line(MCC_ASM_FLDS, arg_to_op(an_ir, an_ir->row->arg1, data), NULL, data);
+	if (an_ir->row->arg1.type != MCC_IR_TYPE_NONE) {
+		if (an_ir->row->type.type == MCC_IR_ROW_FLOAT) {
+			mcc_asm_new_line(MCC_ASM_FLDS, arg_to_op(an_ir, &an_ir->row->arg1, data), NULL, data);
 		} else {
-			mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, an_ir->row->arg1, data), eax(data), data);
+			mcc_asm_new_line(MCC_ASM_MOVL, arg_to_op(an_ir, &an_ir->row->arg1, data), eax(data), data);
 		}
 	}
 	// pop ebx
-	an_ir = mcc_get_function_label(an_ir);
-	if (strcmp(an_ir->row->arg1->func_label, "main") != 0) {
+	an_ir = data->slots->function;
+	if (strcmp(an_ir->row->arg1.func_label, "main") != 0) {
 		mcc_asm_new_line(MCC_ASM_POPL, ebx(data), NULL, data);
 	}
 	mcc_asm_new_line(MCC_ASM_LEAVE, NULL, NULL, data);
@@ -871,14 +936,14 @@ static void generate_return(struct mcc_annotated_ir *an_ir, struct mcc_asm_data
 static void generate_push(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
 {
 	assert(an_ir);
-	assert(an_ir->row->arg1);
-	if (arg_is_local_array(an_ir, an_ir->row->arg1)) {
-		mcc_asm_new_line(MCC_ASM_LEAL, arg_to_op(an_ir, an_ir->row->arg1, data), eax(data), data);
+	assert(an_ir->row->arg1.type != MCC_IR_TYPE_NONE);
+	if (arg_is_local_array(&an_ir->row->arg1, data)) {
+		mcc_asm_new_line(MCC_ASM_LEAL, arg_to_op(an_ir, &an_ir->row->arg1, data), eax(data), data);
 		mcc_asm_new_line(MCC_ASM_PUSHL, eax(data), NULL, data);
 		return;
 	}
 	assert(an_ir->row->instr == MCC_IR_INSTR_PUSH);
-	mcc_asm_new_line(MCC_ASM_PUSHL, arg_to_op(an_ir, an_ir->row->arg1, data), NULL, data);
+	mcc_asm_new_line(MCC_ASM_PUSHL, arg_to_op(an_ir, &an_ir->row->arg1, data), NULL, data);
 }
 
 static void generate_jumpfalse(enum mcc_asm_opcode opcode, struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
@@ -890,12 +955,12 @@ static void generate_jumpfalse(enum mcc_asm_opcode opcode, struct mcc_annotated_
 	if (opcode == MCC_ASM_JNE) {
 		struct mcc_asm_operand *one = mcc_asm_new_literal_operand(1, data);
 		mcc_asm_new_line(MCC_ASM_MOVL, one, eax(data), data);
-		mcc_asm_new_line(MCC_ASM_CMPL, arg_to_op(an_ir, an_ir->row->arg1, data), eax(data), data);
+		mcc_asm_new_line(MCC_ASM_CMPL, arg_to_op(an_ir, &an_ir->row->arg1, data), eax(data), data);
 	} else { // case of MCC_ASM_JE
 		mcc_asm_new_line(MCC_ASM_CMPL, eax(data), eax(data), data);
 	}
 
-	unsigned label = opcode == MCC_ASM_JNE ? an_ir->row->arg2->label : an_ir->row->arg1->label;
+	unsigned label = opcode == MCC_ASM_JNE ? an_ir->row->arg2.label : an_ir->row->arg1.label;
 	mcc_asm_new_label(opcode, label, data);
 }
 
@@ -903,26 +968,26 @@ static void
 generate_arithm_float_op(struct mcc_annotated_ir *an_ir, enum mcc_asm_opcode opcode, struct mcc_asm_data *data)
 {
 	assert(an_ir);
-	mcc_asm_new_line(MCC_ASM_FLDS, arg_to_op(an_ir, an_ir->row->arg2, data), NULL, data);
-	mcc_asm_new_line(MCC_ASM_FLDS, arg_to_op(an_ir, an_ir->row->arg1, data), NULL, data);
+	mcc_asm_new_line(MCC_ASM_FLDS, arg_to_op(an_ir, &an_ir->row->arg2, data), NULL, data);
+	mcc_asm_new_line(MCC_ASM_FLDS, arg_to_op(an_ir, &an_ir->row->arg1, data), NULL, data);
 	mcc_asm_new_line(opcode, st(0, data), st(1, data), data);
 	mcc_asm_new_line(MCC_ASM_FSTPS, ebp(an_ir->stack_position, data), NULL, data);
 }
 
 static void generate_plus(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
 {
-	if (an_ir->row->type->type == MCC_IR_ROW_INT) {
+	if (an_ir->row->type.type == MCC_IR_ROW_INT) {
 		generate_arithm_int_op(an_ir, MCC_ASM_ADDL, data);
-	} else if (an_ir->row->type->type == MCC_IR_ROW_FLOAT) {
+	} else if (an_ir->row->type.type == MCC_IR_ROW_FLOAT) {
 		generate_arithm_float_op(an_ir, MCC_ASM_FADDP, data);
 	}
 }
 
 static void generate_minus(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
 {
-	if (an_ir->row->type->type == MCC_IR_ROW_INT) {
+	if (an_ir->row->type.type == MCC_IR_ROW_INT) {
 		generate_arithm_int_op(an_ir, MCC_ASM_SUBL, data);
-	} else if (an_ir->row->type->type == MCC_IR_ROW_FLOAT) {
+	} else if (an_ir->row->type.type == MCC_IR_ROW_FLOAT) {
 		generate_arithm_float_op(an_ir, MCC_ASM_FSUBP, data);
 	}
 }
@@ -934,8 +999,8 @@ static void generate_cmp_op_float(struct mcc_annotated_ir *an_ir, struct mcc_asm
 		return;
 	}
 
-	mcc_asm_new_line(MCC_ASM_FLDS, arg_to_op(an_ir, an_ir->row->arg2, data), NULL, data);
-	mcc_asm_new_line(MCC_ASM_FLDS, arg_to_op(an_ir, an_ir->row->arg1, data), NULL, data);
+	mcc_asm_new_line(MCC_ASM_FLDS, arg_to_op(an_ir, &an_ir->row->arg2, data), NULL, data);
+	mcc_asm_new_line(MCC_ASM_FLDS, arg_to_op(an_ir, &an_ir->row->arg1, data), NULL, data);
 	mcc_asm_new_line(MCC_ASM_FCOMIP, st(1, data), st(0, data), data);
 	mcc_asm_new_line(MCC_ASM_FSTP, st(0, data), NULL, data);
 }
@@ -947,7 +1012,7 @@ static void generate_cmp(struct mcc_annotated_ir *an_ir, enum mcc_asm_opcode opc
 		return;
 
 	// line 1 to line 1c or line 1d (depended on case)
-	if (is_float(an_ir->row->arg1, an_ir, data)) {
+	if (is_float(&an_ir->row->arg1, an_ir, data)) {
 		generate_cmp_op_float(an_ir, data);
 		// use unsigned opcode in case of float:
 		if (opcode == MCC_ASM_SETG)
@@ -973,9 +1038,9 @@ static void generate_cmp(struct mcc_annotated_ir *an_ir, enum mcc_asm_opcode opc
 static void generate_mult(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
 {
 	assert(an_ir);
-	if (an_ir->row->type->type == MCC_IR_ROW_INT) {
+	if (an_ir->row->type.type == MCC_IR_ROW_INT) {
 		generate_arithm_int_op(an_ir, MCC_ASM_IMULL, data);
-	} else if (an_ir->row->type->type == MCC_IR_ROW_FLOAT) {
+	} else if (an_ir->row->type.type == MCC_IR_ROW_FLOAT) {
 		generate_arithm_float_op(an_ir, MCC_ASM_FMULP, data);
 	}
 }
@@ -983,9 +1048,9 @@ static void generate_mult(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *d
 static void generate_div(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
 {
 	assert(an_ir);
-	if (an_ir->row->type->type == MCC_IR_ROW_INT) {
+	if (an_ir->row->type.type == MCC_IR_ROW_INT) {
 		generate_arithm_int_op(an_ir, MCC_ASM_IDIVL, data);
-	} else if (an_ir->row->type->type == MCC_IR_ROW_FLOAT) {
+	} else if (an_ir->row->type.type == MCC_IR_ROW_FLOAT) {
 		generate_arithm_float_op(an_ir, MCC_ASM_FDIVP, data);
 	}
 }
@@ -993,7 +1058,7 @@ static void generate_div(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *da
 static void generate_call(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
 {
 	assert(an_ir);
-	struct mcc_asm_operand *func = mcc_asm_new_function_operand(an_ir->row->arg1->func_label, data);
+	struct mcc_asm_operand *func = mcc_asm_new_function_operand(an_ir->row->arg1.func_label, data);
 	mcc_asm_new_line(MCC_ASM_CALLL, func, NULL, data);
 	// count pushes before call and add to esp afterwards
 	int literal = count_pushes(an_ir);
@@ -1001,8 +1066,8 @@ static void generate_call(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *d
 		mcc_asm_new_line(MCC_ASM_ADDL, mcc_asm_new_literal_operand(literal * 4, data), esp(data), data);
 	}
 	// if function is void do no move instruction
-	if (an_ir->row->type->type != MCC_IR_ROW_TYPELESS) {
-		if (an_ir->row->type->type == MCC_IR_ROW_FLOAT) {
+	if (an_ir->row->type.type != MCC_IR_ROW_TYPELESS) {
+		if (an_ir->row->type.type == MCC_IR_ROW_FLOAT) {
 			mcc_asm_new_line(MCC_ASM_FSTPS, ebp(an_ir->stack_position, data), NULL, data);
 		} else {
 			mcc_asm_new_line(MCC_ASM_MOVL, eax(data), ebp(an_ir->stack_position, data), data);
@@ -1015,13 +1080,13 @@ static void generate_pop(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *da
 	assert(an_ir);
 	assert(an_ir->row->instr == MCC_IR_INSTR_POP);
 	mcc_asm_new_line(MCC_ASM_MOVL, ebp(an_ir->stack_position, data), eax(data), data);
-	mcc_asm_new_line(MCC_ASM_MOVL, eax(data), arg_to_op(an_ir->next, an_ir->next->row->arg1, data), data);
+	mcc_asm_new_line(MCC_ASM_MOVL, eax(data), arg_to_op(an_ir + 1, &(an_ir + 1)->row->arg1, data), data);
 }
 
 static void generate_neg_float(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
 {
 	assert(an_ir);
-	mcc_asm_new_line(MCC_ASM_FLDS, arg_to_op(an_ir, an_ir->row->arg1, data), NULL, data);
+	mcc_asm_new_line(MCC_ASM_FLDS, arg_to_op(an_ir, &an_ir->row->arg1, data), NULL, data);
 	mcc_asm_new_line(MCC_ASM_FCHS, NULL, NULL, data);
 	mcc_asm_new_line(MCC_ASM_FSTPS, ebp(an_ir->stack_position, data), NULL, data);
 }
@@ -1029,9 +1094,9 @@ static void generate_neg_float(struct mcc_annotated_ir *an_ir, struct mcc_asm_da
 static void generate_negative(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
 {
 	assert(an_ir);
-	if (an_ir->row->type->type == MCC_IR_ROW_INT) {
+	if (an_ir->row->type.type == MCC_IR_ROW_INT) {
 		generate_unary(an_ir, MCC_ASM_NEGL, data);
-	} else if (an_ir->row->type->type == MCC_IR_ROW_FLOAT) {
+	} else if (an_ir->row->type.type == MCC_IR_ROW_FLOAT) {
 		generate_neg_float(an_ir, data);
 	}
 }
@@ -1048,7 +1113,7 @@ void mcc_asm_generate_asm_from_ir(struct mcc_annotated_ir *an_ir, struct mcc_asm
 		generate_instr_assign(an_ir, data);
 		break;
 	case MCC_IR_INSTR_LABEL:
-		mcc_asm_new_label(MCC_ASM_LABEL, an_ir->row->arg1->label, data);
+		mcc_asm_new_label(MCC_ASM_LABEL, an_ir->row->arg1.label, data);
 		break;
 	case MCC_IR_INSTR_FUNC_LABEL:
 		break;
@@ -1131,10 +1196,10 @@ void mcc_asm_generate_function_body(struct mcc_asm_function *function,
 	if (data->has_failed)
 		return;
 
-	an_ir = an_ir->next;
+	an_ir++;
 
 	// Iterate up to next function
-	while (an_ir && an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
+	while (an_ir->row && an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
 
 		mcc_asm_generate_asm_from_ir(an_ir, data);
 		if (data->has_failed) {
@@ -1142,9 +1207,9 @@ void mcc_asm_generate_function_body(struct mcc_asm_function *function,
 		}
 		// if pop, omit the next assign instruction, since it is already handled with the pop instruction
 		if (an_ir->row->instr == MCC_IR_INSTR_POP) {
-			an_ir = an_ir->next->next;
+			an_ir += 2;
 		} else {
-			an_ir = an_ir->next;
+			an_ir++;
 		}
 	}
 }
@@ -1153,21 +1218,30 @@ struct mcc_asm_function *mcc_asm_generate_function(struct mcc_annotated_ir *an_i
 {
 	assert(an_ir->row->instr == MCC_IR_INSTR_FUNC_LABEL);
 	assert(an_ir);
-	assert(an_ir->row->arg1->type == MCC_IR_TYPE_FUNC_LABEL);
+	assert(an_ir->row->arg1.type == MCC_IR_TYPE_FUNC_LABEL);
 
 	if (data->has_failed)
 		return NULL;
 
-	struct mcc_asm_function *function = mcc_asm_new_function(an_ir->row->arg1->func_label, NULL, NULL, data);
+	struct mcc_asm_function *function = mcc_asm_new_function(an_ir->row->arg1.func_label, NULL, NULL, data);
 	if (!function) {
 		data->has_failed = true;
 		return NULL;
 	}
 
+	// Stack slots of all operands in this function
+	data->slots = mcc_asm_new_slot_map(an_ir, data);
+	if (!data->slots) {
+		mcc_asm_delete_function(function);
+		return NULL;
+	}
+
 	// Prolog
-	struct mcc_asm_line *push_ebp = malloc(sizeof *push_ebp);
+	struct mcc_asm_line *push_ebp = mcc_alloc(sizeof *push_ebp);
 	if (!push_ebp) {
 		data->has_failed = true;
+		mcc_asm_delete_slot_map(data->slots);
+		data->slots = NULL;
 		mcc_asm_delete_function(function);
 		return NULL;
 	}
@@ -1180,12 +1254,14 @@ struct mcc_asm_function *mcc_asm_generate_function(struct mcc_annotated_ir *an_i
 	struct mcc_asm_operand *size_literal = mcc_asm_new_literal_operand(an_ir->stack_size, data);
 	mcc_asm_new_line(MCC_ASM_SUBL, size_literal, esp(data), data);
 	// store ebx except for main
-	if (strcmp(an_ir->row->arg1->func_label, "main") != 0) {
+	if (strcmp(an_ir->row->arg1.func_label, "main") != 0) {
 		mcc_asm_new_line(MCC_ASM_PUSHL, ebx(data), NULL, data);
 	}
 
 	// Function body
 	mcc_asm_generate_function_body(function, an_ir, data);
+	mcc_asm_delete_slot_map(data->slots);
+	data->slots = NULL;
 
 	if (data->has_failed) {
 		mcc_asm_delete_all_lines(push_ebp);
@@ -1200,11 +1276,11 @@ struct mcc_asm_function *mcc_asm_generate_function(struct mcc_annotated_ir *an_i
 static struct mcc_annotated_ir *find_next_function(struct mcc_annotated_ir *an_ir)
 {
 	assert(an_ir);
-	an_ir = an_ir->next;
-	while (an_ir && an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
-		an_ir = an_ir->next;
+	an_ir++;
+	while (an_ir->row && an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
+		an_ir++;
 	}
-	return an_ir;
+	return an_ir->row ? an_ir : NULL;
 }
 
 void mcc_asm_generate_text_section(struct mcc_asm_text_section *text_section,
@@ -1235,21 +1311,22 @@ void mcc_asm_generate_text_section(struct mcc_asm_text_section *text_section,
 	return;
 }
 
-static char *get_tmp_ident(char *id)
+// Renames the temporary $tmpN to tmpN, also in the IR
+static char *get_tmp_ident(struct mcc_ir_arg *arg)
 {
-	memmove(id, id + 1, strlen(id));
-	char *new = malloc(sizeof(char) * strlen(id) + 1);
-	if (!new)
+	char *id = mcc_intern(&arg->ident[1]);
+	if (!id)
 		return NULL;
-	snprintf(new, strlen(id) + 1, "%s", id);
-	return new;
+	arg->ident = id;
+	return strdup(id);
 }
 
-static char *rename_identifier(char *id, int counter)
+static char *rename_identifier(struct mcc_ir_arg *arg, int counter)
 {
-	assert(id);
+	assert(arg);
+	char *id = arg->ident;
 	if (strncmp(id, "$tmp", 4) == 0) {
-		return get_tmp_ident(id);
+		return get_tmp_ident(arg);
 	} else {
 		int extra_length = 2 + length_of_int(counter);
 		int new_length = strlen(id) + extra_length;
@@ -1262,6 +1339,41 @@ static char *rename_identifier(char *id, int counter)
 	}
 }
 
+static bool add_float_value(struct mcc_asm_data_index *index, char *name, struct mcc_asm_declaration *decl)
+{
+	struct mcc_asm_float_key *key = mcc_alloc(sizeof(*key));
+	if (!key)
+		return false;
+	key->name = name;
+	key->value = decl->float_value;
+	key->next = index->float_keys;
+	index->float_keys = key;
+	return mcc_hash_map_set_if_absent(index->float_values, key, decl);
+}
+
+// ident is the (already renamed) identifier of the assignment that declared decl
+static bool add_to_index(struct mcc_asm_data_index *index, char *ident, struct mcc_asm_declaration *decl)
+{
+	// Temporaries keep their name, everything else is declared as ident_x
+	if (strcmp(ident, decl->identifier) != 0) {
+		if (!mcc_hash_map_set_if_absent(index->variables, ident, decl))
+			return false;
+	}
+
+	switch (decl->type) {
+	case MCC_ASM_DECLARATION_TYPE_STRING:
+		return mcc_hash_map_set_if_absent(index->strings, decl->string_value, decl);
+	case MCC_ASM_DECLARATION_TYPE_FLOAT:
+		if (!mcc_hash_map_set_if_absent(index->floats, decl->identifier, decl) ||
+		    !add_float_value(index, ident, decl))
+			return false;
+		if (strcmp(ident, decl->identifier) != 0)
+			return add_float_value(index, decl->identifier, decl);
+		return true;
+	}
+	return true;
+}
+
 void mcc_asm_generate_data_section(struct mcc_asm_data_section *data_section,
                                    struct mcc_annotated_ir *an_ir,
                                    struct mcc_asm_data *data)
@@ -1271,56 +1383,60 @@ void mcc_asm_generate_data_section(struct mcc_asm_data_section *data_section,
 	assert(data);
 	if (data->has_failed)
 		return;
-	struct mcc_asm_declaration *head = data_section->head;
-	int counter = 0;
+	struct mcc_asm_declaration *last = data->last_declaration;
 
 	// Allocate all declared strings
-	while (an_ir) {
+	for (; an_ir->row; an_ir++) {
 		if (an_ir->row->instr != MCC_IR_INSTR_ASSIGN) {
-			an_ir = an_ir->next;
 			continue;
 		}
 		struct mcc_asm_declaration *decl = NULL;
-		if (an_ir->row->arg2->type == MCC_IR_TYPE_LIT_STRING) {
-			char *string_identifier = rename_identifier(an_ir->row->arg1->ident, counter);
+		if (an_ir->row->arg2.type == MCC_IR_TYPE_LIT_STRING) {
+			char *string_identifier = rename_identifier(&an_ir->row->arg1, data->num_declarations);
 			decl =
-			    mcc_asm_new_string_declaration(string_identifier, an_ir->row->arg2->lit_string, NULL, data);
+			    mcc_asm_new_string_declaration(string_identifier, an_ir->row->arg2.lit_string, NULL, data);
 			free(string_identifier);
-			counter++;
-		} else if (an_ir->row->arg2->type == MCC_IR_TYPE_LIT_FLOAT) {
-			char *float_identifier = rename_identifier(an_ir->row->arg1->ident, counter);
-			decl = mcc_asm_new_float_declaration(float_identifier, an_ir->row->arg2->lit_float, NULL, data);
+			data->num_declarations++;
+		} else if (an_ir->row->arg2.type == MCC_IR_TYPE_LIT_FLOAT) {
+			char *float_identifier = rename_identifier(&an_ir->row->arg1, data->num_declarations);
+			decl = mcc_asm_new_float_declaration(float_identifier, an_ir->row->arg2.lit_float, NULL, data);
 			free(float_identifier);
-			counter++;
+			data->num_declarations++;
 		} else {
-			an_ir = an_ir->next;
 			continue;
 		}
+		// The declarations so far stay in the data section, they are deleted with it
 		if (!decl) {
-			mcc_asm_delete_all_declarations(head);
-			data->has_failed = false;
+			data->has_failed = true;
 			return;
 		}
-		if (!head) {
-			head = decl;
-			data_section->head = head;
+		if (!last) {
+			data_section->head = decl;
 		} else {
-			head->next = decl;
-			head = decl;
+			last->next = decl;
+		}
+		last = decl;
+		data->last_declaration = decl;
+		if (!add_to_index(data->data_index, an_ir->row->arg1.ident, decl)) {
+			data->has_failed = true;
+			return;
 		}
-		an_ir = an_ir->next;
 	}
 
 	return;
 }
 
-struct mcc_asm *mcc_asm_generate(struct mcc_ir_row *ir)
+struct mcc_asm *mcc_asm_generate(struct mcc_ir_function *ir)
 {
 	struct mcc_asm_data *data = malloc(sizeof(*data));
 	if (!data) {
 		return NULL;
 	}
 	data->has_failed = false;
+	data->slots = NULL;
+	data->last_declaration = NULL;
+	data->num_declarations = 0;
+	data->data_index = mcc_asm_new_data_index(data);
 	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
 	struct mcc_asm *assembly = mcc_asm_new_asm(NULL, NULL, data);
 	struct mcc_asm_text_section *text_section = mcc_asm_new_text_section(NULL, data);
@@ -1329,7 +1445,9 @@ struct mcc_asm *mcc_asm_generate(struct mcc_ir_row *ir)
 		mcc_asm_delete_asm(assembly);
 		mcc_asm_delete_text_section(text_section);
 		mcc_asm_delete_data_section(data_section);
+		mcc_asm_delete_data_index(data->data_index);
 		mcc_delete_annotated_ir(an_ir);
+		free(data);
 		return NULL;
 	}
 	assembly->data_section = data_section;
@@ -1343,9 +1461,64 @@ struct mcc_asm *mcc_asm_generate(struct mcc_ir_row *ir)
 		mcc_delete_annotated_ir(an_ir);
 	}
 
+	mcc_asm_delete_data_index(data->data_index);
 	free(data);
 	mcc_delete_annotated_ir(an_ir);
 
 	return assembly;
 }
 
+struct mcc_asm_data *mcc_asm_new_data(void)
+{
+	struct mcc_asm_data *data = malloc(sizeof(*data));
+	if (!data) {
+		return NULL;
+	}
+	data->has_failed = false;
+	data->current = NULL;
+	data->slots = NULL;
+	data->last_declaration = NULL;
+	data->num_declarations = 0;
+	data->data_index = mcc_asm_new_data_index(data);
+	data->data_section = mcc_asm_new_data_section(NULL, data);
+	if (data->has_failed) {
+		mcc_asm_delete_data(data);
+		return NULL;
+	}
+	return data;
+}
+
+struct mcc_asm_function *mcc_asm_generate_next_function(struct mcc_ir_function *ir, struct mcc_asm_data *data)
+{
+	assert(ir);
+	assert(data);
+	if (data->has_failed)
+		return NULL;
+
+	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
+	if (!an_ir) {
+		data->has_failed = true;
+		return NULL;
+	}
+
+	// The declarations are used by the following functions as well, allocate them from the main region
+	bool scratch = mcc_arena_use_scratch(false);
+	mcc_asm_generate_data_section(data->data_section, an_ir, data);
+	mcc_arena_use_scratch(scratch);
+
+	struct mcc_asm_function *function = mcc_asm_generate_function(an_ir, data);
+	if (!function) {
+		data->has_failed = true;
+	}
+	mcc_delete_annotated_ir(an_ir);
+	return function;
+}
+
+void mcc_asm_delete_data(struct mcc_asm_data *data)
+{
+	if (!data)
+		return;
+	mcc_asm_delete_data_section(data->data_section);
+	mcc_asm_delete_data_index(data->data_index);
+	free(data);
+}
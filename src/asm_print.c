@@ -7,7 +7,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/arena.h"
 #include "mcc/asm.h"
+#include "mcc/ir.h"
 #include "utils/length_of_int.h"
 #include "utils/print_string.h"
 #include "utils/unused.h"
@@ -131,9 +133,9 @@ static void register_to_string(char *dest, int len, enum mcc_asm_register reg, i
 		snprintf(dest, len, "%s", register_name_to_string(reg));
 	} else {
 		if (reg == MCC_ASM_ST) {
-			snprintf(dest, len + length_of_int(offset) + 2, "%s(%d)", register_name_to_string(reg), offset);
+			snprintf(dest, len, "%s(%d)", register_name_to_string(reg), offset);
 		} else {
-			snprintf(dest, len + length_of_int(offset) + 2, "%d(%s)", offset, register_name_to_string(reg));
+			snprintf(dest, len, "%d(%s)", offset, register_name_to_string(reg));
 		}
 	}
 }
@@ -202,7 +204,8 @@ static int length_of_op(struct mcc_asm_operand *op)
 	}
 	switch (op->type) {
 	case MCC_ASM_OPERAND_REGISTER:
-		return 4;
+		// e.g. -12(%ebp)
+		return 4 + length_of_int(op->offset) + 2;
 	case MCC_ASM_OPERAND_DATA:
 		return strlen(op->decl->identifier);
 		break;
@@ -298,3 +301,48 @@ void mcc_asm_print_asm(FILE *out, struct mcc_asm *head)
 	fprintf(out, "\n");
 }
 
+bool mcc_asm_print_program(FILE *out, struct mcc_ast_program *program, struct mcc_pass_manager *passes)
+{
+	assert(out);
+	assert(program);
+
+	struct ir_generation_userdata ir_data;
+	if (!mcc_ir_generate_prepare(program, &ir_data)) {
+		mcc_ir_generate_finish(&ir_data);
+		return false;
+	}
+	struct mcc_asm_data *data = mcc_asm_new_data();
+	if (!data) {
+		mcc_ir_generate_finish(&ir_data);
+		return false;
+	}
+
+	fprintf(out, ".text\n");
+	bool scratch = mcc_arena_use_scratch(true);
+	while (program && !data->has_failed) {
+		struct mcc_ir_function *ir = mcc_ir_generate_function(program, &ir_data);
+		bool optimized = ir && mcc_pass_manager_run_ir(passes, ir);
+		struct mcc_asm_function *function = optimized ? mcc_asm_generate_next_function(ir, data) : NULL;
+		if (function && mcc_pass_manager_run_asm(passes, function)) {
+			mcc_asm_print_func(out, function);
+		} else {
+			data->has_failed = true;
+		}
+		// Without the arena, the delete functions free the function, otherwise the scratch region does
+		mcc_asm_delete_function(function);
+		mcc_ir_delete_ir(ir);
+		mcc_arena_release_scratch();
+		program = program->next_function;
+	}
+	mcc_arena_use_scratch(scratch);
+	mcc_ir_generate_finish(&ir_data);
+
+	bool success = !data->has_failed;
+	if (success) {
+		mcc_asm_print_data_sec(out, data->data_section);
+		fprintf(out, "\n");
+	}
+	mcc_asm_delete_data(data);
+	return success;
+}
+
@@ -4,6 +4,68 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/arena.h"
+
+// ---------------------------------------------------------------- Source files
+
+// Index 0 is reserved for nodes that were not created by the parser
+static struct {
+	char **names;
+	unsigned size;
+	unsigned capacity;
+} filenames;
+
+unsigned mcc_ast_add_filename(char *filename)
+{
+	assert(filename);
+
+	// Consecutive parser runs mostly use the same file name
+	if (filenames.size > 1 && strcmp(filenames.names[filenames.size - 1], filename) == 0)
+		return filenames.size - 1;
+
+	if (filenames.size == filenames.capacity) {
+		unsigned capacity = filenames.capacity ? 2 * filenames.capacity : 8;
+		char **names = realloc(filenames.names, capacity * sizeof(*names));
+		if (!names)
+			return 0;
+		filenames.names = names;
+		filenames.capacity = capacity;
+		if (filenames.size == 0)
+			filenames.names[filenames.size++] = "<unknown>";
+	}
+	filenames.names[filenames.size] = filename;
+	return filenames.size++;
+}
+
+char *mcc_ast_get_filename(struct mcc_ast_node node)
+{
+	if (node.sloc.file >= filenames.size)
+		return "<unknown>";
+	return filenames.names[node.sloc.file];
+}
+
+void mcc_ast_delete_filenames(void)
+{
+	free(filenames.names);
+	filenames.names = NULL;
+	filenames.size = 0;
+	filenames.capacity = 0;
+}
+
+// Returns a copy of the array with twice its capacity and frees the old one
+static void *grow_array(void *elements, unsigned size, unsigned *capacity, size_t element_size)
+{
+	unsigned new_capacity = *capacity ? 2 * *capacity : 4;
+	void *grown = mcc_alloc(new_capacity * element_size);
+	if (!grown)
+		return NULL;
+	if (size > 0)
+		memcpy(grown, elements, size * element_size);
+	mcc_free(elements);
+	*capacity = new_capacity;
+	return grown;
+}
+
 // ---------------------------------------------------------------- Expressions
 
 struct mcc_ast_expression *mcc_ast_new_expression_literal(struct mcc_ast_literal *literal)
@@ -11,7 +73,7 @@ struct mcc_ast_expression *mcc_ast_new_expression_literal(struct mcc_ast_literal
 	if (!literal)
 		return NULL;
 
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
+	struct mcc_ast_expression *expr = mcc_alloc(sizeof(*expr));
 	if (!expr) {
 		return NULL;
 	}
@@ -28,7 +90,7 @@ struct mcc_ast_expression *mcc_ast_new_expression_binary_op(enum mcc_ast_binary_
 	if (!rhs || !lhs)
 		return NULL;
 
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
+	struct mcc_ast_expression *expr = mcc_alloc(sizeof(*expr));
 	if (!expr) {
 		return NULL;
 	}
@@ -40,27 +102,12 @@ struct mcc_ast_expression *mcc_ast_new_expression_binary_op(enum mcc_ast_binary_
 	return expr;
 }
 
-struct mcc_ast_expression *mcc_ast_new_expression_parenth(struct mcc_ast_expression *expression)
-{
-	if (!expression)
-		return NULL;
-
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
-	if (!expr) {
-		return NULL;
-	}
-
-	expr->type = MCC_AST_EXPRESSION_TYPE_PARENTH;
-	expr->expression = expression;
-	return expr;
-}
-
 struct mcc_ast_expression *mcc_ast_new_expression_unary_op(enum mcc_ast_unary_op u_op, struct mcc_ast_expression *child)
 {
 	if (!child)
 		return NULL;
 
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
+	struct mcc_ast_expression *expr = mcc_alloc(sizeof(*expr));
 	if (!expr) {
 		return NULL;
 	}
@@ -77,7 +124,7 @@ struct mcc_ast_expression *mcc_ast_new_expression_variable(struct mcc_ast_identi
 	if (!identifier)
 		return NULL;
 
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
+	struct mcc_ast_expression *expr = mcc_alloc(sizeof(*expr));
 	if (!expr) {
 		return NULL;
 	}
@@ -95,7 +142,7 @@ struct mcc_ast_expression *mcc_ast_new_expression_array_element(struct mcc_ast_i
 	if (!identifier || !index)
 		return NULL;
 
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
+	struct mcc_ast_expression *expr = mcc_alloc(sizeof(*expr));
 	if (!expr) {
 		return NULL;
 	}
@@ -112,7 +159,7 @@ struct mcc_ast_expression *mcc_ast_new_expression_function_call(struct mcc_ast_i
 {
 	assert(identifier);
 
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
+	struct mcc_ast_expression *expr = mcc_alloc(sizeof(*expr));
 	if (!expr) {
 		return NULL;
 	}
@@ -139,10 +186,6 @@ void mcc_ast_delete_expression(struct mcc_ast_expression *expression)
 		mcc_ast_delete_expression(expression->rhs);
 		break;
 
-	case MCC_AST_EXPRESSION_TYPE_PARENTH:
-		mcc_ast_delete_expression(expression->expression);
-		break;
-
 	case MCC_AST_EXPRESSION_TYPE_UNARY_OP:
 		mcc_ast_delete_expression(expression->child);
 		break;
@@ -162,14 +205,14 @@ void mcc_ast_delete_expression(struct mcc_ast_expression *expression)
 		break;
 	}
 
-	free(expression);
+	mcc_free(expression);
 }
 
 // ------------------------------------------------------------------ Types
 
 struct mcc_ast_type *mcc_ast_new_type(enum mcc_ast_types type)
 {
-	struct mcc_ast_type *newtype = malloc(sizeof(*newtype));
+	struct mcc_ast_type *newtype = mcc_alloc(sizeof(*newtype));
 	if (!newtype) {
 		return NULL;
 	}
@@ -179,7 +222,7 @@ struct mcc_ast_type *mcc_ast_new_type(enum mcc_ast_types type)
 
 void mcc_ast_delete_type(struct mcc_ast_type *type)
 {
-	free(type);
+	mcc_free(type);
 }
 
 // ------------------------------------------------------------------
@@ -192,7 +235,7 @@ struct mcc_ast_declaration *mcc_ast_new_variable_declaration(enum mcc_ast_types
 	if (!identifier)
 		return NULL;
 
-	struct mcc_ast_declaration *decl = malloc(sizeof(*decl));
+	struct mcc_ast_declaration *decl = mcc_alloc(sizeof(*decl));
 	if (!decl) {
 		return NULL;
 	}
@@ -200,7 +243,7 @@ struct mcc_ast_declaration *mcc_ast_new_variable_declaration(enum mcc_ast_types
 	struct mcc_ast_type *newtype = mcc_ast_new_type(type);
 
 	if (!newtype) {
-		free(decl);
+		mcc_free(decl);
 		return NULL;
 	}
 
@@ -216,7 +259,7 @@ void mcc_ast_delete_variable_declaration(struct mcc_ast_declaration *decl)
 	assert(decl);
 	mcc_ast_delete_identifier(decl->variable_identifier);
 	mcc_ast_delete_type(decl->variable_type);
-	free(decl);
+	mcc_free(decl);
 }
 
 struct mcc_ast_declaration *mcc_ast_new_array_declaration(enum mcc_ast_types type,
@@ -227,14 +270,14 @@ struct mcc_ast_declaration *mcc_ast_new_array_declaration(enum mcc_ast_types typ
 	if (!identifier || !size)
 		return NULL;
 
-	struct mcc_ast_declaration *array_decl = malloc(sizeof(*array_decl));
+	struct mcc_ast_declaration *array_decl = mcc_alloc(sizeof(*array_decl));
 	if (!array_decl) {
 		return NULL;
 	}
 
 	struct mcc_ast_type *newtype = mcc_ast_new_type(type);
 	if (!newtype) {
-		free(array_decl);
+		mcc_free(array_decl);
 		return NULL;
 	}
 
@@ -253,7 +296,7 @@ void mcc_ast_delete_array_declaration(struct mcc_ast_declaration *array_decl)
 	mcc_ast_delete_identifier(array_decl->array_identifier);
 	mcc_ast_delete_type(array_decl->array_type);
 	mcc_ast_delete_literal(array_decl->array_size);
-	free(array_decl);
+	mcc_free(array_decl);
 }
 
 void mcc_ast_delete_declaration(struct mcc_ast_declaration *decl)
@@ -278,7 +321,7 @@ struct mcc_ast_assignment *mcc_ast_new_variable_assignment(struct mcc_ast_identi
 {
 	if (!identifier || !assigned_value)
 		return NULL;
-	struct mcc_ast_assignment *assignment = malloc(sizeof(*assignment));
+	struct mcc_ast_assignment *assignment = mcc_alloc(sizeof(*assignment));
 	if (assignment == NULL) {
 		return NULL;
 	}
@@ -296,7 +339,7 @@ struct mcc_ast_assignment *mcc_ast_new_array_assignment(struct mcc_ast_identifie
 	if (!index || !identifier || !assigned_value)
 		return NULL;
 
-	struct mcc_ast_assignment *assignment = malloc(sizeof(*assignment));
+	struct mcc_ast_assignment *assignment = mcc_alloc(sizeof(*assignment));
 	if (!assignment) {
 		return NULL;
 	}
@@ -327,7 +370,7 @@ void mcc_ast_delete_variable_assignment(struct mcc_ast_assignment *assignment)
 		return;
 	mcc_ast_delete_identifier(assignment->variable_identifier);
 	mcc_ast_delete_expression(assignment->variable_assigned_value);
-	free(assignment);
+	mcc_free(assignment);
 }
 
 void mcc_ast_delete_array_assignment(struct mcc_ast_assignment *assignment)
@@ -337,7 +380,7 @@ void mcc_ast_delete_array_assignment(struct mcc_ast_assignment *assignment)
 	mcc_ast_delete_identifier(assignment->array_identifier);
 	mcc_ast_delete_expression(assignment->array_assigned_value);
 	mcc_ast_delete_expression(assignment->array_index);
-	free(assignment);
+	mcc_free(assignment);
 }
 
 // ------------------------------------------------------------------ Identifier
@@ -347,7 +390,7 @@ struct mcc_ast_identifier *mcc_ast_new_identifier(char *identifier)
 	if (!identifier)
 		return NULL;
 
-	struct mcc_ast_identifier *expr = malloc(sizeof(*expr));
+	struct mcc_ast_identifier *expr = mcc_alloc(sizeof(*expr));
 	if (!expr) {
 		return NULL;
 	}
@@ -361,9 +404,8 @@ void mcc_ast_delete_identifier(struct mcc_ast_identifier *identifier)
 {
 	if (!identifier)
 		return;
-	if (identifier->identifier_name)
-		free(identifier->identifier_name);
-	free(identifier);
+	// identifier_name is interned, it is freed with all other interned strings
+	mcc_free(identifier);
 }
 
 // -------------------------------------------------------------------  Statements
@@ -374,7 +416,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_if_stmt(struct mcc_ast_expressio
 	if (!condition || !on_true)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = mcc_alloc(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -393,7 +435,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_if_else_stmt(struct mcc_ast_expr
 	if (!condition || !on_true || !on_false)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = mcc_alloc(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -411,7 +453,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_expression(struct mcc_ast_expres
 	if (!expression)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = mcc_alloc(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -428,7 +470,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_while(struct mcc_ast_expression
 	if (!condition || !on_true)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = mcc_alloc(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -445,7 +487,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_declaration(struct mcc_ast_decla
 	if (!declaration)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = mcc_alloc(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -461,7 +503,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_assignment(struct mcc_ast_assign
 	if (!assignment)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = mcc_alloc(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -478,7 +520,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_return(bool is_empty_return, str
 		if (!expression)
 			return NULL;
 	}
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = mcc_alloc(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -500,7 +542,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_compound_stmt(struct mcc_ast_com
 	if (!compound_statement)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = mcc_alloc(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -549,38 +591,39 @@ void mcc_ast_delete_statement(struct mcc_ast_statement *statement)
 	case MCC_AST_STATEMENT_TYPE_COMPOUND_STMT:
 		mcc_ast_delete_compound_statement(statement->compound_statement);
 	}
-	free(statement);
+	mcc_free(statement);
 }
 
 // ------------------------------------------------------------------- Compound
 // Statement
 
-struct mcc_ast_compound_statement *mcc_ast_new_compound_stmt(bool is_empty,
-                                                             struct mcc_ast_statement *statement,
-                                                             struct mcc_ast_compound_statement *next_compound_stmt)
+struct mcc_ast_compound_statement *mcc_ast_new_compound_stmt(void)
 {
-	if (is_empty != true) {
-		if (!statement)
-			return NULL;
-	}
-
-	struct mcc_ast_compound_statement *compound_statement = malloc(sizeof(*compound_statement));
+	struct mcc_ast_compound_statement *compound_statement = mcc_alloc(sizeof(*compound_statement));
 	if (!compound_statement) {
 		return NULL;
 	}
-	if (is_empty != true) {
-		compound_statement->statement = statement;
-	} else {
-		compound_statement->statement = NULL;
-	}
-	if (next_compound_stmt == NULL) {
-		compound_statement->has_next_statement = false;
-		compound_statement->next_compound_statement = NULL;
-	} else {
-		compound_statement->has_next_statement = true;
-		compound_statement->next_compound_statement = next_compound_stmt;
+	compound_statement->num_statements = 0;
+	compound_statement->capacity = 0;
+	compound_statement->statements = NULL;
+	return compound_statement;
+}
+
+struct mcc_ast_compound_statement *mcc_ast_add_statement(struct mcc_ast_compound_statement *compound_statement,
+                                                         struct mcc_ast_statement *statement)
+{
+	if (!compound_statement || !statement)
+		return NULL;
+
+	if (compound_statement->num_statements == compound_statement->capacity) {
+		struct mcc_ast_statement **statements =
+		    grow_array(compound_statement->statements, compound_statement->num_statements,
+		               &compound_statement->capacity, sizeof(*statements));
+		if (!statements)
+			return NULL;
+		compound_statement->statements = statements;
 	}
-	compound_statement->is_empty = is_empty;
+	compound_statement->statements[compound_statement->num_statements++] = statement;
 	return compound_statement;
 }
 
@@ -588,13 +631,11 @@ void mcc_ast_delete_compound_statement(struct mcc_ast_compound_statement *compou
 {
 	if (!compound_statement)
 		return;
-	if (compound_statement->has_next_statement == true) {
-		mcc_ast_delete_compound_statement(compound_statement->next_compound_statement);
-	}
-	if (!compound_statement->is_empty) {
-		mcc_ast_delete_statement(compound_statement->statement);
+	for (unsigned i = 0; i < compound_statement->num_statements; i++) {
+		mcc_ast_delete_statement(compound_statement->statements[i]);
 	}
-	free(compound_statement);
+	mcc_free(compound_statement->statements);
+	mcc_free(compound_statement);
 }
 
 // ------------------------------------------------------------------- Literals
@@ -602,7 +643,7 @@ void mcc_ast_delete_compound_statement(struct mcc_ast_compound_statement *compou
 struct mcc_ast_literal *mcc_ast_new_literal_int(long value)
 {
 
-	struct mcc_ast_literal *lit = malloc(sizeof(*lit));
+	struct mcc_ast_literal *lit = mcc_alloc(sizeof(*lit));
 	if (!lit) {
 		return NULL;
 	}
@@ -614,7 +655,7 @@ struct mcc_ast_literal *mcc_ast_new_literal_int(long value)
 
 struct mcc_ast_literal *mcc_ast_new_literal_float(double value)
 {
-	struct mcc_ast_literal *lit = malloc(sizeof(*lit));
+	struct mcc_ast_literal *lit = mcc_alloc(sizeof(*lit));
 	if (!lit) {
 		return NULL;
 	}
@@ -628,14 +669,14 @@ struct mcc_ast_literal *mcc_ast_new_literal_string(char *value)
 {
 	if (!value)
 		return NULL;
-	struct mcc_ast_literal *lit = malloc(sizeof(*lit));
+	struct mcc_ast_literal *lit = mcc_alloc(sizeof(*lit));
 	if (!lit) {
 		return NULL;
 	}
 
 	char *string_no_quotes = mcc_remove_quotes_from_string(value);
 	if (!string_no_quotes) {
-		free(lit);
+		mcc_free(lit);
 		return NULL;
 	}
 
@@ -649,7 +690,7 @@ char *mcc_remove_quotes_from_string(char *string)
 {
 
 	assert(string);
-	char *intermediate = (char *)malloc((strlen(string) - 1) * sizeof(char));
+	char *intermediate = (char *)mcc_alloc((strlen(string) - 1) * sizeof(char));
 	if (!intermediate)
 		return NULL;
 	strncpy(intermediate, string + 1, strlen(string) - 2);
@@ -659,7 +700,7 @@ char *mcc_remove_quotes_from_string(char *string)
 
 struct mcc_ast_literal *mcc_ast_new_literal_bool(bool value)
 {
-	struct mcc_ast_literal *lit = malloc(sizeof(*lit));
+	struct mcc_ast_literal *lit = mcc_alloc(sizeof(*lit));
 	if (!lit) {
 		return NULL;
 	}
@@ -674,9 +715,9 @@ void mcc_ast_delete_literal(struct mcc_ast_literal *literal)
 	if (!literal)
 		return;
 	if (literal->type == MCC_AST_LITERAL_TYPE_STRING) {
-		free(literal->string_value);
+		mcc_free(literal->string_value);
 	}
-	free(literal);
+	mcc_free(literal);
 }
 
 // ---------------------------------------------------------------------
@@ -689,7 +730,7 @@ struct mcc_ast_function_definition *mcc_ast_new_void_function_def(struct mcc_ast
 	if (!identifier)
 		return NULL;
 
-	struct mcc_ast_function_definition *function_definition = malloc(sizeof(*function_definition));
+	struct mcc_ast_function_definition *function_definition = mcc_alloc(sizeof(*function_definition));
 	if (!function_definition) {
 		return NULL;
 	}
@@ -710,7 +751,7 @@ struct mcc_ast_function_definition *mcc_ast_new_type_function_def(enum mcc_ast_t
 	if (!identifier)
 		return NULL;
 
-	struct mcc_ast_function_definition *function_definition = malloc(sizeof(*function_definition));
+	struct mcc_ast_function_definition *function_definition = mcc_alloc(sizeof(*function_definition));
 	if (!function_definition) {
 		return NULL;
 	}
@@ -732,7 +773,7 @@ void mcc_ast_delete_function_definition(struct mcc_ast_function_definition *func
 	if (function_definition->parameters != NULL) {
 		mcc_ast_delete_parameters(function_definition->parameters);
 	}
-	free(function_definition);
+	mcc_free(function_definition);
 }
 
 // --------------------------------------------------------------------- Program
@@ -743,7 +784,7 @@ struct mcc_ast_program *mcc_ast_new_program(struct mcc_ast_function_definition *
 	if (!function_definition)
 		return NULL;
 
-	struct mcc_ast_program *program = malloc(sizeof(*program));
+	struct mcc_ast_program *program = mcc_alloc(sizeof(*program));
 	if (!program)
 		return NULL;
 
@@ -761,7 +802,7 @@ struct mcc_ast_program *mcc_ast_new_program(struct mcc_ast_function_definition *
 
 struct mcc_ast_program *mcc_ast_new_empty_program(char *name)
 {
-	struct mcc_ast_program *program = malloc(sizeof(*program));
+	struct mcc_ast_program *program = mcc_alloc(sizeof(*program));
 	if (!program)
 		return NULL;
 
@@ -772,56 +813,53 @@ struct mcc_ast_program *mcc_ast_new_empty_program(char *name)
 	program->node.sloc.start_col = 0;
 	program->node.sloc.end_line = 0;
 	program->node.sloc.end_col = 0;
-	program->node.sloc.filename = name;
+	program->node.sloc.file = mcc_ast_add_filename(name);
 
 	return program;
 }
 
 void mcc_ast_delete_program(struct mcc_ast_program *program)
 {
-	if (!program)
-		return;
-
-	if (program->has_next_function == false) {
-		mcc_ast_delete_function_definition(program->function);
-	} else {
-		mcc_ast_delete_program(program->next_function);
+	while (program) {
+		struct mcc_ast_program *next = NULL;
+		if (program->has_next_function == true) {
+			next = program->next_function;
+		}
 		mcc_ast_delete_function_definition(program->function);
+		mcc_free(program);
+		program = next;
 	}
-	free(program);
 }
 
 // ---------------------------------------------------------------------
 // Parameters
 
-struct mcc_ast_parameters *mcc_ast_new_parameters(bool is_empty,
-                                                  struct mcc_ast_declaration *declaration,
-                                                  struct mcc_ast_parameters *next_parameters)
+struct mcc_ast_parameters *mcc_ast_new_parameters(void)
 {
-	if (!is_empty) {
-		if (!declaration)
-			return NULL;
-	}
-	struct mcc_ast_parameters *parameters = malloc(sizeof(*parameters));
-
+	struct mcc_ast_parameters *parameters = mcc_alloc(sizeof(*parameters));
 	if (!parameters) {
 		return NULL;
 	}
+	parameters->num_parameters = 0;
+	parameters->capacity = 0;
+	parameters->declarations = NULL;
+	return parameters;
+}
 
-	parameters->is_empty = is_empty;
+struct mcc_ast_parameters *mcc_ast_add_parameter(struct mcc_ast_parameters *parameters,
+                                                 struct mcc_ast_declaration *declaration)
+{
+	if (!parameters || !declaration)
+		return NULL;
 
-	if (next_parameters == NULL) {
-		parameters->has_next_parameter = false;
-		parameters->next_parameters = NULL;
-	} else {
-		parameters->has_next_parameter = true;
-		parameters->next_parameters = next_parameters;
+	if (parameters->num_parameters == parameters->capacity) {
+		struct mcc_ast_declaration **declarations = grow_array(
+		    parameters->declarations, parameters->num_parameters, &parameters->capacity, sizeof(*declarations));
+		if (!declarations)
+			return NULL;
+		parameters->declarations = declarations;
 	}
-	if (!is_empty) {
-		parameters->declaration = declaration;
-	} else {
-		parameters->declaration = NULL;
-	};
+	parameters->declarations[parameters->num_parameters++] = declaration;
 	return parameters;
 }
 
@@ -829,165 +867,77 @@ void mcc_ast_delete_parameters(struct mcc_ast_parameters *parameters)
 {
 	if (!parameters)
 		return;
-	if (parameters->has_next_parameter == true) {
-		mcc_ast_delete_parameters(parameters->next_parameters);
+	for (unsigned i = 0; i < parameters->num_parameters; i++) {
+		mcc_ast_delete_declaration(parameters->declarations[i]);
 	}
-
-	if (!(parameters->is_empty)) {
-		mcc_ast_delete_declaration(parameters->declaration);
-	}
-	free(parameters);
+	mcc_free(parameters->declarations);
+	mcc_free(parameters);
 }
 
 // ---------------------------------------------------------------------
 // Arguments
 
-struct mcc_ast_arguments *
-mcc_ast_new_arguments(bool is_empty, struct mcc_ast_expression *expression, struct mcc_ast_arguments *next_arguments)
+struct mcc_ast_arguments *mcc_ast_new_arguments(void)
 {
-	if (!is_empty) {
-		if (!expression)
-			return NULL;
-	}
-	struct mcc_ast_arguments *arguments = malloc(sizeof(*arguments));
+	struct mcc_ast_arguments *arguments = mcc_alloc(sizeof(*arguments));
 	if (!arguments) {
 		return NULL;
 	}
-
-	if (next_arguments == NULL) {
-		arguments->has_next_expression = false;
-		arguments->next_arguments = NULL;
-	} else {
-		arguments->has_next_expression = true;
-		arguments->next_arguments = next_arguments;
-	}
-	if (!is_empty) {
-		arguments->expression = expression;
-	} else {
-		arguments->expression = NULL;
-	}
-	arguments->is_empty = is_empty;
+	arguments->num_arguments = 0;
+	arguments->capacity = 0;
+	arguments->expressions = NULL;
 	return arguments;
 }
 
-void mcc_ast_delete_arguments(struct mcc_ast_arguments *arguments)
+struct mcc_ast_arguments *mcc_ast_add_argument(struct mcc_ast_arguments *arguments,
+                                               struct mcc_ast_expression *expression)
 {
-	if (!arguments)
-		return;
+	if (!arguments || !expression)
+		return NULL;
 
-	if (arguments->has_next_expression == true) {
-		mcc_ast_delete_arguments(arguments->next_arguments);
-	}
-	if (!(arguments->is_empty)) {
-		mcc_ast_delete_expression(arguments->expression);
+	if (arguments->num_arguments == arguments->capacity) {
+		struct mcc_ast_expression **expressions = grow_array(
+		    arguments->expressions, arguments->num_arguments, &arguments->capacity, sizeof(*expressions));
+		if (!expressions)
+			return NULL;
+		arguments->expressions = expressions;
 	}
-	free(arguments);
+	arguments->expressions[arguments->num_arguments++] = expression;
+	return arguments;
 }
 
-// ------------------------------------------------------------------- Add and remove built_ins
-
-bool mcc_ast_add_built_ins(struct mcc_ast_program *program)
+void mcc_ast_delete_arguments(struct mcc_ast_arguments *arguments)
 {
-	assert(program);
-
-	const char input[] = "void print(string str){} \
-						void print_nl(){} \
-						void print_int(int a){} \
-						void print_float(float b){} \
-						int read_int(){return 0;} \
-						float read_float(){return 0.0;}";
-
-	struct mcc_parser_result result =
-	    mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, program->node.sloc.filename);
-	if (result.status != MCC_PARSER_STATUS_OK) {
-		return false;
-	}
-
-	if (!program->function) {
-		program->function = (&result)->program->function;
-		program->has_next_function = true;
-		program->next_function = (&result)->program->next_function;
-		(&result)->program->function = NULL;
-		free((&result)->program);
-	} else if (!program->next_function) {
-		program->next_function = (&result)->program;
-		program->has_next_function = true;
-		(&result)->program = NULL;
-	} else {
-		struct mcc_ast_program *program_iter = program->next_function;
-		while (program_iter->next_function) {
-			program_iter = program_iter->next_function;
-		}
-		program_iter->next_function = (&result)->program;
-		program_iter->has_next_function = true;
-		(&result)->program = NULL;
+	if (!arguments)
+		return;
+	for (unsigned i = 0; i < arguments->num_arguments; i++) {
+		mcc_ast_delete_expression(arguments->expressions[i]);
 	}
-
-	return true;
+	mcc_free(arguments->expressions);
+	mcc_free(arguments);
 }
 
-static void remove_function(struct mcc_ast_program *program, struct mcc_ast_program *previous)
-{
-	assert(program);
-	assert(previous);
-	assert(previous->next_function == program);
-	previous->has_next_function = program->has_next_function;
-	previous->next_function = program->next_function;
-	program->has_next_function = false;
-	program->next_function = NULL;
-	mcc_ast_delete_program(program);
-}
+// ------------------------------------------------------------------- Built_ins
 
-static bool name_is_built_in(char *function_name)
-{
-	if (strcmp(function_name, "print") == 0) {
-		return true;
-	} else if (strcmp(function_name, "print_nl") == 0) {
-		return true;
-	} else if (strcmp(function_name, "print_int") == 0) {
-		return true;
-	} else if (strcmp(function_name, "print_float") == 0) {
-		return true;
-	} else if (strcmp(function_name, "read_int") == 0) {
-		return true;
-	} else if (strcmp(function_name, "read_float") == 0) {
-		return true;
-	} else {
-		return false;
-	}
-}
+const struct mcc_ast_built_in mcc_ast_built_ins[MCC_AST_NUM_BUILT_INS] = {
+    {"print", VOID, STRING, "str"},
+    {"print_nl", VOID, VOID, NULL},
+    {"print_int", VOID, INT, "a"},
+    {"print_float", VOID, FLOAT, "b"},
+    {"read_int", INT, VOID, NULL},
+    {"read_float", FLOAT, VOID, NULL},
+};
 
-struct mcc_ast_program *mcc_ast_remove_built_ins(struct mcc_ast_program *program)
+const struct mcc_ast_built_in *mcc_ast_get_built_in(const char *name)
 {
-	assert(program);
-	struct mcc_ast_program *head;
-	head = program;
-	struct mcc_ast_program *previous;
-
-	// Remove all built_ins from the beginning of the AST.
-	while (name_is_built_in(program->function->identifier->identifier_name)) {
-		previous = program;
-		program = program->next_function;
-		previous->has_next_function = false;
-		previous->next_function = NULL;
-		mcc_ast_delete_program(previous);
-	}
-
-	head = program;
-	previous = program;
-	program = previous->next_function;
+	assert(name);
 
-	// Remove all intermediate built_ins from the AST
-	while (program) {
-		if (name_is_built_in(program->function->identifier->identifier_name)) {
-			remove_function(program, previous);
-			program = previous->next_function;
-			continue;
+	for (int i = 0; i < MCC_AST_NUM_BUILT_INS; i++) {
+		if (strcmp(mcc_ast_built_ins[i].name, name) == 0) {
+			return &mcc_ast_built_ins[i];
 		}
-		previous = program;
-		program = program->next_function;
 	}
-	return head;
+	return NULL;
 }
 
 // ------------------------------------------------------------------- Transforming the complete AST
@@ -112,16 +112,6 @@ static void print_dot_expression_binary_op(struct mcc_ast_expression *expression
 	print_dot_edge(out, expression, expression->rhs, "rhs");
 }
 
-static void print_dot_expression_parenth(struct mcc_ast_expression *expression, void *data)
-{
-	assert(expression);
-	assert(data);
-
-	FILE *out = data;
-	print_dot_node(out, expression, "( )");
-	print_dot_edge(out, expression, expression->expression, "expression");
-}
-
 static void print_dot_expression_unary_op(struct mcc_ast_expression *expression, void *data)
 {
 	assert(expression);
@@ -168,7 +158,7 @@ static void print_dot_expression_function_call(struct mcc_ast_expression *expres
 	assert(data);
 
 	char label[LABEL_SIZE] = {0};
-	if (expression->arguments->is_empty) {
+	if (expression->arguments->num_arguments == 0) {
 		snprintf(label, sizeof(label), "expr: funct. call, no args");
 	} else {
 		snprintf(label, sizeof(label), "expr: funct. call");
@@ -177,7 +167,7 @@ static void print_dot_expression_function_call(struct mcc_ast_expression *expres
 	FILE *out = data;
 	print_dot_node(out, expression, label);
 	print_dot_edge(out, expression, expression->function_identifier, "func id");
-	if (!expression->arguments->is_empty) {
+	if (expression->arguments->num_arguments > 0) {
 		print_dot_edge(out, expression, expression->arguments, "func args");
 	}
 }
@@ -435,16 +425,13 @@ static void print_dot_compound_statement(struct mcc_ast_compound_statement *comp
 	assert(data);
 
 	FILE *out = data;
-	if (compound_statement->is_empty) {
+	if (compound_statement->num_statements == 0) {
 		print_dot_node(out, compound_statement, "empty comp_stmt");
 	} else {
 		print_dot_node(out, compound_statement, "comp_stmt");
 	}
-	if (compound_statement->is_empty == false) {
-		print_dot_edge(out, compound_statement, compound_statement->statement, "stmt");
-	}
-	if (compound_statement->has_next_statement == true) {
-		print_dot_edge(out, compound_statement, compound_statement->next_compound_statement, "next stmt:");
+	for (unsigned i = 0; i < compound_statement->num_statements; i++) {
+		print_dot_edge(out, compound_statement, compound_statement->statements[i], "stmt");
 	}
 }
 
@@ -470,14 +457,13 @@ static void print_dot_parameters(struct mcc_ast_parameters *parameters, void *da
 	assert(data);
 
 	FILE *out = data;
-	if (!(parameters->is_empty)) {
-		print_dot_edge(out, parameters, parameters->declaration, "decl");
+	if (parameters->num_parameters > 0) {
 		print_dot_node(out, parameters, "param");
 	} else {
 		print_dot_node(out, parameters, "empty param");
 	}
-	if (parameters->has_next_parameter == true) {
-		print_dot_edge(out, parameters, parameters->next_parameters, "next param");
+	for (unsigned i = 0; i < parameters->num_parameters; i++) {
+		print_dot_edge(out, parameters, parameters->declarations[i], "decl");
 	}
 }
 
@@ -488,9 +474,8 @@ static void print_dot_arguments(struct mcc_ast_arguments *arguments, void *data)
 
 	FILE *out = data;
 	print_dot_node(out, arguments, "args");
-	print_dot_edge(out, arguments, arguments->expression, "expr");
-	if (arguments->has_next_expression == true) {
-		print_dot_edge(out, arguments, arguments->next_arguments, "next arg");
+	for (unsigned i = 0; i < arguments->num_arguments; i++) {
+		print_dot_edge(out, arguments, arguments->expressions[i], "expr");
 	}
 }
 
@@ -536,7 +521,6 @@ static struct mcc_ast_visitor print_dot_visitor(FILE *out)
 
 	    .expression_literal = print_dot_expression_literal,
 	    .expression_binary_op = print_dot_expression_binary_op,
-	    .expression_parenth = print_dot_expression_parenth,
 	    .expression_unary_op = print_dot_expression_unary_op,
 	    .expression_variable = print_dot_expression_variable,
 	    .expression_array_element = print_dot_expression_array_element,
@@ -686,6 +670,7 @@ void mcc_ast_print_dot_result(FILE *out, struct mcc_parser_result *result)
 		mcc_ast_print_dot(out, result->assignment);
 		break;
 	case MCC_PARSER_ENTRY_POINT_PROGRAM:
+	case MCC_PARSER_ENTRY_POINT_PROGRAM_WITH_SYMBOL_TABLE:
 		mcc_ast_print_dot(out, result->program);
 		break;
 	case MCC_PARSER_ENTRY_POINT_FUNCTION_DEFINITION:
@@ -1,6 +1,9 @@
 #include "mcc/ast_visit.h"
 
 #include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
 
 #define visit(node, callback, visitor) \
 	if (callback) { \
@@ -18,143 +21,147 @@
 #define visit_if_post_order(node, callback, visitor) \
 	visit_if((visitor)->order == MCC_AST_VISIT_POST_ORDER, node, callback, visitor)
 
-void mcc_ast_visit_expression(struct mcc_ast_expression *expression, struct mcc_ast_visitor *visitor)
+// Nodes that fit on the C stack, more of them move the stack to the heap
+#define INITIAL_DEPTH 64
+
+// Most children of a node that is not a list
+#define MAX_CHILDREN 3
+
+// Depth up to which the visitor recurses, deeper nodes are kept on the explicit stack
+#define MAX_RECURSION 256
+
+enum node_kind {
+	NODE_EXPRESSION,
+	NODE_STATEMENT,
+	NODE_COMPOUND_STATEMENT,
+	NODE_LITERAL,
+	NODE_DECLARATION,
+	NODE_ASSIGNMENT,
+	NODE_TYPE,
+	NODE_IDENTIFIER,
+	NODE_FUNCTION_DEFINITION,
+	NODE_PARAMETERS,
+	NODE_ARGUMENTS,
+	NODE_PROGRAM,
+};
+
+// Node that is entered or, after its children were visited, left
+struct frame {
+	enum node_kind kind;
+	bool leave;
+	void *node;
+};
+
+// Nodes that are left to visit, the next one on top
+struct stack {
+	struct frame *frames;
+	unsigned size;
+	unsigned capacity;
+	// Bit of each node kind without any callback of the visitor, these nodes are not pushed
+	unsigned skipped;
+	struct frame initial[INITIAL_DEPTH];
+};
+
+#define frame_of(kind, node) ((struct frame){(kind), false, (node)})
+
+// ---------------------------------------------------------------- Enter
+
+// Each function calls the pre order callbacks of a node and stores its children in children, last child first.
+// They return the number of children.
+
+static unsigned enter_expression(struct mcc_ast_expression *expression,
+                                 struct frame *children,
+                                 struct mcc_ast_visitor *visitor)
 {
-	assert(expression);
-	assert(visitor);
-
 	visit_if_pre_order(expression, visitor->expression, visitor);
 
 	switch (expression->type) {
 	case MCC_AST_EXPRESSION_TYPE_LITERAL:
 		visit_if_pre_order(expression, visitor->expression_literal, visitor);
-		mcc_ast_visit(expression->literal, visitor);
-		visit_if_post_order(expression, visitor->expression_literal, visitor);
-		break;
-
+		children[0] = frame_of(NODE_LITERAL, expression->literal);
+		return 1;
 	case MCC_AST_EXPRESSION_TYPE_BINARY_OP:
 		visit_if_pre_order(expression, visitor->expression_binary_op, visitor);
-		mcc_ast_visit(expression->lhs, visitor);
-		mcc_ast_visit(expression->rhs, visitor);
-		visit_if_post_order(expression, visitor->expression_binary_op, visitor);
-		break;
-
-	case MCC_AST_EXPRESSION_TYPE_PARENTH:
-		visit_if_pre_order(expression, visitor->expression_parenth, visitor);
-		mcc_ast_visit(expression->expression, visitor);
-		visit_if_post_order(expression, visitor->expression_parenth, visitor);
-		break;
-
+		children[0] = frame_of(NODE_EXPRESSION, expression->rhs);
+		children[1] = frame_of(NODE_EXPRESSION, expression->lhs);
+		return 2;
 	case MCC_AST_EXPRESSION_TYPE_UNARY_OP:
 		visit_if_pre_order(expression, visitor->expression_unary_op, visitor);
-		mcc_ast_visit(expression->child, visitor);
-		visit_if_post_order(expression, visitor->expression_unary_op, visitor);
-		break;
-
+		children[0] = frame_of(NODE_EXPRESSION, expression->child);
+		return 1;
 	case MCC_AST_EXPRESSION_TYPE_VARIABLE:
 		visit_if_pre_order(expression, visitor->expression_variable, visitor);
-		mcc_ast_visit(expression->identifier, visitor);
-		visit_if_post_order(expression, visitor->expression_variable, visitor);
-		break;
-
+		children[0] = frame_of(NODE_IDENTIFIER, expression->identifier);
+		return 1;
 	case MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT:
 		visit_if_pre_order(expression, visitor->expression_array_element, visitor);
-		mcc_ast_visit(expression->array_identifier, visitor);
-		mcc_ast_visit(expression->index, visitor);
-		visit_if_post_order(expression, visitor->expression_array_element, visitor);
-		break;
+		children[0] = frame_of(NODE_EXPRESSION, expression->index);
+		children[1] = frame_of(NODE_IDENTIFIER, expression->array_identifier);
+		return 2;
 	case MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL:
 		visit_if_pre_order(expression, visitor->expression_function_call, visitor);
-		mcc_ast_visit(expression->function_identifier, visitor);
-		if (!expression->arguments->is_empty) {
-			mcc_ast_visit(expression->arguments, visitor);
+		if (expression->arguments->num_arguments == 0) {
+			children[0] = frame_of(NODE_IDENTIFIER, expression->function_identifier);
+			return 1;
 		}
-		visit_if_post_order(expression, visitor->expression_function_call, visitor);
+		children[0] = frame_of(NODE_ARGUMENTS, expression->arguments);
+		children[1] = frame_of(NODE_IDENTIFIER, expression->function_identifier);
+		return 2;
 	}
-
-	visit_if_post_order(expression, visitor->expression, visitor);
+	return 0;
 }
 
-void mcc_ast_visit_statement(struct mcc_ast_statement *statement, struct mcc_ast_visitor *visitor)
+static unsigned enter_statement(struct mcc_ast_statement *statement,
+                                struct frame *children,
+                                struct mcc_ast_visitor *visitor)
 {
-	assert(statement);
-	assert(visitor);
-
 	visit_if_pre_order(statement, visitor->statement, visitor);
 
 	switch (statement->type) {
 	case MCC_AST_STATEMENT_TYPE_IF_STMT:
 		visit_if_pre_order(statement, visitor->statement_if_stmt, visitor);
-		mcc_ast_visit(statement->if_condition, visitor);
-		mcc_ast_visit(statement->if_on_true, visitor);
-		visit_if_post_order(statement, visitor->statement_if_stmt, visitor);
-		break;
+		children[0] = frame_of(NODE_STATEMENT, statement->if_on_true);
+		children[1] = frame_of(NODE_EXPRESSION, statement->if_condition);
+		return 2;
 	case MCC_AST_STATEMENT_TYPE_IF_ELSE_STMT:
 		visit_if_pre_order(statement, visitor->statement_if_else_stmt, visitor);
-		mcc_ast_visit(statement->if_else_condition, visitor);
-		mcc_ast_visit(statement->if_else_on_true, visitor);
-		mcc_ast_visit(statement->if_else_on_false, visitor);
-		visit_if_post_order(statement, visitor->statement_if_else_stmt, visitor);
-		break;
+		children[0] = frame_of(NODE_STATEMENT, statement->if_else_on_false);
+		children[1] = frame_of(NODE_STATEMENT, statement->if_else_on_true);
+		children[2] = frame_of(NODE_EXPRESSION, statement->if_else_condition);
+		return 3;
 	case MCC_AST_STATEMENT_TYPE_EXPRESSION:
 		visit_if_pre_order(statement, visitor->statement_expression_stmt, visitor);
-		mcc_ast_visit(statement->stmt_expression, visitor);
-		visit_if_post_order(statement, visitor->statement_expression_stmt, visitor);
-		break;
+		children[0] = frame_of(NODE_EXPRESSION, statement->stmt_expression);
+		return 1;
 	case MCC_AST_STATEMENT_TYPE_WHILE:
 		visit_if_pre_order(statement, visitor->statement_while, visitor);
-		mcc_ast_visit(statement->while_condition, visitor);
-		mcc_ast_visit(statement->while_on_true, visitor);
-		visit_if_post_order(statement, visitor->statement_while, visitor);
-		break;
+		children[0] = frame_of(NODE_STATEMENT, statement->while_on_true);
+		children[1] = frame_of(NODE_EXPRESSION, statement->while_condition);
+		return 2;
 	case MCC_AST_STATEMENT_TYPE_DECLARATION:
 		visit_if_pre_order(statement, visitor->statement_declaration, visitor);
-		mcc_ast_visit(statement->declaration, visitor);
-		visit_if_post_order(statement, visitor->statement_declaration, visitor);
-		break;
+		children[0] = frame_of(NODE_DECLARATION, statement->declaration);
+		return 1;
 	case MCC_AST_STATEMENT_TYPE_ASSIGNMENT:
 		visit_if_pre_order(statement, visitor->statement_assignment, visitor);
-		mcc_ast_visit(statement->assignment, visitor);
-		visit_if_post_order(statement, visitor->statement_assignment, visitor);
-		break;
+		children[0] = frame_of(NODE_ASSIGNMENT, statement->assignment);
+		return 1;
 	case MCC_AST_STATEMENT_TYPE_RETURN:
 		visit_if_pre_order(statement, visitor->statement_return, visitor);
-		if (!(statement->is_empty_return)) {
-			mcc_ast_visit(statement->return_value, visitor);
-		}
-		visit_if_post_order(statement, visitor->statement_return, visitor);
-		break;
+		if (statement->is_empty_return)
+			return 0;
+		children[0] = frame_of(NODE_EXPRESSION, statement->return_value);
+		return 1;
 	case MCC_AST_STATEMENT_TYPE_COMPOUND_STMT:
 		visit_if_pre_order(statement, visitor->statement_compound_stmt, visitor);
-		mcc_ast_visit(statement->compound_statement, visitor);
-		visit_if_post_order(statement, visitor->statement_compound_stmt, visitor);
-		break;
-	}
-
-	visit_if_post_order(statement, visitor->statement, visitor);
-}
-
-void mcc_ast_visit_compound_statement(struct mcc_ast_compound_statement *compound_statement,
-                                      struct mcc_ast_visitor *visitor)
-{
-	assert(compound_statement);
-	assert(visitor);
-
-	visit_if_pre_order(compound_statement, visitor->compound_statement, visitor);
-	if (!compound_statement->is_empty) {
-		mcc_ast_visit(compound_statement->statement, visitor);
-	}
-	if (compound_statement->has_next_statement) {
-		mcc_ast_visit(compound_statement->next_compound_statement, visitor);
+		children[0] = frame_of(NODE_COMPOUND_STATEMENT, statement->compound_statement);
+		return 1;
 	}
-	visit_if_post_order(compound_statement, visitor->compound_statement, visitor);
+	return 0;
 }
 
-void mcc_ast_visit_literal(struct mcc_ast_literal *literal, struct mcc_ast_visitor *visitor)
+static unsigned enter_literal(struct mcc_ast_literal *literal, struct mcc_ast_visitor *visitor)
 {
-	assert(literal);
-	assert(visitor);
-
 	visit_if_pre_order(literal, visitor->literal, visitor);
 
 	switch (literal->type) {
@@ -171,52 +178,495 @@ void mcc_ast_visit_literal(struct mcc_ast_literal *literal, struct mcc_ast_visit
 		visit(literal, visitor->literal_string, visitor);
 		break;
 	}
-
-	visit_if_post_order(literal, visitor->literal, visitor);
+	return 0;
 }
 
-void mcc_ast_visit_declaration(struct mcc_ast_declaration *declaration, struct mcc_ast_visitor *visitor)
+static unsigned enter_declaration(struct mcc_ast_declaration *declaration,
+                                  struct frame *children,
+                                  struct mcc_ast_visitor *visitor)
 {
-	assert(declaration);
-	assert(visitor);
-
 	switch (declaration->declaration_type) {
 	case MCC_AST_DECLARATION_TYPE_VARIABLE:
 		visit_if_pre_order(declaration, visitor->variable_declaration, visitor);
-		mcc_ast_visit(declaration->variable_type, visitor);
-		mcc_ast_visit(declaration->variable_identifier, visitor);
-		visit_if_post_order(declaration, visitor->variable_declaration, visitor);
-		break;
+		children[0] = frame_of(NODE_IDENTIFIER, declaration->variable_identifier);
+		children[1] = frame_of(NODE_TYPE, declaration->variable_type);
+		return 2;
 	case MCC_AST_DECLARATION_TYPE_ARRAY:
 		visit_if_pre_order(declaration, visitor->array_declaration, visitor);
-		mcc_ast_visit(declaration->array_type, visitor);
-		mcc_ast_visit(declaration->array_size, visitor);
-		mcc_ast_visit(declaration->array_identifier, visitor);
-		visit_if_post_order(declaration, visitor->array_declaration, visitor);
-		break;
+		children[0] = frame_of(NODE_IDENTIFIER, declaration->array_identifier);
+		children[1] = frame_of(NODE_LITERAL, declaration->array_size);
+		children[2] = frame_of(NODE_TYPE, declaration->array_type);
+		return 3;
 	}
+	return 0;
 }
 
-void mcc_ast_visit_assignment(struct mcc_ast_assignment *assignment, struct mcc_ast_visitor *visitor)
+static unsigned enter_assignment(struct mcc_ast_assignment *assignment,
+                                 struct frame *children,
+                                 struct mcc_ast_visitor *visitor)
 {
-	assert(assignment);
-	assert(visitor);
-
 	switch (assignment->assignment_type) {
 	case MCC_AST_ASSIGNMENT_TYPE_VARIABLE:
 		visit_if_pre_order(assignment, visitor->variable_assignment, visitor);
-		mcc_ast_visit(assignment->variable_identifier, visitor);
-		mcc_ast_visit(assignment->variable_assigned_value, visitor);
-		visit_if_post_order(assignment, visitor->variable_assignment, visitor);
-		break;
+		children[0] = frame_of(NODE_EXPRESSION, assignment->variable_assigned_value);
+		children[1] = frame_of(NODE_IDENTIFIER, assignment->variable_identifier);
+		return 2;
 	case MCC_AST_ASSIGNMENT_TYPE_ARRAY:
 		visit_if_pre_order(assignment, visitor->array_assignment, visitor);
-		mcc_ast_visit(assignment->array_identifier, visitor);
-		mcc_ast_visit(assignment->array_index, visitor);
-		mcc_ast_visit(assignment->array_assigned_value, visitor);
-		visit_if_post_order(assignment, visitor->array_assignment, visitor);
+		children[0] = frame_of(NODE_EXPRESSION, assignment->array_assigned_value);
+		children[1] = frame_of(NODE_EXPRESSION, assignment->array_index);
+		children[2] = frame_of(NODE_IDENTIFIER, assignment->array_identifier);
+		return 3;
+	}
+	return 0;
+}
+
+static unsigned enter_function_definition(struct mcc_ast_function_definition *function_definition,
+                                          struct frame *children,
+                                          struct mcc_ast_visitor *visitor)
+{
+	visit_if_pre_order(function_definition, visitor->function_definition, visitor);
+	children[0] = frame_of(NODE_COMPOUND_STATEMENT, function_definition->compound_stmt);
+	children[1] = frame_of(NODE_PARAMETERS, function_definition->parameters);
+	children[2] = frame_of(NODE_IDENTIFIER, function_definition->identifier);
+	return 3;
+}
+
+static unsigned
+enter_program(struct mcc_ast_program *program, struct frame *children, struct mcc_ast_visitor *visitor)
+{
+	visit_if_pre_order(program, visitor->program, visitor);
+	if (!program->has_next_function) {
+		children[0] = frame_of(NODE_FUNCTION_DEFINITION, program->function);
+		return 1;
+	}
+	children[0] = frame_of(NODE_PROGRAM, program->next_function);
+	children[1] = frame_of(NODE_FUNCTION_DEFINITION, program->function);
+	return 2;
+}
+
+// ---------------------------------------------------------------- Leave
+
+// Calls the post order callbacks of a node, in reverse order of enter
+static void leave(struct frame *frame, struct mcc_ast_visitor *visitor)
+{
+	switch (frame->kind) {
+	case NODE_EXPRESSION: {
+		struct mcc_ast_expression *expression = frame->node;
+		switch (expression->type) {
+		case MCC_AST_EXPRESSION_TYPE_LITERAL:
+			visit_if_post_order(expression, visitor->expression_literal, visitor);
+			break;
+		case MCC_AST_EXPRESSION_TYPE_BINARY_OP:
+			visit_if_post_order(expression, visitor->expression_binary_op, visitor);
+			break;
+		case MCC_AST_EXPRESSION_TYPE_UNARY_OP:
+			visit_if_post_order(expression, visitor->expression_unary_op, visitor);
+			break;
+		case MCC_AST_EXPRESSION_TYPE_VARIABLE:
+			visit_if_post_order(expression, visitor->expression_variable, visitor);
+			break;
+		case MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT:
+			visit_if_post_order(expression, visitor->expression_array_element, visitor);
+			break;
+		case MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL:
+			visit_if_post_order(expression, visitor->expression_function_call, visitor);
+			break;
+		}
+		visit_if_post_order(expression, visitor->expression, visitor);
+		break;
+	}
+	case NODE_STATEMENT: {
+		struct mcc_ast_statement *statement = frame->node;
+		switch (statement->type) {
+		case MCC_AST_STATEMENT_TYPE_IF_STMT:
+			visit_if_post_order(statement, visitor->statement_if_stmt, visitor);
+			break;
+		case MCC_AST_STATEMENT_TYPE_IF_ELSE_STMT:
+			visit_if_post_order(statement, visitor->statement_if_else_stmt, visitor);
+			break;
+		case MCC_AST_STATEMENT_TYPE_EXPRESSION:
+			visit_if_post_order(statement, visitor->statement_expression_stmt, visitor);
+			break;
+		case MCC_AST_STATEMENT_TYPE_WHILE:
+			visit_if_post_order(statement, visitor->statement_while, visitor);
+			break;
+		case MCC_AST_STATEMENT_TYPE_DECLARATION:
+			visit_if_post_order(statement, visitor->statement_declaration, visitor);
+			break;
+		case MCC_AST_STATEMENT_TYPE_ASSIGNMENT:
+			visit_if_post_order(statement, visitor->statement_assignment, visitor);
+			break;
+		case MCC_AST_STATEMENT_TYPE_RETURN:
+			visit_if_post_order(statement, visitor->statement_return, visitor);
+			break;
+		case MCC_AST_STATEMENT_TYPE_COMPOUND_STMT:
+			visit_if_post_order(statement, visitor->statement_compound_stmt, visitor);
+			break;
+		}
+		visit_if_post_order(statement, visitor->statement, visitor);
+		break;
+	}
+	case NODE_COMPOUND_STATEMENT:
+		visit_if_post_order(
+		    (struct mcc_ast_compound_statement *)frame->node, visitor->compound_statement, visitor);
+		break;
+	case NODE_LITERAL:
+		visit_if_post_order((struct mcc_ast_literal *)frame->node, visitor->literal, visitor);
+		break;
+	case NODE_DECLARATION: {
+		struct mcc_ast_declaration *declaration = frame->node;
+		switch (declaration->declaration_type) {
+		case MCC_AST_DECLARATION_TYPE_VARIABLE:
+			visit_if_post_order(declaration, visitor->variable_declaration, visitor);
+			break;
+		case MCC_AST_DECLARATION_TYPE_ARRAY:
+			visit_if_post_order(declaration, visitor->array_declaration, visitor);
+			break;
+		}
+		break;
+	}
+	case NODE_ASSIGNMENT: {
+		struct mcc_ast_assignment *assignment = frame->node;
+		switch (assignment->assignment_type) {
+		case MCC_AST_ASSIGNMENT_TYPE_VARIABLE:
+			visit_if_post_order(assignment, visitor->variable_assignment, visitor);
+			break;
+		case MCC_AST_ASSIGNMENT_TYPE_ARRAY:
+			visit_if_post_order(assignment, visitor->array_assignment, visitor);
+			break;
+		}
+		break;
+	}
+	case NODE_TYPE:
+	case NODE_IDENTIFIER:
+		break;
+	case NODE_FUNCTION_DEFINITION:
+		visit_if_post_order(
+		    (struct mcc_ast_function_definition *)frame->node, visitor->function_definition, visitor);
+		break;
+	case NODE_PARAMETERS:
+		visit_if_post_order((struct mcc_ast_parameters *)frame->node, visitor->parameters, visitor);
+		break;
+	case NODE_ARGUMENTS:
+		visit_if_post_order((struct mcc_ast_arguments *)frame->node, visitor->arguments, visitor);
+		break;
+	case NODE_PROGRAM:
+		visit_if_post_order((struct mcc_ast_program *)frame->node, visitor->program, visitor);
+		break;
+	}
+}
+
+// ---------------------------------------------------------------- Traversal
+
+static void traverse(enum node_kind kind, void *node, struct mcc_ast_visitor *visitor);
+
+// Makes room for count more nodes
+static bool reserve(struct stack *stack, unsigned count)
+{
+	if (stack->capacity - stack->size >= count)
+		return true;
+
+	unsigned capacity = stack->capacity;
+	while (capacity - stack->size < count) {
+		if (capacity > UINT_MAX / 2)
+			return false;
+		capacity *= 2;
+	}
+	struct frame *frames = NULL;
+	if (stack->frames == stack->initial) {
+		frames = malloc(capacity * sizeof(*frames));
+		if (frames)
+			memcpy(frames, stack->initial, stack->size * sizeof(*frames));
+	} else {
+		frames = realloc(stack->frames, capacity * sizeof(*frames));
+	}
+	if (!frames)
+		return false;
+	stack->frames = frames;
+	stack->capacity = capacity;
+	return true;
+}
+
+// Nodes only need to be left again for post order callbacks
+#define push_leave(stack, frame, visitor) \
+	if ((visitor)->order == MCC_AST_VISIT_POST_ORDER) { \
+		(stack)->frames[(stack)->size] = (frame); \
+		(stack)->frames[(stack)->size++].leave = true; \
+	}
+
+// Pushes the elements of an entered list, the first element on top. If the stack cannot grow, they are visited right
+// away instead.
+#define push_list(stack, frame, element_kind, elements, count, visitor) \
+	if (reserve(stack, (count) + 1)) { \
+		push_leave(stack, frame, visitor); \
+		for (unsigned i = (count); i-- > 0;) { \
+			(stack)->frames[(stack)->size++] = frame_of(element_kind, (elements)[i]); \
+		} \
+	} else { \
+		for (unsigned i = 0; i < (count); i++) { \
+			traverse(element_kind, (elements)[i], visitor); \
+		} \
+		leave(&(frame), visitor); \
+	}
+
+// Enters the node on top of the stack and replaces it with its children
+static void enter(struct stack *stack, struct mcc_ast_visitor *visitor)
+{
+	struct frame frame = stack->frames[--stack->size];
+	struct frame children[MAX_CHILDREN];
+	unsigned num_children = 0;
+
+	switch (frame.kind) {
+	case NODE_EXPRESSION:
+		num_children = enter_expression(frame.node, children, visitor);
+		break;
+	case NODE_STATEMENT:
+		num_children = enter_statement(frame.node, children, visitor);
+		break;
+	case NODE_LITERAL:
+		num_children = enter_literal(frame.node, visitor);
 		break;
+	case NODE_DECLARATION:
+		num_children = enter_declaration(frame.node, children, visitor);
+		break;
+	case NODE_ASSIGNMENT:
+		num_children = enter_assignment(frame.node, children, visitor);
+		break;
+	case NODE_TYPE:
+		visit((struct mcc_ast_type *)frame.node, visitor->type, visitor);
+		return;
+	case NODE_IDENTIFIER:
+		visit((struct mcc_ast_identifier *)frame.node, visitor->identifier, visitor);
+		return;
+	case NODE_FUNCTION_DEFINITION:
+		num_children = enter_function_definition(frame.node, children, visitor);
+		break;
+	case NODE_PROGRAM:
+		num_children = enter_program(frame.node, children, visitor);
+		// Programs without functions are not left
+		if (!((struct mcc_ast_program *)frame.node)->function)
+			return;
+		break;
+	case NODE_COMPOUND_STATEMENT: {
+		struct mcc_ast_compound_statement *compound_statement = frame.node;
+		visit_if_pre_order(compound_statement, visitor->compound_statement, visitor);
+		push_list(stack, frame, NODE_STATEMENT, compound_statement->statements,
+		          compound_statement->num_statements, visitor);
+		return;
+	}
+	case NODE_PARAMETERS: {
+		struct mcc_ast_parameters *parameters = frame.node;
+		visit_if_pre_order(parameters, visitor->parameters, visitor);
+		push_list(stack, frame, NODE_DECLARATION, parameters->declarations, parameters->num_parameters,
+		          visitor);
+		return;
+	}
+	case NODE_ARGUMENTS: {
+		struct mcc_ast_arguments *arguments = frame.node;
+		visit_if_pre_order(arguments, visitor->arguments, visitor);
+		push_list(stack, frame, NODE_EXPRESSION, arguments->expressions, arguments->num_arguments, visitor);
+		return;
+	}
+	}
+
+	// Identifiers, types and literals without callbacks are dropped, a node without children is left right away
+	unsigned num_visited = 0;
+	for (unsigned i = 0; i < num_children; i++) {
+		if (!(stack->skipped & (1u << children[i].kind)))
+			children[num_visited++] = children[i];
+	}
+	num_children = num_visited;
+	if (num_children == 0) {
+		if (visitor->order == MCC_AST_VISIT_POST_ORDER)
+			leave(&frame, visitor);
+	} else if (reserve(stack, num_children + 1)) {
+		push_leave(stack, frame, visitor);
+		for (unsigned i = 0; i < num_children; i++) {
+			stack->frames[stack->size++] = children[i];
+		}
+	} else {
+		for (unsigned i = num_children; i-- > 0;) {
+			traverse(children[i].kind, children[i].node, visitor);
+		}
+		leave(&frame, visitor);
+	}
+}
+
+// Node kinds whose only callbacks are the ones of the kind itself
+static unsigned skipped_kinds(struct mcc_ast_visitor *visitor)
+{
+	unsigned skipped = 0;
+	if (!visitor->identifier)
+		skipped |= 1u << NODE_IDENTIFIER;
+	if (!visitor->type)
+		skipped |= 1u << NODE_TYPE;
+	if (!visitor->literal && !visitor->literal_int && !visitor->literal_float && !visitor->literal_bool &&
+	    !visitor->literal_string)
+		skipped |= 1u << NODE_LITERAL;
+	return skipped;
+}
+
+// Visits the subtree of node depth-first without recursion. The children of a node are read when it is entered.
+static void traverse(enum node_kind kind, void *node, struct mcc_ast_visitor *visitor)
+{
+	struct stack stack;
+	stack.frames = stack.initial;
+	stack.size = 0;
+	stack.capacity = INITIAL_DEPTH;
+	stack.skipped = skipped_kinds(visitor);
+	stack.frames[stack.size++] = frame_of(kind, node);
+
+	while (stack.size > 0) {
+		if (stack.frames[stack.size - 1].leave) {
+			leave(&stack.frames[--stack.size], visitor);
+		} else {
+			enter(&stack, visitor);
+		}
+	}
+
+	if (stack.frames != stack.initial)
+		free(stack.frames);
+}
+
+
+// Visits the subtree of node like traverse, but recurses as long as the path to it is shorter than MAX_RECURSION,
+// which is faster on the shallow trees of most programs. Deeper subtrees are visited by traverse.
+static void descend(enum node_kind kind, void *node, struct mcc_ast_visitor *visitor, unsigned skipped, unsigned depth)
+{
+	if (depth >= MAX_RECURSION) {
+		traverse(kind, node, visitor);
+		return;
+	}
+
+	struct frame frame = frame_of(kind, node);
+	struct frame children[MAX_CHILDREN];
+	unsigned num_children = 0;
+
+	switch (kind) {
+	case NODE_EXPRESSION:
+		num_children = enter_expression(node, children, visitor);
+		break;
+	case NODE_STATEMENT:
+		num_children = enter_statement(node, children, visitor);
+		break;
+	case NODE_LITERAL:
+		num_children = enter_literal(node, visitor);
+		break;
+	case NODE_DECLARATION:
+		num_children = enter_declaration(node, children, visitor);
+		break;
+	case NODE_ASSIGNMENT:
+		num_children = enter_assignment(node, children, visitor);
+		break;
+	case NODE_TYPE:
+		visit((struct mcc_ast_type *)node, visitor->type, visitor);
+		return;
+	case NODE_IDENTIFIER:
+		visit((struct mcc_ast_identifier *)node, visitor->identifier, visitor);
+		return;
+	case NODE_FUNCTION_DEFINITION:
+		num_children = enter_function_definition(node, children, visitor);
+		break;
+	case NODE_PROGRAM:
+		// The functions of a program form a list, which would use up the depth. Only the post order callbacks
+		// of programs need the path back.
+		if (visitor->order == MCC_AST_VISIT_POST_ORDER && visitor->program) {
+			traverse(kind, node, visitor);
+			return;
+		}
+		for (struct mcc_ast_program *program = node; program; program = program->next_function) {
+			visit_if_pre_order(program, visitor->program, visitor);
+			if (!program->function)
+				return;
+			descend(NODE_FUNCTION_DEFINITION, program->function, visitor, skipped, depth + 1);
+			if (!program->has_next_function)
+				return;
+		}
+		return;
+	case NODE_COMPOUND_STATEMENT: {
+		struct mcc_ast_compound_statement *compound_statement = node;
+		visit_if_pre_order(compound_statement, visitor->compound_statement, visitor);
+		for (unsigned i = 0; i < compound_statement->num_statements; i++)
+			descend(NODE_STATEMENT, compound_statement->statements[i], visitor, skipped, depth + 1);
+		leave(&frame, visitor);
+		return;
+	}
+	case NODE_PARAMETERS: {
+		struct mcc_ast_parameters *parameters = node;
+		visit_if_pre_order(parameters, visitor->parameters, visitor);
+		for (unsigned i = 0; i < parameters->num_parameters; i++)
+			descend(NODE_DECLARATION, parameters->declarations[i], visitor, skipped, depth + 1);
+		leave(&frame, visitor);
+		return;
+	}
+	case NODE_ARGUMENTS: {
+		struct mcc_ast_arguments *arguments = node;
+		visit_if_pre_order(arguments, visitor->arguments, visitor);
+		for (unsigned i = 0; i < arguments->num_arguments; i++)
+			descend(NODE_EXPRESSION, arguments->expressions[i], visitor, skipped, depth + 1);
+		leave(&frame, visitor);
+		return;
+	}
+	}
+
+	for (unsigned i = num_children; i-- > 0;) {
+		if (!(skipped & (1u << children[i].kind)))
+			descend(children[i].kind, children[i].node, visitor, skipped, depth + 1);
 	}
+	if (visitor->order == MCC_AST_VISIT_POST_ORDER)
+		leave(&frame, visitor);
+}
+
+// ---------------------------------------------------------------- Entry points
+
+void mcc_ast_visit_expression(struct mcc_ast_expression *expression, struct mcc_ast_visitor *visitor)
+{
+	assert(expression);
+	assert(visitor);
+
+	descend(NODE_EXPRESSION, expression, visitor, skipped_kinds(visitor), 0);
+}
+
+void mcc_ast_visit_statement(struct mcc_ast_statement *statement, struct mcc_ast_visitor *visitor)
+{
+	assert(statement);
+	assert(visitor);
+
+	descend(NODE_STATEMENT, statement, visitor, skipped_kinds(visitor), 0);
+}
+
+void mcc_ast_visit_compound_statement(struct mcc_ast_compound_statement *compound_statement,
+                                      struct mcc_ast_visitor *visitor)
+{
+	assert(compound_statement);
+	assert(visitor);
+
+	descend(NODE_COMPOUND_STATEMENT, compound_statement, visitor, skipped_kinds(visitor), 0);
+}
+
+void mcc_ast_visit_literal(struct mcc_ast_literal *literal, struct mcc_ast_visitor *visitor)
+{
+	assert(literal);
+	assert(visitor);
+
+	descend(NODE_LITERAL, literal, visitor, skipped_kinds(visitor), 0);
+}
+
+void mcc_ast_visit_declaration(struct mcc_ast_declaration *declaration, struct mcc_ast_visitor *visitor)
+{
+	assert(declaration);
+	assert(visitor);
+
+	descend(NODE_DECLARATION, declaration, visitor, skipped_kinds(visitor), 0);
+}
+
+void mcc_ast_visit_assignment(struct mcc_ast_assignment *assignment, struct mcc_ast_visitor *visitor)
+{
+	assert(assignment);
+	assert(visitor);
+
+	descend(NODE_ASSIGNMENT, assignment, visitor, skipped_kinds(visitor), 0);
 }
 
 void mcc_ast_visit_type(struct mcc_ast_type *type, struct mcc_ast_visitor *visitor)
@@ -241,11 +691,7 @@ void mcc_ast_visit_function_definition(struct mcc_ast_function_definition *funct
 	assert(function_definition);
 	assert(visitor);
 
-	visit_if_pre_order(function_definition, visitor->function_definition, visitor);
-	mcc_ast_visit(function_definition->identifier, visitor);
-	mcc_ast_visit(function_definition->parameters, visitor);
-	mcc_ast_visit(function_definition->compound_stmt, visitor);
-	visit_if_post_order(function_definition, visitor->function_definition, visitor);
+	descend(NODE_FUNCTION_DEFINITION, function_definition, visitor, skipped_kinds(visitor), 0);
 }
 
 void mcc_ast_visit_parameters(struct mcc_ast_parameters *parameters, struct mcc_ast_visitor *visitor)
@@ -253,14 +699,7 @@ void mcc_ast_visit_parameters(struct mcc_ast_parameters *parameters, struct mcc_
 	assert(parameters);
 	assert(visitor);
 
-	visit_if_pre_order(parameters, visitor->parameters, visitor);
-	if (parameters->has_next_parameter) {
-		mcc_ast_visit(parameters->next_parameters, visitor);
-	}
-	if (!(parameters->is_empty)) {
-		mcc_ast_visit(parameters->declaration, visitor);
-	}
-	visit_if_post_order(parameters, visitor->parameters, visitor);
+	descend(NODE_PARAMETERS, parameters, visitor, skipped_kinds(visitor), 0);
 }
 
 void mcc_ast_visit_arguments(struct mcc_ast_arguments *arguments, struct mcc_ast_visitor *visitor)
@@ -268,12 +707,7 @@ void mcc_ast_visit_arguments(struct mcc_ast_arguments *arguments, struct mcc_ast
 	assert(arguments);
 	assert(visitor);
 
-	visit_if_pre_order(arguments, visitor->arguments, visitor);
-	mcc_ast_visit(arguments->expression, visitor);
-	if (arguments->has_next_expression == true) {
-		mcc_ast_visit(arguments->next_arguments, visitor);
-	}
-	visit_if_post_order(arguments, visitor->arguments, visitor);
+	descend(NODE_ARGUMENTS, arguments, visitor, skipped_kinds(visitor), 0);
 }
 
 void mcc_ast_visit_program(struct mcc_ast_program *program, struct mcc_ast_visitor *visitor)
@@ -281,14 +715,5 @@ void mcc_ast_visit_program(struct mcc_ast_program *program, struct mcc_ast_visit
 	assert(program);
 	assert(visitor);
 
-	visit_if_pre_order(program, visitor->program, visitor);
-	if (!program->function) {
-		return;
-	}
-	mcc_ast_visit(program->function, visitor);
-	if (program->has_next_function) {
-		mcc_ast_visit(program->next_function, visitor);
-	}
-	visit_if_post_order(program, visitor->program, visitor);
+	descend(NODE_PROGRAM, program, visitor, skipped_kinds(visitor), 0);
 }
-
@@ -1,41 +1,14 @@
 #include "mcc/cfg.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
-//---------------------------------------------------------------------------------------- Annotate IR with leaders
+#include "mcc/arena.h"
 
-// Annotate IR to determine leaders
-struct annotated_ir {
-	bool is_leader;
-	struct annotated_ir *next;
-	struct annotated_ir *prev;
-	struct mcc_ir_row *row;
-};
-
-static struct annotated_ir *new_annotated_ir(struct mcc_ir_row *row, bool is_leader)
-{
-	assert(row);
-	struct annotated_ir *ir = malloc(sizeof(*ir));
-	if (!ir)
-		return NULL;
-	ir->is_leader = is_leader;
-	ir->row = row;
-	ir->next = NULL;
-	ir->prev = NULL;
-	return ir;
-}
-
-static void delete_annotated_ir(struct annotated_ir *head)
-{
-	if (!head)
-		return;
-
-	delete_annotated_ir(head->next);
-	free(head);
-}
+//---------------------------------------------------------------------------------------- Leaders
 
 static bool is_leader(enum mcc_ir_instruction current, enum mcc_ir_instruction previous)
 {
@@ -57,130 +30,85 @@ static bool is_leader(enum mcc_ir_instruction current, enum mcc_ir_instruction p
 	return false;
 }
 
-static struct annotated_ir *annotate_ir(struct mcc_ir_row *head)
+static struct mcc_ir_row *get_leader(struct mcc_basic_block *block)
 {
-	assert(head);
-	struct annotated_ir *head_an = new_annotated_ir(head, true);
-	if (!head_an)
-		return NULL;
-	struct annotated_ir *first_an = head_an;
-	struct annotated_ir *temp;
-	head = head->next_row;
-
-	while (head) {
-		if (is_leader(head->instr, head_an->row->instr)) {
-			temp = new_annotated_ir(head, true);
-		} else {
-			temp = new_annotated_ir(head, false);
-		}
-		if (!temp) {
-			delete_annotated_ir(first_an);
-			return NULL;
-		}
-		head_an->next = temp;
-		temp->prev = head_an;
-		head_an = temp;
-		head = head->next_row;
-		continue;
-	}
-	return first_an;
+	return &block->function->rows[block->leader];
 }
 
-//---------------------------------------------------------------------------------------- Functions: CFG
-
-// Truncate IR before the next leader
-static void truncate_ir_in_BB(struct mcc_ir_row *head)
+static struct mcc_ir_row *get_last_row(struct mcc_basic_block *block)
 {
-	assert(head);
-	struct mcc_ir_row *previous = head;
-	head = head->next_row;
-	while (head) {
-		if (is_leader(head->instr, previous->instr)) {
-			previous->next_row = NULL;
-			head->prev_row = NULL;
-		}
-		previous = head;
-		head = head->next_row;
-	}
+	return &block->function->rows[block->leader + block->num_rows - 1];
 }
 
-// Truncate IR in entire CFG
-static void truncate_ir(struct mcc_basic_block *head)
-{
-	if (!head)
-		return;
-	truncate_ir(head->next);
-	truncate_ir_in_BB(head->leader);
-}
+//---------------------------------------------------------------------------------------- Functions: CFG
 
-static struct mcc_ir_row *get_last_row(struct mcc_basic_block *head)
+// Maps the label numbers of one function to the basic block starting with that label. Labels are numbered across the
+// functions, so the table only covers the range from the smallest to the largest label of the function.
+struct label_table {
+	struct mcc_basic_block **blocks;
+	unsigned first;
+	unsigned size;
+};
+
+static bool build_label_table(struct label_table *table, struct mcc_basic_block *head)
 {
-	assert(head);
-	struct mcc_ir_row *ir_head = head->leader;
-	struct mcc_ir_row *previous = ir_head;
-	ir_head = ir_head->next_row;
-	while (ir_head) {
-		if (is_leader(ir_head->instr, previous->instr)) {
-			break;
-		}
-		previous = ir_head;
-		ir_head = ir_head->next_row;
+	unsigned min_label = UINT_MAX;
+	unsigned max_label = 0;
+	for (struct mcc_basic_block *block = head; block; block = block->next) {
+		struct mcc_ir_row *leader = get_leader(block);
+		if (leader->instr != MCC_IR_INSTR_LABEL)
+			continue;
+		if (leader->arg1.label < min_label)
+			min_label = leader->arg1.label;
+		if (leader->arg1.label > max_label)
+			max_label = leader->arg1.label;
 	}
-	return previous;
-}
 
-static bool row_is_target_label(struct mcc_ir_row *row, unsigned label)
-{
-	assert(row);
-	if (row->instr == MCC_IR_INSTR_LABEL) {
-		if (row->arg1->label == label) {
-			return true;
-		}
+	table->first = min_label;
+	table->size = min_label <= max_label ? max_label - min_label + 1 : 0;
+	table->blocks = NULL;
+	if (table->size == 0)
+		return true;
+	table->blocks = calloc(table->size, sizeof(*table->blocks));
+	if (!table->blocks)
+		return false;
+
+	for (struct mcc_basic_block *block = head; block; block = block->next) {
+		struct mcc_ir_row *leader = get_leader(block);
+		// Keep the first block in case of duplicate labels
+		if (leader->instr == MCC_IR_INSTR_LABEL && !table->blocks[leader->arg1.label - min_label])
+			table->blocks[leader->arg1.label - min_label] = block;
 	}
-	return false;
+	return true;
 }
 
-static bool jump_target_is_in_bb(struct mcc_ir_row *jump_row, struct mcc_basic_block *block)
+static struct mcc_basic_block *get_bb_jump_target(struct mcc_ir_row *jump_row, struct label_table *labels)
 {
-	struct mcc_ir_row *head = block->leader;
-	int target_label;
+	unsigned target_label;
 	if (jump_row->instr == MCC_IR_INSTR_JUMP) {
-		target_label = jump_row->arg1->label;
+		target_label = jump_row->arg1.label;
 	} else if (jump_row->instr == MCC_IR_INSTR_JUMPFALSE) {
-		target_label = jump_row->arg2->label;
+		target_label = jump_row->arg2.label;
 	} else {
-		return false;
+		return NULL;
 	}
 
-	if (row_is_target_label(head, target_label))
-		return true;
-
-	return false;
-}
-
-static struct mcc_basic_block *get_bb_jump_target(struct mcc_ir_row *jump_row, struct mcc_basic_block *head)
-{
-	if (!head)
+	if (target_label < labels->first || target_label - labels->first >= labels->size)
 		return NULL;
-	if (jump_target_is_in_bb(jump_row, head))
-		return head;
-	struct mcc_basic_block *next = get_bb_jump_target(jump_row, head->next);
-	if (next)
-		return next;
-	return NULL;
+	return labels->blocks[target_label - labels->first];
 }
 
 // Set children for one basic block
-static void set_children(struct mcc_basic_block *head, struct mcc_basic_block *first)
+static void set_children(struct mcc_basic_block *head, struct label_table *labels)
 {
 	assert(head);
-	assert(first);
+	assert(labels);
 	struct mcc_ir_row *last_row = get_last_row(head);
 
 	switch (last_row->instr) {
 	case MCC_IR_INSTR_JUMP:
 		head->child_left = NULL;
-		head->child_right = get_bb_jump_target(last_row, first);
+		head->child_right = get_bb_jump_target(last_row, labels);
 		return;
 	case MCC_IR_INSTR_JUMPFALSE:
 		// After the jump, the next IR line is given from the linear IR
@@ -189,7 +117,7 @@ static void set_children(struct mcc_basic_block *head, struct mcc_basic_block *f
 		} else {
 			head->child_left = NULL;
 		}
-		head->child_right = get_bb_jump_target(last_row, first);
+		head->child_right = get_bb_jump_target(last_row, labels);
 		return;
 	case MCC_IR_INSTR_RETURN:
 		head->child_left = NULL;
@@ -205,162 +133,180 @@ static void set_children(struct mcc_basic_block *head, struct mcc_basic_block *f
 	}
 }
 
-// Transform linear cfg into directed graph
-static void sort_cfg(struct mcc_basic_block *head, struct mcc_basic_block *first)
+// Adds block to the predecessors of its children, or only counts them if the arrays are not allocated yet
+static void add_to_children(struct mcc_basic_block *block, bool count_only)
 {
-	assert(first);
-	if (!head)
-		return;
-	sort_cfg(head->next, first);
-	set_children(head, first);
+	struct mcc_basic_block *children[] = {block->child_left, block->child_right};
+	for (unsigned i = 0; i < 2; i++) {
+		struct mcc_basic_block *child = children[i];
+		// Both children are the same if a conditional jump targets the next block
+		if (!child || (i == 1 && child == block->child_left))
+			continue;
+		if (!count_only)
+			child->predecessors[child->num_predecessors] = block;
+		child->num_predecessors++;
+	}
 }
 
-static void mcc_delete_cfg(struct mcc_basic_block *head)
+// The predecessors are counted first, so that the array of each block is allocated once
+static bool set_predecessors(struct mcc_basic_block *first)
 {
-	if (!head)
-		return;
-	mcc_delete_cfg(head->next);
-	free(head);
+	for (struct mcc_basic_block *block = first; block; block = block->next) {
+		add_to_children(block, true);
+	}
+	for (struct mcc_basic_block *block = first; block; block = block->next) {
+		if (block->num_predecessors > 0) {
+			block->predecessors = mcc_alloc(block->num_predecessors * sizeof(*block->predecessors));
+			if (!block->predecessors)
+				return false;
+		}
+		block->num_predecessors = 0;
+	}
+	for (struct mcc_basic_block *block = first; block; block = block->next) {
+		add_to_children(block, false);
+	}
+	return true;
 }
 
-// Put all basic block leaders into their own BB. Link them to a single linear chain of BBs with the "next" field
-static struct mcc_basic_block *get_basic_blocks(struct annotated_ir *an_ir)
+// Transform linear cfg of one function into directed graph
+static bool sort_cfg(struct mcc_basic_block *first)
 {
-	struct mcc_basic_block *bb_first = mcc_cfg_new_basic_block(an_ir->row, NULL, NULL);
-	if (!bb_first) {
-		return NULL;
+	assert(first);
+	struct label_table labels;
+	if (!build_label_table(&labels, first))
+		return false;
+
+	for (struct mcc_basic_block *head = first; head; head = head->next) {
+		set_children(head, &labels);
 	}
 
-	struct mcc_basic_block *bb_head = bb_first;
-	an_ir = an_ir->next;
+	free(labels.blocks);
+	return set_predecessors(first);
+}
 
-	while (an_ir) {
-		if (an_ir->is_leader) {
-			struct mcc_basic_block *new = mcc_cfg_new_basic_block(an_ir->row, NULL, NULL);
-			if (!new) {
-				mcc_delete_cfg(bb_first);
-				return NULL;
-			}
+// Put all basic block leaders of the function into their own BB. Link them to a single linear chain of BBs with the
+// "next" field
+static struct mcc_basic_block *get_basic_blocks(struct mcc_ir_function *function)
+{
+	struct mcc_basic_block *bb_first = NULL;
+	struct mcc_basic_block *bb_head = NULL;
+
+	for (unsigned i = 0; i < function->num_rows; i++) {
+		if (i > 0 && !is_leader(function->rows[i].instr, function->rows[i - 1].instr))
+			continue;
+
+		struct mcc_basic_block *new = mcc_cfg_new_basic_block(function, i, NULL, NULL);
+		if (!new) {
+			mcc_delete_cfg(bb_first);
+			return NULL;
+		}
+		if (!bb_head) {
+			bb_first = new;
+		} else {
+			new->index = bb_head->index + 1;
 			bb_head->next = new;
-			bb_head = new;
 		}
-		an_ir = an_ir->next;
+		bb_head = new;
 	}
 
+	// Each block ends before the leader of the next block
+	for (struct mcc_basic_block *block = bb_first; block; block = block->next) {
+		if (block->next) {
+			block->num_rows = block->next->leader - block->leader;
+		} else {
+			block->num_rows = function->num_rows - block->leader;
+		}
+	}
 	return bb_first;
 }
 
-struct mcc_basic_block *mcc_cfg_generate(struct mcc_ir_row *ir)
+struct mcc_basic_block *mcc_cfg_generate_function(struct mcc_ir_function *function)
 {
-	struct annotated_ir *an_ir = annotate_ir(ir);
-	if (!an_ir)
-		return NULL;
-	struct annotated_ir *an_ir_first = an_ir;
+	assert(function);
+	assert(function->num_rows > 0);
 
-	struct mcc_basic_block *basic_blocks = get_basic_blocks(an_ir_first);
+	struct mcc_basic_block *basic_blocks = get_basic_blocks(function);
 	if (!basic_blocks) {
-		delete_annotated_ir(an_ir_first);
 		return NULL;
 	}
 
 	// Rearrange linear chain into graph, by setting the child nodes
 	struct mcc_basic_block *root = basic_blocks;
-	sort_cfg(root, root);
-
-	// Truncate IR inside the basic blocks to end before next leader
-	truncate_ir(root);
-
-	// Cleanup
-	delete_annotated_ir(an_ir_first);
+	if (!sort_cfg(root)) {
+		mcc_delete_cfg(root);
+		return NULL;
+	}
 
 	return root;
 }
 
-static void remove_all_bbs_above(struct mcc_basic_block *first, struct mcc_basic_block *head)
+struct mcc_basic_block *mcc_cfg_generate(struct mcc_ir_function *ir)
 {
-	assert(first);
-	assert(head);
-	if (first == head) {
-		return;
-	}
-	struct mcc_basic_block *previous = first;
-	while (previous) {
-		if (previous->next == head) {
-			previous->next = NULL;
-			mcc_delete_cfg_and_ir(first);
-			return;
+	assert(ir);
+
+	struct mcc_basic_block *root = NULL;
+	struct mcc_basic_block *last = NULL;
+	for (struct mcc_ir_function *function = ir; function; function = function->next) {
+		struct mcc_basic_block *first = mcc_cfg_generate_function(function);
+		if (!first) {
+			mcc_delete_cfg(root);
+			return NULL;
 		}
-		previous = previous->next;
-	}
-}
-
-static void remove_cfg_after_next_function_label(struct mcc_basic_block *head)
-{
-	assert(head);
-	struct mcc_basic_block *previous = head;
-	head = previous->next;
-	while (head) {
-		if (head->leader->arg1) {
-			if (head->leader->arg1->type == MCC_IR_TYPE_FUNC_LABEL) {
-				previous->next = NULL;
-				mcc_delete_cfg_and_ir(head);
-				break;
-			}
+		if (!last) {
+			root = first;
+		} else {
+			last->next = first;
+		}
+		last = first;
+		while (last->next) {
+			last = last->next;
 		}
-		previous = previous->next;
-		head = head->next;
 	}
+	return root;
 }
 
-struct mcc_basic_block *mcc_cfg_limit_to_function(char *function_identifier, struct mcc_basic_block *cfg_first)
+struct mcc_ir_function *mcc_cfg_find_function(struct mcc_ir_function *ir, const char *function_identifier)
 {
 	assert(function_identifier);
-	assert(cfg_first);
-	struct mcc_basic_block *head = cfg_first;
-	while (head) {
-		if (head->leader->arg1) {
-			if (head->leader->arg1->type == MCC_IR_TYPE_FUNC_LABEL) {
-				// Right function
-				if (strcmp(head->leader->arg1->func_label, function_identifier) == 0) {
-					remove_all_bbs_above(cfg_first, head);
-					remove_cfg_after_next_function_label(head);
-					break;
-				}
-			}
-		}
-		head = head->next;
-	}
-	if (!head) {
-		mcc_delete_cfg_and_ir(cfg_first);
-		return NULL;
+	for (struct mcc_ir_function *function = ir; function; function = function->next) {
+		struct mcc_ir_row *label = &function->rows[0];
+		if (label->instr == MCC_IR_INSTR_FUNC_LABEL && strcmp(label->arg1.func_label, function_identifier) == 0)
+			return function;
 	}
-	return head;
+	return NULL;
 }
 
 //---------------------------------------------------------------------------------------- Functions: Set up
 // datastructs
 
-struct mcc_basic_block *mcc_cfg_new_basic_block(struct mcc_ir_row *leader,
+struct mcc_basic_block *mcc_cfg_new_basic_block(struct mcc_ir_function *function,
+                                                unsigned leader,
                                                 struct mcc_basic_block *child_left,
                                                 struct mcc_basic_block *child_right)
 {
-	assert(leader);
-	struct mcc_basic_block *block = malloc(sizeof(*block));
+	assert(function);
+	assert(leader < function->num_rows);
+	struct mcc_basic_block *block = mcc_alloc(sizeof(*block));
 	if (!block)
 		return NULL;
 	block->next = NULL;
 	block->child_left = child_left;
 	block->child_right = child_right;
+	block->function = function;
 	block->leader = leader;
+	block->num_rows = 1;
+	block->index = 0;
+	block->predecessors = NULL;
+	block->num_predecessors = 0;
 	return block;
 }
 
-void mcc_delete_cfg_and_ir(struct mcc_basic_block *head)
+void mcc_delete_cfg(struct mcc_basic_block *head)
 {
-	if (!head)
-		return;
-	mcc_delete_cfg_and_ir(head->next);
-	mcc_ir_delete_ir(head->leader);
-	free(head);
+	while (head) {
+		struct mcc_basic_block *next = head->next;
+		mcc_free(head->predecessors);
+		mcc_free(head);
+		head = next;
+	}
 }
-
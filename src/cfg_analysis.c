@@ -0,0 +1,478 @@
+#include "mcc/cfg_analysis.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UNREACHABLE UINT_MAX
+
+static unsigned get_children(struct mcc_basic_block *block, struct mcc_basic_block *children[2])
+{
+	unsigned num_children = 0;
+	if (block->child_left)
+		children[num_children++] = block->child_left;
+	// Both children are the same if a conditional jump targets the next block
+	if (block->child_right && block->child_right != block->child_left)
+		children[num_children++] = block->child_right;
+	return num_children;
+}
+
+static struct mcc_cfg_block_info *get_info(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *block)
+{
+	assert(block->function == analysis->entry->function);
+	assert(block->index < analysis->num_blocks);
+	return &analysis->info[block->index];
+}
+
+static bool is_reachable(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *block)
+{
+	return analysis->info[block->index].rpo_number != UNREACHABLE;
+}
+
+//---------------------------------------------------------------------------------------- Reverse postorder
+
+// Iterative depth-first search from the entry block. The state of a block is 0 as long as it was not visited, then it
+// is 1 + the number of its children that were visited.
+static bool compute_rpo(struct mcc_cfg_analysis *analysis)
+{
+	unsigned *state = calloc(analysis->num_blocks, sizeof(*state));
+	struct mcc_basic_block **stack = malloc(analysis->num_blocks * sizeof(*stack));
+	if (!state || !stack) {
+		free(state);
+		free(stack);
+		return false;
+	}
+
+	// The blocks are stored in postorder first and reversed afterwards
+	struct mcc_basic_block **order = analysis->rpo;
+	unsigned num_visited = 0;
+	unsigned top = 0;
+	stack[top++] = analysis->entry;
+	state[analysis->entry->index] = 1;
+	while (top > 0) {
+		struct mcc_basic_block *block = stack[top - 1];
+		struct mcc_basic_block *children[2];
+		unsigned num_children = get_children(block, children);
+		if (state[block->index] - 1 < num_children) {
+			struct mcc_basic_block *child = children[state[block->index] - 1];
+			state[block->index]++;
+			if (state[child->index] == 0) {
+				state[child->index] = 1;
+				stack[top++] = child;
+			}
+		} else {
+			order[num_visited++] = block;
+			top--;
+		}
+	}
+
+	for (unsigned i = 0; i < num_visited / 2; i++) {
+		struct mcc_basic_block *tmp = order[i];
+		order[i] = order[num_visited - 1 - i];
+		order[num_visited - 1 - i] = tmp;
+	}
+	for (unsigned i = 0; i < num_visited; i++) {
+		analysis->info[order[i]->index].rpo_number = i;
+	}
+	analysis->num_reachable = num_visited;
+
+	free(state);
+	free(stack);
+	return true;
+}
+
+//---------------------------------------------------------------------------------------- Dominators
+
+// Walks up the dominator tree from a and b to their nearest common dominator. A dominator comes before the blocks it
+// dominates in reverse postorder.
+static struct mcc_basic_block *intersect(struct mcc_cfg_analysis *analysis,
+                                         struct mcc_basic_block *a,
+                                         struct mcc_basic_block *b)
+{
+	struct mcc_cfg_block_info *info = analysis->info;
+	while (a != b) {
+		while (info[a->index].rpo_number > info[b->index].rpo_number) {
+			a = info[a->index].idom;
+		}
+		while (info[b->index].rpo_number > info[a->index].rpo_number) {
+			b = info[b->index].idom;
+		}
+	}
+	return a;
+}
+
+// Cooper, Harvey and Kennedy: the immediate dominator of a block is the nearest common dominator of its processed
+// predecessors, iterated in reverse postorder until nothing changes. The entry block is its own dominator meanwhile.
+static void compute_idoms(struct mcc_cfg_analysis *analysis)
+{
+	struct mcc_cfg_block_info *info = analysis->info;
+	info[analysis->entry->index].idom = analysis->entry;
+
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (unsigned i = 1; i < analysis->num_reachable; i++) {
+			struct mcc_basic_block *block = analysis->rpo[i];
+			struct mcc_basic_block *new_idom = NULL;
+			for (unsigned j = 0; j < block->num_predecessors; j++) {
+				struct mcc_basic_block *predecessor = block->predecessors[j];
+				// Unreachable or not processed yet
+				if (!info[predecessor->index].idom)
+					continue;
+				new_idom = new_idom ? intersect(analysis, predecessor, new_idom) : predecessor;
+			}
+			if (info[block->index].idom != new_idom) {
+				info[block->index].idom = new_idom;
+				changed = true;
+			}
+		}
+	}
+	info[analysis->entry->index].idom = NULL;
+}
+
+// Links the children of each block in the dominator tree and numbers the blocks in a walk of the tree
+static bool build_dominator_tree(struct mcc_cfg_analysis *analysis)
+{
+	struct mcc_cfg_block_info *info = analysis->info;
+
+	// Backwards, so that the children end up in reverse postorder
+	for (unsigned i = analysis->num_reachable; i-- > 1;) {
+		struct mcc_basic_block *block = analysis->rpo[i];
+		struct mcc_cfg_block_info *parent = &info[info[block->index].idom->index];
+		info[block->index].dom_sibling = parent->dom_child;
+		parent->dom_child = block;
+	}
+
+	// The next child to visit of each block on the stack
+	struct mcc_basic_block **stack = malloc(analysis->num_reachable * sizeof(*stack));
+	struct mcc_basic_block **next_child = malloc(analysis->num_blocks * sizeof(*next_child));
+	if (!stack || !next_child) {
+		free(stack);
+		free(next_child);
+		return false;
+	}
+
+	unsigned pre = 0;
+	unsigned post = 0;
+	unsigned top = 0;
+	stack[top++] = analysis->entry;
+	info[analysis->entry->index].dom_pre = pre++;
+	next_child[analysis->entry->index] = info[analysis->entry->index].dom_child;
+	while (top > 0) {
+		struct mcc_basic_block *block = stack[top - 1];
+		struct mcc_basic_block *child = next_child[block->index];
+		if (child) {
+			next_child[block->index] = info[child->index].dom_sibling;
+			info[child->index].dom_pre = pre++;
+			next_child[child->index] = info[child->index].dom_child;
+			stack[top++] = child;
+		} else {
+			info[block->index].dom_post = post++;
+			top--;
+		}
+	}
+
+	free(stack);
+	free(next_child);
+	return true;
+}
+
+// The dominance frontiers are the join points, i.e. blocks with several predecessors, that are reached by walking up
+// the dominator tree from a predecessor to the immediate dominator of the join point. last_added holds the join point
+// that was added last to the frontier of each block, so that it is added only once.
+static void walk_frontiers(struct mcc_cfg_analysis *analysis, struct mcc_basic_block **last_added, bool count_only)
+{
+	struct mcc_cfg_block_info *info = analysis->info;
+	memset(last_added, 0, analysis->num_blocks * sizeof(*last_added));
+
+	for (unsigned i = 0; i < analysis->num_reachable; i++) {
+		struct mcc_basic_block *block = analysis->rpo[i];
+		if (block->num_predecessors < 2)
+			continue;
+		for (unsigned j = 0; j < block->num_predecessors; j++) {
+			struct mcc_basic_block *runner = block->predecessors[j];
+			if (!is_reachable(analysis, runner))
+				continue;
+			while (runner && runner != info[block->index].idom) {
+				struct mcc_cfg_block_info *runner_info = &info[runner->index];
+				if (last_added[runner->index] != block) {
+					last_added[runner->index] = block;
+					if (!count_only)
+						runner_info->frontier[runner_info->num_frontier] = block;
+					runner_info->num_frontier++;
+				}
+				runner = runner_info->idom;
+			}
+		}
+	}
+}
+
+// The frontiers are counted first, so that they can be stored in one array
+static bool compute_frontiers(struct mcc_cfg_analysis *analysis)
+{
+	struct mcc_cfg_block_info *info = analysis->info;
+	struct mcc_basic_block **last_added = malloc(analysis->num_blocks * sizeof(*last_added));
+	if (!last_added)
+		return false;
+
+	walk_frontiers(analysis, last_added, true);
+	unsigned total = 0;
+	for (unsigned i = 0; i < analysis->num_blocks; i++) {
+		total += info[i].num_frontier;
+	}
+	if (total > 0) {
+		analysis->frontiers = malloc(total * sizeof(*analysis->frontiers));
+		if (!analysis->frontiers) {
+			free(last_added);
+			return false;
+		}
+	}
+
+	unsigned offset = 0;
+	for (unsigned i = 0; i < analysis->num_blocks; i++) {
+		if (info[i].num_frontier > 0)
+			info[i].frontier = analysis->frontiers + offset;
+		offset += info[i].num_frontier;
+		info[i].num_frontier = 0;
+	}
+	walk_frontiers(analysis, last_added, false);
+
+	free(last_added);
+	return true;
+}
+
+//---------------------------------------------------------------------------------------- Loops
+
+static bool is_header(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *block)
+{
+	for (unsigned i = 0; i < block->num_predecessors; i++) {
+		if (mcc_cfg_is_back_edge(analysis, block->predecessors[i], block))
+			return true;
+	}
+	return false;
+}
+
+// Collects the blocks of the loop from the latches backwards up to the header. body has room for all blocks, mark
+// holds the number + 1 of the last loop that a block was added to.
+static bool collect_loop(struct mcc_cfg_analysis *analysis,
+                         unsigned number,
+                         struct mcc_basic_block **body,
+                         unsigned *mark)
+{
+	struct mcc_loop *loop = &analysis->loops[number];
+	struct mcc_basic_block *header = loop->header;
+
+	unsigned num_body = 0;
+	body[num_body++] = header;
+	mark[header->index] = number + 1;
+	for (unsigned i = 0; i < header->num_predecessors; i++) {
+		struct mcc_basic_block *predecessor = header->predecessors[i];
+		if (!mcc_cfg_is_back_edge(analysis, predecessor, header))
+			continue;
+		loop->latches[loop->num_latches++] = predecessor;
+		if (mark[predecessor->index] != number + 1) {
+			mark[predecessor->index] = number + 1;
+			body[num_body++] = predecessor;
+		}
+	}
+	// The blocks added to body are the work list
+	for (unsigned i = 1; i < num_body; i++) {
+		struct mcc_basic_block *block = body[i];
+		for (unsigned j = 0; j < block->num_predecessors; j++) {
+			struct mcc_basic_block *predecessor = block->predecessors[j];
+			if (!is_reachable(analysis, predecessor) || mark[predecessor->index] == number + 1)
+				continue;
+			mark[predecessor->index] = number + 1;
+			body[num_body++] = predecessor;
+		}
+	}
+
+	loop->blocks = malloc(num_body * sizeof(*loop->blocks));
+	if (!loop->blocks)
+		return false;
+	memcpy(loop->blocks, body, num_body * sizeof(*loop->blocks));
+	loop->num_blocks = num_body;
+
+	// The only predecessor from outside, if it leads nowhere else
+	struct mcc_basic_block *outside = NULL;
+	unsigned num_outside = 0;
+	for (unsigned i = 0; i < header->num_predecessors; i++) {
+		struct mcc_basic_block *predecessor = header->predecessors[i];
+		if (is_reachable(analysis, predecessor) && mark[predecessor->index] != number + 1) {
+			outside = predecessor;
+			num_outside++;
+		}
+	}
+	struct mcc_basic_block *children[2];
+	if (num_outside == 1 && get_children(outside, children) == 1)
+		loop->preheader = outside;
+	return true;
+}
+
+// The headers are visited in reverse postorder, so the header of an outer loop, which dominates the headers of the
+// loops nested in it, is visited first. The innermost loop of a block is set by the last loop containing it.
+static bool compute_loops(struct mcc_cfg_analysis *analysis)
+{
+	for (unsigned i = 0; i < analysis->num_reachable; i++) {
+		if (is_header(analysis, analysis->rpo[i]))
+			analysis->num_loops++;
+	}
+	if (analysis->num_loops == 0)
+		return true;
+
+	analysis->loops = calloc(analysis->num_loops, sizeof(*analysis->loops));
+	struct mcc_basic_block **body = malloc(analysis->num_blocks * sizeof(*body));
+	unsigned *mark = calloc(analysis->num_blocks, sizeof(*mark));
+	if (!analysis->loops || !body || !mark) {
+		free(body);
+		free(mark);
+		return false;
+	}
+
+	bool success = true;
+	unsigned number = 0;
+	for (unsigned i = 0; i < analysis->num_reachable && success; i++) {
+		struct mcc_basic_block *header = analysis->rpo[i];
+		if (!is_header(analysis, header))
+			continue;
+
+		struct mcc_loop *loop = &analysis->loops[number];
+		loop->header = header;
+		loop->parent = analysis->info[header->index].loop;
+		loop->depth = loop->parent ? loop->parent->depth + 1 : 1;
+		loop->latches = malloc(header->num_predecessors * sizeof(*loop->latches));
+		success = loop->latches && collect_loop(analysis, number, body, mark);
+		if (success) {
+			for (unsigned j = 0; j < loop->num_blocks; j++) {
+				analysis->info[loop->blocks[j]->index].loop = loop;
+			}
+		}
+		number++;
+	}
+
+	free(body);
+	free(mark);
+	return success;
+}
+
+//---------------------------------------------------------------------------------------- Functions
+
+struct mcc_cfg_analysis *mcc_cfg_analyze(struct mcc_basic_block *entry)
+{
+	assert(entry);
+	assert(entry->index == 0);
+
+	struct mcc_cfg_analysis *analysis = calloc(1, sizeof(*analysis));
+	if (!analysis)
+		return NULL;
+	analysis->entry = entry;
+
+	// The blocks of other functions may follow in a CFG of the whole program
+	for (struct mcc_basic_block *block = entry; block && block->function == entry->function; block = block->next) {
+		analysis->num_blocks++;
+	}
+	analysis->blocks = malloc(analysis->num_blocks * sizeof(*analysis->blocks));
+	analysis->info = calloc(analysis->num_blocks, sizeof(*analysis->info));
+	analysis->rpo = malloc(analysis->num_blocks * sizeof(*analysis->rpo));
+	if (!analysis->blocks || !analysis->info || !analysis->rpo) {
+		mcc_cfg_delete_analysis(analysis);
+		return NULL;
+	}
+
+	struct mcc_basic_block *block = entry;
+	for (unsigned i = 0; i < analysis->num_blocks; i++) {
+		assert(block->index == i);
+		analysis->blocks[i] = block;
+		analysis->info[i].rpo_number = UNREACHABLE;
+		block = block->next;
+	}
+
+	if (!compute_rpo(analysis)) {
+		mcc_cfg_delete_analysis(analysis);
+		return NULL;
+	}
+	compute_idoms(analysis);
+	if (!build_dominator_tree(analysis) || !compute_frontiers(analysis) || !compute_loops(analysis)) {
+		mcc_cfg_delete_analysis(analysis);
+		return NULL;
+	}
+	return analysis;
+}
+
+bool mcc_cfg_is_reachable(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *block)
+{
+	assert(analysis);
+	assert(block);
+	return get_info(analysis, block)->rpo_number != UNREACHABLE;
+}
+
+bool mcc_cfg_dominates(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *a, struct mcc_basic_block *b)
+{
+	assert(analysis);
+	assert(a);
+	assert(b);
+	if (!mcc_cfg_is_reachable(analysis, a) || !mcc_cfg_is_reachable(analysis, b))
+		return false;
+
+	// a is an ancestor of b in the dominator tree
+	struct mcc_cfg_block_info *info_a = get_info(analysis, a);
+	struct mcc_cfg_block_info *info_b = get_info(analysis, b);
+	return info_a->dom_pre <= info_b->dom_pre && info_b->dom_post <= info_a->dom_post;
+}
+
+struct mcc_basic_block *mcc_cfg_get_idom(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *block)
+{
+	assert(analysis);
+	assert(block);
+	return get_info(analysis, block)->idom;
+}
+
+struct mcc_loop *mcc_cfg_get_loop(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *block)
+{
+	assert(analysis);
+	assert(block);
+	return get_info(analysis, block)->loop;
+}
+
+unsigned mcc_cfg_loop_depth(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *block)
+{
+	struct mcc_loop *loop = mcc_cfg_get_loop(analysis, block);
+	return loop ? loop->depth : 0;
+}
+
+bool mcc_cfg_is_loop_header(struct mcc_cfg_analysis *analysis, struct mcc_basic_block *block)
+{
+	struct mcc_loop *loop = mcc_cfg_get_loop(analysis, block);
+	return loop && loop->header == block;
+}
+
+bool mcc_cfg_is_back_edge(struct mcc_cfg_analysis *analysis,
+                          struct mcc_basic_block *from,
+                          struct mcc_basic_block *to)
+{
+	assert(analysis);
+	assert(from);
+	assert(to);
+	if (from->child_left != to && from->child_right != to)
+		return false;
+	return mcc_cfg_dominates(analysis, to, from);
+}
+
+void mcc_cfg_delete_analysis(struct mcc_cfg_analysis *analysis)
+{
+	if (!analysis)
+		return;
+	if (analysis->loops) {
+		for (unsigned i = 0; i < analysis->num_loops; i++) {
+			free(analysis->loops[i].blocks);
+			free(analysis->loops[i].latches);
+		}
+	}
+	free(analysis->loops);
+	free(analysis->frontiers);
+	free(analysis->rpo);
+	free(analysis->info);
+	free(analysis->blocks);
+	free(analysis);
+}
@@ -15,43 +15,59 @@ void mcc_cfg_print_dot_end(FILE *out)
 	fprintf(out, "%s", "}\n");
 }
 
-void mcc_cfg_print_dot_bb(FILE *out, struct mcc_basic_block *block)
+static void print_dot_edge(FILE *out,
+                           struct mcc_basic_block *from,
+                           struct mcc_basic_block *to,
+                           struct mcc_cfg_analysis *analysis)
 {
-	fprintf(out, "\"%p\" [shape=record label=\"{\n", (void *)block);
-	mcc_cfg_print_dot_ir(out, block->leader);
+	fprintf(out, "\"%p\"->\"%p\"", (void *)from, (void *)to);
+	if (analysis && mcc_cfg_is_back_edge(analysis, from, to)) {
+		fprintf(out, " [color=red style=bold label=\"back edge\"]");
+	}
+	fprintf(out, ";\n");
+}
+
+void mcc_cfg_print_dot_bb(FILE *out, struct mcc_basic_block *block, struct mcc_cfg_analysis *analysis)
+{
+	fprintf(out, "\"%p\" [shape=record ", (void *)block);
+	if (analysis && mcc_cfg_is_loop_header(analysis, block)) {
+		unsigned depth = mcc_cfg_loop_depth(analysis, block);
+		fprintf(out, "color=blue style=bold xlabel=\"loop header, depth %u\" ", depth);
+	}
+	fprintf(out, "label=\"{\n");
+	mcc_cfg_print_dot_ir(out, block);
 	fprintf(out, "}\n\"];\n");
 	if (block->child_left) {
-		fprintf(out, "\"%p\"->\"%p\";\n", (void *)block, (void *)block->child_left);
+		print_dot_edge(out, block, block->child_left, analysis);
 	}
 	if (block->child_right) {
-		fprintf(out, "\"%p\"->\"%p\";\n", (void *)block, (void *)block->child_right);
+		print_dot_edge(out, block, block->child_right, analysis);
 	}
 }
 
-void mcc_cfg_print_dot_ir_row(FILE *out, struct mcc_ir_row *leader)
+void mcc_cfg_print_dot_ir_row(FILE *out, struct mcc_basic_block *block, unsigned row)
 {
 	fprintf(out, "{");
-	mcc_ir_print_ir_row(out, leader, true, true);
+	mcc_ir_print_ir_row(out, block->function, &block->function->rows[row], true, true);
 	fprintf(out, "}");
-	if (leader->next_row)
+	if (row + 1 < block->leader + block->num_rows)
 		fprintf(out, "|");
 	fprintf(out, "\n");
 }
 
-void mcc_cfg_print_dot_ir(FILE *out, struct mcc_ir_row *leader)
+void mcc_cfg_print_dot_ir(FILE *out, struct mcc_basic_block *block)
 {
-	while (leader) {
-		mcc_cfg_print_dot_ir_row(out, leader);
-		leader = leader->next_row;
+	for (unsigned row = block->leader; row < block->leader + block->num_rows; row++) {
+		mcc_cfg_print_dot_ir_row(out, block, row);
 	}
 }
 
-void mcc_cfg_print_dot_cfg(FILE *out, struct mcc_basic_block *head)
+void mcc_cfg_print_dot_cfg(FILE *out, struct mcc_basic_block *head, struct mcc_cfg_analysis *analysis)
 {
 	mcc_cfg_print_dot_begin(out);
 	while (head) {
 
-		mcc_cfg_print_dot_bb(out, head);
+		mcc_cfg_print_dot_bb(out, head, analysis);
 		head = head->next;
 	}
 	mcc_cfg_print_dot_end(out);
@@ -0,0 +1,114 @@
+#include "mcc/intern.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mcc/arena.h"
+#include "utils/hash_map.h"
+
+#define BLOCK_SIZE 4096
+
+// Strings are stored back to back in blocks, instead of one allocation per string
+struct block {
+	struct block *next;
+	size_t used;
+	size_t size;
+	char data[];
+};
+
+static struct {
+	// String contents -> interned string
+	struct mcc_hash_map *strings;
+	struct block *blocks;
+	struct mcc_intern_stats stats;
+} interner;
+
+static char *store(const char *string)
+{
+	size_t length = strlen(string) + 1;
+	struct block *block = interner.blocks;
+	if (!block || block->size - block->used < length) {
+		size_t size = length > BLOCK_SIZE ? length : BLOCK_SIZE;
+		block = malloc(sizeof(*block) + size);
+		if (!block)
+			return NULL;
+		block->next = interner.blocks;
+		block->used = 0;
+		block->size = size;
+		interner.blocks = block;
+		interner.stats.blocks++;
+	}
+	char *stored = &block->data[block->used];
+	memcpy(stored, string, length);
+	block->used += length;
+	interner.stats.bytes += length;
+	return stored;
+}
+
+char *mcc_intern(const char *string)
+{
+	assert(string);
+
+	interner.stats.requests++;
+	char *interned = interner.strings ? mcc_hash_map_get(interner.strings, string) : NULL;
+	if (interned) {
+		interner.stats.hits++;
+		return interned;
+	}
+
+	// The table lives until mcc_intern_delete_all, so it must not grow into the scratch region of the arena
+	bool scratch = mcc_arena_use_scratch(false);
+	if (!interner.strings)
+		interner.strings = mcc_hash_map_new_string();
+	interned = interner.strings ? store(string) : NULL;
+	if (interned && !mcc_hash_map_set(interner.strings, interned, interned))
+		interned = NULL;
+	mcc_arena_use_scratch(scratch);
+	if (interned)
+		interner.stats.strings++;
+	return interned;
+}
+
+char *mcc_intern_lookup(const char *string)
+{
+	assert(string);
+
+	if (!interner.strings)
+		return NULL;
+	return mcc_hash_map_get(interner.strings, string);
+}
+
+bool mcc_intern_equal(const char *interned_a, const char *interned_b)
+{
+	return interned_a == interned_b;
+}
+
+struct mcc_intern_stats mcc_intern_get_stats(void)
+{
+	return interner.stats;
+}
+
+void mcc_intern_print_stats(FILE *out)
+{
+	struct mcc_intern_stats stats = interner.stats;
+	fprintf(out, "interned strings:          %zu (%zu bytes in %zu blocks)\n", stats.strings, stats.bytes,
+	        stats.blocks);
+	fprintf(out, "intern requests:           %zu\n", stats.requests);
+	// Each request used to be a strdup, now there is one allocation per block
+	fprintf(out, "allocations saved:         %zu\n", stats.requests - stats.blocks);
+}
+
+void mcc_intern_delete_all(void)
+{
+	mcc_hash_map_delete(interner.strings);
+	interner.strings = NULL;
+	struct block *block = interner.blocks;
+	while (block) {
+		struct block *next = block->next;
+		free(block);
+		block = next;
+	}
+	interner.blocks = NULL;
+	memset(&interner.stats, 0, sizeof(interner.stats));
+}
@@ -6,20 +6,21 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/arena.h"
 #include "mcc/ast_visit.h"
-#include "utils/length_of_int.h"
+#include "mcc/intern.h"
+#include "utils/hash_map.h"
+#include "utils/stack.h"
 
 // clang-format off
 
-#define mcc_ir_new_arg(x, y) _Generic((x), \
+#define mcc_ir_new_arg(x) _Generic((x), \
     long:                           new_arg_int, \
     double:                         new_arg_float, \
     bool:                           new_arg_bool, \
     char*:                          new_arg_string, \
-    struct mcc_ir_row *:            new_arg_row, \
-    unsigned:                       new_arg_label, \
     struct mcc_ast_identifier *:    new_arg_identifier \
-    )(x,y)
+    )(x)
 
 // clang-format on
 
@@ -46,304 +47,222 @@ bool is_binary_instr(struct mcc_ir_row *row)
 	}
 }
 
-//---------------------------------------------------------------------------------------- IR datastructures
+static bool index_equal(const struct mcc_ir_index *index_a, const struct mcc_ir_index *index_b)
+{
+	if (index_a->type != index_b->type)
+		return false;
+
+	switch (index_a->type) {
+	case MCC_IR_TYPE_LIT_INT:
+		return index_a->lit_int == index_b->lit_int;
+	case MCC_IR_TYPE_IDENTIFIER:
+		return mcc_intern_equal(index_a->ident, index_b->ident);
+	case MCC_IR_TYPE_ROW:
+		return index_a->row == index_b->row;
+	default:
+		return false;
+	}
+}
 
-static void append_row(struct mcc_ir_row *row, struct ir_generation_userdata *data)
+bool mcc_ir_arg_equal(const struct mcc_ir_arg *arg_a, const struct mcc_ir_arg *arg_b)
 {
-	assert(data);
+	assert(arg_a);
+	assert(arg_b);
 
-	struct ir_generation_userdata *userdata = data;
-	if (data->has_failed)
-		return;
+	if (arg_a->type != arg_b->type)
+		return false;
 
-	if (!row) {
-		userdata->has_failed = true;
-		return;
-	}
-	if (!data->head) {
-		data->head = row;
-		data->current = row;
-		return;
+	switch (arg_a->type) {
+	case MCC_IR_TYPE_NONE:
+		return true;
+	case MCC_IR_TYPE_LIT_INT:
+		return arg_a->lit_int == arg_b->lit_int;
+	case MCC_IR_TYPE_LIT_FLOAT:
+		// Same bit pattern, so that 0.0 and -0.0 differ
+		return memcmp(&arg_a->lit_float, &arg_b->lit_float, sizeof(arg_a->lit_float)) == 0;
+	case MCC_IR_TYPE_LIT_BOOL:
+		return arg_a->lit_bool == arg_b->lit_bool;
+	case MCC_IR_TYPE_LIT_STRING:
+		return mcc_intern_equal(arg_a->lit_string, arg_b->lit_string);
+	case MCC_IR_TYPE_ROW:
+		return arg_a->row == arg_b->row;
+	case MCC_IR_TYPE_LABEL:
+		return arg_a->label == arg_b->label;
+	case MCC_IR_TYPE_IDENTIFIER:
+		return mcc_intern_equal(arg_a->ident, arg_b->ident);
+	case MCC_IR_TYPE_ARR_ELEM:
+		return mcc_intern_equal(arg_a->arr_ident, arg_b->arr_ident) &&
+		       index_equal(&arg_a->index, &arg_b->index);
+	case MCC_IR_TYPE_FUNC_LABEL:
+		return mcc_intern_equal(arg_a->func_label, arg_b->func_label);
 	}
-	data->current->next_row = row;
-	row->prev_row = data->current;
-	data->current = row;
+	return false;
 }
 
-static struct mcc_ir_row_type *
-new_ir_row_type(enum mcc_ir_row_types row_type, signed size, struct ir_generation_userdata *data)
+//---------------------------------------------------------------------------------------- IR datastructures
+
+static const struct mcc_ir_arg no_arg = {.type = MCC_IR_TYPE_NONE};
+
+// Appends a row to the function that is currently generated and returns its index
+static unsigned append_row(struct mcc_ir_arg arg1,
+                           struct mcc_ir_arg arg2,
+                           enum mcc_ir_instruction instr,
+                           struct mcc_ir_row_type type,
+                           struct ir_generation_userdata *data)
 {
 	assert(data);
-
 	if (data->has_failed)
-		return NULL;
+		return 0;
 
-	struct mcc_ir_row_type *type = malloc(sizeof(*type));
-	if (!type) {
-		data->has_failed = true;
-		return NULL;
+	if (data->num_rows == data->capacity) {
+		unsigned capacity = data->capacity ? 2 * data->capacity : 64;
+		struct mcc_ir_row *rows = realloc(data->rows, capacity * sizeof(*rows));
+		if (!rows) {
+			data->has_failed = true;
+			return 0;
+		}
+		data->rows = rows;
+		data->capacity = capacity;
 	}
-	type->type = row_type;
-	type->array_size = size;
-	return type;
+	struct mcc_ir_row *row = &data->rows[data->num_rows];
+	row->row_no = 0;
+	row->instr = instr;
+	row->type = type;
+	row->arg1 = arg1;
+	row->arg2 = arg2;
+	return data->num_rows++;
 }
 
-static struct mcc_ir_row_type *typeless(struct ir_generation_userdata *data)
+// Instruction of the last row, MCC_IR_INSTR_UNKNOWN if there is none
+static enum mcc_ir_instruction last_instr(struct ir_generation_userdata *data)
 {
-	assert(data);
-	if (data->has_failed)
-		return NULL;
+	if (data->num_rows == 0)
+		return MCC_IR_INSTR_UNKNOWN;
+	return data->rows[data->num_rows - 1].instr;
+}
 
-	return new_ir_row_type(MCC_IR_ROW_TYPELESS, -1, data);
+static struct mcc_ir_row_type ir_row_type(enum mcc_ir_row_types row_type, signed size)
+{
+	return (struct mcc_ir_row_type){.type = row_type, .array_size = size};
 }
 
-static struct mcc_ir_arg *new_arg_func_label(struct mcc_ast_function_definition *def,
-                                             struct ir_generation_userdata *data)
+static struct mcc_ir_row_type typeless(void)
 {
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	if (!arg) {
-		data->has_failed = true;
-		return NULL;
-	}
-	arg->type = MCC_IR_TYPE_FUNC_LABEL;
-	arg->func_label = strdup(def->identifier->identifier_name);
-	return arg;
+	return ir_row_type(MCC_IR_ROW_TYPELESS, -1);
 }
 
-static struct mcc_ir_arg *new_arg_row(struct mcc_ir_row *row, struct ir_generation_userdata *data)
+static struct mcc_ir_arg new_arg_func_label(struct mcc_ast_function_definition *def)
 {
-	assert(data);
-	if (data->has_failed)
-		return NULL;
+	return (struct mcc_ir_arg){.type = MCC_IR_TYPE_FUNC_LABEL, .func_label = def->identifier->identifier_name};
+}
 
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	if (!arg) {
-		data->has_failed = true;
-		return NULL;
-	}
-	arg->type = MCC_IR_TYPE_ROW;
-	arg->row = row;
-	return arg;
+static struct mcc_ir_arg new_arg_row(unsigned row)
+{
+	return (struct mcc_ir_arg){.type = MCC_IR_TYPE_ROW, .row = row};
 }
 
-static struct mcc_ir_arg *new_arg_int(long lit, struct ir_generation_userdata *data)
+static struct mcc_ir_arg new_arg_int(long lit)
 {
-	assert(data);
-	if (data->has_failed)
-		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	if (!arg) {
-		data->has_failed = true;
-		return NULL;
-	}
-	arg->type = MCC_IR_TYPE_LIT_INT;
-	arg->lit_int = lit;
-	return arg;
+	return (struct mcc_ir_arg){.type = MCC_IR_TYPE_LIT_INT, .lit_int = lit};
 }
 
-static struct mcc_ir_arg *new_arg_float(double lit, struct ir_generation_userdata *data)
+static struct mcc_ir_arg new_arg_float(double lit)
 {
-	assert(data);
-	if (data->has_failed)
-		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	if (!arg) {
-		data->has_failed = true;
-		return NULL;
-	}
-	arg->type = MCC_IR_TYPE_LIT_FLOAT;
-	arg->lit_float = lit;
-	return arg;
+	return (struct mcc_ir_arg){.type = MCC_IR_TYPE_LIT_FLOAT, .lit_float = lit};
 }
 
-static struct mcc_ir_arg *new_arg_bool(bool lit, struct ir_generation_userdata *data)
+static struct mcc_ir_arg new_arg_bool(bool lit)
 {
-	assert(data);
-	if (data->has_failed)
-		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	if (!arg) {
-		data->has_failed = true;
-		return NULL;
-	}
-	arg->type = MCC_IR_TYPE_LIT_BOOL;
-	arg->lit_bool = lit;
-	return arg;
+	return (struct mcc_ir_arg){.type = MCC_IR_TYPE_LIT_BOOL, .lit_bool = lit};
 }
 
-static struct mcc_ir_arg *new_arg_string(char *lit, struct ir_generation_userdata *data)
+// lit must be interned
+static struct mcc_ir_arg new_arg_string(char *lit)
 {
-	assert(data);
-	if (data->has_failed)
-		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	char *string = strdup(lit);
-	if (!arg || !string) {
-		data->has_failed = true;
-		free(arg);
-		free(string);
-		return NULL;
-	}
-	arg->type = MCC_IR_TYPE_LIT_STRING;
-	arg->lit_string = string;
-	return arg;
+	return (struct mcc_ir_arg){.type = MCC_IR_TYPE_LIT_STRING, .lit_string = lit};
 }
 
-static struct mcc_ir_arg *new_arg_label(struct ir_generation_userdata *data)
+static struct mcc_ir_arg new_arg_label(struct ir_generation_userdata *data)
 {
 	assert(data);
-	if (data->has_failed)
-		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	if (!arg) {
-		data->has_failed = true;
-		return NULL;
-	}
-	arg->type = MCC_IR_TYPE_LABEL;
-	arg->label = data->label_counter;
+	struct mcc_ir_arg arg = {.type = MCC_IR_TYPE_LABEL, .label = data->label_counter};
 	data->label_counter = data->label_counter + 1;
 	return arg;
 }
 
-static struct mcc_ir_arg *new_arg_identifier(struct mcc_ast_identifier *ident, struct ir_generation_userdata *data)
+// ident must be interned
+static struct mcc_ir_arg new_arg_identifier_from_string(char *ident)
 {
-	assert(data);
-	if (data->has_failed)
-		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	char *str = strdup(ident->identifier_name);
-	if (!arg || !str) {
-		data->has_failed = true;
-		free(arg);
-		free(str);
-		return NULL;
-	}
-	arg->type = MCC_IR_TYPE_IDENTIFIER;
-	arg->ident = str;
-	return arg;
+	return (struct mcc_ir_arg){.type = MCC_IR_TYPE_IDENTIFIER, .ident = ident};
 }
 
-static struct mcc_ir_arg *new_arg_identifier_from_string(char *ident, struct ir_generation_userdata *data)
+static struct mcc_ir_arg new_arg_identifier(struct mcc_ast_identifier *ident)
 {
-	assert(data);
-	if (data->has_failed)
-		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	char *str = strdup(ident);
-	if (!arg || !str) {
-		data->has_failed = true;
-		free(arg);
-		free(str);
-		return NULL;
-	}
-	arg->type = MCC_IR_TYPE_IDENTIFIER;
-	arg->ident = str;
-	return arg;
+	return new_arg_identifier_from_string(ident->identifier_name);
 }
 
-static struct mcc_ir_row *new_row(struct mcc_ir_arg *arg1,
-                                  struct mcc_ir_arg *arg2,
-                                  enum mcc_ir_instruction instr,
-                                  struct mcc_ir_row_type *type,
-                                  struct ir_generation_userdata *data)
+// Interned name of the next temporary
+static char *new_tmp_identifier(struct ir_generation_userdata *data)
 {
-	assert(data);
-	if (data->has_failed)
-		return NULL;
-	struct mcc_ir_row *row = malloc(sizeof(*row));
-	if (!row) {
+	char ident[32];
+	snprintf(ident, sizeof(ident), "$tmp%d", data->tmp_counter);
+	data->tmp_counter++;
+	char *interned = mcc_intern(ident);
+	if (!interned)
 		data->has_failed = true;
-		return NULL;
-	}
-	row->row_no = 0;
-	row->arg1 = arg1;
-	row->arg2 = arg2;
-	row->instr = instr;
-	row->type = type;
-	row->next_row = NULL;
-	row->prev_row = NULL;
-	return row;
+	return interned;
 }
 
-static struct mcc_ir_row *new_ir_row_array_tmp(struct mcc_ir_arg *index, struct ir_generation_userdata *data)
+static struct mcc_ir_arg
+new_arg_arr_elem(struct mcc_ast_identifier *ident, struct mcc_ir_arg index, struct ir_generation_userdata *data)
 {
 	assert(data);
 	if (data->has_failed)
-		return NULL;
-	unsigned size = 4 + length_of_int(data->tmp_counter) + 1;
-	char *ident = malloc(sizeof(char) * size);
-	if (!ident) {
-		data->has_failed = true;
-		return NULL;
+		return no_arg;
+
+	if (index.type == MCC_IR_TYPE_ARR_ELEM) {
+		// Assign the index to a temporary, it is always of type int because it is only used when the index of
+		// an array element is again an array element
+		struct mcc_ir_arg tmp = new_arg_identifier_from_string(new_tmp_identifier(data));
+		append_row(tmp, index, MCC_IR_INSTR_ASSIGN, ir_row_type(MCC_IR_ROW_INT, -1), data);
+		index = tmp;
 	}
-	snprintf(ident, size, "$tmp%d", data->tmp_counter);
-	data->tmp_counter++;
-	struct mcc_ir_arg *arg1 = new_arg_identifier_from_string(ident, data);
-	free(ident);
-	struct mcc_ir_arg *arg2 = index;
-	// is always of type int because it is only used when index of array element is again array element
-	struct mcc_ir_row_type *type = new_ir_row_type(MCC_IR_ROW_INT, -1, data);
-	struct mcc_ir_row *row = new_row(arg1, arg2, MCC_IR_INSTR_ASSIGN, type, data);
-	append_row(row, data);
-	return row;
-}
 
-static struct mcc_ir_arg *
-new_arg_arr_elem(struct mcc_ast_identifier *ident, struct mcc_ir_arg *index, struct ir_generation_userdata *data)
-{
-	assert(data);
-	if (data->has_failed)
-		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	char *str = strdup(ident->identifier_name);
-	if (!arg || !str) {
+	struct mcc_ir_arg arg = {.type = MCC_IR_TYPE_ARR_ELEM, .arr_ident = ident->identifier_name};
+	arg.index.type = index.type;
+	switch (index.type) {
+	case MCC_IR_TYPE_LIT_INT:
+		arg.index.lit_int = index.lit_int;
+		break;
+	case MCC_IR_TYPE_IDENTIFIER:
+		arg.index.ident = index.ident;
+		break;
+	case MCC_IR_TYPE_ROW:
+		arg.index.row = index.row;
+		break;
+	default:
 		data->has_failed = true;
-		free(arg);
-		free(str);
-		return NULL;
-	}
-	arg->type = MCC_IR_TYPE_ARR_ELEM;
-	arg->arr_ident = str;
-	if (index->type == MCC_IR_TYPE_ARR_ELEM) {
-		struct mcc_ir_row *row = new_ir_row_array_tmp(index, data);
-		arg->index = new_arg_identifier_from_string(row->arg1->ident, data);
-	} else {
-		arg->index = index;
+		return no_arg;
 	}
 	return arg;
 }
 
-static struct mcc_ir_row *new_ir_row_float_tmp(double f_value, struct ir_generation_userdata *data)
+// Assigns a float literal to a new temporary and returns the temporary
+static struct mcc_ir_arg new_float_tmp(double f_value, struct ir_generation_userdata *data)
 {
 	assert(data);
 	if (data->has_failed)
-		return NULL;
-	unsigned size = 4 + length_of_int(data->tmp_counter) + 1;
-	char *ident = malloc(sizeof(char) * size);
-	if (!ident) {
-		data->has_failed = true;
-		return NULL;
-	}
-	snprintf(ident, size, "$tmp%d", data->tmp_counter);
-	data->tmp_counter++;
-	struct mcc_ir_arg *arg1 = new_arg_identifier_from_string(ident, data);
-	free(ident);
-	struct mcc_ir_arg *arg2 = new_arg_float(f_value, data);
-	struct mcc_ir_row_type *type = new_ir_row_type(MCC_IR_ROW_FLOAT, -1, data);
-	struct mcc_ir_row *row = new_row(arg1, arg2, MCC_IR_INSTR_ASSIGN, type, data);
-	append_row(row, data);
-	if (!arg1 || !arg2 || !row || !type)
-		data->has_failed = true;
-	return row;
+		return no_arg;
+	struct mcc_ir_arg tmp = new_arg_identifier_from_string(new_tmp_identifier(data));
+	append_row(tmp, new_arg_float(f_value), MCC_IR_INSTR_ASSIGN, ir_row_type(MCC_IR_ROW_FLOAT, -1), data);
+	return tmp;
 }
 
-static void number_rows(struct mcc_ir_row *head)
+static void number_rows(struct mcc_ir_function *function, struct ir_generation_userdata *data)
 {
-	if (!head)
-		return;
-	int i = 0;
-	do {
-		switch (head->instr) {
+	for (unsigned i = 0; i < function->num_rows; i++) {
+		struct mcc_ir_row *row = &function->rows[i];
+		switch (row->instr) {
 		case MCC_IR_INSTR_AND:
 		case MCC_IR_INSTR_OR:
 		case MCC_IR_INSTR_PLUS:
@@ -361,418 +280,472 @@ static void number_rows(struct mcc_ir_row *head)
 		case MCC_IR_INSTR_CALL:
 		case MCC_IR_INSTR_POP:
 
-			head->row_no = i;
-			i = i + 1;
+			row->row_no = data->row_counter;
+			data->row_counter = data->row_counter + 1;
 			break;
 		default:
 			break;
 		}
-		head = head->next_row;
-	} while (head);
+	}
 }
 
-static struct mcc_ir_arg *arg_from_declaration(struct mcc_ast_declaration *decl, struct ir_generation_userdata *data)
+static struct mcc_ir_arg arg_from_declaration(struct mcc_ast_declaration *decl)
 {
 	assert(decl);
-	if (data->has_failed)
-		return NULL;
 	switch (decl->declaration_type) {
 	case MCC_AST_DECLARATION_TYPE_ARRAY:
-		return new_arg_identifier(decl->array_identifier, data);
+		return new_arg_identifier(decl->array_identifier);
 	case MCC_AST_DECLARATION_TYPE_VARIABLE:
-		return new_arg_identifier(decl->variable_identifier, data);
+		return new_arg_identifier(decl->variable_identifier);
 	default:
-		return NULL;
+		return no_arg;
 	}
 }
 
-struct mcc_ir_arg *mcc_ir_generate_arg_lit(struct mcc_ast_literal *literal, struct ir_generation_userdata *data)
+struct mcc_ir_arg mcc_ir_generate_arg_lit(struct mcc_ast_literal *literal, struct ir_generation_userdata *data)
 {
 	assert(literal);
 
 	if (data->has_failed)
-		return NULL;
-
-	struct mcc_ir_arg *arg = NULL;
-	struct mcc_ir_row *row = NULL;
+		return no_arg;
 
 	switch (literal->type) {
 	case MCC_AST_LITERAL_TYPE_INT:
-		arg = mcc_ir_new_arg(literal->i_value, data);
-		break;
+		return mcc_ir_new_arg(literal->i_value);
 	case MCC_AST_LITERAL_TYPE_FLOAT:
-		row = new_ir_row_float_tmp(literal->f_value, data);
-		if (!row)
-			return NULL;
-		arg = new_arg_identifier_from_string(row->arg1->ident, data);
-		break;
+		return new_float_tmp(literal->f_value, data);
 	case MCC_AST_LITERAL_TYPE_BOOL:
-		arg = mcc_ir_new_arg(literal->bool_value, data);
-		break;
-	case MCC_AST_LITERAL_TYPE_STRING:
-		arg = mcc_ir_new_arg(literal->string_value, data);
-		break;
-	}
-
-	return arg;
-}
-
-static struct mcc_ir_arg *copy_label_arg(struct mcc_ir_arg *arg, struct ir_generation_userdata *data)
-{
-	assert(arg);
-	assert(data);
-
-	if (data->has_failed)
-		return NULL;
-
-	struct mcc_ir_arg *new = malloc(sizeof(*new));
-	if (!new) {
-		data->has_failed = true;
-		return NULL;
+		return mcc_ir_new_arg(literal->bool_value);
+	case MCC_AST_LITERAL_TYPE_STRING: {
+		// Equal literals share one string, which also outlives the AST
+		char *interned = mcc_intern(literal->string_value);
+		if (!interned) {
+			data->has_failed = true;
+			return no_arg;
+		}
+		return mcc_ir_new_arg(interned);
 	}
-	new->type = MCC_IR_TYPE_LABEL;
-	new->label = arg->label;
-	return new;
-}
-
-static struct mcc_ir_arg *copy_arg(struct mcc_ir_arg *arg, struct ir_generation_userdata *data)
-{
-	if (data->has_failed)
-		return NULL;
-
-	assert(arg);
-	assert(data);
-
-	switch (arg->type) {
-	case MCC_IR_TYPE_LIT_INT:
-		return new_arg_int(arg->lit_int, data);
-	case MCC_IR_TYPE_LIT_BOOL:
-		return new_arg_bool(arg->lit_bool, data);
-	case MCC_IR_TYPE_LIT_FLOAT:
-		return new_arg_float(arg->lit_float, data);
-	case MCC_IR_TYPE_LIT_STRING:
-		return new_arg_string(arg->lit_string, data);
-	case MCC_IR_TYPE_IDENTIFIER:
-		return new_arg_identifier_from_string(arg->ident, data);
-	case MCC_IR_TYPE_LABEL:
-		return copy_label_arg(arg, data);
-	case MCC_IR_TYPE_ROW:
-		return new_arg_row(arg->row, data);
-	default:
-		return NULL;
 	}
+	return no_arg;
 }
 
 //------------------------------------------------------------------------------ IR generation
 
-static struct mcc_ir_row_type *
-st_row_to_ir_type(struct mcc_symbol_table_row *row, int array_size, struct ir_generation_userdata *data)
+static struct mcc_ir_row_type st_row_to_ir_type(struct mcc_symbol_table_row *row, int array_size)
 {
 	assert(row);
-	assert(data);
-	if (data->has_failed)
-		return NULL;
-
-	struct mcc_ir_row_type *type = new_ir_row_type(MCC_IR_ROW_TYPELESS, -1, data);
-	if (!type)
-		return NULL;
 
 	switch (row->row_type) {
 	case MCC_SYMBOL_TABLE_ROW_TYPE_INT:
-		type->type = MCC_IR_ROW_INT;
-		type->array_size = array_size;
-		break;
+		return ir_row_type(MCC_IR_ROW_INT, array_size);
 	case MCC_SYMBOL_TABLE_ROW_TYPE_FLOAT:
-		type->type = MCC_IR_ROW_FLOAT;
-		type->array_size = array_size;
-		break;
+		return ir_row_type(MCC_IR_ROW_FLOAT, array_size);
 	case MCC_SYMBOL_TABLE_ROW_TYPE_BOOL:
-		type->type = MCC_IR_ROW_BOOL;
-		type->array_size = array_size;
-		break;
+		return ir_row_type(MCC_IR_ROW_BOOL, array_size);
 	case MCC_SYMBOL_TABLE_ROW_TYPE_STRING:
-		type->type = MCC_IR_ROW_STRING;
-		type->array_size = array_size;
-		break;
+		return ir_row_type(MCC_IR_ROW_STRING, array_size);
 	default:
-		type->type = MCC_IR_ROW_TYPELESS;
-		type->array_size = array_size;
-		break;
+		return ir_row_type(MCC_IR_ROW_TYPELESS, array_size);
 	}
-	return type;
 }
 
-static struct mcc_ir_row_type *
-ident_to_ir_type(struct mcc_ir_arg *arg, struct mcc_ast_expression *exp, struct ir_generation_userdata *data)
+static struct mcc_ir_row_type ident_to_ir_type(char *ident, struct mcc_ast_expression *exp)
 {
-	assert(arg);
+	assert(ident);
 	assert(exp);
-	assert(data);
-	if (data->has_failed)
-		return NULL;
 	// if argument is dummy for tmp of float declaration return row_type float
-	if (strncmp(arg->ident, "$tmp", 4) == 0) {
-		return new_ir_row_type(MCC_IR_ROW_FLOAT, -1, data);
+	if (strncmp(ident, "$tmp", 4) == 0) {
+		return ir_row_type(MCC_IR_ROW_FLOAT, -1);
 	}
 	struct mcc_symbol_table_row *row = NULL;
 	if (exp->type == MCC_AST_EXPRESSION_TYPE_VARIABLE) {
-		row = mcc_symbol_table_check_upwards_for_declaration(arg->ident, exp->variable_row);
+		row = mcc_symbol_table_check_upwards_for_declaration(ident, exp->variable_row);
 	} else if (exp->type == MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT) {
-		row = mcc_symbol_table_check_upwards_for_declaration(arg->ident, exp->array_row);
+		row = mcc_symbol_table_check_upwards_for_declaration(ident, exp->array_row);
 	} else if (exp->type == MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL) {
-		row = mcc_symbol_table_check_for_function_declaration(arg->ident, exp->function_row);
+		row = mcc_symbol_table_check_for_function_declaration(ident, exp->function_row);
 	}
 
-	return st_row_to_ir_type(row, -1, data);
+	return st_row_to_ir_type(row, -1);
 }
 
-static struct mcc_ir_row_type *
+static struct mcc_ir_row_type
 get_type_of_row(struct mcc_ir_arg *arg, struct mcc_ast_expression *exp, struct ir_generation_userdata *data)
 {
 	assert(arg);
 	assert(exp);
 	assert(data);
-	if (data->has_failed)
-		return NULL;
 
 	switch (arg->type) {
 	case MCC_IR_TYPE_LIT_INT:
-		return new_ir_row_type(MCC_IR_ROW_INT, -1, data);
+		return ir_row_type(MCC_IR_ROW_INT, -1);
 	case MCC_IR_TYPE_LIT_FLOAT:
-		return new_ir_row_type(MCC_IR_ROW_FLOAT, -1, data);
+		return ir_row_type(MCC_IR_ROW_FLOAT, -1);
 	case MCC_IR_TYPE_LIT_BOOL:
-		return new_ir_row_type(MCC_IR_ROW_BOOL, -1, data);
+		return ir_row_type(MCC_IR_ROW_BOOL, -1);
 	case MCC_IR_TYPE_LIT_STRING:
-		return new_ir_row_type(MCC_IR_ROW_STRING, -1, data);
+		return ir_row_type(MCC_IR_ROW_STRING, -1);
 	case MCC_IR_TYPE_ROW:
-		return new_ir_row_type(arg->row->type->type, arg->row->type->array_size, data);
+		return data->rows[arg->row].type;
+	case MCC_IR_TYPE_NONE:
 	case MCC_IR_TYPE_LABEL:
-		return new_ir_row_type(MCC_IR_ROW_TYPELESS, -1, data);
+		return typeless();
 	case MCC_IR_TYPE_IDENTIFIER:
-		return ident_to_ir_type(arg, exp, data);
+		return ident_to_ir_type(arg->ident, exp);
 	case MCC_IR_TYPE_ARR_ELEM:
-		return ident_to_ir_type(arg, exp, data);
+		return ident_to_ir_type(arg->arr_ident, exp);
 	case MCC_IR_TYPE_FUNC_LABEL:
-		return ident_to_ir_type(arg, exp, data);
+		return ident_to_ir_type(arg->func_label, exp);
 	}
-	return NULL;
+	return typeless();
 }
 
-struct mcc_ir_arg *mcc_ir_generate_expression_binary_op(struct mcc_ast_expression *expression,
-                                                        struct ir_generation_userdata *data)
+// Appends the row of a binary operation whose operands are evaluated
+static struct mcc_ir_arg binary_op_row(struct mcc_ast_expression *expression,
+                                       struct mcc_ir_arg lhs,
+                                       struct mcc_ir_arg rhs,
+                                       struct ir_generation_userdata *data)
 {
-	assert(expression->lhs);
-	assert(expression->rhs);
-	assert(data);
-
-	struct mcc_ir_arg *lhs = mcc_ir_generate_expression(expression->lhs, data);
-	struct mcc_ir_arg *rhs = mcc_ir_generate_expression(expression->rhs, data);
-
 	if (data->has_failed)
-		return NULL;
+		return no_arg;
 
 	enum mcc_ir_instruction instr = MCC_IR_INSTR_UNKNOWN;
-	struct mcc_ir_row_type *type = NULL;
+	struct mcc_ir_row_type type = typeless();
 	switch (expression->op) {
 	case MCC_AST_BINARY_OP_ADD:
 		instr = MCC_IR_INSTR_PLUS;
-		type = get_type_of_row(lhs, expression->lhs, data);
+		type = get_type_of_row(&lhs, expression->lhs, data);
 		break;
 	case MCC_AST_BINARY_OP_SUB:
 		instr = MCC_IR_INSTR_MINUS;
-		type = get_type_of_row(lhs, expression->lhs, data);
+		type = get_type_of_row(&lhs, expression->lhs, data);
 		break;
 	case MCC_AST_BINARY_OP_MUL:
 		instr = MCC_IR_INSTR_MULTIPLY;
-		type = get_type_of_row(lhs, expression->lhs, data);
+		type = get_type_of_row(&lhs, expression->lhs, data);
 		break;
 	case MCC_AST_BINARY_OP_DIV:
 		instr = MCC_IR_INSTR_DIVIDE;
-		type = get_type_of_row(lhs, expression->lhs, data);
+		type = get_type_of_row(&lhs, expression->lhs, data);
 		break;
 	case MCC_AST_BINARY_OP_SMALLER:
 		instr = MCC_IR_INSTR_SMALLER;
-		type = new_ir_row_type(MCC_IR_ROW_BOOL, -1, data);
+		type = ir_row_type(MCC_IR_ROW_BOOL, -1);
 		break;
 	case MCC_AST_BINARY_OP_GREATER:
 		instr = MCC_IR_INSTR_GREATER;
-		type = new_ir_row_type(MCC_IR_ROW_BOOL, -1, data);
+		type = ir_row_type(MCC_IR_ROW_BOOL, -1);
 		break;
 	case MCC_AST_BINARY_OP_SMALLEREQ:
 		instr = MCC_IR_INSTR_SMALLEREQ;
-		type = new_ir_row_type(MCC_IR_ROW_BOOL, -1, data);
+		type = ir_row_type(MCC_IR_ROW_BOOL, -1);
 		break;
 	case MCC_AST_BINARY_OP_GREATEREQ:
 		instr = MCC_IR_INSTR_GREATEREQ;
-		type = new_ir_row_type(MCC_IR_ROW_BOOL, -1, data);
+		type = ir_row_type(MCC_IR_ROW_BOOL, -1);
 		break;
 	case MCC_AST_BINARY_OP_CONJ:
 		instr = MCC_IR_INSTR_AND;
-		type = new_ir_row_type(MCC_IR_ROW_BOOL, -1, data);
+		type = ir_row_type(MCC_IR_ROW_BOOL, -1);
 		break;
 	case MCC_AST_BINARY_OP_DISJ:
 		instr = MCC_IR_INSTR_OR;
-		type = new_ir_row_type(MCC_IR_ROW_BOOL, -1, data);
+		type = ir_row_type(MCC_IR_ROW_BOOL, -1);
 		break;
 	case MCC_AST_BINARY_OP_EQUAL:
 		instr = MCC_IR_INSTR_EQUALS;
-		type = new_ir_row_type(MCC_IR_ROW_BOOL, -1, data);
+		type = ir_row_type(MCC_IR_ROW_BOOL, -1);
 		break;
 	case MCC_AST_BINARY_OP_NOTEQUAL:
 		instr = MCC_IR_INSTR_NOTEQUALS;
-		type = new_ir_row_type(MCC_IR_ROW_BOOL, -1, data);
+		type = ir_row_type(MCC_IR_ROW_BOOL, -1);
 		break;
 	}
 
-	struct mcc_ir_row *row = new_row(lhs, rhs, instr, type, data);
-	append_row(row, data);
-
-	struct mcc_ir_arg *arg = mcc_ir_new_arg(row, data);
-	return arg;
+	return new_arg_row(append_row(lhs, rhs, instr, type, data));
 }
 
-struct mcc_ir_arg *mcc_ir_generate_expression_unary_op(struct mcc_ast_expression *expression,
-                                                       struct ir_generation_userdata *data)
+// Appends the row of a unary operation whose operand is evaluated
+static struct mcc_ir_arg
+unary_op_row(struct mcc_ast_expression *expression, struct mcc_ir_arg child, struct ir_generation_userdata *data)
 {
-	assert(expression->child);
-	assert(data);
-
-	struct mcc_ir_arg *child = mcc_ir_generate_expression(expression->child, data);
-	enum mcc_ir_instruction instr = MCC_IR_INSTR_UNKNOWN;
-	struct mcc_ir_row_type *type = NULL;
 	if (data->has_failed)
-		return NULL;
+		return no_arg;
 
+	enum mcc_ir_instruction instr = MCC_IR_INSTR_UNKNOWN;
+	struct mcc_ir_row_type type = typeless();
 	switch (expression->u_op) {
 	case MCC_AST_UNARY_OP_NEGATIV:
 		instr = MCC_IR_INSTR_NEGATIV;
-		type = get_type_of_row(child, expression->child, data);
+		type = get_type_of_row(&child, expression->child, data);
 		break;
 	case MCC_AST_UNARY_OP_NOT:
 		instr = MCC_IR_INSTR_NOT;
-		type = new_ir_row_type(MCC_IR_ROW_BOOL, -1, data);
+		type = ir_row_type(MCC_IR_ROW_BOOL, -1);
 		break;
 	}
 
-	struct mcc_ir_row *row = new_row(child, NULL, instr, type, data);
-	append_row(row, data);
-	struct mcc_ir_arg *arg = mcc_ir_new_arg(row, data);
+	return new_arg_row(append_row(child, no_arg, instr, type, data));
+}
+
+static bool is_string_literal(struct mcc_ast_expression *expression)
+{
+	return expression->type == MCC_AST_EXPRESSION_TYPE_LITERAL &&
+	       expression->literal->type == MCC_AST_LITERAL_TYPE_STRING;
+}
+
+// Assigns a string literal that is passed as argument to a new temporary and returns the temporary
+static struct mcc_ir_arg string_argument(struct mcc_ast_expression *expression, struct ir_generation_userdata *data)
+{
+	char *tmp = new_tmp_identifier(data);
+	struct mcc_ir_arg lit = mcc_ir_generate_arg_lit(expression->literal, data);
+	if (data->has_failed)
+		return no_arg;
+
+	struct mcc_ir_arg arg = new_arg_identifier_from_string(tmp);
+	append_row(arg, lit, MCC_IR_INSTR_ASSIGN, ir_row_type(MCC_IR_ROW_STRING, -1), data);
 	return arg;
 }
 
-struct mcc_ir_arg *mcc_ir_generate_expression_var(struct mcc_ast_expression *expression,
-                                                  struct ir_generation_userdata *data)
+// Pushes the evaluated arguments, the last one first. They are pushed after all of them are evaluated, in order to
+// have all push-instructions following each other without other instructions in between.
+static void push_arguments(struct mcc_ast_arguments *arguments,
+                           struct mcc_ir_arg *values,
+                           struct ir_generation_userdata *data)
+{
+	for (unsigned i = arguments->num_arguments; i-- > 0;) {
+		struct mcc_ast_expression *expression = arguments->expressions[i];
+		struct mcc_ir_row_type type = is_string_literal(expression) ? ir_row_type(MCC_IR_ROW_STRING, -1)
+		                                                            : get_type_of_row(&values[i], expression, data);
+		append_row(values[i], no_arg, MCC_IR_INSTR_PUSH, type, data);
+	}
+}
+
+// Appends the call of a function whose arguments are pushed
+static struct mcc_ir_arg call_row(struct mcc_ast_expression *expression, struct ir_generation_userdata *data)
+{
+	if (data->has_failed)
+		return no_arg;
+
+	struct mcc_ir_arg arg = mcc_ir_new_arg(expression->function_identifier);
+	struct mcc_ir_row_type type = get_type_of_row(&arg, expression, data);
+	return new_arg_row(append_row(arg, no_arg, MCC_IR_INSTR_CALL, type, data));
+}
+
+struct mcc_ir_arg mcc_ir_generate_expression_binary_op(struct mcc_ast_expression *expression,
+                                                       struct ir_generation_userdata *data)
+{
+	assert(expression->type == MCC_AST_EXPRESSION_TYPE_BINARY_OP);
+	return mcc_ir_generate_expression(expression, data);
+}
+
+struct mcc_ir_arg mcc_ir_generate_expression_unary_op(struct mcc_ast_expression *expression,
+                                                      struct ir_generation_userdata *data)
+{
+	assert(expression->type == MCC_AST_EXPRESSION_TYPE_UNARY_OP);
+	return mcc_ir_generate_expression(expression, data);
+}
+
+struct mcc_ir_arg mcc_ir_generate_expression_var(struct mcc_ast_expression *expression,
+                                                 struct ir_generation_userdata *data)
 {
 	assert(expression->identifier);
 	assert(data);
 	if (data->has_failed)
-		return NULL;
+		return no_arg;
 
-	struct mcc_ir_arg *arg = mcc_ir_new_arg(expression->identifier, data);
-	return arg;
+	return mcc_ir_new_arg(expression->identifier);
 }
 
 void mcc_ir_generate_arguments(struct mcc_ast_arguments *arguments, struct ir_generation_userdata *data)
 {
 	assert(data);
 	assert(arguments);
-	if (data->has_failed)
+	if (data->has_failed || arguments->num_arguments == 0)
 		return;
 
-	if (!arguments->is_empty) {
-		if (arguments->expression->type == MCC_AST_EXPRESSION_TYPE_LITERAL &&
-		    arguments->expression->literal->type == MCC_AST_LITERAL_TYPE_STRING) {
-			unsigned size = 5 + length_of_int(data->tmp_counter);
-			char tmp[size];
-			snprintf(tmp, size, "$tmp%d", data->tmp_counter);
-			data->tmp_counter += 1;
-			struct mcc_ir_arg *lit = mcc_ir_generate_expression(arguments->expression, data);
-			if (!lit)
-				return;
-			struct mcc_ir_row_type *type1 = get_type_of_row(lit, arguments->expression, data);
-			struct mcc_ir_row_type *type2 = get_type_of_row(lit, arguments->expression, data);
-			struct mcc_ir_arg *ident1 = new_arg_identifier_from_string(tmp, data);
-			struct mcc_ir_arg *ident2 = new_arg_identifier_from_string(tmp, data);
-			struct mcc_ir_row *row1 = NULL, *row2 = NULL;
-			row1 = new_row(ident1, lit, MCC_IR_INSTR_ASSIGN, type1, data);
-			append_row(row1, data);
-			// recursive call of mcc_ir_generate_arguments in order to have all push-instructions following
-			// each other without othre instructions in between
-			if (arguments->next_arguments) {
-				mcc_ir_generate_arguments(arguments->next_arguments, data);
-			}
-			row2 = new_row(ident2, NULL, MCC_IR_INSTR_PUSH, type2, data);
-			append_row(row2, data);
-		} else {
-			struct mcc_ir_arg *arg_push = mcc_ir_generate_expression(arguments->expression, data);
-			if (!arg_push)
-				return;
-			struct mcc_ir_row_type *type = get_type_of_row(arg_push, arguments->expression, data);
-			// recursive call of mcc_ir_generate_arguments in order to have all push-instructions following
-			// each other without othre instructions in between
-			if (arguments->next_arguments) {
-				mcc_ir_generate_arguments(arguments->next_arguments, data);
-			}
-			struct mcc_ir_row *row = new_row(arg_push, NULL, MCC_IR_INSTR_PUSH, type, data);
-			append_row(row, data);
-		}
+	struct mcc_ir_arg *values = malloc(sizeof(*values) * arguments->num_arguments);
+	if (!values) {
+		data->has_failed = true;
+		return;
+	}
+
+	for (unsigned i = 0; i < arguments->num_arguments && !data->has_failed; i++) {
+		struct mcc_ast_expression *expression = arguments->expressions[i];
+		values[i] = is_string_literal(expression) ? string_argument(expression, data)
+		                                          : mcc_ir_generate_expression(expression, data);
 	}
+	if (!data->has_failed)
+		push_arguments(arguments, values, data);
+	free(values);
 }
 
-struct mcc_ir_arg *mcc_ir_generate_expression_func_call(struct mcc_ast_expression *expression,
-                                                        struct ir_generation_userdata *data)
+struct mcc_ir_arg mcc_ir_generate_expression_func_call(struct mcc_ast_expression *expression,
+                                                       struct ir_generation_userdata *data)
 {
-	assert(expression->function_identifier);
-	assert(data);
-	if (data->has_failed)
-		return NULL;
+	assert(expression->type == MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL);
+	return mcc_ir_generate_expression(expression, data);
+}
 
-	mcc_ir_generate_arguments(expression->arguments, data);
+enum expression_step {
+	// Evaluate the expression and push its value
+	STEP_EVALUATE,
+	// Evaluate an argument of a function call and push its value
+	STEP_ARGUMENT,
+	// Pop the values of the evaluated operands and push the value of the expression
+	STEP_COMBINE,
+};
 
-	struct mcc_ir_arg *arg = mcc_ir_new_arg(expression->function_identifier, data);
-	if (!arg)
-		return NULL;
-	struct mcc_ir_row_type *type = get_type_of_row(arg, expression, data);
-	struct mcc_ir_row *row = new_row(arg, NULL, MCC_IR_INSTR_CALL, type, data);
-	append_row(row, data);
-	return mcc_ir_new_arg(row, data);
+struct expression_frame {
+	enum expression_step step;
+	struct mcc_ast_expression *expression;
+};
+
+// Steps that are left to do, the next one on top, and the values of the evaluated operands. Expressions are lowered
+// with them instead of recursion, so that long chains of operations do not overflow the C stack.
+struct expression_stacks {
+	struct mcc_stack frames;
+	struct mcc_stack values;
+};
+
+static void push_frame(struct expression_stacks *stacks,
+                       enum expression_step step,
+                       struct mcc_ast_expression *expression,
+                       struct ir_generation_userdata *data)
+{
+	struct expression_frame frame = {step, expression};
+	if (!mcc_stack_push(&stacks->frames, &frame))
+		data->has_failed = true;
 }
 
-struct mcc_ir_arg *mcc_ir_generate_expression(struct mcc_ast_expression *expression,
-                                              struct ir_generation_userdata *data)
+static void push_value(struct expression_stacks *stacks, struct mcc_ir_arg value, struct ir_generation_userdata *data)
 {
-	assert(expression);
-	assert(data);
-	if (data->has_failed)
-		return NULL;
+	if (!mcc_stack_push(&stacks->values, &value))
+		data->has_failed = true;
+}
 
-	struct mcc_ir_arg *arg = NULL;
+static struct mcc_ir_arg pop_value(struct expression_stacks *stacks)
+{
+	struct mcc_ir_arg value;
+	mcc_stack_pop(&stacks->values, &value);
+	return value;
+}
+
+// Pushes the value of a leaf or the steps that evaluate the operands of an expression and then combine them
+static void evaluate_step(struct expression_stacks *stacks,
+                          struct expression_frame frame,
+                          struct ir_generation_userdata *data)
+{
+	struct mcc_ast_expression *expression = frame.expression;
+	if (frame.step == STEP_ARGUMENT && is_string_literal(expression)) {
+		push_value(stacks, string_argument(expression, data), data);
+		return;
+	}
 
 	switch (expression->type) {
 	case MCC_AST_EXPRESSION_TYPE_LITERAL:
-		arg = mcc_ir_generate_arg_lit(expression->literal, data);
-		break;
+		push_value(stacks, mcc_ir_generate_arg_lit(expression->literal, data), data);
+		return;
+	case MCC_AST_EXPRESSION_TYPE_VARIABLE:
+		push_value(stacks, mcc_ir_generate_expression_var(expression, data), data);
+		return;
 	case MCC_AST_EXPRESSION_TYPE_BINARY_OP:
-		arg = mcc_ir_generate_expression_binary_op(expression, data);
-		break;
-	case MCC_AST_EXPRESSION_TYPE_PARENTH:
-		arg = mcc_ir_generate_expression(expression->expression, data);
-		break;
+		push_frame(stacks, STEP_COMBINE, expression, data);
+		push_frame(stacks, STEP_EVALUATE, expression->rhs, data);
+		push_frame(stacks, STEP_EVALUATE, expression->lhs, data);
+		return;
 	case MCC_AST_EXPRESSION_TYPE_UNARY_OP:
-		arg = mcc_ir_generate_expression_unary_op(expression, data);
-		break;
-	case MCC_AST_EXPRESSION_TYPE_VARIABLE:
-		arg = mcc_ir_generate_expression_var(expression, data);
-		break;
+		push_frame(stacks, STEP_COMBINE, expression, data);
+		push_frame(stacks, STEP_EVALUATE, expression->child, data);
+		return;
 	case MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT:
-		arg = new_arg_arr_elem(expression->array_identifier,
-		                       mcc_ir_generate_expression(expression->index, data), data);
-		break;
+		push_frame(stacks, STEP_COMBINE, expression, data);
+		push_frame(stacks, STEP_EVALUATE, expression->index, data);
+		return;
 	case MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL:
-		arg = mcc_ir_generate_expression_func_call(expression, data);
+		push_frame(stacks, STEP_COMBINE, expression, data);
+		for (unsigned i = expression->arguments->num_arguments; i-- > 0;) {
+			push_frame(stacks, STEP_ARGUMENT, expression->arguments->expressions[i], data);
+		}
+		return;
+	}
+}
+
+// Replaces the values of the operands of an expression with its value
+static void combine_step(struct expression_stacks *stacks,
+                         struct mcc_ast_expression *expression,
+                         struct ir_generation_userdata *data)
+{
+	switch (expression->type) {
+	case MCC_AST_EXPRESSION_TYPE_BINARY_OP: {
+		struct mcc_ir_arg rhs = pop_value(stacks);
+		struct mcc_ir_arg lhs = pop_value(stacks);
+		push_value(stacks, binary_op_row(expression, lhs, rhs, data), data);
+		return;
+	}
+	case MCC_AST_EXPRESSION_TYPE_UNARY_OP: {
+		struct mcc_ir_arg child = pop_value(stacks);
+		push_value(stacks, unary_op_row(expression, child, data), data);
+		return;
+	}
+	case MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT: {
+		struct mcc_ir_arg index = pop_value(stacks);
+		push_value(stacks, new_arg_arr_elem(expression->array_identifier, index, data), data);
+		return;
+	}
+	case MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL: {
+		struct mcc_ir_arg *arguments = mcc_stack_drop(&stacks->values, expression->arguments->num_arguments);
+		push_arguments(expression->arguments, arguments, data);
+		push_value(stacks, call_row(expression, data), data);
+		return;
+	}
+	default:
+		return;
+	}
+}
+
+struct mcc_ir_arg mcc_ir_generate_expression(struct mcc_ast_expression *expression,
+                                             struct ir_generation_userdata *data)
+{
+	assert(expression);
+	assert(data);
+	if (data->has_failed)
+		return no_arg;
+
+	// Leaves do not need the stacks
+	switch (expression->type) {
+	case MCC_AST_EXPRESSION_TYPE_LITERAL:
+		return mcc_ir_generate_arg_lit(expression->literal, data);
+	case MCC_AST_EXPRESSION_TYPE_VARIABLE:
+		return mcc_ir_generate_expression_var(expression, data);
+	default:
 		break;
 	}
-	return arg;
+
+	struct expression_frame initial_frames[MCC_STACK_INITIAL_CAPACITY];
+	struct mcc_ir_arg initial_values[MCC_STACK_INITIAL_CAPACITY];
+	struct expression_stacks stacks;
+	mcc_stack_init(&stacks.frames, initial_frames, MCC_STACK_INITIAL_CAPACITY, sizeof(*initial_frames));
+	mcc_stack_init(&stacks.values, initial_values, MCC_STACK_INITIAL_CAPACITY, sizeof(*initial_values));
+
+	push_frame(&stacks, STEP_EVALUATE, expression, data);
+	while (stacks.frames.size > 0 && !data->has_failed) {
+		struct expression_frame frame;
+		mcc_stack_pop(&stacks.frames, &frame);
+		if (frame.step == STEP_COMBINE)
+			combine_step(&stacks, frame.expression, data);
+		else
+			evaluate_step(&stacks, frame, data);
+	}
+
+	struct mcc_ir_arg value = no_arg;
+	if (!data->has_failed) {
+		assert(stacks.values.size == 1);
+		value = pop_value(&stacks);
+	}
+	mcc_stack_delete(&stacks.frames);
+	mcc_stack_delete(&stacks.values);
+	return value;
 }
 
 void mcc_ir_generate_comp_statement(struct mcc_ast_compound_statement *cmp_stmt, struct ir_generation_userdata *data)
@@ -780,10 +753,8 @@ void mcc_ir_generate_comp_statement(struct mcc_ast_compound_statement *cmp_stmt,
 	if (data->has_failed)
 		return;
 
-	while (cmp_stmt) {
-		if (!cmp_stmt->is_empty)
-			mcc_ir_generate_statement(cmp_stmt->statement, data);
-		cmp_stmt = cmp_stmt->next_compound_statement;
+	for (unsigned i = 0; i < cmp_stmt->num_statements; i++) {
+		mcc_ir_generate_statement(cmp_stmt->statements[i], data);
 	}
 }
 
@@ -794,39 +765,36 @@ void mcc_ir_generate_assignment(struct mcc_ast_assignment *asgn, struct ir_gener
 	if (data->has_failed)
 		return;
 
-	struct mcc_ir_arg *identifier = NULL, *exp = NULL;
-	struct mcc_ir_row *row = NULL;
+	struct mcc_ir_arg identifier, exp;
 	struct mcc_symbol_table_row *st_row = NULL;
-	struct mcc_ir_row_type *type = NULL;
+	struct mcc_ir_row_type type;
 	if (asgn->assignment_type == MCC_AST_ASSIGNMENT_TYPE_VARIABLE) {
 		st_row = mcc_symbol_table_check_upwards_for_declaration(asgn->variable_identifier->identifier_name,
 		                                                        asgn->row);
-		type = st_row_to_ir_type(st_row, -1, data);
-		identifier = mcc_ir_new_arg(asgn->variable_identifier, data);
+		type = st_row_to_ir_type(st_row, -1);
+		identifier = mcc_ir_new_arg(asgn->variable_identifier);
 		// if float literal do not generate expression, because it will generate unneseccary extra line
 		if (asgn->variable_assigned_value->type == MCC_AST_EXPRESSION_TYPE_LITERAL &&
 		    asgn->variable_assigned_value->literal->type == MCC_AST_LITERAL_TYPE_FLOAT) {
-			exp = new_arg_float(asgn->variable_assigned_value->literal->f_value, data);
+			exp = new_arg_float(asgn->variable_assigned_value->literal->f_value);
 		} else {
 			exp = mcc_ir_generate_expression(asgn->variable_assigned_value, data);
 		}
-		row = new_row(identifier, exp, MCC_IR_INSTR_ASSIGN, type, data);
 	} else {
 		st_row =
 		    mcc_symbol_table_check_upwards_for_declaration(asgn->array_identifier->identifier_name, asgn->row);
-		type = st_row_to_ir_type(st_row, -1, data);
-		struct mcc_ir_arg *index = mcc_ir_generate_expression(asgn->array_index, data);
+		type = st_row_to_ir_type(st_row, -1);
+		struct mcc_ir_arg index = mcc_ir_generate_expression(asgn->array_index, data);
 		identifier = new_arg_arr_elem(asgn->array_identifier, index, data);
 		// if float literal do not generate expression, because it will generate unneseccary extra line
 		if (asgn->array_assigned_value->type == MCC_AST_EXPRESSION_TYPE_LITERAL &&
 		    asgn->array_assigned_value->literal->type == MCC_AST_LITERAL_TYPE_FLOAT) {
-			exp = new_arg_float(asgn->array_assigned_value->literal->f_value, data);
+			exp = new_arg_float(asgn->array_assigned_value->literal->f_value);
 		} else {
 			exp = mcc_ir_generate_expression(asgn->array_assigned_value, data);
 		}
-		row = new_row(identifier, exp, MCC_IR_INSTR_ASSIGN, type, data);
 	}
-	append_row(row, data);
+	append_row(identifier, exp, MCC_IR_INSTR_ASSIGN, type, data);
 }
 
 void mcc_ir_generate_statememt_while_stmt(struct mcc_ast_statement *stmt, struct ir_generation_userdata *data)
@@ -835,28 +803,24 @@ void mcc_ir_generate_statememt_while_stmt(struct mcc_ast_statement *stmt, struct
 		return;
 
 	// L0
-	struct mcc_ir_arg *l0 = new_arg_label(data);
-	struct mcc_ir_row *label_row = new_row(l0, NULL, MCC_IR_INSTR_LABEL, typeless(data), data);
-	append_row(label_row, data);
+	struct mcc_ir_arg l0 = new_arg_label(data);
+	append_row(l0, no_arg, MCC_IR_INSTR_LABEL, typeless(), data);
 
 	// Condition
-	struct mcc_ir_arg *cond = mcc_ir_generate_expression(stmt->if_condition, data);
+	struct mcc_ir_arg cond = mcc_ir_generate_expression(stmt->if_condition, data);
 
 	// Jumpfalse L1
-	struct mcc_ir_arg *l1 = new_arg_label(data);
-	struct mcc_ir_row *jumpfalse = new_row(cond, l1, MCC_IR_INSTR_JUMPFALSE, typeless(data), data);
-	append_row(jumpfalse, data);
+	struct mcc_ir_arg l1 = new_arg_label(data);
+	append_row(cond, l1, MCC_IR_INSTR_JUMPFALSE, typeless(), data);
 
 	// On true
 	mcc_ir_generate_statement(stmt->while_on_true, data);
 
 	// Jump L0
-	struct mcc_ir_row *jump_row = new_row(copy_arg(l0, data), NULL, MCC_IR_INSTR_JUMP, typeless(data), data);
-	append_row(jump_row, data);
+	append_row(l0, no_arg, MCC_IR_INSTR_JUMP, typeless(), data);
 
 	// Label L1
-	struct mcc_ir_row *label_row_2 = new_row(copy_arg(l1, data), NULL, MCC_IR_INSTR_LABEL, typeless(data), data);
-	append_row(label_row_2, data);
+	append_row(l1, no_arg, MCC_IR_INSTR_LABEL, typeless(), data);
 }
 
 void mcc_ir_generate_statememt_if_else_stmt(struct mcc_ast_statement *stmt, struct ir_generation_userdata *data)
@@ -865,44 +829,33 @@ void mcc_ir_generate_statememt_if_else_stmt(struct mcc_ast_statement *stmt, stru
 		return;
 
 	// Condition
-	struct mcc_ir_arg *cond = mcc_ir_generate_expression(stmt->if_condition, data);
+	struct mcc_ir_arg cond = mcc_ir_generate_expression(stmt->if_condition, data);
 
 	// Jumpfalse L1
-	struct mcc_ir_arg *l1 = new_arg_label(data);
-	if (!l1)
-		return;
-	struct mcc_ir_row *jumpfalse = new_row(cond, l1, MCC_IR_INSTR_JUMPFALSE, typeless(data), data);
-	append_row(jumpfalse, data);
+	struct mcc_ir_arg l1 = new_arg_label(data);
+	append_row(cond, l1, MCC_IR_INSTR_JUMPFALSE, typeless(), data);
 
 	// If true
 	mcc_ir_generate_statement(stmt->if_else_on_true, data);
 
-	struct mcc_ir_arg *l2 = new_arg_label(data);
-	if (!l2)
-		return;
+	struct mcc_ir_arg l2 = new_arg_label(data);
 	bool if_ends_on_return = false;
-	if (data->current->instr != MCC_IR_INSTR_RETURN) {
+	if (last_instr(data) != MCC_IR_INSTR_RETURN) {
 		// Jump L2
-		struct mcc_ir_row *jump_row = new_row(l2, NULL, MCC_IR_INSTR_JUMP, typeless(data), data);
-		append_row(jump_row, data);
+		append_row(l2, no_arg, MCC_IR_INSTR_JUMP, typeless(), data);
 	} else {
 		if_ends_on_return = true;
 	}
 
 	// Label L1
-	struct mcc_ir_row *label_row = new_row(copy_arg(l1, data), NULL, MCC_IR_INSTR_LABEL, typeless(data), data);
-	append_row(label_row, data);
+	append_row(l1, no_arg, MCC_IR_INSTR_LABEL, typeless(), data);
 
 	// If false
 	mcc_ir_generate_statement(stmt->if_else_on_false, data);
 
-	if (data->current->instr != MCC_IR_INSTR_RETURN || !if_ends_on_return) {
+	if (last_instr(data) != MCC_IR_INSTR_RETURN || !if_ends_on_return) {
 		// Label L2
-		struct mcc_ir_row *label_row_2 =
-		    new_row(copy_arg(l2, data), NULL, MCC_IR_INSTR_LABEL, typeless(data), data);
-		append_row(label_row_2, data);
-	} else {
-		mcc_ir_delete_ir_arg(l2);
+		append_row(l2, no_arg, MCC_IR_INSTR_LABEL, typeless(), data);
 	}
 }
 
@@ -910,15 +863,11 @@ void mcc_ir_generate_statememt_if_stmt(struct mcc_ast_statement *stmt, struct ir
 {
 	if (data->has_failed)
 		return;
-	struct mcc_ir_arg *cond = mcc_ir_generate_expression(stmt->if_condition, data);
-	struct mcc_ir_arg *label = new_arg_label(data);
-	if (!label)
-		return;
-	struct mcc_ir_row *jumpfalse = new_row(cond, label, MCC_IR_INSTR_JUMPFALSE, typeless(data), data);
-	append_row(jumpfalse, data);
+	struct mcc_ir_arg cond = mcc_ir_generate_expression(stmt->if_condition, data);
+	struct mcc_ir_arg label = new_arg_label(data);
+	append_row(cond, label, MCC_IR_INSTR_JUMPFALSE, typeless(), data);
 	mcc_ir_generate_statement(stmt->if_on_true, data);
-	struct mcc_ir_row *label_row = new_row(copy_arg(label, data), NULL, MCC_IR_INSTR_LABEL, typeless(data), data);
-	append_row(label_row, data);
+	append_row(label, no_arg, MCC_IR_INSTR_LABEL, typeless(), data);
 }
 
 void mcc_ir_generate_statement_return(struct mcc_ast_statement *stmt, struct ir_generation_userdata *data)
@@ -929,20 +878,18 @@ void mcc_ir_generate_statement_return(struct mcc_ast_statement *stmt, struct ir_
 	if (data->has_failed)
 		return;
 
-	if (data->current->instr == MCC_IR_INSTR_RETURN) {
+	if (last_instr(data) == MCC_IR_INSTR_RETURN) {
 		return;
 	}
 
 	if (stmt->return_value) {
-		struct mcc_ir_arg *exp = mcc_ir_generate_expression(stmt->return_value, data);
-		if (!exp)
+		struct mcc_ir_arg exp = mcc_ir_generate_expression(stmt->return_value, data);
+		if (data->has_failed)
 			return;
-		struct mcc_ir_row_type *type = get_type_of_row(exp, stmt->return_value, data);
-		struct mcc_ir_row *row = new_row(exp, NULL, MCC_IR_INSTR_RETURN, type, data);
-		append_row(row, data);
+		struct mcc_ir_row_type type = get_type_of_row(&exp, stmt->return_value, data);
+		append_row(exp, no_arg, MCC_IR_INSTR_RETURN, type, data);
 	} else {
-		struct mcc_ir_row *row = new_row(NULL, NULL, MCC_IR_INSTR_RETURN, typeless(data), data);
-		append_row(row, data);
+		append_row(no_arg, no_arg, MCC_IR_INSTR_RETURN, typeless(), data);
 	}
 }
 
@@ -954,61 +901,39 @@ void mcc_ir_generate_declaration(struct mcc_ast_declaration *decl, struct ir_gen
 	if (data->has_failed)
 		return;
 
-	struct mcc_ir_arg *arg1 = NULL, *arg2 = NULL;
-	struct mcc_ir_row *row = NULL;
 	// Only arrays and floats need an extra IR line for declaration
-	if (data->has_failed ||
-	    (decl->declaration_type == MCC_AST_DECLARATION_TYPE_VARIABLE && decl->variable_type->type_value != FLOAT)) {
+	if (decl->declaration_type == MCC_AST_DECLARATION_TYPE_VARIABLE && decl->variable_type->type_value != FLOAT) {
 		return;
 	} else if (decl->variable_type->type_value == FLOAT) {
-		arg1 = mcc_ir_new_arg(decl->variable_identifier, data);
-		arg2 = mcc_ir_new_arg((double)0.0, data);
-		row = new_row(arg1, arg2, MCC_IR_INSTR_ASSIGN, new_ir_row_type(MCC_IR_ROW_FLOAT, -1, data), data);
+		struct mcc_ir_arg arg1 = mcc_ir_new_arg(decl->variable_identifier);
+		struct mcc_ir_arg arg2 = mcc_ir_new_arg((double)0.0);
+		append_row(arg1, arg2, MCC_IR_INSTR_ASSIGN, ir_row_type(MCC_IR_ROW_FLOAT, -1), data);
 	} else {
-		arg1 = mcc_ir_new_arg(decl->array_identifier, data);
-		arg2 = mcc_ir_generate_arg_lit(decl->array_size, data);
+		struct mcc_ir_arg arg1 = mcc_ir_new_arg(decl->array_identifier);
+		struct mcc_ir_arg arg2 = mcc_ir_generate_arg_lit(decl->array_size, data);
 
-		struct mcc_ir_row_type *type = st_row_to_ir_type(decl->row, (int)decl->array_size->i_value, data);
+		struct mcc_ir_row_type type = st_row_to_ir_type(decl->row, (int)decl->array_size->i_value);
 		switch (decl->array_type->type_value) {
 		case INT:
-			row = new_row(arg1, arg2, MCC_IR_INSTR_ARRAY, type, data);
-			break;
 		case FLOAT:
-			row = new_row(arg1, arg2, MCC_IR_INSTR_ARRAY, type, data);
-			break;
 		case STRING:
-			row = new_row(arg1, arg2, MCC_IR_INSTR_ARRAY, type, data);
-			break;
 		case BOOL:
-			row = new_row(arg1, arg2, MCC_IR_INSTR_ARRAY, type, data);
+			append_row(arg1, arg2, MCC_IR_INSTR_ARRAY, type, data);
 			break;
 		case VOID:
-			mcc_ir_delete_ir_arg(arg1);
-			mcc_ir_delete_ir_arg(arg2);
 			data->has_failed = true;
-			return;
+			break;
 		}
 	}
-
-	if (!arg1 || !arg2 || !row) {
-		mcc_ir_delete_ir_arg(arg1);
-		mcc_ir_delete_ir_arg(arg2);
-		mcc_ir_delete_ir_row(row);
-		data->has_failed = true;
-		return;
-	}
-
-	append_row(row, data);
 }
 
 void mcc_ir_generate_statement(struct mcc_ast_statement *stmt, struct ir_generation_userdata *data)
 {
 	if (data->has_failed)
 		return;
-	struct mcc_ir_arg *arg = NULL;
 	switch (stmt->type) {
 	case MCC_AST_STATEMENT_TYPE_EXPRESSION:
-		arg = mcc_ir_generate_expression(stmt->stmt_expression, data);
+		mcc_ir_generate_expression(stmt->stmt_expression, data);
 		break;
 	case MCC_AST_STATEMENT_TYPE_COMPOUND_STMT:
 		mcc_ir_generate_comp_statement(stmt->compound_statement, data);
@@ -1034,7 +959,6 @@ void mcc_ir_generate_statement(struct mcc_ast_statement *stmt, struct ir_generat
 	default:
 		break;
 	}
-	mcc_ir_delete_ir_arg(arg);
 }
 
 void mcc_ir_generate_program(struct mcc_ast_program *program, struct ir_generation_userdata *data)
@@ -1053,30 +977,22 @@ void mcc_ir_generate_function_definition(struct mcc_ast_function_definition *def
 		return;
 
 	// Function Label
-	struct mcc_ir_arg *func_label = new_arg_func_label(def, data);
-	struct mcc_ir_row *label_row = new_row(func_label, NULL, MCC_IR_INSTR_FUNC_LABEL, typeless(data), data);
-	append_row(label_row, data);
+	append_row(new_arg_func_label(def), no_arg, MCC_IR_INSTR_FUNC_LABEL, typeless(), data);
 
 	// Pop args and assign them
 	struct mcc_ast_parameters *pars = def->parameters;
 
-	while (pars && !pars->is_empty) {
+	for (unsigned i = 0; i < pars->num_parameters; i++) {
+		struct mcc_ast_declaration *par = pars->declarations[i];
 		int size = -1;
-		if (pars->declaration->declaration_type == MCC_AST_DECLARATION_TYPE_ARRAY) {
-			size = (int)pars->declaration->array_size->i_value;
+		if (par->declaration_type == MCC_AST_DECLARATION_TYPE_ARRAY) {
+			size = (int)par->array_size->i_value;
 		}
+		struct mcc_ir_row_type type = st_row_to_ir_type(par->row, size);
 		// Pop arg
-		struct mcc_ir_row_type *type1 = st_row_to_ir_type(pars->declaration->row, size, data);
-		struct mcc_ir_row *pop_row = new_row(NULL, NULL, MCC_IR_INSTR_POP, type1, data);
-		append_row(pop_row, data);
-		struct mcc_ir_arg *pop_arg = new_arg_row(pop_row, data);
-
+		unsigned pop_row = append_row(no_arg, no_arg, MCC_IR_INSTR_POP, type, data);
 		// Assign it
-		struct mcc_ir_row_type *type2 = st_row_to_ir_type(pars->declaration->row, size, data);
-		struct mcc_ir_arg *var = arg_from_declaration(pars->declaration, data);
-		struct mcc_ir_row *assign = new_row(var, pop_arg, MCC_IR_INSTR_ASSIGN, type2, data);
-		append_row(assign, data);
-		pars = pars->next_parameters;
+		append_row(arg_from_declaration(par), new_arg_row(pop_row), MCC_IR_INSTR_ASSIGN, type, data);
 	}
 
 	// Function body
@@ -1085,91 +1001,132 @@ void mcc_ir_generate_function_definition(struct mcc_ast_function_definition *def
 
 // --------------------------------------------------------------------------------------- Variable shadowing
 
+// A declaration that shadows a declaration of an enclosing scope is renamed to $rN, numbered in the order of the
+// modifying visitor. The AST is traversed once: every identifier is bound to the row of its declaration by a lookup in
+// the symbol table. Names are only changed after the traversal, so that all lookups see the original names.
+
+// Identifier and the row of its declaration
+struct binding {
+	struct mcc_ast_identifier *ident;
+	struct mcc_symbol_table_row *row;
+};
+
 // struct for user data concerning variable shadowing
 struct renaming_userdata {
 	struct ir_generation_userdata *ir_data;
 	int num;
-	struct mcc_ast_identifier *ident;
+	// Row of a shadowing declaration -> interned new name
+	struct mcc_hash_map *renamed_rows;
+	// Rows of shadowing declarations in the order they were renamed
+	struct mcc_symbol_table_row **renamed_order;
+	size_t num_renamed;
+	size_t renamed_capacity;
+	struct binding *bindings;
+	size_t num_bindings;
+	size_t bindings_capacity;
 };
 
-static void rename_row(struct mcc_symbol_table_row *row, struct renaming_userdata *data)
+// Interned name for the current renaming
+static char *get_renamed_name(struct renaming_userdata *data)
 {
-	assert(row);
-	assert(data);
-
-	size_t size = 3 + length_of_int(data->num);
-	row->name = (char *)realloc(row->name, size);
-	if (!row->name) {
+	char name[32];
+	snprintf(name, sizeof(name), "$r%d", data->num);
+	char *interned = mcc_intern(name);
+	if (!interned)
 		data->ir_data->has_failed = true;
-		return;
-	}
-	snprintf(row->name, size, "$r%d", data->num);
+	return interned;
 }
 
-static void rename_ident(struct mcc_ast_identifier *ident, struct renaming_userdata *data)
+static void add_binding(struct mcc_ast_identifier *ident, struct mcc_symbol_table_row *row,
+                        struct renaming_userdata *data)
 {
 	assert(ident);
 	assert(data);
-	if (data->ir_data->has_failed)
+	if (data->ir_data->has_failed || !row)
 		return;
 
-	size_t size = 3 + length_of_int(data->num);
-	ident->identifier_name = (char *)realloc(ident->identifier_name, size);
-	if (!ident->identifier_name) {
-		data->ir_data->has_failed = true;
-		return;
+	if (data->num_bindings == data->bindings_capacity) {
+		size_t capacity = data->bindings_capacity ? 2 * data->bindings_capacity : 64;
+		struct binding *bindings = realloc(data->bindings, capacity * sizeof(*bindings));
+		if (!bindings) {
+			data->ir_data->has_failed = true;
+			return;
+		}
+		data->bindings = bindings;
+		data->bindings_capacity = capacity;
 	}
-	snprintf(ident->identifier_name, size, "$r%d", data->num);
+	data->bindings[data->num_bindings].ident = ident;
+	data->bindings[data->num_bindings].row = row;
+	data->num_bindings++;
 }
 
-static void cb_rename_ident(struct mcc_ast_identifier *ident, void *data)
+// Records the new name of a shadowing declaration
+static bool add_renamed_row(struct mcc_symbol_table_row *row, char *name, struct renaming_userdata *data)
+{
+	if (data->num_renamed == data->renamed_capacity) {
+		size_t capacity = data->renamed_capacity ? 2 * data->renamed_capacity : 16;
+		struct mcc_symbol_table_row **rows = realloc(data->renamed_order, capacity * sizeof(*rows));
+		if (!rows)
+			return false;
+		data->renamed_order = rows;
+		data->renamed_capacity = capacity;
+	}
+	if (!mcc_hash_map_set(data->renamed_rows, row, name))
+		return false;
+	data->renamed_order[data->num_renamed++] = row;
+	return true;
+}
+
+// Binds an identifier used after the given row to its declaration
+static void bind_ident(struct mcc_ast_identifier *ident, struct mcc_symbol_table_row *row,
+                       struct renaming_userdata *data)
 {
 	assert(ident);
 	assert(data);
-	struct renaming_userdata *re_data = data;
-	if (re_data->ir_data->has_failed)
+	if (data->ir_data->has_failed || !row)
 		return;
-	if (strcmp(ident->identifier_name, re_data->ident->identifier_name) == 0) {
-		rename_ident(ident, re_data);
-	}
+
+	add_binding(ident, mcc_symbol_table_check_upwards_for_declaration(ident->identifier_name, row), data);
 }
 
-// Setup an AST Visitor for visiting declarations
-static struct mcc_ast_visitor rename_ident_visitor(struct renaming_userdata *data)
+static void cb_bind_variable(struct mcc_ast_expression *expression, void *data)
 {
-	return (struct mcc_ast_visitor){
-	    .order = MCC_AST_VISIT_PRE_ORDER,
+	assert(expression);
+	assert(data);
 
-	    .userdata = data,
+	bind_ident(expression->identifier, expression->variable_row, data);
+}
 
-	    .identifier = cb_rename_ident,
-	};
+static void cb_bind_array_element(struct mcc_ast_expression *expression, void *data)
+{
+	assert(expression);
+	assert(data);
+
+	bind_ident(expression->array_identifier, expression->array_row, data);
 }
 
-// callback of the modifying visitor. Checks if compound statement is a declaration, if so checks in symbol table if it
-// shadows a variable. If it does, all variables in the subtree of that compound statement become renamed
-static void cb_variable_shadowing(struct mcc_ast_compound_statement *comp_stmt, void *data)
+static void cb_bind_variable_assignment(struct mcc_ast_assignment *assignment, void *data)
 {
+	assert(assignment);
 	assert(data);
-	assert(comp_stmt);
-	struct renaming_userdata *re_data = data;
-	if (re_data->ir_data->has_failed)
-		return;
-	if (comp_stmt->is_empty || comp_stmt->statement->type != MCC_AST_STATEMENT_TYPE_DECLARATION)
-		return;
-	struct mcc_ast_declaration *decl = comp_stmt->statement->declaration;
+
+	bind_ident(assignment->variable_identifier, assignment->row, data);
+}
+
+static void cb_bind_array_assignment(struct mcc_ast_assignment *assignment, void *data)
+{
+	assert(assignment);
+	assert(data);
+
+	bind_ident(assignment->array_identifier, assignment->row, data);
+}
+
+// Checks in symbol table if a declaration shadows a variable. If it does, the declaration gets a new name, which is
+// applied to all identifiers bound to it by rename_bindings.
+static void rename_shadowing_declaration(struct mcc_ast_declaration *decl, struct renaming_userdata *re_data)
+{
 	struct mcc_symbol_table_row *row = decl->row;
 	struct mcc_symbol_table_row *prev = NULL;
-	// get previous row in symbol table
-	if (row->prev_row) {
-		prev = row->prev_row;
-	} else if (row->scope->parent_row) {
-		if (row->scope->parent_row->row_structure == MCC_SYMBOL_TABLE_ROW_STRUCTURE_FUNCTION) {
-			return;
-		} else {
-			prev = row->scope->parent_row;
-		}
-	}
 	// get identifier of declaration
 	struct mcc_ast_identifier *ident = NULL;
 	switch (decl->declaration_type) {
@@ -1180,20 +1137,67 @@ static void cb_variable_shadowing(struct mcc_ast_compound_statement *comp_stmt,
 		ident = decl->array_identifier;
 		break;
 	}
+	add_binding(ident, row, re_data);
+	// get previous row in symbol table
+	if (row->prev_row) {
+		prev = row->prev_row;
+	} else if (row->scope->parent_row) {
+		if (row->scope->parent_row->row_structure == MCC_SYMBOL_TABLE_ROW_STRUCTURE_FUNCTION) {
+			return;
+		} else {
+			prev = row->scope->parent_row;
+		}
+	}
 	// check if a row with same name exists upwards in the symbol table, if yes rename
-	prev = mcc_symbol_table_check_upwards_for_declaration(ident->identifier_name, prev);
-	if (prev) {
-		re_data->ident = ident;
-		if (comp_stmt->next_compound_statement) {
-			struct mcc_ast_visitor visitor = rename_ident_visitor(data);
-			mcc_ast_visit(comp_stmt->next_compound_statement, &visitor);
+	if (prev && mcc_symbol_table_check_upwards_for_declaration(ident->identifier_name, prev)) {
+		char *name = get_renamed_name(re_data);
+		if (!name)
+			return;
+		if (!add_renamed_row(row, name, re_data)) {
+			re_data->ir_data->has_failed = true;
+			return;
 		}
-		rename_ident(ident, re_data);
-		rename_row(row, re_data);
 		re_data->num += 1;
 	}
 }
 
+// callback of the modifying visitor. Checks the declarations of a compound statement for variable shadowing. They are
+// checked from last to first, so that the new names are numbered as before the statements were stored in an array.
+static void cb_variable_shadowing(struct mcc_ast_compound_statement *comp_stmt, void *data)
+{
+	assert(data);
+	assert(comp_stmt);
+	struct renaming_userdata *re_data = data;
+
+	for (unsigned i = comp_stmt->num_statements; i-- > 0 && !re_data->ir_data->has_failed;) {
+		struct mcc_ast_statement *stmt = comp_stmt->statements[i];
+		if (stmt->type == MCC_AST_STATEMENT_TYPE_DECLARATION)
+			rename_shadowing_declaration(stmt->declaration, re_data);
+	}
+}
+
+// Applies the new names of shadowing declarations to their rows and to all identifiers bound to them
+static void rename_bindings(struct renaming_userdata *data)
+{
+	assert(data);
+	if (data->ir_data->has_failed)
+		return;
+
+	for (size_t i = 0; i < data->num_bindings; i++) {
+		char *name = mcc_hash_map_get(data->renamed_rows, data->bindings[i].row);
+		if (name)
+			data->bindings[i].ident->identifier_name = name;
+	}
+
+	for (size_t i = 0; i < data->num_renamed; i++) {
+		struct mcc_symbol_table_row *row = data->renamed_order[i];
+		if (mcc_symbol_table_rename_row(row, mcc_hash_map_get(data->renamed_rows, row))) {
+			data->ir_data->has_failed = true;
+			return;
+		}
+	}
+}
+
 // --------------------------------------------------------------------------------------- append empty return
 
 static void append_empty_return(struct mcc_ast_compound_statement *comp_stmt, struct renaming_userdata *re_data)
@@ -1203,7 +1207,7 @@ static void append_empty_return(struct mcc_ast_compound_statement *comp_stmt, st
 	if (re_data->ir_data->has_failed) {
 		return;
 	}
-	struct mcc_ast_statement *stmt = malloc(sizeof(*stmt));
+	struct mcc_ast_statement *stmt = mcc_alloc(sizeof(*stmt));
 	if (!stmt) {
 		re_data->ir_data->has_failed = true;
 		return;
@@ -1211,17 +1215,10 @@ static void append_empty_return(struct mcc_ast_compound_statement *comp_stmt, st
 	stmt->type = MCC_AST_STATEMENT_TYPE_RETURN;
 	stmt->is_empty_return = true;
 	stmt->return_value = NULL;
-	struct mcc_ast_compound_statement *new_comp_stmt = malloc(sizeof(*new_comp_stmt));
-	if (!new_comp_stmt) {
+	if (!mcc_ast_add_statement(comp_stmt, stmt)) {
+		mcc_free(stmt);
 		re_data->ir_data->has_failed = true;
-		return;
 	}
-	new_comp_stmt->statement = stmt;
-	new_comp_stmt->is_empty = false;
-	new_comp_stmt->has_next_statement = false;
-	new_comp_stmt->next_compound_statement = NULL;
-	comp_stmt->has_next_statement = true;
-	comp_stmt->next_compound_statement = new_comp_stmt;
 }
 
 // callback to add an empty return statement to void functions where no empty return statement is present at the end of
@@ -1235,23 +1232,21 @@ static void cb_add_return(struct mcc_ast_function_definition *def, void *data)
 		return;
 
 	struct mcc_ast_compound_statement *comp_stmt = def->compound_stmt;
-	struct mcc_ast_compound_statement *prev_stmt = comp_stmt;
-	do {
-		if (!comp_stmt->is_empty && comp_stmt->statement->type == MCC_AST_STATEMENT_TYPE_RETURN) {
+	for (unsigned i = 0; i < comp_stmt->num_statements; i++) {
+		if (comp_stmt->statements[i]->type == MCC_AST_STATEMENT_TYPE_RETURN) {
 			return;
 		}
-		prev_stmt = comp_stmt;
-		comp_stmt = comp_stmt->next_compound_statement;
-	} while (comp_stmt);
+	}
 	if (def->type == VOID) {
-		append_empty_return(prev_stmt, data);
+		append_empty_return(comp_stmt, data);
 	}
 }
 
 // --------------------------------------------------------------------------------------- generate IR
 
 // Setup an AST Visitor for visiting compound statements with a statement of type declaration to ensure variable
-// shadowing and visit function definitions to add returns in void functions where needed
+// shadowing, binding identifiers to their declarations and visit function definitions to add returns in void
+// functions where needed
 static struct mcc_ast_visitor modifying_visitor(struct renaming_userdata *data)
 {
 	return (struct mcc_ast_visitor){
@@ -1261,6 +1256,11 @@ static struct mcc_ast_visitor modifying_visitor(struct renaming_userdata *data)
 
 	    .compound_statement = cb_variable_shadowing,
 	    .function_definition = cb_add_return,
+
+	    .expression_variable = cb_bind_variable,
+	    .expression_array_element = cb_bind_array_element,
+	    .variable_assignment = cb_bind_variable_assignment,
+	    .array_assignment = cb_bind_array_assignment,
 	};
 }
 
@@ -1278,104 +1278,130 @@ static void modify_ast(struct mcc_ast_program *ast, struct ir_generation_userdat
 	}
 	re_data->ir_data = ir_data;
 	re_data->num = 0;
+	re_data->bindings = NULL;
+	re_data->num_bindings = 0;
+	re_data->bindings_capacity = 0;
+	re_data->renamed_order = NULL;
+	re_data->num_renamed = 0;
+	re_data->renamed_capacity = 0;
+	re_data->renamed_rows = mcc_hash_map_new_pointer();
+	if (!re_data->renamed_rows) {
+		ir_data->has_failed = true;
+		free(re_data);
+		return;
+	}
 	struct mcc_ast_visitor visitor = modifying_visitor(re_data);
 	mcc_ast_visit(ast, &visitor);
+	rename_bindings(re_data);
+	mcc_hash_map_delete(re_data->renamed_rows);
+	free(re_data->renamed_order);
+	free(re_data->bindings);
 	free(re_data);
 }
 
-struct mcc_ir_row *mcc_ir_generate(struct mcc_ast_program *ast)
+bool mcc_ir_generate_prepare(struct mcc_ast_program *ast, struct ir_generation_userdata *data)
 {
-	struct ir_generation_userdata *data = malloc(sizeof(*data));
-	if (!data)
-		return NULL;
-	data->head = NULL;
+	assert(ast);
+	assert(data);
+
+	data->rows = NULL;
+	data->num_rows = 0;
+	data->capacity = 0;
 	data->has_failed = false;
-	data->current = NULL;
 	data->label_counter = 0;
 	data->tmp_counter = 0;
-
-	// remove all built_ins before creating the IR
-	ast = mcc_ast_remove_built_ins(ast);
+	data->row_counter = 0;
 
 	// Add return statements for void functions and enforce variable shadowing
 	modify_ast(ast, data);
-	if (data->has_failed) {
-		free(data);
-		return NULL;
-	}
+	return !data->has_failed;
+}
 
-	while (ast) {
-		mcc_ir_generate_program(ast, data);
-		ast = ast->next_function;
-	}
+// Copies the generated rows to a function of their exact size
+static struct mcc_ir_function *new_function(struct ir_generation_userdata *data)
+{
+	assert(data);
+	if (data->has_failed)
+		return NULL;
 
-	if (data->has_failed) {
-		mcc_ir_delete_ir(data->head);
-		free(data);
+	struct mcc_ir_function *function = mcc_alloc(sizeof(*function));
+	struct mcc_ir_row *rows = mcc_alloc(data->num_rows * sizeof(*rows));
+	if (!function || !rows) {
+		mcc_free(function);
+		mcc_free(rows);
+		data->has_failed = true;
 		return NULL;
 	}
-	struct mcc_ir_row *head = data->head;
-	free(data);
+	memcpy(rows, data->rows, data->num_rows * sizeof(*rows));
+	function->rows = rows;
+	function->num_rows = data->num_rows;
+	function->next = NULL;
 
 	// Set row numbers (used for naming temporaries in IR) for the visual representation
-	number_rows(head);
-	return head;
+	number_rows(function, data);
+	return function;
 }
 
-//---------------------------------------------------------------------------------------- Cleanup
-
-void mcc_ir_delete_ir_arg(struct mcc_ir_arg *arg)
+struct mcc_ir_function *mcc_ir_generate_function(struct mcc_ast_program *program,
+                                                 struct ir_generation_userdata *data)
 {
-	if (!arg)
-		return;
-	if (arg->type == MCC_IR_TYPE_FUNC_LABEL) {
-		free(arg->func_label);
-	}
-	if (arg->type == MCC_IR_TYPE_ARR_ELEM) {
-		mcc_ir_delete_ir_arg(arg->index);
-	}
-	if (arg->type == MCC_IR_TYPE_LIT_STRING) {
-		free(arg->lit_string);
-	}
-	if (arg->type == MCC_IR_TYPE_IDENTIFIER) {
-		free(arg->ident);
-	}
-	if (arg->type == MCC_IR_TYPE_ARR_ELEM) {
-		free(arg->arr_ident);
-	}
-	free(arg);
-}
+	assert(program);
+	assert(data);
+	if (data->has_failed)
+		return NULL;
 
-void mcc_ir_delete_ir_row_type(struct mcc_ir_row_type *type)
-{
-	if (!type)
-		return;
-	free(type);
+	data->num_rows = 0;
+	mcc_ir_generate_program(program, data);
+	return new_function(data);
 }
 
-void mcc_ir_delete_ir_row(struct mcc_ir_row *row)
+void mcc_ir_generate_finish(struct ir_generation_userdata *data)
 {
-	if (!row)
-		return;
-	mcc_ir_delete_ir_arg(row->arg1);
-	mcc_ir_delete_ir_arg(row->arg2);
-	mcc_ir_delete_ir_row_type(row->type);
-	free(row);
+	assert(data);
+	free(data->rows);
+	data->rows = NULL;
+	data->num_rows = 0;
+	data->capacity = 0;
 }
 
-void mcc_ir_delete_ir(struct mcc_ir_row *head)
+struct mcc_ir_function *mcc_ir_generate(struct mcc_ast_program *ast)
 {
-	if (!head)
-		return;
-	struct mcc_ir_row *temp = NULL;
-	while (head->next_row) {
-		head = head->next_row;
+	struct ir_generation_userdata data;
+	if (!mcc_ir_generate_prepare(ast, &data)) {
+		mcc_ir_generate_finish(&data);
+		return NULL;
 	}
-	do {
-		temp = head->prev_row;
-		mcc_ir_delete_ir_row(head);
-		head = temp;
-	} while (temp);
+
+	struct mcc_ir_function *head = NULL;
+	struct mcc_ir_function *last = NULL;
+	while (ast) {
+		struct mcc_ir_function *function = mcc_ir_generate_function(ast, &data);
+		if (!function) {
+			mcc_ir_generate_finish(&data);
+			mcc_ir_delete_ir(head);
+			return NULL;
+		}
+		if (!last) {
+			head = function;
+		} else {
+			last->next = function;
+		}
+		last = function;
+		ast = ast->next_function;
+	}
+
+	mcc_ir_generate_finish(&data);
+	return head;
 }
 
+//---------------------------------------------------------------------------------------- Cleanup
 
+void mcc_ir_delete_ir(struct mcc_ir_function *head)
+{
+	while (head) {
+		struct mcc_ir_function *next = head->next;
+		mcc_free(head->rows);
+		mcc_free(head);
+		head = next;
+	}
+}
@@ -10,7 +10,12 @@
 
 char *bool_to_string(bool b);
 char *instr_to_string(enum mcc_ir_instruction instr);
-static void print_arg(FILE *out, struct mcc_ir_arg *arg, bool escape_quotes, bool doubly_escaped);
+static void print_arg(FILE *out,
+                      struct mcc_ir_function *function,
+                      struct mcc_ir_arg *arg,
+                      bool escape_quotes,
+                      bool doubly_escaped);
+static void print_index(FILE *out, struct mcc_ir_function *function, struct mcc_ir_index *index);
 static void print_type(FILE *out, struct mcc_ir_row_type *type);
 
 void mcc_ir_print_table_begin(FILE *out)
@@ -26,22 +31,32 @@ void mcc_ir_print_table_end(FILE *out)
 	fprintf(out, "\n");
 }
 
-void mcc_ir_print_ir(FILE *out, struct mcc_ir_row *head, bool escape_quotes, bool doubly_escaped)
+void mcc_ir_print_ir(FILE *out, struct mcc_ir_function *head, bool escape_quotes, bool doubly_escaped)
 {
 	mcc_ir_print_table_begin(out);
 
-	while (head) {
-		mcc_ir_print_ir_row(out, head, escape_quotes, doubly_escaped);
-		fprintf(out, "\n");
-		head = head->next_row;
+	for (; head; head = head->next) {
+		mcc_ir_print_function(out, head, escape_quotes, doubly_escaped);
 	}
 
 	mcc_ir_print_table_end(out);
 }
 
-void mcc_ir_print_ir_row(FILE *out, struct mcc_ir_row *row, bool escape_quotes, bool doubly_escaped)
+void mcc_ir_print_function(FILE *out, struct mcc_ir_function *function, bool escape_quotes, bool doubly_escaped)
 {
-	print_type(out, row->type);
+	for (unsigned i = 0; i < function->num_rows; i++) {
+		mcc_ir_print_ir_row(out, function, &function->rows[i], escape_quotes, doubly_escaped);
+		fprintf(out, "\n");
+	}
+}
+
+void mcc_ir_print_ir_row(FILE *out,
+                         struct mcc_ir_function *function,
+                         struct mcc_ir_row *row,
+                         bool escape_quotes,
+                         bool doubly_escaped)
+{
+	print_type(out, &row->type);
 	switch (row->instr) {
 	// Instruction first
 	case MCC_IR_INSTR_JUMP:
@@ -50,9 +65,9 @@ void mcc_ir_print_ir_row(FILE *out, struct mcc_ir_row *row, bool escape_quotes,
 	case MCC_IR_INSTR_RETURN:
 		fprintf(out, "\t");
 		fprintf(out, "%s ", instr_to_string(row->instr));
-		print_arg(out, row->arg1, escape_quotes, doubly_escaped);
+		print_arg(out, function, &row->arg1, escape_quotes, doubly_escaped);
 		fprintf(out, " ");
-		print_arg(out, row->arg2, escape_quotes, doubly_escaped);
+		print_arg(out, function, &row->arg2, escape_quotes, doubly_escaped);
 		break;
 
 	// Pop
@@ -68,15 +83,15 @@ void mcc_ir_print_ir_row(FILE *out, struct mcc_ir_row *row, bool escape_quotes,
 		fprintf(out, "\t");
 		fprintf(out, "$t%d =", row->row_no);
 		fprintf(out, " %s ", instr_to_string(row->instr));
-		print_arg(out, row->arg1, escape_quotes, doubly_escaped);
+		print_arg(out, function, &row->arg1, escape_quotes, doubly_escaped);
 		break;
 
 	case MCC_IR_INSTR_ARRAY:
 		fprintf(out, "\t");
 		fprintf(out, "%s ", instr_to_string(row->instr));
-		print_arg(out, row->arg1, escape_quotes, doubly_escaped);
+		print_arg(out, function, &row->arg1, escape_quotes, doubly_escaped);
 		fprintf(out, "[");
-		print_arg(out, row->arg2, escape_quotes, doubly_escaped);
+		print_arg(out, function, &row->arg2, escape_quotes, doubly_escaped);
 		fprintf(out, "]");
 
 		break;
@@ -96,27 +111,27 @@ void mcc_ir_print_ir_row(FILE *out, struct mcc_ir_row *row, bool escape_quotes,
 	case MCC_IR_INSTR_PLUS:
 		fprintf(out, "\t");
 		fprintf(out, "$t%d = ", row->row_no);
-		print_arg(out, row->arg1, escape_quotes, doubly_escaped);
+		print_arg(out, function, &row->arg1, escape_quotes, doubly_escaped);
 		fprintf(out, " %s ", instr_to_string(row->instr));
-		print_arg(out, row->arg2, escape_quotes, doubly_escaped);
+		print_arg(out, function, &row->arg2, escape_quotes, doubly_escaped);
 		break;
 
 	// Inline
 	case MCC_IR_INSTR_ASSIGN:
 		fprintf(out, "\t");
-		print_arg(out, row->arg1, escape_quotes, doubly_escaped);
+		print_arg(out, function, &row->arg1, escape_quotes, doubly_escaped);
 		fprintf(out, " %s ", instr_to_string(row->instr));
-		print_arg(out, row->arg2, escape_quotes, doubly_escaped);
+		print_arg(out, function, &row->arg2, escape_quotes, doubly_escaped);
 		break;
 
 	// Function label
 	case MCC_IR_INSTR_FUNC_LABEL:
-		fprintf(out, "  %s", row->arg1->func_label);
+		fprintf(out, "  %s", row->arg1.func_label);
 		break;
 
 	// Label
 	case MCC_IR_INSTR_LABEL:
-		fprintf(out, "  L%d", row->arg1->label);
+		fprintf(out, "  L%d", row->arg1.label);
 		break;
 	default:
 		break;
@@ -216,13 +231,34 @@ char *bool_to_string(bool b)
 	}
 }
 
-static void print_arg(FILE *out, struct mcc_ir_arg *arg, bool escape_quotes, bool doubly_escaped)
+static void print_index(FILE *out, struct mcc_ir_function *function, struct mcc_ir_index *index)
 {
-	if (!arg)
+	switch (index->type) {
+	case MCC_IR_TYPE_LIT_INT:
+		fprintf(out, "%ld", index->lit_int);
+		return;
+	case MCC_IR_TYPE_IDENTIFIER:
+		fprintf(out, "%s", index->ident);
 		return;
+	case MCC_IR_TYPE_ROW:
+		fprintf(out, "$t%d", function->rows[index->row].row_no);
+		return;
+	default:
+		return;
+	}
+}
+
+static void print_arg(FILE *out,
+                      struct mcc_ir_function *function,
+                      struct mcc_ir_arg *arg,
+                      bool escape_quotes,
+                      bool doubly_escaped)
+{
 	switch (arg->type) {
+	case MCC_IR_TYPE_NONE:
+		return;
 	case MCC_IR_TYPE_ROW:
-		fprintf(out, "$t%d", arg->row->row_no);
+		fprintf(out, "$t%d", function->rows[arg->row].row_no);
 		return;
 	case MCC_IR_TYPE_LIT_INT:
 		fprintf(out, "%ld", arg->lit_int);
@@ -243,7 +279,7 @@ static void print_arg(FILE *out, struct mcc_ir_arg *arg, bool escape_quotes, boo
 		return;
 	case MCC_IR_TYPE_ARR_ELEM:
 		fprintf(out, "%s[", arg->arr_ident);
-		print_arg(out, arg->index, escape_quotes, doubly_escaped);
+		print_index(out, function, &arg->index);
 		fprintf(out, "]");
 		return;
 	case MCC_IR_TYPE_FUNC_LABEL:
@@ -0,0 +1,357 @@
+#include "mcc/optimize.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+//---------------------------------------------------------------------------------------- Removal of rows
+
+// State of a row while its function is transformed
+struct row_state {
+	bool removed;
+	// Value of a removed row, MCC_IR_TYPE_NONE if it has none
+	struct mcc_ir_arg value;
+	// Index of a kept row after the removed rows are moved out
+	unsigned index;
+};
+
+// Returns true if the row is removed, then value is set to the value that replaces the uses of the row
+typedef bool (*transform_row_cb)(struct mcc_ir_row *row, struct mcc_ir_arg *value);
+
+// Replaces the use of a removed row by its value
+static void forward_arg(struct mcc_ir_arg *arg, struct row_state *states)
+{
+	if (arg->type == MCC_IR_TYPE_ROW && states[arg->row].removed) {
+		assert(states[arg->row].value.type != MCC_IR_TYPE_NONE);
+		*arg = states[arg->row].value;
+	} else if (arg->type == MCC_IR_TYPE_ARR_ELEM && arg->index.type == MCC_IR_TYPE_ROW &&
+	           states[arg->index.row].removed) {
+		// Indices are ints, so only int literals and other rows are forwarded to them
+		struct mcc_ir_arg *value = &states[arg->index.row].value;
+		if (value->type == MCC_IR_TYPE_LIT_INT) {
+			arg->index.type = MCC_IR_TYPE_LIT_INT;
+			arg->index.lit_int = value->lit_int;
+		} else {
+			assert(value->type == MCC_IR_TYPE_ROW);
+			arg->index.row = value->row;
+		}
+	}
+}
+
+static void renumber_arg(struct mcc_ir_arg *arg, struct row_state *states)
+{
+	if (arg->type == MCC_IR_TYPE_ROW) {
+		arg->row = states[arg->row].index;
+	} else if (arg->type == MCC_IR_TYPE_ARR_ELEM && arg->index.type == MCC_IR_TYPE_ROW) {
+		arg->index.row = states[arg->index.row].index;
+	}
+}
+
+// Moves the kept rows together, their uses of removed rows are forwarded already
+static void remove_rows(struct mcc_ir_function *function, struct row_state *states)
+{
+	unsigned num_rows = 0;
+	for (unsigned i = 0; i < function->num_rows; i++) {
+		if (!states[i].removed)
+			states[i].index = num_rows++;
+	}
+
+	for (unsigned i = 0; i < function->num_rows; i++) {
+		if (states[i].removed)
+			continue;
+		struct mcc_ir_row row = function->rows[i];
+		renumber_arg(&row.arg1, states);
+		renumber_arg(&row.arg2, states);
+		function->rows[states[i].index] = row;
+	}
+	function->num_rows = num_rows;
+}
+
+// Calls transform for each row in order, after the uses of the rows removed so far have been forwarded in it
+static bool transform_rows(struct mcc_ir_function *function, transform_row_cb transform)
+{
+	assert(function);
+
+	struct row_state *states = calloc(function->num_rows, sizeof(*states));
+	if (!states)
+		return false;
+
+	bool removed_any = false;
+	for (unsigned i = 0; i < function->num_rows; i++) {
+		struct mcc_ir_row *row = &function->rows[i];
+		forward_arg(&row->arg1, states);
+		forward_arg(&row->arg2, states);
+		if (transform(row, &states[i].value)) {
+			states[i].removed = true;
+			removed_any = true;
+		}
+	}
+
+	if (removed_any)
+		remove_rows(function, states);
+	free(states);
+	return true;
+}
+
+//---------------------------------------------------------------------------------------- Constant folding
+
+static struct mcc_ir_arg int_arg(uint32_t value)
+{
+	return (struct mcc_ir_arg){.type = MCC_IR_TYPE_LIT_INT, .lit_int = (int32_t)value};
+}
+
+static struct mcc_ir_arg bool_arg(bool value)
+{
+	return (struct mcc_ir_arg){.type = MCC_IR_TYPE_LIT_BOOL, .lit_bool = value};
+}
+
+static bool fold_int(enum mcc_ir_instruction instr, int32_t a, int32_t b, struct mcc_ir_arg *value)
+{
+	switch (instr) {
+	case MCC_IR_INSTR_PLUS:
+		*value = int_arg((uint32_t)a + (uint32_t)b);
+		return true;
+	case MCC_IR_INSTR_MINUS:
+		*value = int_arg((uint32_t)a - (uint32_t)b);
+		return true;
+	case MCC_IR_INSTR_MULTIPLY:
+		*value = int_arg((uint32_t)a * (uint32_t)b);
+		return true;
+	case MCC_IR_INSTR_DIVIDE:
+		if (b == 0 || (a == INT32_MIN && b == -1))
+			return false;
+		*value = int_arg((uint32_t)(a / b));
+		return true;
+	case MCC_IR_INSTR_EQUALS:
+		*value = bool_arg(a == b);
+		return true;
+	case MCC_IR_INSTR_NOTEQUALS:
+		*value = bool_arg(a != b);
+		return true;
+	case MCC_IR_INSTR_SMALLER:
+		*value = bool_arg(a < b);
+		return true;
+	case MCC_IR_INSTR_GREATER:
+		*value = bool_arg(a > b);
+		return true;
+	case MCC_IR_INSTR_SMALLEREQ:
+		*value = bool_arg(a <= b);
+		return true;
+	case MCC_IR_INSTR_GREATEREQ:
+		*value = bool_arg(a >= b);
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool fold_bool(enum mcc_ir_instruction instr, bool a, bool b, struct mcc_ir_arg *value)
+{
+	switch (instr) {
+	case MCC_IR_INSTR_AND:
+		*value = bool_arg(a && b);
+		return true;
+	case MCC_IR_INSTR_OR:
+		*value = bool_arg(a || b);
+		return true;
+	case MCC_IR_INSTR_EQUALS:
+		*value = bool_arg(a == b);
+		return true;
+	case MCC_IR_INSTR_NOTEQUALS:
+		*value = bool_arg(a != b);
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool fold_row(struct mcc_ir_row *row, struct mcc_ir_arg *value)
+{
+	struct mcc_ir_arg *a = &row->arg1;
+	struct mcc_ir_arg *b = &row->arg2;
+
+	if (row->instr == MCC_IR_INSTR_NEGATIV && a->type == MCC_IR_TYPE_LIT_INT) {
+		*value = int_arg(-(uint32_t)a->lit_int);
+		return true;
+	}
+	if (row->instr == MCC_IR_INSTR_NOT && a->type == MCC_IR_TYPE_LIT_BOOL) {
+		*value = bool_arg(!a->lit_bool);
+		return true;
+	}
+	if (!is_binary_instr(row))
+		return false;
+
+	if (a->type == MCC_IR_TYPE_LIT_INT && b->type == MCC_IR_TYPE_LIT_INT)
+		return fold_int(row->instr, (int32_t)a->lit_int, (int32_t)b->lit_int, value);
+	if (a->type == MCC_IR_TYPE_LIT_BOOL && b->type == MCC_IR_TYPE_LIT_BOOL)
+		return fold_bool(row->instr, a->lit_bool, b->lit_bool, value);
+	return false;
+}
+
+bool mcc_optimize_fold_constants(struct mcc_ir_function *function)
+{
+	return transform_rows(function, fold_row);
+}
+
+//---------------------------------------------------------------------------------------- Simplification
+
+// Rows are computed once and literals never change, so they can replace a later use of a row that gives them
+static bool is_stable(struct mcc_ir_arg *arg)
+{
+	switch (arg->type) {
+	case MCC_IR_TYPE_LIT_INT:
+	case MCC_IR_TYPE_LIT_BOOL:
+	case MCC_IR_TYPE_ROW:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool is_int(struct mcc_ir_arg *arg, long value)
+{
+	return arg->type == MCC_IR_TYPE_LIT_INT && arg->lit_int == value;
+}
+
+static bool is_bool(struct mcc_ir_arg *arg, bool value)
+{
+	return arg->type == MCC_IR_TYPE_LIT_BOOL && arg->lit_bool == value;
+}
+
+// Row gives operand if neutral is the literal of the other operand, which is only allowed to be the second one for
+// operations that are not commutative
+static bool forward_operand(struct mcc_ir_row *row,
+                            bool (*neutral)(struct mcc_ir_arg *arg),
+                            bool commutative,
+                            struct mcc_ir_arg *value)
+{
+	if (neutral(&row->arg2) && is_stable(&row->arg1)) {
+		*value = row->arg1;
+		return true;
+	}
+	if (commutative && neutral(&row->arg1) && is_stable(&row->arg2)) {
+		*value = row->arg2;
+		return true;
+	}
+	return false;
+}
+
+static bool is_zero(struct mcc_ir_arg *arg)
+{
+	return is_int(arg, 0);
+}
+
+static bool is_one(struct mcc_ir_arg *arg)
+{
+	return is_int(arg, 1);
+}
+
+static bool is_true(struct mcc_ir_arg *arg)
+{
+	return is_bool(arg, true);
+}
+
+static bool is_false(struct mcc_ir_arg *arg)
+{
+	return is_bool(arg, false);
+}
+
+static bool simplify_row(struct mcc_ir_row *row, struct mcc_ir_arg *value)
+{
+	switch (row->instr) {
+	case MCC_IR_INSTR_JUMPFALSE:
+		if (is_true(&row->arg1))
+			return true;
+		if (is_false(&row->arg1)) {
+			row->instr = MCC_IR_INSTR_JUMP;
+			row->arg1 = row->arg2;
+			row->arg2 = (struct mcc_ir_arg){.type = MCC_IR_TYPE_NONE};
+		}
+		return false;
+	case MCC_IR_INSTR_PLUS:
+		return row->type.type == MCC_IR_ROW_INT && forward_operand(row, is_zero, true, value);
+	case MCC_IR_INSTR_MINUS:
+		return row->type.type == MCC_IR_ROW_INT && forward_operand(row, is_zero, false, value);
+	case MCC_IR_INSTR_MULTIPLY:
+		if (row->type.type != MCC_IR_ROW_INT)
+			return false;
+		// Reading the other operand has no side effect, so it can be dropped
+		if (is_zero(&row->arg1) || is_zero(&row->arg2)) {
+			*value = int_arg(0);
+			return true;
+		}
+		return forward_operand(row, is_one, true, value);
+	case MCC_IR_INSTR_DIVIDE:
+		return row->type.type == MCC_IR_ROW_INT && forward_operand(row, is_one, false, value);
+	case MCC_IR_INSTR_AND:
+		if (is_false(&row->arg1) || is_false(&row->arg2)) {
+			*value = bool_arg(false);
+			return true;
+		}
+		return forward_operand(row, is_true, true, value);
+	case MCC_IR_INSTR_OR:
+		if (is_true(&row->arg1) || is_true(&row->arg2)) {
+			*value = bool_arg(true);
+			return true;
+		}
+		return forward_operand(row, is_false, true, value);
+	default:
+		return false;
+	}
+}
+
+bool mcc_optimize_simplify(struct mcc_ir_function *function)
+{
+	return transform_rows(function, simplify_row);
+}
+
+//---------------------------------------------------------------------------------------- Peephole optimization
+
+static bool same_operand(struct mcc_asm_operand *a, struct mcc_asm_operand *b)
+{
+	if (a->type != b->type)
+		return false;
+
+	switch (a->type) {
+	case MCC_ASM_OPERAND_REGISTER:
+		return a->reg == b->reg && a->offset == b->offset;
+	case MCC_ASM_OPERAND_COMPUTED_OFFSET:
+		return a->offset_initial == b->offset_initial && a->offset_base == b->offset_base &&
+		       a->offset_factor == b->offset_factor && a->offset_size == b->offset_size;
+	case MCC_ASM_OPERAND_DATA:
+		return a->decl == b->decl && a->offset == b->offset;
+	case MCC_ASM_OPERAND_LITERAL:
+		return a->literal == b->literal;
+	case MCC_ASM_OPERAND_FUNCTION:
+		return strcmp(a->func_name, b->func_name) == 0;
+	}
+	return false;
+}
+
+// A general purpose register itself, not the memory it points to
+static bool is_register(struct mcc_asm_operand *operand)
+{
+	return operand->type == MCC_ASM_OPERAND_REGISTER && operand->offset == 0 && operand->reg != MCC_ASM_ST;
+}
+
+bool mcc_optimize_peephole(struct mcc_asm_function *function)
+{
+	assert(function);
+
+	struct mcc_asm_line *line = function->head;
+	while (line && line->next) {
+		struct mcc_asm_line *next = line->next;
+		// movl %eax, -8(%ebp)
+		// movl -8(%ebp), %eax  <- %eax holds that value already
+		if (line->opcode == MCC_ASM_MOVL && next->opcode == MCC_ASM_MOVL && is_register(line->first) &&
+		    !is_register(line->second) && same_operand(line->second, next->first) &&
+		    same_operand(line->first, next->second)) {
+			line->next = next->next;
+			mcc_asm_delete_line(next);
+		} else {
+			line = next;
+		}
+	}
+	return true;
+}
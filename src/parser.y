@@ -4,7 +4,7 @@
 
 %define api.pure full
 %lex-param   {void *scanner}
-%parse-param {void *scanner} {struct mcc_parser_result* result}
+%parse-param {void *scanner} {struct mcc_parser_result* result} {struct mcc_symbol_table_builder *builder}
 
 %define parse.trace
 %define parse.error verbose
@@ -12,6 +12,9 @@
 %code requires {
 #include "mcc/parser.h"
 
+// Only set for MCC_PARSER_ENTRY_POINT_PROGRAM_WITH_SYMBOL_TABLE, see mcc/symbol_table.h
+struct mcc_symbol_table_builder;
+
 #include <stdbool.h>
 #include <string.h>
 
@@ -45,9 +48,14 @@ while (0)
 }
 
 %{
+#include "mcc/symbol_table.h"
+
 int mcc_parser_lex();
 void mcc_parser_error();
 
+// Function definitions are prepended while parsing, since the list is linked
+static struct mcc_ast_program *reverse_program(struct mcc_ast_program *program);
+
 
 #define loc(ast_node, ast_sloc, ast_sloc_last) \
 	if (ast_node) { \
@@ -59,7 +67,7 @@ void mcc_parser_error();
 	(ast_node)->node.sloc.start_line = (ast_sloc).first_line;     \
 	(ast_node)->node.sloc.end_col = (ast_sloc_last).last_column;  \
 	(ast_node)->node.sloc.end_line = (ast_sloc_last).last_line;   \
-	(ast_node)->node.sloc.filename = result->filename;            \
+	(ast_node)->node.sloc.file = result->file;                    \
 
 %}
 
@@ -134,11 +142,14 @@ void mcc_parser_error();
 %type <struct mcc_ast_assignment *> assignment
 %type <struct mcc_ast_statement *> statement
 %type <struct mcc_ast_compound_statement *> compound_statement
+%type <struct mcc_ast_compound_statement *> function_body
 %type <struct mcc_ast_compound_statement *> statements
 %type <struct mcc_ast_program *> program
 %type <struct mcc_ast_function_definition *> function_def
 %type <struct mcc_ast_parameters *> parameters
+%type <struct mcc_ast_parameters *> parameter_list
 %type <struct mcc_ast_arguments *> arguments
+%type <struct mcc_ast_arguments *> argument_list
 %type <struct mcc_ast_program *> function_defs
 %type <struct mcc_ast_identifier *> identifier
 
@@ -148,15 +159,17 @@ void mcc_parser_error();
 %destructor { mcc_ast_delete($$); } declaration
 %destructor { mcc_ast_delete($$); } literal
 %destructor { mcc_ast_delete($$); } compound_statement
+%destructor { mcc_ast_delete($$); } function_body
 %destructor { mcc_ast_delete($$); } statements
 %destructor { mcc_ast_delete($$); } parameters
+%destructor { mcc_ast_delete($$); } parameter_list
 %destructor { mcc_ast_delete($$); } function_def
 %destructor { mcc_ast_delete($$); } function_defs
 %destructor { mcc_ast_delete($$); } program
 %destructor { mcc_ast_delete($$); } arguments
+%destructor { mcc_ast_delete($$); } argument_list
 %destructor { mcc_ast_delete($$); } identifier
 %destructor { free($$); } STRING_LITERAL
-%destructor { free($$); } IDENTIFIER
 
 %start toplevel
 
@@ -191,7 +204,8 @@ unit_test           : expression
                       { result->entry_point = MCC_PARSER_ENTRY_POINT_PROGRAM; result->program = $1; }
                     ;
 
-expression          : literal { $$ = mcc_ast_new_expression_literal($1);                           loc($$, @1 ,@1); }
+expression          : literal { $$ = mcc_ast_new_expression_literal($1);                           loc($$, @1 ,@1);
+                        mcc_symbol_table_builder_link_expression(builder, $$); }
                     | expression PLUS expression
                       { $$ = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_ADD, $1, $3);      loc($$, @1, @3); }
                     | expression MINUS expression
@@ -216,32 +230,42 @@ expression          : literal { $$ = mcc_ast_new_expression_literal($1);
                       { $$ = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_EQUAL, $1, $3);    loc($$, @1, @3); }
                     | expression EXKLA_EQ expression
                       { $$ = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_NOTEQUAL,$1,$3);   loc($$, @1, @3); }
-                    | LPARENTH expression RPARENTH { $$ = mcc_ast_new_expression_parenth($2);      loc($$, @1, @3); }
+                    | LPARENTH expression RPARENTH { $$ = $2; }
                     | MINUS expression %prec EX_MINUS
                       { $$ = mcc_ast_new_expression_unary_op(MCC_AST_UNARY_OP_NEGATIV, $2);        loc($$, @1, @2); }
                     | EXKLA expression %prec EX_EXKL
                       { $$ = mcc_ast_new_expression_unary_op(MCC_AST_UNARY_OP_NOT, $2);            loc($$, @1, @2); }
-                    | identifier { $$ = mcc_ast_new_expression_variable($1);                       loc($$, @1, @1); }
+                    | identifier { $$ = mcc_ast_new_expression_variable($1);                       loc($$, @1, @1);
+                        mcc_symbol_table_builder_link_expression(builder, $$); }
                     | identifier SQUARE_OPEN expression SQUARE_CLOSE
-                      { $$ = mcc_ast_new_expression_array_element($1,$3);                          loc($$, @1, @4); }
+                      { $$ = mcc_ast_new_expression_array_element($1,$3);                          loc($$, @1, @4);
+                        mcc_symbol_table_builder_link_expression(builder, $$); }
                     | identifier LPARENTH arguments RPARENTH
-                      { $$ = mcc_ast_new_expression_function_call($1, $3);                         loc($$, @1, @4); }
+                      { $$ = mcc_ast_new_expression_function_call($1, $3);                         loc($$, @1, @4);
+                        mcc_symbol_table_builder_link_expression(builder, $$); }
                     ;
 
-arguments           : expression { $$ = mcc_ast_new_arguments(false, $1, NULL);                    loc($$, @1, @1); }
-                    | expression COMMA arguments { $$ = mcc_ast_new_arguments(false, $1, $3);      loc($$, @1, @3); }
-                    | %empty { $$ = mcc_ast_new_arguments(true, NULL, NULL); }
+arguments           : argument_list { $$ = $1; }
+                    | %empty { $$ = mcc_ast_new_arguments(); }
+                    ;
+
+argument_list       : expression { $$ = mcc_ast_add_argument(mcc_ast_new_arguments(), $1);        loc($$, @1, @1); }
+                    | argument_list COMMA expression { $$ = mcc_ast_add_argument($1, $3);          loc($$, @1, @3); }
                     ;
 
 
-assignment          : identifier EQ expression { $$ = mcc_ast_new_variable_assignment ($1, $3);    loc($$, @1, @3); }
+assignment          : identifier EQ expression { $$ = mcc_ast_new_variable_assignment ($1, $3);    loc($$, @1, @3);
+                        mcc_symbol_table_builder_link_assignment(builder, $$); }
                     | identifier SQUARE_OPEN expression SQUARE_CLOSE EQ expression
-                      { $$ = mcc_ast_new_array_assignment ($1, $3, $6);                            loc($$, @1, @6); }
+                      { $$ = mcc_ast_new_array_assignment ($1, $3, $6);                            loc($$, @1, @6);
+                        mcc_symbol_table_builder_link_assignment(builder, $$); }
                     ;
 
-declaration         : TYPE identifier { $$ = mcc_ast_new_variable_declaration($1,$2);              loc($$, @1, @2); }
+declaration         : TYPE identifier { $$ = mcc_ast_new_variable_declaration($1,$2);              loc($$, @1, @2);
+                        mcc_symbol_table_builder_declare(builder, $$); }
                     | TYPE SQUARE_OPEN INT_LITERAL SQUARE_CLOSE identifier
-                      { $$ = mcc_ast_new_array_declaration($1, mcc_ast_new_literal_int($3), $5);   loc($$, @1, @5); }
+                      { $$ = mcc_ast_new_array_declaration($1, mcc_ast_new_literal_int($3), $5);   loc($$, @1, @5);
+                        mcc_symbol_table_builder_declare(builder, $$); }
                     ;
 
 identifier          : IDENTIFIER { $$ = mcc_ast_new_identifier($1);                                loc($$, @1, @1); }
@@ -261,12 +285,22 @@ statement           : IF LPARENTH expression RPARENTH statement %prec NOT_ELSE
                     | compound_statement { $$ = mcc_ast_new_statement_compound_stmt($1);           loc($$, @1, @1); }
                     ;
 
-statements          : statement statements { $$ = mcc_ast_new_compound_stmt(false, $1, $2);        loc($$, @1, @2); }
-                    | statement            { $$ = mcc_ast_new_compound_stmt(false, $1, NULL);      loc($$, @1, @1); }
+statements          : statements statement { $$ = mcc_ast_add_statement($1, $2);                   loc($$, @1, @2); }
+                    | statement { $$ = mcc_ast_add_statement(mcc_ast_new_compound_stmt(), $1);     loc($$, @1, @1); }
                     ;
 
-compound_statement  : CURL_OPEN statements CURL_CLOSE { $$ = $2;                                   loc($$, @1, @3); }
-                    | CURL_OPEN CURL_CLOSE { $$ = mcc_ast_new_compound_stmt(true,NULL,NULL);       loc($$, @1, @2); }
+compound_statement  : open_scope statements CURL_CLOSE { $$ = $2;                                  loc($$, @1, @3);
+                        mcc_symbol_table_builder_close_scope(builder); }
+                    | open_scope CURL_CLOSE { $$ = mcc_ast_new_compound_stmt();                    loc($$, @1, @2);
+                        mcc_symbol_table_builder_close_scope(builder); }
+                    ;
+
+open_scope          : CURL_OPEN { mcc_symbol_table_builder_open_scope(builder); }
+                    ;
+
+// The body of a function shares the scope of the parameters
+function_body       : CURL_OPEN statements CURL_CLOSE { $$ = $2;                                   loc($$, @1, @3); }
+                    | CURL_OPEN CURL_CLOSE { $$ = mcc_ast_new_compound_stmt();                     loc($$, @1, @2); }
                     ;
 
 literal             : INT_LITERAL    { $$ = mcc_ast_new_literal_int($1);                           loc($$, @1, @1); }
@@ -275,22 +309,29 @@ literal             : INT_LITERAL    { $$ = mcc_ast_new_literal_int($1);
                     | STRING_LITERAL { $$ = mcc_ast_new_literal_string($1); free($1);              loc($$, @1, @1); }
                     ;
 
-parameters          : declaration    { $$ = mcc_ast_new_parameters(false, $1, NULL );              loc($$, @1, @1); }
-                    | declaration COMMA parameters   { $$ = mcc_ast_new_parameters(false, $1, $3 );loc($$, @1, @3); }
-                    | %empty { $$ = mcc_ast_new_parameters(true, NULL, NULL); }
+parameters          : parameter_list { $$ = $1; }
+                    | %empty { $$ = mcc_ast_new_parameters(); }
+                    ;
+
+parameter_list      : declaration { $$ = mcc_ast_add_parameter(mcc_ast_new_parameters(), $1);     loc($$, @1, @1); }
+                    | parameter_list COMMA declaration { $$ = mcc_ast_add_parameter($1, $3);       loc($$, @1, @3); }
                     ;
 
-function_def        : VOID identifier LPARENTH parameters RPARENTH compound_statement
-                      { $$ = mcc_ast_new_void_function_def($2, $4, $6);                            loc($$, @1, @6); }
-                    | TYPE identifier LPARENTH parameters RPARENTH compound_statement
-                      { $$ = mcc_ast_new_type_function_def($1, $2, $4, $6);                        loc($$, @1, @6); }
+function_def        : VOID identifier LPARENTH { mcc_symbol_table_builder_open_function(builder, VOID, $2); }
+                      parameters RPARENTH function_body
+                      { $$ = mcc_ast_new_void_function_def($2, $5, $7);                            loc($$, @1, @7);
+                        mcc_symbol_table_builder_close_function(builder, $$); }
+                    | TYPE identifier LPARENTH { mcc_symbol_table_builder_open_function(builder, $1, $2); }
+                      parameters RPARENTH function_body
+                      { $$ = mcc_ast_new_type_function_def($1, $2, $5, $7);                        loc($$, @1, @7);
+                        mcc_symbol_table_builder_close_function(builder, $$); }
                     ;
 
-function_defs       : function_def function_defs  { $$ = mcc_ast_new_program($1, $2);              loc($$, @1, @2); }
+function_defs       : function_defs function_def  { $$ = mcc_ast_new_program($2, $1);              loc($$, @2, @2); }
                     | function_def                { $$ = mcc_ast_new_program($1, NULL);            loc($$, @1, @1); }
                     ;
 
-program             : function_defs { $$ = $1;                                                     loc($$, @1, @1); }
+program             : function_defs { $$ = reverse_program($1);                                    loc($$, @1, @1); }
                     ;
 
 %%
@@ -304,31 +345,105 @@ program             : function_defs { $$ = $1;
 #include "utils/length_of_int.h"
 #include "mcc/parser.h"
 
+// Runs the parser on a scanner whose input was already set up
+static struct mcc_parser_result parse(yyscan_t scanner, enum mcc_parser_entry_point entry_point, char *name)
+{
+	struct mcc_parser_result result = {
+	    .status = MCC_PARSER_STATUS_OK,
+	    .error_buffer = NULL,
+	};
+
+	bool program = entry_point == MCC_PARSER_ENTRY_POINT_PROGRAM ||
+	               entry_point == MCC_PARSER_ENTRY_POINT_PROGRAM_WITH_SYMBOL_TABLE;
+	if (!program) {
+		result.filename = "<test_suite>";
+		mcc_parser_set_extra(1, scanner);
+	} else {
+		result.filename = name;
+		mcc_parser_set_extra(2, scanner);
+	}
+	result.file = mcc_ast_add_filename(result.filename);
+
+	// Without a builder the actions of the parser leave the symbol table alone
+	struct mcc_symbol_table_builder builder;
+	bool build = entry_point == MCC_PARSER_ENTRY_POINT_PROGRAM_WITH_SYMBOL_TABLE;
+	if (build && mcc_symbol_table_builder_init(&builder)) {
+		result.status = MCC_PARSER_STATUS_UNKNOWN_ERROR;
+		return result;
+	}
+
+	if (yyparse(scanner, &result, build ? &builder : NULL) != 0) {
+		result.status = MCC_PARSER_STATUS_UNKNOWN_ERROR;
+		if (!result.error_buffer) {
+			if (build) {
+				mcc_symbol_table_builder_finish(&builder, false);
+			}
+			return result;
+		}
+	}
+
+	if (!(&result)->program) {
+		result.status = MCC_PARSER_STATUS_UNKNOWN_ERROR;
+	}
+
+	// If building failed the table is left NULL, it can still be created from the AST
+	if (build) {
+		result.symbol_table = mcc_symbol_table_builder_finish(&builder, result.status == MCC_PARSER_STATUS_OK);
+	}
+	return result;
+}
+
 struct mcc_parser_result mcc_parse_string(const char *input_string, enum mcc_parser_entry_point entry_point, char *name)
 {
 	assert(input_string);
 
-	char *input = strdup(input_string);
+	// The scanner works in place and needs two terminating NULLs
+	size_t size = strlen(input_string);
+	char *input = malloc(size + 2);
 
 	if (!input) {
 		return (struct mcc_parser_result){
 		    .status = MCC_PARSER_STATUS_UNKNOWN_ERROR,
 		};
 	}
+	memcpy(input, input_string, size);
+	input[size] = '\0';
+	input[size + 1] = '\0';
+
+	struct mcc_parser_result result = mcc_parse_buffer(input, size, entry_point, name);
+
+	free(input);
+
+	return result;
+}
+
+struct mcc_parser_result
+mcc_parse_buffer(char *buffer, size_t size, enum mcc_parser_entry_point entry_point, char *name)
+{
+	assert(buffer);
+	assert(buffer[size] == '\0' && buffer[size + 1] == '\0');
+
+	yyscan_t scanner;
+	mcc_parser_lex_init(&scanner);
+	if (!scanner) {
+		return (struct mcc_parser_result){
+		    .status = MCC_PARSER_STATUS_UNKNOWN_ERROR,
+		};
+	}
 
-	FILE *in = fmemopen((void *)input, strlen(input), "r");
-	if (!in) {
+	// Scan the buffer in place instead of copying it into the buffers of the scanner
+	YY_BUFFER_STATE state = mcc_parser__scan_buffer(buffer, size + 2, scanner);
+	if (!state) {
+		mcc_parser_lex_destroy(scanner);
 		return (struct mcc_parser_result){
 		    .status = MCC_PARSER_STATUS_UNABLE_TO_OPEN_STREAM,
 		};
 	}
 
-	struct mcc_parser_result result = mcc_parse_file(in, entry_point, name);
-
-	free(input);
-
-	fclose(in);
+	struct mcc_parser_result result = parse(scanner, entry_point, name);
 
+	mcc_parser__delete_buffer(state, scanner);
+	mcc_parser_lex_destroy(scanner);
 	return result;
 }
 
@@ -345,33 +460,23 @@ struct mcc_parser_result mcc_parse_file(FILE *input, enum mcc_parser_entry_point
 	}
 	mcc_parser_set_in(input, scanner);
 
-	struct mcc_parser_result result = {
-	    .status = MCC_PARSER_STATUS_OK,
-	    .error_buffer = NULL,
-	};
-
-	if (entry_point != MCC_PARSER_ENTRY_POINT_PROGRAM) {
-		result.filename = "<test_suite>";
-		mcc_parser_set_extra(1, scanner);
-	} else {
-		result.filename = name;
-		mcc_parser_set_extra(2, scanner);
-	}
-
-	if (yyparse(scanner, &result) != 0) {
-		result.status = MCC_PARSER_STATUS_UNKNOWN_ERROR;
-		if (!result.error_buffer) {
-			mcc_parser_lex_destroy(scanner);
-			return result;
-		}
-	}
+	struct mcc_parser_result result = parse(scanner, entry_point, name);
 
 	mcc_parser_lex_destroy(scanner);
+	return result;
+}
 
-	if (!(&result)->program) {
-		result.status = MCC_PARSER_STATUS_UNKNOWN_ERROR;
+static struct mcc_ast_program *reverse_program(struct mcc_ast_program *program)
+{
+	struct mcc_ast_program *reversed = NULL;
+	while (program) {
+		struct mcc_ast_program *next = program->next_function;
+		program->next_function = reversed;
+		program->has_next_function = reversed != NULL;
+		reversed = program;
+		program = next;
 	}
-	return result;
+	return reversed;
 }
 
 void mcc_ast_delete_result(struct mcc_parser_result *result)
@@ -394,6 +499,7 @@ void mcc_ast_delete_result(struct mcc_parser_result *result)
 		mcc_ast_delete(result->assignment);
 		break;
 	case MCC_PARSER_ENTRY_POINT_PROGRAM:
+	case MCC_PARSER_ENTRY_POINT_PROGRAM_WITH_SYMBOL_TABLE:
 		mcc_ast_delete(result->program);
 		break;
 	case MCC_PARSER_ENTRY_POINT_FUNCTION_DEFINITION:
@@ -415,6 +521,7 @@ void mcc_ast_delete_result(struct mcc_parser_result *result)
 void mcc_parser_error(struct MCC_PARSER_LTYPE *yylloc,
                       yyscan_t *scanner,
                       struct mcc_parser_result *result,
+                      struct mcc_symbol_table_builder *builder,
                       const char *msg)
 {
 	int size = strlen(msg) + length_of_int(yylloc->first_line) + length_of_int(yylloc->first_column) + strlen(result->filename) + 6;
@@ -424,5 +531,6 @@ void mcc_parser_error(struct MCC_PARSER_LTYPE *yylloc,
 	snprintf(result->error_buffer, size, "%s:%d:%d: %s\n", result->filename, yylloc->first_line, yylloc->first_column, msg);
 	// scanner needed to get meaningfull msg
 	UNUSED(scanner);
+	UNUSED(builder);
 }
 
@@ -0,0 +1,150 @@
+#include "mcc/pass_manager.h"
+
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+
+#include "mcc/asm_print.h"
+#include "mcc/ir_print.h"
+#include "mcc/optimize.h"
+
+// clang-format off
+
+// In the order in which the passes run, the IR passes run before the assembly code is generated
+static const struct mcc_pass passes[] = {
+	{.name = "fold-constants", .kind = MCC_PASS_KIND_IR, .level = 1, .run_ir = mcc_optimize_fold_constants},
+	{.name = "simplify", .kind = MCC_PASS_KIND_IR, .level = 2, .run_ir = mcc_optimize_simplify},
+	{.name = "peephole", .kind = MCC_PASS_KIND_ASM, .level = 1, .run_asm = mcc_optimize_peephole},
+};
+
+// clang-format on
+
+#define NUM_PASSES (sizeof(passes) / sizeof(passes[0]))
+
+_Static_assert(NUM_PASSES <= MCC_PASS_MANAGER_MAX_PASSES, "too many passes for the timings of the pass manager");
+
+const struct mcc_pass *mcc_pass_get_passes(unsigned *count)
+{
+	assert(count);
+	*count = NUM_PASSES;
+	return passes;
+}
+
+const struct mcc_pass *mcc_pass_find(const char *name)
+{
+	assert(name);
+	for (unsigned i = 0; i < NUM_PASSES; i++) {
+		if (strcmp(passes[i].name, name) == 0)
+			return &passes[i];
+	}
+	return NULL;
+}
+
+bool mcc_pass_manager_init(struct mcc_pass_manager *manager,
+                           int level,
+                           const char *print_after,
+                           FILE *print_out,
+                           bool time_passes)
+{
+	assert(manager);
+	assert(!print_after || print_out);
+
+	manager->level = level;
+	manager->print_after = print_after;
+	manager->print_out = print_out;
+	manager->time_passes = time_passes;
+	memset(manager->timings, 0, sizeof(manager->timings));
+
+	if (level < 0 || level > MCC_PASS_MANAGER_MAX_LEVEL)
+		return false;
+	return !print_after || mcc_pass_find(print_after);
+}
+
+static double now(void)
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+static bool runs_pass(struct mcc_pass_manager *manager, const struct mcc_pass *pass, enum mcc_pass_kind kind)
+{
+	return pass->kind == kind && pass->level <= manager->level;
+}
+
+static bool prints_after(struct mcc_pass_manager *manager, const struct mcc_pass *pass)
+{
+	return manager->print_after && strcmp(manager->print_after, pass->name) == 0;
+}
+
+bool mcc_pass_manager_run_ir(struct mcc_pass_manager *manager, struct mcc_ir_function *function)
+{
+	assert(function);
+	if (!manager)
+		return true;
+
+	for (unsigned i = 0; i < NUM_PASSES; i++) {
+		const struct mcc_pass *pass = &passes[i];
+		if (!runs_pass(manager, pass, MCC_PASS_KIND_IR))
+			continue;
+
+		double start = manager->time_passes ? now() : 0;
+		bool success = pass->run_ir(function);
+		if (manager->time_passes)
+			manager->timings[i].seconds += now() - start;
+		manager->timings[i].runs++;
+		if (!success)
+			return false;
+
+		if (prints_after(manager, pass)) {
+			fprintf(manager->print_out, "*** IR after %s ***\n", pass->name);
+			mcc_ir_print_function(manager->print_out, function, false, false);
+		}
+	}
+	return true;
+}
+
+bool mcc_pass_manager_run_asm(struct mcc_pass_manager *manager, struct mcc_asm_function *function)
+{
+	assert(function);
+	if (!manager)
+		return true;
+
+	for (unsigned i = 0; i < NUM_PASSES; i++) {
+		const struct mcc_pass *pass = &passes[i];
+		if (!runs_pass(manager, pass, MCC_PASS_KIND_ASM))
+			continue;
+
+		double start = manager->time_passes ? now() : 0;
+		bool success = pass->run_asm(function);
+		if (manager->time_passes)
+			manager->timings[i].seconds += now() - start;
+		manager->timings[i].runs++;
+		if (!success)
+			return false;
+
+		if (prints_after(manager, pass)) {
+			fprintf(manager->print_out, "*** Assembly code after %s ***\n", pass->name);
+			mcc_asm_print_func(manager->print_out, function);
+		}
+	}
+	return true;
+}
+
+void mcc_pass_manager_print_timings(struct mcc_pass_manager *manager, FILE *out)
+{
+	assert(manager);
+	assert(out);
+
+	double total = 0;
+	fprintf(out, "%-16s %-4s %8s %12s\n", "pass", "kind", "runs", "time");
+	for (unsigned i = 0; i < NUM_PASSES; i++) {
+		const struct mcc_pass *pass = &passes[i];
+		if (pass->level > manager->level)
+			continue;
+		fprintf(out, "%-16s %-4s %8u %10.6f s\n", pass->name, pass->kind == MCC_PASS_KIND_IR ? "ir" : "asm",
+		        manager->timings[i].runs, manager->timings[i].seconds);
+		total += manager->timings[i].seconds;
+	}
+	fprintf(out, "%-30s %10.6f s\n", "total", total);
+}
@@ -7,6 +7,9 @@
 #include <string.h>
 
 #include "mcc/ast_visit.h"
+#include "mcc/intern.h"
+#include "utils/hash_map.h"
+#include "utils/stack.h"
 #include "utils/unused.h"
 
 #define not_zero(x) (x > 0 ? x : 1)
@@ -16,9 +19,7 @@
 // Generics for check and get type
 #define check_and_get_type(x, ...) _Generic((x), \
 		struct mcc_ast_expression *:          check_and_get_type_expression, \
-		struct mcc_ast_identifier *:          check_and_get_type_identifier, \
-		struct mcc_ast_declaration *:         get_data_type_declaration, \
-		struct mcc_ast_literal *:             check_and_get_type_literal \
+		struct mcc_ast_identifier *:          check_and_get_type_identifier \
 		)(x, __VA_ARGS__)
 
 #define mcc_semantic_check_raise_error(x,y,...) _Generic((y), \
@@ -30,15 +31,15 @@
 
 // ------------------------------------------------------------- Forward declaration
 
-// Check and get type functions
-struct mcc_semantic_check_data_type *check_and_get_type_expression(struct mcc_ast_expression *expression,
-                                                                   struct mcc_semantic_check *check);
+// Check and get type functions, they store the type of the node in type
+static enum mcc_semantic_check_error_code check_and_get_type_expression(struct mcc_ast_expression *expression,
+                                                                        struct mcc_semantic_check *check,
+                                                                        struct mcc_semantic_check_data_type *type);
 
-struct mcc_semantic_check_data_type *check_and_get_type_identifier(struct mcc_ast_identifier *identifier,
-                                                                   struct mcc_semantic_check *check,
-                                                                   struct mcc_symbol_table_row *row);
-
-struct mcc_semantic_check_data_type *check_and_get_type_literal(struct mcc_ast_literal *literal, void *placeholder);
+static enum mcc_semantic_check_error_code check_and_get_type_identifier(struct mcc_ast_identifier *identifier,
+                                                                        struct mcc_semantic_check *check,
+                                                                        struct mcc_symbol_table_row *row,
+                                                                        struct mcc_semantic_check_data_type *type);
 
 // ------------------------------------------------------------- Functions: Error handling
 
@@ -47,7 +48,7 @@ static int get_sloc_string_size(struct mcc_ast_node node)
 {
 	// Hard coded 6 due to rounding and colons
 	return floor(log10(not_zero(node.sloc.start_col)) + log10(not_zero(node.sloc.start_line))) +
-	       strlen(node.sloc.filename) + 6;
+	       strlen(mcc_ast_get_filename(node)) + 6;
 }
 
 static enum mcc_semantic_check_error_code
@@ -63,7 +64,7 @@ err_to_check_with_sloc(struct mcc_semantic_check *check, struct mcc_ast_node nod
 	if (!buffer) {
 		return MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
 	}
-	if (0 > snprintf(buffer, size, "%s:%d:%d: %s", node.sloc.filename, node.sloc.start_line, node.sloc.start_col,
+	if (0 > snprintf(buffer, size, "%s:%d:%d: %s", mcc_ast_get_filename(node), node.sloc.start_line, node.sloc.start_col,
 	                 string)) {
 		free(buffer);
 		return MCC_SEMANTIC_CHECK_ERROR_SNPRINTF_FAILED;
@@ -194,6 +195,7 @@ struct mcc_semantic_check *mcc_semantic_check_initialize_check()
 	if (check) {
 		check->status = MCC_SEMANTIC_CHECK_OK;
 		check->error_buffer = NULL;
+		check->functions = NULL;
 	}
 	return check;
 }
@@ -228,9 +230,9 @@ run_check_early_abrt(enum mcc_semantic_check_error_code (*fctptr)(struct mcc_ast
 	return (*fctptr)(ast, table, check);
 }
 
-// Run all semantic checks, returns NULL if library functions fail
-struct mcc_semantic_check *mcc_semantic_check_run_all(struct mcc_ast_program *ast,
-                                                      struct mcc_symbol_table *symbol_table)
+// Run all semantic checks one after another, returns NULL if library functions fail
+struct mcc_semantic_check *mcc_semantic_check_run_all_separately(struct mcc_ast_program *ast,
+                                                                 struct mcc_symbol_table *symbol_table)
 {
 	assert(ast);
 	assert(symbol_table);
@@ -260,50 +262,46 @@ struct mcc_semantic_check *mcc_semantic_check_run_all(struct mcc_ast_program *as
 // ------------------------------------------------------------- check_and_get_type functionalities
 
 // getter for default data type
-static struct mcc_semantic_check_data_type *get_new_data_type()
+static struct mcc_semantic_check_data_type new_data_type(enum mcc_semantic_check_data_types data_type)
 {
-	struct mcc_semantic_check_data_type *type = malloc(sizeof(*type));
-	if (!type)
-		return NULL;
-	type->type = MCC_SEMANTIC_CHECK_UNKNOWN;
-	type->is_array = false;
-	type->array_size = -1;
-	return type;
+	return (struct mcc_semantic_check_data_type){
+	    .type = data_type,
+	    .array_size = -1,
+	    .is_array = false,
+	};
 }
 
 // get data type of given symbol tabel row
-static struct mcc_semantic_check_data_type *get_data_type_from_row(struct mcc_symbol_table_row *row)
+static struct mcc_semantic_check_data_type get_data_type_from_row(struct mcc_symbol_table_row *row)
 {
 	assert(row);
 
-	struct mcc_semantic_check_data_type *type = get_new_data_type();
-	if (!type)
-		return NULL;
+	struct mcc_semantic_check_data_type type = new_data_type(MCC_SEMANTIC_CHECK_UNKNOWN);
 	switch (row->row_type) {
 	case MCC_SYMBOL_TABLE_ROW_TYPE_INT:
-		type->type = MCC_SEMANTIC_CHECK_INT;
+		type.type = MCC_SEMANTIC_CHECK_INT;
 		break;
 	case MCC_SYMBOL_TABLE_ROW_TYPE_FLOAT:
-		type->type = MCC_SEMANTIC_CHECK_FLOAT;
+		type.type = MCC_SEMANTIC_CHECK_FLOAT;
 		break;
 	case MCC_SYMBOL_TABLE_ROW_TYPE_BOOL:
-		type->type = MCC_SEMANTIC_CHECK_BOOL;
+		type.type = MCC_SEMANTIC_CHECK_BOOL;
 		break;
 	case MCC_SYMBOL_TABLE_ROW_TYPE_STRING:
-		type->type = MCC_SEMANTIC_CHECK_STRING;
+		type.type = MCC_SEMANTIC_CHECK_STRING;
 		break;
 	case MCC_SYMBOL_TABLE_ROW_TYPE_VOID:
-		type->type = MCC_SEMANTIC_CHECK_VOID;
+		type.type = MCC_SEMANTIC_CHECK_VOID;
 		break;
 	default:
-		type->type = MCC_SEMANTIC_CHECK_UNKNOWN;
+		type.type = MCC_SEMANTIC_CHECK_UNKNOWN;
 		break;
 	}
 
 	if (row->array_size != -1) {
-		type->is_array = true;
+		type.is_array = true;
 	}
-	type->array_size = row->array_size;
+	type.array_size = row->array_size;
 	return type;
 }
 
@@ -325,21 +323,17 @@ static enum mcc_semantic_check_data_types ast_to_semantic_check_type(enum mcc_as
 	}
 }
 
-static struct mcc_semantic_check_data_type *get_data_type_declaration(struct mcc_ast_declaration *decl,
-                                                                      struct mcc_semantic_check *check)
+static struct mcc_semantic_check_data_type get_data_type_declaration(struct mcc_ast_declaration *decl)
 {
 	assert(decl);
-	UNUSED(check);
-	struct mcc_semantic_check_data_type *type = get_new_data_type();
-	if (!type)
-		return NULL;
+	struct mcc_semantic_check_data_type type = new_data_type(MCC_SEMANTIC_CHECK_UNKNOWN);
 	if (decl->declaration_type == MCC_AST_DECLARATION_TYPE_VARIABLE) {
-		type->is_array = false;
-		type->type = ast_to_semantic_check_type(decl->variable_type->type_value);
+		type.is_array = false;
+		type.type = ast_to_semantic_check_type(decl->variable_type->type_value);
 	} else {
-		type->is_array = true;
-		type->array_size = decl->array_size->i_value;
-		type->type = ast_to_semantic_check_type(decl->array_type->type_value);
+		type.is_array = true;
+		type.array_size = decl->array_size->i_value;
+		type.type = ast_to_semantic_check_type(decl->array_type->type_value);
 	}
 	return type;
 }
@@ -418,162 +412,150 @@ static char *to_string(struct mcc_semantic_check_data_type *type)
 	return buffer;
 }
 
-// check and get type of binary expression. Returns MCC_SEMANTIC_CHECK_UNKNOWN if error occurs
-static struct mcc_semantic_check_data_type *check_and_get_type_binary_expression(struct mcc_ast_expression *expression,
-                                                                                 struct mcc_semantic_check *check)
+// check and get type of binary expression from the types of its operands. The type is MCC_SEMANTIC_CHECK_UNKNOWN if an
+// error occurs
+static enum mcc_semantic_check_error_code
+check_and_get_type_binary_expression(struct mcc_ast_expression *expression,
+                                     struct mcc_semantic_check *check,
+                                     struct mcc_semantic_check_data_type lhs,
+                                     struct mcc_semantic_check_data_type rhs,
+                                     struct mcc_semantic_check_data_type *type)
 {
-	assert(expression->lhs);
-	assert(expression->rhs);
+	assert(expression->type == MCC_AST_EXPRESSION_TYPE_BINARY_OP);
 	assert(check);
 
 	bool success = false;
-	struct mcc_semantic_check_data_type *lhs = check_and_get_type(expression->lhs, check);
-	if (!lhs)
-		return NULL;
-	struct mcc_semantic_check_data_type *rhs = check_and_get_type(expression->rhs, check);
-	if (!rhs) {
-		free(lhs);
-		return NULL;
-	}
+	enum mcc_semantic_check_error_code error = MCC_SEMANTIC_CHECK_ERROR_OK;
 	enum mcc_ast_binary_op op = expression->op;
 
 	switch (op) {
 	case MCC_AST_BINARY_OP_ADD:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_SUB:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_MUL:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_DIV:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_SMALLER:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_GREATER:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_SMALLEREQ:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_GREATEREQ:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_CONJ:
-		success = is_bool(lhs) && is_bool(rhs);
+		success = is_bool(&lhs) && is_bool(&rhs);
 		break;
 	case MCC_AST_BINARY_OP_DISJ:
-		success = is_bool(lhs) && is_bool(rhs);
+		success = is_bool(&lhs) && is_bool(&rhs);
 		break;
 	case MCC_AST_BINARY_OP_EQUAL:
-		success = types_equal(lhs, rhs);
+		success = types_equal(&lhs, &rhs);
 		break;
 	case MCC_AST_BINARY_OP_NOTEQUAL:
-		success = types_equal(lhs, rhs);
+		success = types_equal(&lhs, &rhs);
 		break;
 	default:
 		break;
 	}
 
-	if (!success || lhs->is_array || rhs->is_array || is_string(lhs) || is_string(rhs)) {
-		if (mcc_semantic_check_raise_error(2, check, expression->node,
-		                                   "operation on incompatible types '%s' and '%s'.", true,
-		                                   to_string(lhs), to_string(rhs)) != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			free(rhs);
-			free(lhs);
-			return NULL;
-		}
-		lhs->type = MCC_SEMANTIC_CHECK_UNKNOWN;
+	if (!success || lhs.is_array || rhs.is_array || is_string(&lhs) || is_string(&rhs)) {
+		error = mcc_semantic_check_raise_error(2, check, expression->node,
+		                                       "operation on incompatible types '%s' and '%s'.", true,
+		                                       to_string(&lhs), to_string(&rhs));
+		if (error != MCC_SEMANTIC_CHECK_ERROR_OK)
+			return error;
+		lhs.type = MCC_SEMANTIC_CHECK_UNKNOWN;
 	}
-	if (success && (lhs->type == MCC_SEMANTIC_CHECK_UNKNOWN)) {
-		if (mcc_semantic_check_raise_error(0, check, expression->node, "unknown type.", false) !=
-		    MCC_SEMANTIC_CHECK_ERROR_OK) {
-			free(rhs);
-			free(lhs);
-			return NULL;
-		}
+	if (success && (lhs.type == MCC_SEMANTIC_CHECK_UNKNOWN)) {
+		error = mcc_semantic_check_raise_error(0, check, expression->node, "unknown type.", false);
+		if (error != MCC_SEMANTIC_CHECK_ERROR_OK)
+			return error;
 	}
 	if (!(op == MCC_AST_BINARY_OP_ADD || op == MCC_AST_BINARY_OP_SUB || op == MCC_AST_BINARY_OP_MUL ||
 	      op == MCC_AST_BINARY_OP_DIV)) {
-		lhs->type = MCC_SEMANTIC_CHECK_BOOL;
+		lhs.type = MCC_SEMANTIC_CHECK_BOOL;
 	}
-	free(rhs);
-	return lhs;
+	*type = lhs;
+	return MCC_SEMANTIC_CHECK_ERROR_OK;
 }
 
-struct mcc_semantic_check_data_type *check_and_get_type_unary_expression(struct mcc_ast_expression *expression,
-                                                                         struct mcc_semantic_check *check)
+// check and get type of unary expression from the type of its operand
+static enum mcc_semantic_check_error_code
+check_and_get_type_unary_expression(struct mcc_ast_expression *expression,
+                                    struct mcc_semantic_check *check,
+                                    struct mcc_semantic_check_data_type child,
+                                    struct mcc_semantic_check_data_type *type)
 {
 	assert(expression->type == MCC_AST_EXPRESSION_TYPE_UNARY_OP);
-	assert(expression->child);
 	assert(check);
 
-	struct mcc_semantic_check_data_type *child = check_and_get_type(expression->child, check);
-	if (!child)
-		return NULL;
+	enum mcc_semantic_check_error_code error = MCC_SEMANTIC_CHECK_ERROR_OK;
 	enum mcc_ast_unary_op u_op = expression->u_op;
 
-	if (child->is_array || is_string(child) || ((u_op == MCC_AST_UNARY_OP_NEGATIV) && is_bool(child)) ||
-	    ((u_op == MCC_AST_UNARY_OP_NOT) && !is_bool(child))) {
-		if (mcc_semantic_check_raise_error(1, check, expression->node,
-		                                   "unary operation not compatible with '%s'.", true,
-		                                   to_string(child)) != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			free(child);
-			return NULL;
-		}
-		child->type = MCC_SEMANTIC_CHECK_UNKNOWN;
+	if (child.is_array || is_string(&child) || ((u_op == MCC_AST_UNARY_OP_NEGATIV) && is_bool(&child)) ||
+	    ((u_op == MCC_AST_UNARY_OP_NOT) && !is_bool(&child))) {
+		error = mcc_semantic_check_raise_error(1, check, expression->node,
+		                                       "unary operation not compatible with '%s'.", true,
+		                                       to_string(&child));
+		if (error != MCC_SEMANTIC_CHECK_ERROR_OK)
+			return error;
+		child.type = MCC_SEMANTIC_CHECK_UNKNOWN;
 	}
-	return child;
+	*type = child;
+	return MCC_SEMANTIC_CHECK_ERROR_OK;
 }
 
-// get and check the type of an array element. Includes ensuring index to be of type 'INT'
-static struct mcc_semantic_check_data_type *check_and_get_type_array_element(struct mcc_ast_expression *array_element,
-                                                                             struct mcc_semantic_check *check)
+// get and check the type of an array element from the type of its index. Includes ensuring index to be of type 'INT'
+static enum mcc_semantic_check_error_code
+check_and_get_type_array_element(struct mcc_ast_expression *array_element,
+                                 struct mcc_semantic_check *check,
+                                 struct mcc_semantic_check_data_type index,
+                                 struct mcc_semantic_check_data_type *type)
 {
 	assert(array_element->type == MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT);
 	assert(check);
 
-	struct mcc_semantic_check_data_type *index = check_and_get_type(array_element->index, check);
-	if (!index)
-		return NULL;
-	struct mcc_semantic_check_data_type *identifier =
-	    check_and_get_type(array_element->array_identifier, check, array_element->array_row);
-	if (!identifier) {
-		free(index);
-		return NULL;
-	}
+	struct mcc_semantic_check_data_type identifier;
+	enum mcc_semantic_check_error_code error = check_and_get_type(array_element->array_identifier, check, array_element->array_row, &identifier);
+	if (error != MCC_SEMANTIC_CHECK_ERROR_OK)
+		return error;
 	char *name = array_element->array_identifier->identifier_name;
-	if (!is_int(index)) {
-		if (mcc_semantic_check_raise_error(1, check, array_element->node, "expected type 'INT' but was '%s'.",
-		                                   true, to_string(index)) != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			free(index);
-			free(identifier);
-			return NULL;
-		}
-		identifier->type = MCC_SEMANTIC_CHECK_UNKNOWN;
-	}
-	if (!identifier->is_array) {
-		if (mcc_semantic_check_raise_error(1, check, array_element->node,
-		                                   "subscripted value '%s' is not an array.", false,
-		                                   name) != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			free(index);
-			free(identifier);
-			return NULL;
-		}
-		identifier->type = MCC_SEMANTIC_CHECK_UNKNOWN;
+	if (!is_int(&index)) {
+		error = mcc_semantic_check_raise_error(1, check, array_element->node,
+		                                       "expected type 'INT' but was '%s'.", true, to_string(&index));
+		if (error != MCC_SEMANTIC_CHECK_ERROR_OK)
+			return error;
+		identifier.type = MCC_SEMANTIC_CHECK_UNKNOWN;
 	}
-	identifier->is_array = false;
-	identifier->array_size = -1;
-	free(index);
-	return identifier;
+	if (!identifier.is_array) {
+		error = mcc_semantic_check_raise_error(1, check, array_element->node,
+		                                       "subscripted value '%s' is not an array.", false, name);
+		if (error != MCC_SEMANTIC_CHECK_ERROR_OK)
+			return error;
+		identifier.type = MCC_SEMANTIC_CHECK_UNKNOWN;
+	}
+	identifier.is_array = false;
+	identifier.array_size = -1;
+	*type = identifier;
+	return MCC_SEMANTIC_CHECK_ERROR_OK;
 }
 
 // gets the type of a function call expression. Arguments are checked seperatly.
-static struct mcc_semantic_check_data_type *check_and_get_type_function_call(struct mcc_ast_expression *function_call,
-                                                                             struct mcc_semantic_check *check)
+static enum mcc_semantic_check_error_code
+check_and_get_type_function_call(struct mcc_ast_expression *function_call,
+                                 struct mcc_semantic_check *check,
+                                 struct mcc_semantic_check_data_type *type)
 {
 	assert(function_call->type == MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL);
 	assert(check);
@@ -583,93 +565,210 @@ static struct mcc_semantic_check_data_type *check_and_get_type_function_call(str
 	row = mcc_symbol_table_check_for_function_declaration(name, row);
 
 	if (!row) {
-		if (mcc_semantic_check_raise_error(1, check, function_call->node,
-		                                   "'%s' undeclared (first use in this function).", false,
-		                                   name) != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			return NULL;
-		}
-		return get_new_data_type();
-	} else {
-		return get_data_type_from_row(row);
+		*type = new_data_type(MCC_SEMANTIC_CHECK_UNKNOWN);
+		return mcc_semantic_check_raise_error(1, check, function_call->node,
+		                                      "'%s' undeclared (first use in this function).", false, name);
 	}
+	*type = get_data_type_from_row(row);
+	return MCC_SEMANTIC_CHECK_ERROR_OK;
 }
 
-// get the type of a literal, placeholder unused but needed due to macro
-struct mcc_semantic_check_data_type *check_and_get_type_literal(struct mcc_ast_literal *literal, void *placeholder)
+// get the type of a literal
+static struct mcc_semantic_check_data_type get_data_type_literal(struct mcc_ast_literal *literal)
 {
 	assert(literal);
-	UNUSED(placeholder);
-
-	struct mcc_semantic_check_data_type *type = get_new_data_type();
-	if (!type)
-		return NULL;
 
 	switch (literal->type) {
 	case MCC_AST_LITERAL_TYPE_INT:
-		type->type = MCC_SEMANTIC_CHECK_INT;
-		break;
+		return new_data_type(MCC_SEMANTIC_CHECK_INT);
 	case MCC_AST_LITERAL_TYPE_FLOAT:
-		type->type = MCC_SEMANTIC_CHECK_FLOAT;
-		break;
+		return new_data_type(MCC_SEMANTIC_CHECK_FLOAT);
 	case MCC_AST_LITERAL_TYPE_BOOL:
-		type->type = MCC_SEMANTIC_CHECK_BOOL;
-		break;
+		return new_data_type(MCC_SEMANTIC_CHECK_BOOL);
 	case MCC_AST_LITERAL_TYPE_STRING:
-		type->type = MCC_SEMANTIC_CHECK_STRING;
+		return new_data_type(MCC_SEMANTIC_CHECK_STRING);
+	default:
+		return new_data_type(MCC_SEMANTIC_CHECK_UNKNOWN);
+	}
+}
+
+// Expression whose operands are checked or, once they are, whose type is computed from theirs
+struct type_frame {
+	struct mcc_ast_expression *expression;
+	bool combine;
+};
+
+// Expressions that are left to check, the next one on top, and the types of the checked operands. Types are computed
+// with them instead of recursion, so that long chains of operations do not overflow the C stack.
+struct type_stacks {
+	struct mcc_stack frames;
+	struct mcc_stack types;
+};
+
+static enum mcc_semantic_check_error_code
+push_frame(struct type_stacks *stacks, struct mcc_ast_expression *expression, bool combine)
+{
+	struct type_frame frame = {expression, combine};
+	if (!mcc_stack_push(&stacks->frames, &frame))
+		return MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
+	return MCC_SEMANTIC_CHECK_ERROR_OK;
+}
+
+static enum mcc_semantic_check_error_code push_type(struct type_stacks *stacks,
+                                                    struct mcc_semantic_check_data_type type)
+{
+	if (!mcc_stack_push(&stacks->types, &type))
+		return MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
+	return MCC_SEMANTIC_CHECK_ERROR_OK;
+}
+
+static struct mcc_semantic_check_data_type pop_type(struct type_stacks *stacks)
+{
+	struct mcc_semantic_check_data_type type;
+	mcc_stack_pop(&stacks->types, &type);
+	return type;
+}
+
+// check and get type of an expression without operands
+static enum mcc_semantic_check_error_code check_and_get_type_leaf(struct mcc_ast_expression *expression,
+                                                                  struct mcc_semantic_check *check,
+                                                                  struct mcc_semantic_check_data_type *type)
+{
+	switch (expression->type) {
+	case MCC_AST_EXPRESSION_TYPE_LITERAL:
+		*type = get_data_type_literal(expression->literal);
+		return MCC_SEMANTIC_CHECK_ERROR_OK;
+	case MCC_AST_EXPRESSION_TYPE_VARIABLE:
+		return check_and_get_type(expression->identifier, check, expression->variable_row, type);
+	case MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL:
+		return check_and_get_type_function_call(expression, check, type);
+	default:
+		return MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
+	}
+}
+
+// Pushes the type of a leaf or the steps that check the operands of an expression and then combine their types
+static enum mcc_semantic_check_error_code
+check_step(struct type_stacks *stacks, struct mcc_ast_expression *expression, struct mcc_semantic_check *check)
+{
+	struct mcc_semantic_check_data_type type;
+	enum mcc_semantic_check_error_code error = MCC_SEMANTIC_CHECK_ERROR_OK;
+	switch (expression->type) {
+	case MCC_AST_EXPRESSION_TYPE_BINARY_OP:
+		error = push_frame(stacks, expression, true);
+		if (error == MCC_SEMANTIC_CHECK_ERROR_OK)
+			error = push_frame(stacks, expression->rhs, false);
+		if (error == MCC_SEMANTIC_CHECK_ERROR_OK)
+			error = push_frame(stacks, expression->lhs, false);
+		return error;
+	case MCC_AST_EXPRESSION_TYPE_UNARY_OP:
+		error = push_frame(stacks, expression, true);
+		if (error == MCC_SEMANTIC_CHECK_ERROR_OK)
+			error = push_frame(stacks, expression->child, false);
+		return error;
+	case MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT:
+		error = push_frame(stacks, expression, true);
+		if (error == MCC_SEMANTIC_CHECK_ERROR_OK)
+			error = push_frame(stacks, expression->index, false);
+		return error;
+	default:
+		error = check_and_get_type_leaf(expression, check, &type);
+		if (error != MCC_SEMANTIC_CHECK_ERROR_OK)
+			return error;
+		return push_type(stacks, type);
+	}
+}
+
+// Replaces the types of the operands of an expression with its type
+static enum mcc_semantic_check_error_code
+combine_step(struct type_stacks *stacks, struct mcc_ast_expression *expression, struct mcc_semantic_check *check)
+{
+	struct mcc_semantic_check_data_type type;
+	enum mcc_semantic_check_error_code error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
+	switch (expression->type) {
+	case MCC_AST_EXPRESSION_TYPE_BINARY_OP: {
+		struct mcc_semantic_check_data_type rhs = pop_type(stacks);
+		struct mcc_semantic_check_data_type lhs = pop_type(stacks);
+		error = check_and_get_type_binary_expression(expression, check, lhs, rhs, &type);
+		break;
+	}
+	case MCC_AST_EXPRESSION_TYPE_UNARY_OP:
+		error = check_and_get_type_unary_expression(expression, check, pop_type(stacks), &type);
+		break;
+	case MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT:
+		error = check_and_get_type_array_element(expression, check, pop_type(stacks), &type);
 		break;
 	default:
-		type->type = MCC_SEMANTIC_CHECK_UNKNOWN;
 		break;
 	}
-	return type;
+	if (error != MCC_SEMANTIC_CHECK_ERROR_OK)
+		return error;
+	return push_type(stacks, type);
 }
 
-struct mcc_semantic_check_data_type *check_and_get_type_expression(struct mcc_ast_expression *expression,
-                                                                   struct mcc_semantic_check *check)
+static enum mcc_semantic_check_error_code check_and_get_type_expression(struct mcc_ast_expression *expression,
+                                                                        struct mcc_semantic_check *check,
+                                                                        struct mcc_semantic_check_data_type *type)
 {
 	assert(expression);
 	assert(check);
+	assert(type);
 
 	switch (expression->type) {
-	case MCC_AST_EXPRESSION_TYPE_LITERAL:
-		return check_and_get_type(expression->literal, NULL);
 	case MCC_AST_EXPRESSION_TYPE_BINARY_OP:
-		return check_and_get_type_binary_expression(expression, check);
-	case MCC_AST_EXPRESSION_TYPE_PARENTH:
-		return check_and_get_type(expression->expression, check);
 	case MCC_AST_EXPRESSION_TYPE_UNARY_OP:
-		return check_and_get_type_unary_expression(expression, check);
-	case MCC_AST_EXPRESSION_TYPE_VARIABLE:
-		return check_and_get_type(expression->identifier, check, expression->variable_row);
 	case MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT:
-		return check_and_get_type_array_element(expression, check);
-	case MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL:
-		return check_and_get_type_function_call(expression, check);
+		break;
 	default:
-		return NULL;
+		// Leaves do not need the stacks
+		return check_and_get_type_leaf(expression, check, type);
 	}
+
+	struct type_frame initial_frames[MCC_STACK_INITIAL_CAPACITY];
+	struct mcc_semantic_check_data_type initial_types[MCC_STACK_INITIAL_CAPACITY];
+	struct type_stacks stacks;
+	mcc_stack_init(&stacks.frames, initial_frames, MCC_STACK_INITIAL_CAPACITY, sizeof(*initial_frames));
+	mcc_stack_init(&stacks.types, initial_types, MCC_STACK_INITIAL_CAPACITY, sizeof(*initial_types));
+
+	enum mcc_semantic_check_error_code error = push_frame(&stacks, expression, false);
+	while (error == MCC_SEMANTIC_CHECK_ERROR_OK && stacks.frames.size > 0) {
+		struct type_frame frame;
+		mcc_stack_pop(&stacks.frames, &frame);
+		if (frame.combine)
+			error = combine_step(&stacks, frame.expression, check);
+		else
+			error = check_step(&stacks, frame.expression, check);
+	}
+
+	if (error == MCC_SEMANTIC_CHECK_ERROR_OK) {
+		assert(stacks.types.size == 1);
+		*type = pop_type(&stacks);
+	}
+	mcc_stack_delete(&stacks.frames);
+	mcc_stack_delete(&stacks.types);
+	return error;
 }
 
-struct mcc_semantic_check_data_type *check_and_get_type_identifier(struct mcc_ast_identifier *identifier,
-                                                                   struct mcc_semantic_check *check,
-                                                                   struct mcc_symbol_table_row *row)
+static enum mcc_semantic_check_error_code check_and_get_type_identifier(struct mcc_ast_identifier *identifier,
+                                                                        struct mcc_semantic_check *check,
+                                                                        struct mcc_symbol_table_row *row,
+                                                                        struct mcc_semantic_check_data_type *type)
 {
 	assert(identifier);
 	assert(check);
 	assert(row);
+	assert(type);
 
 	char *name = identifier->identifier_name;
 	row = mcc_symbol_table_check_upwards_for_declaration(name, row);
 	if (!row) {
-		if (mcc_semantic_check_raise_error(1, check, identifier->node,
-		                                   "'%s' undeclared (first use in this function).", false,
-		                                   name) != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			return NULL;
-		}
-		return get_new_data_type();
+		*type = new_data_type(MCC_SEMANTIC_CHECK_UNKNOWN);
+		return mcc_semantic_check_raise_error(1, check, identifier->node,
+		                                      "'%s' undeclared (first use in this function).", false, name);
 	}
 
-	return get_data_type_from_row(row);
+	*type = get_data_type_from_row(row);
+	return MCC_SEMANTIC_CHECK_ERROR_OK;
 }
 
 // ------------------------------------------------------------- type checker
@@ -689,28 +788,21 @@ static void cb_return_value(struct mcc_ast_statement *statement, void *r_v_userd
 	struct return_value_userdata *userdata = r_v_userdata;
 	struct mcc_semantic_check *check = userdata->check;
 	struct mcc_semantic_check_data_type *function_type = userdata->function_type;
-	struct mcc_semantic_check_data_type *return_type = NULL;
+	struct mcc_semantic_check_data_type return_type = new_data_type(MCC_SEMANTIC_CHECK_VOID);
 	if (statement->return_value) {
-		return_type = check_and_get_type(statement->return_value, check);
-		if (!return_type) {
-			userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-			return;
-		}
-	} else {
-		return_type = get_new_data_type();
-		if (!return_type) {
-			userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
+		enum mcc_semantic_check_error_code error =
+		    check_and_get_type(statement->return_value, check, &return_type);
+		if (error != MCC_SEMANTIC_CHECK_ERROR_OK) {
+			userdata->error = error;
 			return;
 		}
-		return_type->type = MCC_SEMANTIC_CHECK_VOID;
 	}
-	if (!types_equal(function_type, return_type)) {
+	if (!types_equal(function_type, &return_type)) {
 		userdata->error =
 		    mcc_semantic_check_raise_error(userdata->error, 2, check, statement->return_value->node,
 		                                   "return value of type '%s', expected '%s'.", true,
-		                                   to_string(return_type), to_string(function_type));
+		                                   to_string(&return_type), to_string(function_type));
 	}
-	free(return_type);
 }
 
 // Setup an AST Visitor for checking that return values have the correct type
@@ -731,27 +823,16 @@ static void cb_type_check_return_value(struct mcc_ast_function_definition *funct
 	assert(data);
 
 	struct type_checking_userdata *t_c_userdata = data;
-	struct return_value_userdata *r_v_userdata = malloc(sizeof(*r_v_userdata));
-	if (!r_v_userdata) {
-		t_c_userdata->error = MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
-		return;
-	}
-	r_v_userdata->check = t_c_userdata->check;
-	r_v_userdata->error = t_c_userdata->error;
-	r_v_userdata->function_type = get_new_data_type();
-	if (!r_v_userdata->function_type) {
-		t_c_userdata->error = MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
-		return;
-	}
-	r_v_userdata->function_type->type = ast_to_semantic_check_type(function->type);
+	struct mcc_semantic_check_data_type function_type = new_data_type(ast_to_semantic_check_type(function->type));
+	struct return_value_userdata r_v_userdata = {
+	    .check = t_c_userdata->check,
+	    .function_type = &function_type,
+	    .error = t_c_userdata->error,
+	};
 
-	struct mcc_ast_visitor visitor = return_value_visitor(r_v_userdata);
+	struct mcc_ast_visitor visitor = return_value_visitor(&r_v_userdata);
 	mcc_ast_visit(function, &visitor);
-	t_c_userdata->error = r_v_userdata->error;
-	r_v_userdata->error = 0;
-	r_v_userdata->check = NULL;
-	free(r_v_userdata->function_type);
-	free(r_v_userdata);
+	t_c_userdata->error = r_v_userdata.error;
 }
 
 static void cb_type_conversion_assignment(struct mcc_ast_statement *statement, void *data)
@@ -762,50 +843,44 @@ static void cb_type_conversion_assignment(struct mcc_ast_statement *statement, v
 	struct type_checking_userdata *userdata = data;
 	struct mcc_semantic_check *check = userdata->check;
 	struct mcc_ast_assignment *assignment = statement->assignment;
-	struct mcc_semantic_check_data_type *lhs_type = NULL, *rhs_type = NULL, *index = NULL;
+	struct mcc_semantic_check_data_type lhs_type, rhs_type;
+	// The index of a variable assignment counts as integer
+	struct mcc_semantic_check_data_type index = new_data_type(MCC_SEMANTIC_CHECK_INT);
+	enum mcc_semantic_check_error_code error = MCC_SEMANTIC_CHECK_ERROR_OK;
 
 	switch (assignment->assignment_type) {
 	case MCC_AST_ASSIGNMENT_TYPE_VARIABLE:
-		lhs_type = check_and_get_type(assignment->variable_identifier, check, assignment->row);
-		rhs_type = check_and_get_type(assignment->variable_assigned_value, check);
+		error = check_and_get_type(assignment->variable_identifier, check, assignment->row, &lhs_type);
+		if (error == MCC_SEMANTIC_CHECK_ERROR_OK)
+			error = check_and_get_type(assignment->variable_assigned_value, check, &rhs_type);
 		break;
 	case MCC_AST_ASSIGNMENT_TYPE_ARRAY:
-		lhs_type = check_and_get_type(assignment->array_identifier, check, assignment->row);
-		rhs_type = check_and_get_type(assignment->array_assigned_value, check);
-		index = check_and_get_type(assignment->array_index, check);
+		error = check_and_get_type(assignment->array_identifier, check, assignment->row, &lhs_type);
+		if (error == MCC_SEMANTIC_CHECK_ERROR_OK)
+			error = check_and_get_type(assignment->array_assigned_value, check, &rhs_type);
+		if (error == MCC_SEMANTIC_CHECK_ERROR_OK)
+			error = check_and_get_type(assignment->array_index, check, &index);
+		lhs_type.is_array = false;
+		lhs_type.array_size = -1;
 		break;
 	default:
 		return;
 	}
 
-	if (!lhs_type || !rhs_type || (!index && assignment->assignment_type == MCC_AST_ASSIGNMENT_TYPE_ARRAY)) {
-		userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-		free(lhs_type);
-		free(rhs_type);
-		free(index);
-		return;
-	} else {
-		if (assignment->assignment_type == MCC_AST_ASSIGNMENT_TYPE_ARRAY) {
-			lhs_type->is_array = false;
-			lhs_type->array_size = -1;
-		}
-		if (index && !is_int(index)) {
-			userdata->error = mcc_semantic_check_raise_error(userdata->error, 0, check, assignment->node,
-			                                                 "array subscript is not an integer.", false);
-		} else if (!types_equal(lhs_type, rhs_type)) {
-			userdata->error =
-			    mcc_semantic_check_raise_error(userdata->error, 2, check, assignment->node,
-			                                   "implicit type conversion. Expected '%s' but was '%s'", true,
-			                                   to_string(lhs_type), to_string(rhs_type));
-		} else if (lhs_type->is_array) {
-			userdata->error =
-			    mcc_semantic_check_raise_error(userdata->error, 0, check, assignment->node,
-			                                   "assignment to Variable of array type not possible.", false);
-		}
+	if (error != MCC_SEMANTIC_CHECK_ERROR_OK) {
+		userdata->error = error;
+	} else if (!is_int(&index)) {
+		userdata->error = mcc_semantic_check_raise_error(userdata->error, 0, check, assignment->node,
+		                                                 "array subscript is not an integer.", false);
+	} else if (!types_equal(&lhs_type, &rhs_type)) {
+		userdata->error = mcc_semantic_check_raise_error(userdata->error, 2, check, assignment->node,
+		                                                 "implicit type conversion. Expected '%s' but was '%s'",
+		                                                 true, to_string(&lhs_type), to_string(&rhs_type));
+	} else if (lhs_type.is_array) {
+		userdata->error =
+		    mcc_semantic_check_raise_error(userdata->error, 0, check, assignment->node,
+		                                   "assignment to Variable of array type not possible.", false);
 	}
-	free(lhs_type);
-	free(rhs_type);
-	free(index);
 }
 
 static void cb_type_check_if_stmt(struct mcc_ast_statement *statement, void *data)
@@ -816,16 +891,16 @@ static void cb_type_check_if_stmt(struct mcc_ast_statement *statement, void *dat
 	struct type_checking_userdata *userdata = data;
 	struct mcc_semantic_check *check = userdata->check;
 	struct mcc_ast_expression *if_condition = statement->if_condition;
-	struct mcc_semantic_check_data_type *type = check_and_get_type(if_condition, check);
+	struct mcc_semantic_check_data_type type;
+	enum mcc_semantic_check_error_code error = check_and_get_type(if_condition, check, &type);
 
-	if (!type) {
-		userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-	} else if (!is_bool(type)) {
+	if (error != MCC_SEMANTIC_CHECK_ERROR_OK) {
+		userdata->error = error;
+	} else if (!is_bool(&type)) {
 		userdata->error = mcc_semantic_check_raise_error(
 		    userdata->error, 1, check, if_condition->node,
-		    "condition of if-statement of type '%s', expected type 'BOOL'.", true, to_string(type));
+		    "condition of if-statement of type '%s', expected type 'BOOL'.", true, to_string(&type));
 	}
-	free(type);
 }
 
 static void cb_type_check_if_else_stmt(struct mcc_ast_statement *statement, void *data)
@@ -836,16 +911,16 @@ static void cb_type_check_if_else_stmt(struct mcc_ast_statement *statement, void
 	struct type_checking_userdata *userdata = data;
 	struct mcc_semantic_check *check = userdata->check;
 	struct mcc_ast_expression *if_condition = statement->if_else_condition;
-	struct mcc_semantic_check_data_type *type = check_and_get_type(if_condition, check);
+	struct mcc_semantic_check_data_type type;
+	enum mcc_semantic_check_error_code error = check_and_get_type(if_condition, check, &type);
 
-	if (!type) {
-		userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-	} else if (!is_bool(type)) {
+	if (error != MCC_SEMANTIC_CHECK_ERROR_OK) {
+		userdata->error = error;
+	} else if (!is_bool(&type)) {
 		userdata->error = mcc_semantic_check_raise_error(
 		    userdata->error, 1, check, if_condition->node,
-		    "condition of if-statement of type '%s', expected type 'BOOL'.", true, to_string(type));
+		    "condition of if-statement of type '%s', expected type 'BOOL'.", true, to_string(&type));
 	}
-	free(type);
 }
 
 static void cb_type_check_while_stmt(struct mcc_ast_statement *statement, void *data)
@@ -856,16 +931,16 @@ static void cb_type_check_while_stmt(struct mcc_ast_statement *statement, void *
 	struct type_checking_userdata *userdata = data;
 	struct mcc_semantic_check *check = userdata->check;
 	struct mcc_ast_expression *while_condition = statement->while_condition;
-	struct mcc_semantic_check_data_type *type = check_and_get_type(while_condition, check);
+	struct mcc_semantic_check_data_type type;
+	enum mcc_semantic_check_error_code error = check_and_get_type(while_condition, check, &type);
 
-	if (!type) {
-		userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-	} else if (!is_bool(type)) {
+	if (error != MCC_SEMANTIC_CHECK_ERROR_OK) {
+		userdata->error = error;
+	} else if (!is_bool(&type)) {
 		userdata->error = mcc_semantic_check_raise_error(
 		    userdata->error, 1, check, while_condition->node,
-		    "condition of while-loop of type '%s', expected type 'BOOL'.", true, to_string(type));
+		    "condition of while-loop of type '%s', expected type 'BOOL'.", true, to_string(&type));
 	}
-	free(type);
 }
 
 static void cb_type_check_expression_stmt(struct mcc_ast_statement *statement, void *data)
@@ -877,12 +952,12 @@ static void cb_type_check_expression_stmt(struct mcc_ast_statement *statement, v
 	struct mcc_semantic_check *check = userdata->check;
 	struct mcc_ast_expression *expression = statement->stmt_expression;
 	// check the expression. No Error handling needed
-	struct mcc_semantic_check_data_type *type = check_and_get_type(expression, check);
+	struct mcc_semantic_check_data_type type;
+	enum mcc_semantic_check_error_code error = check_and_get_type(expression, check, &type);
 
-	if (!type) {
-		userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
+	if (error != MCC_SEMANTIC_CHECK_ERROR_OK) {
+		userdata->error = error;
 	}
-	free(type);
 }
 
 static struct mcc_ast_visitor type_checking_visitor(struct type_checking_userdata *userdata)
@@ -951,8 +1026,11 @@ static bool recursively_check_nonvoid_property(struct mcc_ast_compound_statement
 	if (!compound_statement)
 		return false;
 
-	return (check_nonvoid_property(compound_statement->statement) ||
-	        recursively_check_nonvoid_property(compound_statement->next_compound_statement));
+	for (unsigned i = 0; i < compound_statement->num_statements; i++) {
+		if (check_nonvoid_property(compound_statement->statements[i]))
+			return true;
+	}
+	return false;
 }
 
 static enum mcc_semantic_check_error_code run_nonvoid_check(struct mcc_ast_function_definition *function,
@@ -984,16 +1062,168 @@ enum mcc_semantic_check_error_code mcc_semantic_check_run_nonvoid_check(struct m
 
 	enum mcc_semantic_check_error_code error = MCC_SEMANTIC_CHECK_ERROR_OK;
 
-	do {
+	// An empty program has no function
+	for (; ast && ast->function; ast = ast->next_function) {
 		error = run_nonvoid_check(ast->function, check);
 		if (error != MCC_SEMANTIC_CHECK_ERROR_OK)
 			break;
-		ast = ast->next_function;
-	} while (ast);
+	}
 
 	return error;
 }
 
+// ------------------------------------------------------------- Function table
+
+// Signature of a function definition
+struct function_signature {
+	// NULL for the built_ins
+	struct mcc_ast_program *program;
+	// Number of definitions with the same name, only counted at the first definition
+	int num_definitions;
+	int num_params;
+	struct mcc_semantic_check_data_type *param_types;
+};
+
+struct mcc_semantic_check_function_table {
+	// Interned function name -> signature of its first definition
+	struct mcc_hash_map *signatures;
+	// All definitions in the order of the program
+	struct function_signature *definitions;
+	int num_definitions;
+};
+
+static void delete_function_table(struct mcc_semantic_check_function_table *table)
+{
+	if (!table)
+		return;
+	for (int i = 0; i < table->num_definitions; i++) {
+		free(table->definitions[i].param_types);
+	}
+	free(table->definitions);
+	mcc_hash_map_delete(table->signatures);
+	free(table);
+}
+
+// Indexes signature by the interned name, unless an earlier definition has the same name
+static bool index_signature(struct mcc_semantic_check_function_table *table,
+                            struct function_signature *signature,
+                            char *name)
+{
+	struct function_signature *first = mcc_hash_map_get(table->signatures, name);
+	if (first) {
+		first->num_definitions++;
+		return true;
+	}
+	return mcc_hash_map_set(table->signatures, name, signature);
+}
+
+static bool add_signature(struct mcc_semantic_check_function_table *table,
+                          struct function_signature *signature,
+                          struct mcc_ast_program *program)
+{
+	assert(table);
+	assert(signature);
+	assert(program);
+
+	struct mcc_ast_parameters *params = program->function->parameters;
+	signature->program = program;
+	signature->num_definitions = 1;
+	signature->num_params = params ? (int)params->num_parameters : 0;
+	signature->param_types = NULL;
+
+	if (signature->num_params > 0) {
+		signature->param_types = malloc(signature->num_params * sizeof(*signature->param_types));
+		if (!signature->param_types)
+			return false;
+		for (int i = 0; i < signature->num_params; i++) {
+			signature->param_types[i] = get_data_type_declaration(params->declarations[i]);
+		}
+	}
+
+	return index_signature(table, signature, program->function->identifier->identifier_name);
+}
+
+static bool add_built_in_signature(struct mcc_semantic_check_function_table *table,
+                                   struct function_signature *signature,
+                                   const struct mcc_ast_built_in *built_in)
+{
+	assert(table);
+	assert(signature);
+	assert(built_in);
+
+	signature->program = NULL;
+	signature->num_definitions = 1;
+	signature->num_params = built_in->parameter_type == VOID ? 0 : 1;
+	signature->param_types = NULL;
+
+	if (signature->num_params > 0) {
+		signature->param_types = malloc(sizeof(*signature->param_types));
+		if (!signature->param_types)
+			return false;
+		signature->param_types[0] = new_data_type(ast_to_semantic_check_type(built_in->parameter_type));
+	}
+
+	char *name = mcc_intern(built_in->name);
+	if (!name)
+		return false;
+	return index_signature(table, signature, name);
+}
+
+// Collects the signatures of all functions of the program once per check. Returns NULL if memory allocation failed.
+static struct mcc_semantic_check_function_table *get_function_table(struct mcc_ast_program *ast,
+                                                                    struct mcc_semantic_check *check)
+{
+	assert(ast);
+	assert(check);
+
+	if (check->functions)
+		return check->functions;
+
+	struct mcc_semantic_check_function_table *table = malloc(sizeof(*table));
+	if (!table)
+		return NULL;
+	// The built_ins follow the functions of the program, an empty program has no function
+	table->num_definitions = MCC_AST_NUM_BUILT_INS;
+	for (struct mcc_ast_program *program = ast; program && program->function; program = program->next_function) {
+		table->num_definitions++;
+	}
+	table->definitions = calloc(table->num_definitions, sizeof(*table->definitions));
+	table->signatures = mcc_hash_map_new_pointer();
+	if (!table->definitions || !table->signatures) {
+		delete_function_table(table);
+		return NULL;
+	}
+
+	struct mcc_ast_program *program = ast;
+	int num_functions = table->num_definitions - MCC_AST_NUM_BUILT_INS;
+	for (int i = 0; i < num_functions; i++, program = program->next_function) {
+		if (!add_signature(table, &table->definitions[i], program)) {
+			delete_function_table(table);
+			return NULL;
+		}
+	}
+	for (int i = 0; i < MCC_AST_NUM_BUILT_INS; i++) {
+		if (!add_built_in_signature(table, &table->definitions[num_functions + i], &mcc_ast_built_ins[i])) {
+			delete_function_table(table);
+			return NULL;
+		}
+	}
+	check->functions = table;
+	return table;
+}
+
+// Returns the signature of the first function with the given name, NULL if there is none
+static struct function_signature *get_signature(struct mcc_semantic_check_function_table *table, const char *name)
+{
+	assert(table);
+	assert(name);
+
+	name = mcc_intern_lookup(name);
+	if (!name)
+		return NULL;
+	return mcc_hash_map_get(table->signatures, name);
+}
+
 // ------------------------------------------------------------- checking for correct main function
 
 enum mcc_semantic_check_error_code mcc_semantic_check_run_main_function(struct mcc_ast_program *ast,
@@ -1007,29 +1237,22 @@ enum mcc_semantic_check_error_code mcc_semantic_check_run_main_function(struct m
 	assert(check->status == MCC_SEMANTIC_CHECK_OK);
 	assert(!check->error_buffer);
 
-	// Memorize AST entry point to get the correct filename later
-	struct mcc_ast_program *original_ast = ast;
-	int number_of_mains = 0;
-
-	do {
-		if (strcmp(ast->function->identifier->identifier_name, "main") == 0) {
-			number_of_mains += 1;
-			if (number_of_mains > 1) {
-				return mcc_semantic_check_raise_error(0, check, original_ast->node,
-				                                      "Too many main functions defined.", false);
-			}
-			if (!(ast->function->parameters->is_empty)) {
-				return mcc_semantic_check_raise_error(0, check, original_ast->node,
-				                                      "Main has wrong signature. "
-				                                      "Must be `int main()`.",
-				                                      false);
-			}
-		}
-		ast = ast->next_function;
-	} while (ast);
+	struct mcc_semantic_check_function_table *table = get_function_table(ast, check);
+	if (!table)
+		return MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
 
-	if (number_of_mains == 0) {
-		return mcc_semantic_check_raise_error(0, check, original_ast->node, "No main function defined.", false);
+	struct function_signature *main_function = get_signature(table, "main");
+	if (!main_function) {
+		return mcc_semantic_check_raise_error(0, check, ast->node, "No main function defined.", false);
+	}
+	if (main_function->num_params != 0) {
+		return mcc_semantic_check_raise_error(0, check, ast->node,
+		                                      "Main has wrong signature. "
+		                                      "Must be `int main()`.",
+		                                      false);
+	}
+	if (main_function->num_definitions > 1) {
+		return mcc_semantic_check_raise_error(0, check, ast->node, "Too many main functions defined.", false);
 	}
 
 	return MCC_SEMANTIC_CHECK_ERROR_OK;
@@ -1045,33 +1268,18 @@ enum mcc_semantic_check_error_code mcc_semantic_check_run_multiple_function_defi
 	assert(!check->error_buffer);
 	assert(ast);
 
-	struct mcc_ast_program *program_to_check = ast;
-
-	// Program has only one function
-	if (!program_to_check->next_function) {
-		return MCC_SEMANTIC_CHECK_ERROR_OK;
-	}
-
-	while (program_to_check->next_function) {
-		struct mcc_ast_program *program_to_compare = program_to_check->next_function;
-		char *name_of_check = program_to_check->function->identifier->identifier_name;
-		char *name_of_compare = program_to_compare->function->identifier->identifier_name;
+	struct mcc_semantic_check_function_table *table = get_function_table(ast, check);
+	if (!table)
+		return MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
 
-		if (strcmp(name_of_check, name_of_compare) == 0) {
-			return mcc_semantic_check_raise_error(1, check, program_to_check->node, "redefinition of '%s'.",
-			                                      false, name_of_compare);
-		}
-		// compare all next_functions
-		while (program_to_compare->next_function) {
-			program_to_compare = program_to_compare->next_function;
-			char *name_of_compare = program_to_compare->function->identifier->identifier_name;
-			if (strcmp(name_of_check, name_of_compare) == 0) {
-				return mcc_semantic_check_raise_error(1, check, program_to_check->node,
-				                                      "redefinition of '%s'.", false, name_of_compare);
-			}
+	// Report at the first function whose name is defined more than once
+	for (int i = 0; i < table->num_definitions; i++) {
+		struct function_signature *signature = &table->definitions[i];
+		if (signature->num_definitions > 1) {
+			return mcc_semantic_check_raise_error(1, check, signature->program->node, "redefinition of '%s'.",
+			                                      false,
+			                                      signature->program->function->identifier->identifier_name);
 		}
-
-		program_to_check = program_to_check->next_function;
 	}
 
 	return MCC_SEMANTIC_CHECK_ERROR_OK;
@@ -1079,6 +1287,25 @@ enum mcc_semantic_check_error_code mcc_semantic_check_run_multiple_function_defi
 
 // ------------------------------------------------------------- check for multiple variable declarations
 
+static enum mcc_semantic_check_error_code
+check_scope_for_multiple_variable_declaration(struct mcc_symbol_table_scope *scope, struct mcc_semantic_check *check);
+
+// Checks all child scopes of a row
+static enum mcc_semantic_check_error_code check_child_scopes_for_multiple_variable_declaration(
+    struct mcc_symbol_table_row *row, struct mcc_semantic_check *check)
+{
+	assert(row);
+	assert(check);
+
+	enum mcc_semantic_check_error_code error = MCC_SEMANTIC_CHECK_ERROR_OK;
+	struct mcc_symbol_table_scope *child_scope = row->child_scope;
+	while (child_scope && error == MCC_SEMANTIC_CHECK_ERROR_OK) {
+		error = check_scope_for_multiple_variable_declaration(child_scope, check);
+		child_scope = child_scope->next_scope;
+	}
+	return error;
+}
+
 static enum mcc_semantic_check_error_code
 check_scope_for_multiple_variable_declaration(struct mcc_symbol_table_scope *scope, struct mcc_semantic_check *check)
 {
@@ -1095,40 +1322,29 @@ check_scope_for_multiple_variable_declaration(struct mcc_symbol_table_scope *sco
 		return error;
 	}
 
-	struct mcc_symbol_table_row *row_to_check = scope->head;
-
-	// Recursively check child scope of current row
-	if (row_to_check->child_scope) {
-		error = check_scope_for_multiple_variable_declaration(row_to_check->child_scope, check);
-		if (error != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			return error;
-		}
+	// Recursively check child scopes of the first row
+	error = check_child_scopes_for_multiple_variable_declaration(scope->head, check);
+	if (error != MCC_SEMANTIC_CHECK_ERROR_OK) {
+		return error;
 	}
 
-	struct mcc_symbol_table_row *row_to_compare = NULL;
-	while (row_to_check->next_row) {
-
-		row_to_compare = row_to_check->next_row;
-
-		if (strcmp(row_to_check->name, row_to_compare->name) == 0) {
-			return mcc_semantic_check_raise_error(1, check, *(row_to_compare->node),
-			                                      "redefinition of '%s'.", false, row_to_check->name);
-		}
-
-		while (row_to_compare->next_row) {
-			row_to_compare = row_to_compare->next_row;
-			if (strcmp(row_to_check->name, row_to_compare->name) == 0) {
-				return mcc_semantic_check_raise_error(1, check, *(row_to_compare->node),
-				                                      "redefinition of '%s'.", false,
-				                                      row_to_check->name);
-			}
+	// Redefinitions were linked to the previous declaration of the same name when the rows were inserted
+	struct mcc_symbol_table_row *row = scope->head;
+	while (row) {
+		if (row->prev_declaration) {
+			return mcc_semantic_check_raise_error(1, check, *(row->node), "redefinition of '%s'.", false,
+			                                      row->name);
 		}
-
-		row_to_check = row_to_check->next_row;
+		row = row->next_row;
 	}
 
-	if (row_to_check->child_scope) {
-		error = check_scope_for_multiple_variable_declaration(row_to_check->child_scope, check);
+	row = scope->head->next_row;
+	while (row) {
+		error = check_child_scopes_for_multiple_variable_declaration(row, check);
+		if (error != MCC_SEMANTIC_CHECK_ERROR_OK) {
+			return error;
+		}
+		row = row->next_row;
 	}
 	return error;
 }
@@ -1163,77 +1379,34 @@ enum mcc_semantic_check_error_code mcc_semantic_check_run_multiple_variable_decl
 
 struct function_arguments_userdata {
 	struct mcc_semantic_check *check;
-	struct mcc_ast_program *program;
+	struct mcc_semantic_check_function_table *functions;
 	enum mcc_semantic_check_error_code error;
 };
 
-static int get_number_of_params(struct mcc_ast_parameters *parameters)
-{
-	assert(parameters);
-
-	if (parameters->is_empty) {
-		return 0;
-	}
-	int num = 1;
-	while (parameters->next_parameters) {
-		num += 1;
-		parameters = parameters->next_parameters;
-	}
-	return num;
-}
-
-static int get_number_of_args(struct mcc_ast_arguments *arguments)
-{
-	assert(arguments);
-
-	if (arguments->is_empty) {
-		return 0;
-	}
-	int num = 1;
-	while (arguments->next_arguments) {
-		num += 1;
-		arguments = arguments->next_arguments;
-	}
-	return num;
-}
-
-static struct mcc_ast_parameters *get_params_from_ast(struct mcc_ast_program *ast, const char *name)
-{
-	assert(ast);
-	assert(name);
-	struct mcc_ast_parameters *params = NULL;
-	do {
-		if (strcmp(ast->function->identifier->identifier_name, name) == 0) {
-			params = ast->function->parameters;
-		}
-		ast = ast->next_function;
-	} while (ast);
-
-	return params;
-}
-
 static void cb_function_arguments_expression_function_call(struct mcc_ast_expression *expression, void *userdata)
 {
 	assert(expression);
 	assert(userdata);
 
 	struct function_arguments_userdata *data = userdata;
-	struct mcc_ast_program *ast = data->program;
 	struct mcc_semantic_check *check = data->check;
+	if (data->error != MCC_SEMANTIC_CHECK_ERROR_OK || check->status != MCC_SEMANTIC_CHECK_OK)
+		return;
 
 	// Get the used arguments from the AST:
 	struct mcc_ast_arguments *args = expression->arguments;
-	// Get the required parameters from the function declaration
-	struct mcc_ast_parameters *params = get_params_from_ast(ast, expression->function_identifier->identifier_name);
-	// No parameters found -> unkown function
-	if (!params) {
+	// Get the required parameters from the function table
+	struct function_signature *signature =
+	    get_signature(data->functions, expression->function_identifier->identifier_name);
+	// No signature found -> unkown function
+	if (!signature) {
 		data->error = mcc_semantic_check_raise_error(1, check, expression->node, "Undefined reference to '%s'",
 		                                             false, expression->function_identifier->identifier_name);
 		return;
 	}
 
-	int num_params = get_number_of_params(params);
-	int num_args = get_number_of_args(args);
+	int num_params = signature->num_params;
+	int num_args = (int)args->num_arguments;
 	if (num_params == 0 && num_args == 0) {
 		return;
 	} else if (num_args - num_params > 0) {
@@ -1248,31 +1421,22 @@ static void cb_function_arguments_expression_function_call(struct mcc_ast_expres
 		return;
 	}
 
-	struct mcc_semantic_check_data_type *type_expr = NULL, *type_decl = NULL;
-	do {
+	struct mcc_semantic_check_data_type type_expr;
+	for (int i = 0; i < num_params; i++) {
 		// Check for type error
-		type_expr = check_and_get_type(args->expression, check);
-		type_decl = check_and_get_type(params->declaration, check);
-		if (!type_expr || !type_decl) {
-			data->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-			free(type_decl);
-			free(type_expr);
+		enum mcc_semantic_check_error_code error = check_and_get_type(args->expressions[i], check, &type_expr);
+		if (error != MCC_SEMANTIC_CHECK_ERROR_OK) {
+			data->error = error;
 			return;
 		}
-		if (!types_equal(type_expr, type_decl)) {
+		struct mcc_semantic_check_data_type *type_decl = &signature->param_types[i];
+		if (!types_equal(&type_expr, type_decl)) {
 			data->error = mcc_semantic_check_raise_error(2, check, expression->node,
 			                                             "Expected '%s' but argument is of type '%s'", true,
-			                                             to_string(type_decl), to_string(type_expr));
-			free(type_expr);
-			free(type_decl);
+			                                             to_string(type_decl), to_string(&type_expr));
 			return;
 		}
-		free(type_expr);
-		free(type_decl);
-
-		params = params->next_parameters;
-		args = args->next_arguments;
-	} while (params && args);
+	}
 	return;
 }
 
@@ -1298,11 +1462,15 @@ enum mcc_semantic_check_error_code mcc_semantic_check_run_function_arguments(str
 	assert(!check->error_buffer);
 	assert(check->status == MCC_SEMANTIC_CHECK_OK);
 
+	struct mcc_semantic_check_function_table *functions = get_function_table(ast, check);
+	if (!functions)
+		return MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
+
 	struct function_arguments_userdata *userdata = malloc(sizeof(*userdata));
 	if (!userdata)
 		return MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
 	userdata->check = check;
-	userdata->program = ast;
+	userdata->functions = functions;
 	userdata->error = MCC_SEMANTIC_CHECK_ERROR_OK;
 
 	struct mcc_ast_visitor visitor = function_arguments_visitor(userdata);
@@ -1312,12 +1480,267 @@ enum mcc_semantic_check_error_code mcc_semantic_check_run_function_arguments(str
 	return error;
 }
 
+// ------------------------------------------------------------- Fused semantic checks
+
+// The checks of the AST share one traversal. Each of them reports to a check of its own, so that the first error of
+// each is known afterwards and the one the separate checks find first can be reported.
+struct fused_checks_userdata {
+	struct mcc_semantic_check_data_type function_type;
+	// Type errors of the functions that were traversed completely. The separate type check reports the return values
+	// of a function before its other statements, so both are collected until the function ends.
+	struct mcc_semantic_check type_errors;
+	struct mcc_semantic_check return_errors;
+	struct mcc_semantic_check statement_errors;
+	struct type_checking_userdata type_checking;
+	struct return_value_userdata return_value;
+	struct mcc_semantic_check nonvoid_errors;
+	enum mcc_semantic_check_error_code nonvoid;
+	struct mcc_semantic_check argument_errors;
+	struct function_arguments_userdata function_arguments;
+};
+
+static struct mcc_semantic_check empty_check(void)
+{
+	return (struct mcc_semantic_check){MCC_SEMANTIC_CHECK_OK, NULL, NULL};
+}
+
+static void clear_check(struct mcc_semantic_check *check)
+{
+	free(check->error_buffer);
+	*check = empty_check();
+}
+
+// Moves the error of from to check, unless check already has one
+static void move_error(struct mcc_semantic_check *check, struct mcc_semantic_check *from)
+{
+	if (check->status == MCC_SEMANTIC_CHECK_OK && from->status != MCC_SEMANTIC_CHECK_OK) {
+		check->status = from->status;
+		check->error_buffer = from->error_buffer;
+		from->error_buffer = NULL;
+	}
+	clear_check(from);
+}
+
+// A check is done once it found an error, or once an earlier check did, since only the first error is reported
+static bool type_check_done(struct fused_checks_userdata *data)
+{
+	return data->type_errors.status != MCC_SEMANTIC_CHECK_OK ||
+	       data->type_checking.error != MCC_SEMANTIC_CHECK_ERROR_OK ||
+	       data->return_value.error != MCC_SEMANTIC_CHECK_ERROR_OK;
+}
+
+static bool nonvoid_check_done(struct fused_checks_userdata *data)
+{
+	return type_check_done(data) || data->nonvoid_errors.status != MCC_SEMANTIC_CHECK_OK ||
+	       data->nonvoid != MCC_SEMANTIC_CHECK_ERROR_OK;
+}
+
+static bool function_arguments_done(struct fused_checks_userdata *data)
+{
+	return nonvoid_check_done(data) || data->argument_errors.status != MCC_SEMANTIC_CHECK_OK ||
+	       data->function_arguments.error != MCC_SEMANTIC_CHECK_ERROR_OK;
+}
+
+static void finish_function(struct fused_checks_userdata *data)
+{
+	move_error(&data->type_errors, &data->return_errors);
+	move_error(&data->type_errors, &data->statement_errors);
+}
+
+static void cb_fused_function_definition(struct mcc_ast_function_definition *function, void *userdata)
+{
+	struct fused_checks_userdata *data = userdata;
+	finish_function(data);
+
+	data->function_type.type = ast_to_semantic_check_type(function->type);
+	if (!nonvoid_check_done(data))
+		data->nonvoid = run_nonvoid_check(function, &data->nonvoid_errors);
+}
+
+static void cb_fused_return(struct mcc_ast_statement *statement, void *userdata)
+{
+	struct fused_checks_userdata *data = userdata;
+	if (!type_check_done(data) && data->return_errors.status == MCC_SEMANTIC_CHECK_OK)
+		cb_return_value(statement, &data->return_value);
+}
+
+// Statements of the type check other than return
+static bool type_check_statement(struct fused_checks_userdata *data)
+{
+	return !type_check_done(data) && data->statement_errors.status == MCC_SEMANTIC_CHECK_OK;
+}
+
+static void cb_fused_assignment(struct mcc_ast_statement *statement, void *userdata)
+{
+	struct fused_checks_userdata *data = userdata;
+	if (type_check_statement(data))
+		cb_type_conversion_assignment(statement, &data->type_checking);
+}
+
+static void cb_fused_if_stmt(struct mcc_ast_statement *statement, void *userdata)
+{
+	struct fused_checks_userdata *data = userdata;
+	if (type_check_statement(data))
+		cb_type_check_if_stmt(statement, &data->type_checking);
+}
+
+static void cb_fused_if_else_stmt(struct mcc_ast_statement *statement, void *userdata)
+{
+	struct fused_checks_userdata *data = userdata;
+	if (type_check_statement(data))
+		cb_type_check_if_else_stmt(statement, &data->type_checking);
+}
+
+static void cb_fused_while_stmt(struct mcc_ast_statement *statement, void *userdata)
+{
+	struct fused_checks_userdata *data = userdata;
+	if (type_check_statement(data))
+		cb_type_check_while_stmt(statement, &data->type_checking);
+}
+
+static void cb_fused_expression_stmt(struct mcc_ast_statement *statement, void *userdata)
+{
+	struct fused_checks_userdata *data = userdata;
+	if (type_check_statement(data))
+		cb_type_check_expression_stmt(statement, &data->type_checking);
+}
+
+static void cb_fused_function_call(struct mcc_ast_expression *expression, void *userdata)
+{
+	struct fused_checks_userdata *data = userdata;
+	if (function_arguments_done(data))
+		return;
+
+	cb_function_arguments_expression_function_call(expression, &data->function_arguments);
+	if (data->argument_errors.status == MCC_SEMANTIC_CHECK_OK)
+		return;
+
+	// The separate check visits the calls in post order, so an error of a call among the arguments precedes this one.
+	// The calls visited before this one had no error, so only the arguments are checked again.
+	struct mcc_semantic_check nested = empty_check();
+	struct function_arguments_userdata nested_arguments = {
+	    .check = &nested,
+	    .functions = data->function_arguments.functions,
+	    .error = MCC_SEMANTIC_CHECK_ERROR_OK,
+	};
+	struct mcc_ast_visitor visitor = function_arguments_visitor(&nested_arguments);
+	mcc_ast_visit(expression->arguments, &visitor);
+	if (nested_arguments.error != MCC_SEMANTIC_CHECK_ERROR_OK) {
+		data->function_arguments.error = nested_arguments.error;
+	} else if (nested.status != MCC_SEMANTIC_CHECK_OK) {
+		clear_check(&data->argument_errors);
+		move_error(&data->argument_errors, &nested);
+	}
+	clear_check(&nested);
+}
+
+static struct mcc_ast_visitor fused_checks_visitor(struct fused_checks_userdata *data)
+{
+	return (struct mcc_ast_visitor){
+	    .order = MCC_AST_VISIT_PRE_ORDER,
+
+	    .userdata = data,
+
+	    .function_definition = cb_fused_function_definition,
+	    .statement_return = cb_fused_return,
+	    .statement_assignment = cb_fused_assignment,
+	    .statement_if_stmt = cb_fused_if_stmt,
+	    .statement_if_else_stmt = cb_fused_if_else_stmt,
+	    .statement_while = cb_fused_while_stmt,
+	    .statement_expression_stmt = cb_fused_expression_stmt,
+	    .expression_function_call = cb_fused_function_call,
+	};
+}
+
+// Reports the result of a check that shared the traversal, with the early aborts of run_check_early_abrt
+static enum mcc_semantic_check_error_code report_fused_early_abrt(struct mcc_semantic_check *check,
+                                                                  struct mcc_semantic_check *fused,
+                                                                  enum mcc_semantic_check_error_code fused_error,
+                                                                  enum mcc_semantic_check_error_code previous_return)
+{
+	if (previous_return != MCC_SEMANTIC_CHECK_ERROR_OK)
+		return previous_return;
+	if (check->status != MCC_SEMANTIC_CHECK_OK)
+		return MCC_SEMANTIC_CHECK_ERROR_OK;
+	if (fused_error != MCC_SEMANTIC_CHECK_ERROR_OK)
+		return fused_error;
+	move_error(check, fused);
+	return MCC_SEMANTIC_CHECK_ERROR_OK;
+}
+
+enum mcc_semantic_check_error_code mcc_semantic_check_run_fused(struct mcc_ast_program *ast,
+                                                                struct mcc_symbol_table *symbol_table,
+                                                                struct mcc_semantic_check *check)
+{
+	assert(ast);
+	assert(symbol_table);
+	assert(check);
+
+	struct mcc_semantic_check_function_table *functions = get_function_table(ast, check);
+	if (!functions)
+		return MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
+
+	struct fused_checks_userdata data = {
+	    .function_type = {MCC_SEMANTIC_CHECK_UNKNOWN, -1, false},
+	    .type_errors = empty_check(),
+	    .return_errors = empty_check(),
+	    .statement_errors = empty_check(),
+	    .type_checking = {&data.statement_errors, MCC_SEMANTIC_CHECK_ERROR_OK},
+	    .return_value = {&data.return_errors, &data.function_type, MCC_SEMANTIC_CHECK_ERROR_OK},
+	    .nonvoid_errors = empty_check(),
+	    .nonvoid = MCC_SEMANTIC_CHECK_ERROR_OK,
+	    .argument_errors = empty_check(),
+	    .function_arguments = {&data.argument_errors, functions, MCC_SEMANTIC_CHECK_ERROR_OK},
+	};
+	struct mcc_ast_visitor visitor = fused_checks_visitor(&data);
+	mcc_ast_visit(ast, &visitor);
+	finish_function(&data);
+
+	enum mcc_semantic_check_error_code type_error = data.return_value.error != MCC_SEMANTIC_CHECK_ERROR_OK
+	                                                    ? data.return_value.error
+	                                                    : data.type_checking.error;
+	enum mcc_semantic_check_error_code error =
+	    report_fused_early_abrt(check, &data.type_errors, type_error, MCC_SEMANTIC_CHECK_ERROR_OK);
+	error = report_fused_early_abrt(check, &data.nonvoid_errors, data.nonvoid, error);
+	// These checks only look at the function table and the symbol table
+	error = run_check_early_abrt(mcc_semantic_check_run_main_function, ast, symbol_table, check, error);
+	error = run_check_early_abrt(mcc_semantic_check_run_multiple_function_definitions, ast, symbol_table, check,
+	                             error);
+	error = run_check_early_abrt(mcc_semantic_check_run_multiple_variable_declarations, ast, symbol_table, check,
+	                             error);
+	error = report_fused_early_abrt(check, &data.argument_errors, data.function_arguments.error, error);
+
+	clear_check(&data.type_errors);
+	clear_check(&data.nonvoid_errors);
+	clear_check(&data.argument_errors);
+	return error;
+}
+
+// Run all semantic checks, returns NULL if library functions fail
+struct mcc_semantic_check *mcc_semantic_check_run_all(struct mcc_ast_program *ast,
+                                                      struct mcc_symbol_table *symbol_table)
+{
+	assert(ast);
+	assert(symbol_table);
+
+	struct mcc_semantic_check *check = mcc_semantic_check_initialize_check();
+	if (!check)
+		return NULL;
+
+	if (mcc_semantic_check_run_fused(ast, symbol_table, check) != MCC_SEMANTIC_CHECK_ERROR_OK) {
+		mcc_semantic_check_delete_single_check(check);
+		return NULL;
+	}
+	return check;
+}
+
 // ------------------------------------------------------------- Functions: Cleanup
 
 void mcc_semantic_check_delete_single_check(struct mcc_semantic_check *check)
 {
 	if (check == NULL)
 		return;
+	delete_function_table(check->functions);
 	free(check->error_buffer);
 	free(check);
 }
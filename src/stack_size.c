@@ -5,115 +5,96 @@
 #include <stdlib.h>
 #include <string.h>
 
-struct mcc_annotated_ir *mcc_get_function_label(struct mcc_annotated_ir *an_ir)
+#include "mcc/arena.h"
+#include "utils/hash_map.h"
+
+void mcc_delete_annotated_ir(struct mcc_annotated_ir *an_ir)
 {
-	assert(an_ir);
-	while (an_ir && an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
-		an_ir = an_ir->prev;
-	}
-	return an_ir;
+	mcc_free(an_ir);
 }
 
-struct mcc_annotated_ir *mcc_new_annotated_ir(struct mcc_ir_row *row, int stack_size)
+// --------------------------------------------------------------------------------------- Layout state
+
+// Stack layout of the function that is currently annotated. Collected while walking over the IR once, so that
+// neither sizes nor positions require to rescan the function. Names are interned and looked up by pointer.
+struct stack_layout {
+	// Function label of the current function
+	struct mcc_annotated_ir *function;
+	int frame_size;
+	int current_position;
+	int pop_counter;
+	// Variable name -> first assignment to that variable
+	struct mcc_hash_map *variables;
+	// Array name -> array declaration
+	struct mcc_hash_map *arrays;
+	// Assignments to array elements whose array is not declared in the current function, see
+	// resolve_array_elements
+	bool has_unresolved;
+	struct mcc_hash_map *unresolved;
+};
+
+static bool begin_function(struct stack_layout *layout, struct mcc_annotated_ir *function)
 {
-	assert(row);
-	struct mcc_annotated_ir *ir = malloc(sizeof(*ir));
-	if (!ir)
-		return NULL;
-	ir->stack_size = stack_size;
-	ir->stack_position = 0;
-	ir->row = row;
-	ir->next = NULL;
-	ir->prev = NULL;
-	return ir;
+	if (layout->function) {
+		layout->function->stack_size = layout->frame_size;
+	}
+	mcc_hash_map_delete(layout->variables);
+	mcc_hash_map_delete(layout->arrays);
+
+	layout->function = function;
+	layout->frame_size = 0;
+	layout->current_position = 0;
+	layout->pop_counter = DWORD_SIZE;
+	layout->variables = mcc_hash_map_new_pointer();
+	layout->arrays = mcc_hash_map_new_pointer();
+	return layout->variables && layout->arrays;
 }
 
-void mcc_delete_annotated_ir(struct mcc_annotated_ir *head)
+static void end_layout(struct stack_layout *layout)
 {
-	if (!head)
-		return;
-
-	mcc_delete_annotated_ir(head->next);
-	free(head);
+	if (layout->function) {
+		layout->function->stack_size = layout->frame_size;
+	}
+	mcc_hash_map_delete(layout->variables);
+	mcc_hash_map_delete(layout->arrays);
+	mcc_hash_map_delete(layout->unresolved);
 }
 
-// --------------------------------------------------------------------------------------- Forward declarations
-
-static struct mcc_ir_row *first_line_of_function(struct mcc_ir_row *ir);
-static int get_row_size(struct mcc_ir_row *ir);
-
 // --------------------------------------------------------------------------------------- Calc stack size and position
 
-static bool assignment_is_first_occurence(struct mcc_ir_row *first, struct mcc_ir_row *ir)
+static int get_row_size(struct mcc_ir_row *ir)
 {
-	assert(first);
 	assert(ir);
-	assert(ir->instr == MCC_IR_INSTR_ASSIGN);
 
-	// Arrays are allocated when they're declared
-	if (ir->arg1->type == MCC_IR_TYPE_ARR_ELEM) {
-		return false;
-	}
-
-	char *id_name = ir->arg1->ident;
-	struct mcc_ir_row *head = first;
-	while (head != ir) {
-		if (head->instr != MCC_IR_INSTR_ASSIGN) {
-			head = head->next_row;
-			continue;
-		}
-		if (strcmp(head->arg1->ident, id_name) == 0) {
-			return false;
-		}
-		head = head->next_row;
-	}
-	return true;
+	if (ir->type.type != MCC_IR_ROW_TYPELESS)
+		return DWORD_SIZE;
+	return 0;
 }
 
-static int get_var_size(struct mcc_ir_row *ir)
+static int get_var_size(struct mcc_ir_row *ir, struct stack_layout *layout)
 {
 	assert(ir);
 	assert(ir->instr == MCC_IR_INSTR_ASSIGN);
 
-	struct mcc_ir_row *first = first_line_of_function(ir);
-
-	if (!assignment_is_first_occurence(first, ir)) {
+	// Arrays are allocated when they're declared
+	if (ir->arg1.type == MCC_IR_TYPE_ARR_ELEM) {
 		return 0;
 	}
-	if (ir->type->type != MCC_IR_ROW_TYPELESS)
-		return DWORD_SIZE;
-	return 0;
-}
-
-static struct mcc_ir_row *first_line_of_function(struct mcc_ir_row *ir)
-{
-	assert(ir);
-	do {
-		if (ir->instr == MCC_IR_INSTR_FUNC_LABEL)
-			return ir;
-		ir = ir->prev_row;
-
-	} while (ir);
-	return NULL;
-}
-
-static int get_row_size(struct mcc_ir_row *ir)
-{
-	assert(ir);
-
-	if (ir->type->type != MCC_IR_ROW_TYPELESS)
-		return DWORD_SIZE;
-	return 0;
+	// Variable was already allocated by a previous assignment
+	if (mcc_hash_map_get(layout->variables, ir->arg1.ident)) {
+		return 0;
+	}
+	return get_row_size(ir);
 }
 
-static int get_stack_frame_size(struct mcc_ir_row *ir)
+static int get_stack_frame_size(struct mcc_ir_row *ir, struct stack_layout *layout)
 {
 	assert(ir);
 
 	switch (ir->instr) {
 	// Assignment of variables to immediate value or temporary:
 	case MCC_IR_INSTR_ASSIGN:
-		return get_var_size(ir);
+		return get_var_size(ir, layout);
 
 	// Assignment of temporary: Int or Float
 	case MCC_IR_INSTR_PLUS:
@@ -140,7 +121,7 @@ static int get_stack_frame_size(struct mcc_ir_row *ir)
 
 	// Size of entire array
 	case MCC_IR_INSTR_ARRAY:
-		return get_row_size(ir) * ir->type->array_size;
+		return get_row_size(ir) * ir->type.array_size;
 
 	// Labels: Size 0
 	case MCC_IR_INSTR_LABEL:
@@ -157,181 +138,152 @@ static int get_stack_frame_size(struct mcc_ir_row *ir)
 	}
 }
 
-static struct mcc_annotated_ir *add_stack_sizes(struct mcc_ir_row *ir)
+static bool add_array_element_position(struct mcc_annotated_ir *head, struct stack_layout *layout)
 {
-	assert(ir);
-	assert(ir->instr == MCC_IR_INSTR_FUNC_LABEL);
-
-	struct mcc_annotated_ir *head = mcc_new_annotated_ir(ir, 0);
-	struct mcc_annotated_ir *first = head;
-	struct mcc_annotated_ir *new;
-	ir = ir->next_row;
-
-	while (ir) {
-		int size = get_stack_frame_size(ir);
-		new = mcc_new_annotated_ir(ir, size);
-		if (!new) {
-			mcc_delete_annotated_ir(first);
-			return NULL;
-		}
-		// If size == 0, we basically copy the previous line's stack_position to correctly reference later
-		// variables
-		new->prev = head;
-		head->next = new;
-		head = new;
+	struct mcc_ir_arg *array_element = &head->row->arg1;
 
-		ir = ir->next_row;
+	// Array index is not int literal -> computed during runtime
+	if (array_element->index.type != MCC_IR_TYPE_LIT_INT) {
+		head->stack_position = 0;
+		return true;
 	}
-	return first;
-}
-
-static int get_frame_size_of_function(struct mcc_annotated_ir *head)
-{
-	assert(head);
-	assert(head->row->instr == MCC_IR_INSTR_FUNC_LABEL);
-
-	int frame_size = 0;
-	head = head->next;
-	while (head && head->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
-		frame_size = frame_size + head->stack_size;
-		head = head->next;
+	struct mcc_annotated_ir *array = mcc_hash_map_get(layout->arrays, array_element->arr_ident);
+	if (!array) {
+		head->stack_position = 0;
+		layout->has_unresolved = true;
+		return mcc_hash_map_set(layout->unresolved, head, head);
 	}
-	return frame_size;
+	head->stack_position = array->stack_position + (array_element->index.lit_int) * get_row_size(array->row);
+	return true;
 }
 
-int mcc_get_array_base_stack_loc(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *array_base)
+static bool add_stack_position(struct mcc_annotated_ir *head, struct stack_layout *layout)
 {
-	assert(array_base);
-	assert(an_ir);
-	assert(an_ir->row->arg1 == array_base || an_ir->row->arg2 == array_base);
-
-	an_ir = mcc_get_function_label(an_ir);
-	while (an_ir) {
-		if (an_ir->row->instr == MCC_IR_INSTR_ARRAY) {
-			if (strcmp(an_ir->row->arg1->ident, array_base->arr_ident) == 0) {
-				return an_ir->stack_position;
+	struct mcc_ir_row *row = head->row;
+
+	switch (row->instr) {
+	// Variables
+	case MCC_IR_INSTR_ASSIGN:
+		if (row->arg1.type == MCC_IR_TYPE_ARR_ELEM) {
+			if (!add_array_element_position(head, layout))
+				return false;
+		} else {
+			struct mcc_annotated_ir *first = mcc_hash_map_get(layout->variables, row->arg1.ident);
+			if (first) {
+				head->stack_position = first->stack_position;
+				return true;
 			}
+			layout->current_position = layout->current_position - head->stack_size;
+			head->stack_position = layout->current_position;
 		}
-		an_ir = an_ir->next;
+		return mcc_hash_map_set_if_absent(layout->variables, row->arg1.ident, head);
+	// Arrays
+	case MCC_IR_INSTR_ARRAY:
+		layout->current_position = layout->current_position - get_row_size(row) * row->type.array_size;
+		head->stack_position = layout->current_position;
+		return mcc_hash_map_set_if_absent(layout->arrays, row->arg1.ident, head);
+	// Pop (Located on previous stack)
+	case MCC_IR_INSTR_POP:
+		layout->pop_counter += 4;
+		head->stack_position = layout->pop_counter;
+		layout->current_position = layout->current_position - head->stack_size;
+		return true;
+	// Rest
+	default:
+		layout->current_position = layout->current_position - head->stack_size;
+		head->stack_position = layout->current_position;
+		return true;
 	}
-	return 0;
 }
 
-int mcc_get_array_element_stack_loc(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *array_element)
+// Assignments to elements of arrays that are not declared in their function (i.e. array parameters) are located
+// relative to the next declaration of an array with the same name further down the IR, if there is one. At the
+// time of the assignment, that declaration has no stack position yet. Walk backwards over the IR to find it.
+static bool resolve_array_elements(struct mcc_annotated_ir *first, size_t num_rows, struct stack_layout *layout)
 {
-	assert(array_element);
-	assert(an_ir);
-	assert(an_ir->row->arg1 == array_element || an_ir->row->arg2 == array_element);
-
-	// Array index is not int literal -> computed during runtime
-	if (array_element->index->type != MCC_IR_TYPE_LIT_INT) {
-		return 0;
-	}
+	struct mcc_hash_map *next_arrays = mcc_hash_map_new_pointer();
+	if (!next_arrays)
+		return false;
 
-	an_ir = mcc_get_function_label(an_ir);
-	while (an_ir) {
-		if (an_ir->row->instr == MCC_IR_INSTR_ARRAY) {
-			if (strcmp(an_ir->row->arg1->ident, array_element->arr_ident) == 0) {
-				int array_pos = an_ir->stack_position;
-				int element_pos =
-				    array_pos + (array_element->index->lit_int) * get_row_size(an_ir->row);
-				return element_pos;
+	for (size_t i = num_rows; i-- > 0;) {
+		struct mcc_annotated_ir *an_ir = &first[i];
+		struct mcc_ir_row *row = an_ir->row;
+		if (row->instr == MCC_IR_INSTR_ARRAY) {
+			if (!mcc_hash_map_set(next_arrays, row->arg1.ident, an_ir)) {
+				mcc_hash_map_delete(next_arrays);
+				return false;
+			}
+		} else if (mcc_hash_map_get(layout->unresolved, an_ir)) {
+			struct mcc_annotated_ir *array = mcc_hash_map_get(next_arrays, row->arg1.arr_ident);
+			if (array) {
+				an_ir->stack_position = (row->arg1.index.lit_int) * get_row_size(array->row);
 			}
 		}
-		an_ir = an_ir->next;
 	}
-	return 0;
+	mcc_hash_map_delete(next_arrays);
+	return true;
 }
 
-int lookup_var_loc(struct mcc_annotated_ir *an_ir, struct mcc_annotated_ir *var)
+struct mcc_annotated_ir *mcc_annotate_ir(struct mcc_ir_function *ir)
 {
-	assert(an_ir);
-	assert(var);
-	assert(var->row->instr == MCC_IR_INSTR_ASSIGN);
+	assert(ir);
+	assert(ir->rows[0].instr == MCC_IR_INSTR_FUNC_LABEL);
 
-	an_ir = mcc_get_function_label(an_ir);
-	an_ir = an_ir->next;
+	size_t num_rows = 0;
+	for (struct mcc_ir_function *function = ir; function; function = function->next) {
+		num_rows += function->num_rows;
+	}
 
-	while (an_ir && (an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL)) {
-		if (an_ir->row->instr != MCC_IR_INSTR_ASSIGN) {
-			an_ir = an_ir->next;
-			continue;
-		}
-		if (strcmp(an_ir->row->arg1->ident, var->row->arg1->ident) == 0) {
-			return an_ir->stack_position;
-		}
-		an_ir = an_ir->next;
+	struct stack_layout layout = {
+	    .function = NULL,
+	    .variables = NULL,
+	    .arrays = NULL,
+	    .has_unresolved = false,
+	    .unresolved = mcc_hash_map_new_pointer(),
+	};
+	struct mcc_annotated_ir *first = mcc_alloc((num_rows + 1) * sizeof(*first));
+	if (!layout.unresolved || !first) {
+		end_layout(&layout);
+		mcc_free(first);
+		return NULL;
 	}
-	return 0;
-}
 
-static void add_stack_positions(struct mcc_annotated_ir *head)
-{
-	assert(head);
-	assert(head->row->instr == MCC_IR_INSTR_FUNC_LABEL);
-
-	struct mcc_annotated_ir *func = head;
-	head->stack_size = get_frame_size_of_function(head);
-	head = head->next;
-	int current_position = 0;
-	int pop_counter = DWORD_SIZE;
-
-	while (head) {
-		// Function label
-		if (head->row->instr == MCC_IR_INSTR_FUNC_LABEL) {
-			head->stack_size = get_frame_size_of_function(head);
-			current_position = 0;
-			pop_counter = DWORD_SIZE;
-			func = head;
-			head = head->next;
-			continue;
-		}
+	struct mcc_annotated_ir *head = first;
+	for (struct mcc_ir_function *function = ir; function; function = function->next) {
+		for (unsigned i = 0; i < function->num_rows; i++, head++) {
+			struct mcc_ir_row *row = &function->rows[i];
+			head->row = row;
+			head->stack_size = 0;
+			head->stack_position = 0;
+
+			// Function label
+			if (row->instr == MCC_IR_INSTR_FUNC_LABEL) {
+				if (!begin_function(&layout, head)) {
+					end_layout(&layout);
+					mcc_delete_annotated_ir(first);
+					return NULL;
+				}
+				continue;
+			}
 
-		// Variables
-		if (head->row->instr == MCC_IR_INSTR_ASSIGN) {
-			if (head->row->arg1->type == MCC_IR_TYPE_ARR_ELEM) {
-				head->stack_position = mcc_get_array_element_stack_loc(head, head->row->arg1);
-			} else if (!assignment_is_first_occurence(func->row, head->row)) {
-				head->stack_position = lookup_var_loc(func, head);
-			} else {
-				current_position = current_position - head->stack_size;
-				head->stack_position = current_position;
+			head->stack_size = get_stack_frame_size(row, &layout);
+			layout.frame_size += head->stack_size;
+			if (!add_stack_position(head, &layout)) {
+				end_layout(&layout);
+				mcc_delete_annotated_ir(first);
+				return NULL;
 			}
-			head = head->next;
-			continue;
 		}
-		// Arrays
-		if (head->row->instr == MCC_IR_INSTR_ARRAY) {
-			current_position = current_position - get_row_size(head->row) * head->row->type->array_size;
-			head->stack_position = current_position;
-			head = head->next;
-			continue;
-		}
-		// Pop (Located on previous stack)
-		if (head->row->instr == MCC_IR_INSTR_POP) {
-			pop_counter += 4;
-			head->stack_position = pop_counter;
-			current_position = current_position - head->stack_size;
-			head = head->next;
-			continue;
-		}
-
-		// Rest
-		current_position = current_position - head->stack_size;
-		head->stack_position = current_position;
-		head = head->next;
 	}
-}
-
-struct mcc_annotated_ir *mcc_annotate_ir(struct mcc_ir_row *ir)
-{
-	assert(ir);
-	assert(ir->instr == MCC_IR_INSTR_FUNC_LABEL);
+	head->row = NULL;
+	head->stack_size = 0;
+	head->stack_position = 0;
 
-	struct mcc_annotated_ir *an_head = add_stack_sizes(ir);
-	if (!an_head)
+	if (layout.has_unresolved && !resolve_array_elements(first, num_rows, &layout)) {
+		end_layout(&layout);
+		mcc_delete_annotated_ir(first);
 		return NULL;
-	add_stack_positions(an_head);
-	return an_head;
+	}
+	end_layout(&layout);
+	return first;
 }
-
@@ -1,10 +1,14 @@
 #include "mcc/symbol_table.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/arena.h"
 #include "mcc/ast_visit.h"
+#include "mcc/intern.h"
+#include "utils/hash_map.h"
 
 // ------------------------------------------------------- Forward declaration
 
@@ -31,12 +35,69 @@ static enum mcc_symbol_table_row_type convert_enum(enum mcc_ast_types type)
 	}
 }
 
+// ------------------------------------------------------- Scope index
+
+// Inserts row into the index of its scope, keeping the rows of a name ordered by position. Returns 0 on success.
+static int index_insert(struct mcc_symbol_table_scope *scope, struct mcc_symbol_table_row *row)
+{
+	assert(scope);
+	assert(row);
+
+	if (!scope->index) {
+		scope->index = mcc_hash_map_new_pointer();
+		if (!scope->index) {
+			return 1;
+		}
+	}
+
+	struct mcc_symbol_table_row *last = mcc_hash_map_get(scope->index, row->name);
+	if (!last || last->position < row->position) {
+		row->prev_declaration = last;
+		return mcc_hash_map_set(scope->index, row->name, row) ? 0 : 1;
+	}
+
+	// Only a renamed row can be inserted in the middle
+	while (last->prev_declaration && last->prev_declaration->position > row->position) {
+		last = last->prev_declaration;
+	}
+	row->prev_declaration = last->prev_declaration;
+	last->prev_declaration = row;
+	return 0;
+}
+
+static void index_remove(struct mcc_symbol_table_scope *scope, struct mcc_symbol_table_row *row)
+{
+	assert(scope);
+	assert(row);
+
+	if (!scope->index) {
+		return;
+	}
+
+	struct mcc_symbol_table_row *last = mcc_hash_map_get(scope->index, row->name);
+	if (last == row) {
+		// Removing first makes room, setting the previous row can't fail
+		mcc_hash_map_remove(scope->index, row->name);
+		if (row->prev_declaration) {
+			mcc_hash_map_set(scope->index, row->name, row->prev_declaration);
+		}
+	} else {
+		while (last && last->prev_declaration != row) {
+			last = last->prev_declaration;
+		}
+		if (last) {
+			last->prev_declaration = row->prev_declaration;
+		}
+	}
+	row->prev_declaration = NULL;
+}
+
 // ------------------------------------------------------- Symbol Table row
 
 struct mcc_symbol_table_row *
-mcc_symbol_table_new_row_variable(char *name, enum mcc_symbol_table_row_type type, struct mcc_ast_node *node)
+mcc_symbol_table_new_row_variable(const char *name, enum mcc_symbol_table_row_type type, struct mcc_ast_node *node)
 {
-	struct mcc_symbol_table_row *row = malloc(sizeof(*row));
+	struct mcc_symbol_table_row *row = mcc_alloc(sizeof(*row));
 	if (!row) {
 		return NULL;
 	}
@@ -44,9 +105,9 @@ mcc_symbol_table_new_row_variable(char *name, enum mcc_symbol_table_row_type typ
 	row->row_structure = MCC_SYMBOL_TABLE_ROW_STRUCTURE_VARIABLE;
 	row->array_size = -1;
 	row->row_type = type;
-	row->name = strdup(name);
+	row->name = mcc_intern(name);
 	if (!row->name) {
-		free(row);
+		mcc_free(row);
 		return NULL;
 	}
 	row->node = node;
@@ -54,14 +115,16 @@ mcc_symbol_table_new_row_variable(char *name, enum mcc_symbol_table_row_type typ
 	row->next_row = NULL;
 	row->scope = NULL;
 	row->child_scope = NULL;
+	row->position = 0;
+	row->prev_declaration = NULL;
 
 	return row;
 }
 
 struct mcc_symbol_table_row *
-mcc_symbol_table_new_row_function(char *name, enum mcc_symbol_table_row_type type, struct mcc_ast_node *node)
+mcc_symbol_table_new_row_function(const char *name, enum mcc_symbol_table_row_type type, struct mcc_ast_node *node)
 {
-	struct mcc_symbol_table_row *row = malloc(sizeof(*row));
+	struct mcc_symbol_table_row *row = mcc_alloc(sizeof(*row));
 	if (!row) {
 		return NULL;
 	}
@@ -69,9 +132,9 @@ mcc_symbol_table_new_row_function(char *name, enum mcc_symbol_table_row_type typ
 	row->row_structure = MCC_SYMBOL_TABLE_ROW_STRUCTURE_FUNCTION;
 	row->array_size = -1;
 	row->row_type = type;
-	row->name = strdup(name);
+	row->name = mcc_intern(name);
 	if (!row->name) {
-		free(row);
+		mcc_free(row);
 		return NULL;
 	}
 	row->node = node;
@@ -79,6 +142,8 @@ mcc_symbol_table_new_row_function(char *name, enum mcc_symbol_table_row_type typ
 	row->next_row = NULL;
 	row->scope = NULL;
 	row->child_scope = NULL;
+	row->position = 0;
+	row->prev_declaration = NULL;
 
 	return row;
 }
@@ -88,7 +153,7 @@ struct mcc_symbol_table_row *mcc_symbol_table_new_row_array(char *name,
                                                             enum mcc_symbol_table_row_type type,
                                                             struct mcc_ast_node *node)
 {
-	struct mcc_symbol_table_row *row = malloc(sizeof(*row));
+	struct mcc_symbol_table_row *row = mcc_alloc(sizeof(*row));
 	if (!row) {
 		return NULL;
 	}
@@ -96,9 +161,9 @@ struct mcc_symbol_table_row *mcc_symbol_table_new_row_array(char *name,
 	row->row_structure = MCC_SYMBOL_TABLE_ROW_STRUCTURE_ARRAY;
 	row->array_size = array_size;
 	row->row_type = type;
-	row->name = strdup(name);
+	row->name = mcc_intern(name);
 	if (!row->name) {
-		free(row);
+		mcc_free(row);
 		return NULL;
 	}
 	row->node = node;
@@ -106,6 +171,8 @@ struct mcc_symbol_table_row *mcc_symbol_table_new_row_array(char *name,
 	row->next_row = NULL;
 	row->scope = NULL;
 	row->child_scope = NULL;
+	row->position = 0;
+	row->prev_declaration = NULL;
 
 	return row;
 }
@@ -119,6 +186,17 @@ void mcc_symbol_table_delete_row(struct mcc_symbol_table_row *row)
 		mcc_symbol_table_delete_all_scopes(row->child_scope);
 	}
 
+	struct mcc_symbol_table_scope *scope = row->scope;
+	if (scope) {
+		index_remove(scope, row);
+		if (scope->head == row) {
+			scope->head = row->next_row;
+		}
+		if (scope->last_row == row) {
+			scope->last_row = row->prev_row;
+		}
+	}
+
 	// rearrange pointer structure
 	if (!row->prev_row && row->next_row) {
 		row->next_row->prev_row = NULL;
@@ -131,9 +209,8 @@ void mcc_symbol_table_delete_row(struct mcc_symbol_table_row *row)
 		row->prev_row->next_row = row->next_row;
 	}
 
-	// free row
-	free(row->name);
-	free(row);
+	// free row, its name is interned
+	mcc_free(row);
 }
 
 void mcc_symbol_table_delete_all_rows(struct mcc_symbol_table_row *head)
@@ -173,11 +250,29 @@ void mcc_symbol_table_row_append_child_scope(struct mcc_symbol_table_row *row, s
 	return;
 }
 
+int mcc_symbol_table_rename_row(struct mcc_symbol_table_row *row, const char *name)
+{
+	assert(row);
+	assert(name);
+
+	char *interned = mcc_intern(name);
+	if (!interned) {
+		return 1;
+	}
+	if (!row->scope) {
+		row->name = interned;
+		return 0;
+	}
+	index_remove(row->scope, row);
+	row->name = interned;
+	return index_insert(row->scope, row);
+}
+
 // --------------------------------------------------------- Symbol Table scope
 
 struct mcc_symbol_table_scope *mcc_symbol_table_new_scope()
 {
-	struct mcc_symbol_table_scope *scope = malloc(sizeof(*scope));
+	struct mcc_symbol_table_scope *scope = mcc_alloc(sizeof(*scope));
 	if (!scope) {
 		return NULL;
 	}
@@ -186,6 +281,8 @@ struct mcc_symbol_table_scope *mcc_symbol_table_new_scope()
 	scope->parent_row = NULL;
 	scope->next_scope = NULL;
 	scope->prev_scope = NULL;
+	scope->last_row = NULL;
+	scope->index = NULL;
 
 	return scope;
 }
@@ -194,48 +291,59 @@ struct mcc_symbol_table_row *mcc_symbol_table_scope_get_last_row(struct mcc_symb
 {
 	assert(scope);
 
-	if (!scope->head) {
-		return NULL;
-	}
-
-	struct mcc_symbol_table_row *row = scope->head;
-	while (row->next_row) {
-		row = row->next_row;
-	}
-	return row;
+	return scope->last_row;
 }
 
-void mcc_symbol_table_scope_append_row(struct mcc_symbol_table_scope *scope, struct mcc_symbol_table_row *row)
+int mcc_symbol_table_scope_append_row(struct mcc_symbol_table_scope *scope, struct mcc_symbol_table_row *row)
 {
 	assert(scope);
 	assert(row);
 
-	struct mcc_symbol_table_row **head_ref = &scope->head;
-	struct mcc_symbol_table_row *last_row = *head_ref;
 	row->scope = scope;
+	if (!scope->last_row) {
+		row->position = 0;
+		scope->head = row;
+	} else {
+		row->position = scope->last_row->position + 1;
+		scope->last_row->next_row = row;
+		row->prev_row = scope->last_row;
+	}
+	scope->last_row = row;
 
-	if (!*head_ref) {
-		*head_ref = row;
-		return;
+	return index_insert(scope, row);
+}
+
+struct mcc_symbol_table_row *
+mcc_symbol_table_scope_find_row(struct mcc_symbol_table_scope *scope, const char *name, unsigned max_position)
+{
+	assert(scope);
+	assert(name);
+
+	if (!scope->index) {
+		return NULL;
 	}
-	while (last_row->next_row) {
-		last_row = last_row->next_row;
+
+	struct mcc_symbol_table_row *row = mcc_hash_map_get(scope->index, name);
+	while (row && row->position > max_position) {
+		row = row->prev_declaration;
 	}
-	last_row->next_row = row;
-	row->prev_row = last_row;
-	return;
+	return row;
 }
 
 void mcc_symbol_table_delete_scope(struct mcc_symbol_table_scope *scope)
 {
 	assert(scope);
 
+	// The index is not needed to delete the rows
+	mcc_hash_map_delete(scope->index);
+	scope->index = NULL;
+
 	// delete rows
 	if (scope->head) {
 		mcc_symbol_table_delete_all_rows(scope->head);
 	}
 
-	free(scope);
+	mcc_free(scope);
 }
 
 void mcc_symbol_table_delete_all_scopes(struct mcc_symbol_table_scope *head)
@@ -259,7 +367,7 @@ void mcc_symbol_table_delete_all_scopes(struct mcc_symbol_table_scope *head)
 
 struct mcc_symbol_table *mcc_symbol_table_new_table()
 {
-	struct mcc_symbol_table *table = malloc(sizeof(*table));
+	struct mcc_symbol_table *table = mcc_alloc(sizeof(*table));
 	if (!table) {
 		return NULL;
 	}
@@ -310,7 +418,7 @@ void mcc_symbol_table_delete_table(struct mcc_symbol_table *table)
 		mcc_symbol_table_delete_all_scopes(table->head);
 	}
 
-	free(table);
+	mcc_free(table);
 }
 
 // --------------------------------------------------------------- traversing AST and create symbol table
@@ -338,7 +446,10 @@ static int create_row_declaration(struct mcc_ast_declaration *declaration, struc
 	if (!row) {
 		return 1;
 	}
-	mcc_symbol_table_scope_append_row(scope, row);
+	if (mcc_symbol_table_scope_append_row(scope, row)) {
+		mcc_symbol_table_delete_row(row);
+		return 1;
+	}
 	declaration->row = row;
 	return 0;
 }
@@ -356,15 +467,11 @@ static int create_rows_function_parameters(struct mcc_ast_function_definition *f
 	}
 	mcc_symbol_table_row_append_child_scope(row, child_scope);
 
-	if (!function_definition->parameters->is_empty) {
-		struct mcc_ast_parameters *parameters = function_definition->parameters;
-
-		do {
-			if (create_row_declaration(parameters->declaration, child_scope)) {
-				return 1;
-			}
-			parameters = parameters->next_parameters;
-		} while (parameters);
+	struct mcc_ast_parameters *parameters = function_definition->parameters;
+	for (unsigned i = 0; i < parameters->num_parameters; i++) {
+		if (create_row_declaration(parameters->declarations[i], child_scope)) {
+			return 1;
+		}
 	}
 
 	return 0;
@@ -380,7 +487,10 @@ static struct mcc_symbol_table_row *create_pseudo_row(struct mcc_symbol_table_sc
 		if (!row) {
 			return NULL;
 		}
-		mcc_symbol_table_scope_append_row(scope, row);
+		if (mcc_symbol_table_scope_append_row(scope, row)) {
+			mcc_symbol_table_delete_row(row);
+			return NULL;
+		}
 	}
 	return scope->head;
 }
@@ -407,22 +517,15 @@ static struct mcc_symbol_table_scope *append_child_scope_to_last_row(struct mcc_
 	return new_scope;
 }
 
-// Creates rows of a compound statement at its next compound statements, returns 0 on success
+// Creates rows of the statements of a compound statement, returns 0 on success
 static int create_rows_compound_statement(struct mcc_ast_compound_statement *compound_stmt,
                                           struct mcc_symbol_table_scope *scope)
 {
 	assert(compound_stmt);
 	assert(scope);
 
-	if (compound_stmt->statement) {
-		if (create_rows_statement(compound_stmt->statement, scope)) {
-			return 1;
-		}
-	}
-
-	while (compound_stmt->next_compound_statement) {
-		compound_stmt = compound_stmt->next_compound_statement;
-		if (create_rows_statement(compound_stmt->statement, scope)) {
+	for (unsigned i = 0; i < compound_stmt->num_statements; i++) {
+		if (create_rows_statement(compound_stmt->statements[i], scope)) {
 			return 1;
 		}
 	}
@@ -467,16 +570,11 @@ static int link_pointer_arguments(struct mcc_ast_arguments *arguments, struct mc
 	assert(arguments);
 	assert(scope);
 
-	if (!arguments->expression) {
-		return 0;
-	}
-	do {
-		if (link_pointer_expression(arguments->expression, scope)) {
+	for (unsigned i = 0; i < arguments->num_arguments; i++) {
+		if (link_pointer_expression(arguments->expressions[i], scope)) {
 			return 1;
 		}
-		arguments = arguments->next_arguments;
-	} while (arguments);
-
+	}
 	return 0;
 }
 
@@ -504,9 +602,6 @@ static int link_pointer_expression(struct mcc_ast_expression *expression, struct
 		exit_code = link_pointer_expression(expression->lhs, scope);
 		exit_code += link_pointer_expression(expression->rhs, scope);
 		break;
-	case MCC_AST_EXPRESSION_TYPE_PARENTH:
-		exit_code = link_pointer_expression(expression->expression, scope);
-		break;
 	case MCC_AST_EXPRESSION_TYPE_UNARY_OP:
 		exit_code = link_pointer_expression(expression->child, scope);
 		break;
@@ -650,7 +745,10 @@ static int create_row_function_definition(struct mcc_ast_function_definition *fu
 	if (!row) {
 		return 1;
 	}
-	mcc_symbol_table_scope_append_row(table->head, row);
+	if (mcc_symbol_table_scope_append_row(table->head, row)) {
+		mcc_symbol_table_delete_row(row);
+		return 1;
+	}
 	if (create_rows_function_parameters(function_definition, row)) {
 		return 1;
 	}
@@ -660,6 +758,53 @@ static int create_row_function_definition(struct mcc_ast_function_definition *fu
 	return 0;
 }
 
+// Creates the rows of the built_ins behind the functions of the program, returns 0 on success.
+static int create_rows_built_ins(struct mcc_symbol_table *table)
+{
+	assert(table);
+
+	if (!table->head) {
+		if (insert_new_scope(table)) {
+			return 1;
+		}
+	}
+
+	for (int i = 0; i < MCC_AST_NUM_BUILT_INS; i++) {
+		const struct mcc_ast_built_in *built_in = &mcc_ast_built_ins[i];
+
+		// The built_ins have no AST, so their rows have no node
+		struct mcc_symbol_table_row *row =
+		    mcc_symbol_table_new_row_function(built_in->name, convert_enum(built_in->return_type), NULL);
+		if (!row) {
+			return 1;
+		}
+		if (mcc_symbol_table_scope_append_row(table->head, row)) {
+			mcc_symbol_table_delete_row(row);
+			return 1;
+		}
+
+		struct mcc_symbol_table_scope *child_scope = mcc_symbol_table_new_scope();
+		if (!child_scope) {
+			return 1;
+		}
+		mcc_symbol_table_row_append_child_scope(row, child_scope);
+
+		if (built_in->parameter_type == VOID) {
+			continue;
+		}
+		struct mcc_symbol_table_row *parameter = mcc_symbol_table_new_row_variable(
+		    built_in->parameter_name, convert_enum(built_in->parameter_type), NULL);
+		if (!parameter) {
+			return 1;
+		}
+		if (mcc_symbol_table_scope_append_row(child_scope, parameter)) {
+			mcc_symbol_table_delete_row(parameter);
+			return 1;
+		}
+	}
+	return 0;
+}
+
 // Check if there is a declaration of the given name in the symbol table above (including) the given row and returns
 // the row, otherwise NULL. However, checks on function level are not done.
 struct mcc_symbol_table_row *mcc_symbol_table_check_upwards_for_declaration(const char *wanted_name,
@@ -668,24 +813,24 @@ struct mcc_symbol_table_row *mcc_symbol_table_check_upwards_for_declaration(cons
 	assert(wanted_name);
 	assert(start_row);
 
+	// Names of rows are interned, a name that was never interned can't be declared
+	wanted_name = mcc_intern_lookup(wanted_name);
+	if (!wanted_name) {
+		return NULL;
+	}
+
 	struct mcc_symbol_table_row *row = start_row;
 	struct mcc_symbol_table_scope *scope = row->scope;
 
-	if (strcmp(wanted_name, row->name) == 0) {
+	if (mcc_intern_equal(wanted_name, row->name)) {
 		return row;
 	}
 
+	// In each scope only rows up to the current one are visible
 	while (scope->parent_row) {
-		if (strcmp(wanted_name, row->name) == 0) {
-			return row;
-		}
-
-		while (row->prev_row) {
-			row = row->prev_row;
-
-			if (strcmp(wanted_name, row->name) == 0) {
-				return row;
-			}
+		struct mcc_symbol_table_row *found = mcc_symbol_table_scope_find_row(scope, wanted_name, row->position);
+		if (found) {
+			return found;
 		}
 		row = scope->parent_row;
 		scope = row->scope;
@@ -700,6 +845,11 @@ struct mcc_symbol_table_row *mcc_symbol_table_check_for_function_declaration(con
 	assert(wanted_name);
 	assert(start_row);
 
+	wanted_name = mcc_intern_lookup(wanted_name);
+	if (!wanted_name) {
+		return NULL;
+	}
+
 	struct mcc_symbol_table_row *row = start_row;
 	struct mcc_symbol_table_scope *scope = row->scope;
 
@@ -709,19 +859,12 @@ struct mcc_symbol_table_row *mcc_symbol_table_check_for_function_declaration(con
 		scope = row->scope;
 	}
 
-	// iterate through top level
-	row = scope->head;
-	if (!row) {
-		return NULL;
+	// first function of that name on top level
+	row = mcc_symbol_table_scope_find_row(scope, wanted_name, UINT_MAX);
+	while (row && row->prev_declaration) {
+		row = row->prev_declaration;
 	}
-	do {
-		if (strcmp(wanted_name, row->name) == 0) {
-			return row;
-		}
-		row = row->next_row;
-	} while (row);
-
-	return NULL;
+	return row;
 }
 
 // inserts the corresponding rows of a ast program into a given table
@@ -756,17 +899,200 @@ struct mcc_symbol_table *mcc_symbol_table_create(struct mcc_ast_program *program
 {
 	assert(program);
 
-	// Add builtin functions before creating symbol table
-	if (!mcc_ast_add_built_ins(program)) {
-		return NULL;
-	}
 	struct mcc_symbol_table *table = mcc_symbol_table_new_table();
 	if (!table) {
 		return NULL;
 	}
 
 	table = create_program(program, table);
+	if (table && create_rows_built_ins(table)) {
+		mcc_symbol_table_delete_table(table);
+		return NULL;
+	}
 
 	return table;
 }
 
+
+// --------------------------------------------------------------- create symbol table while parsing
+
+int mcc_symbol_table_builder_init(struct mcc_symbol_table_builder *builder)
+{
+	assert(builder);
+
+	builder->table = mcc_symbol_table_new_table();
+	builder->scope = NULL;
+	builder->function_row = NULL;
+	builder->failed = !builder->table;
+
+	return builder->failed ? 1 : 0;
+}
+
+void mcc_symbol_table_builder_open_function(struct mcc_symbol_table_builder *builder,
+                                            enum mcc_ast_types type,
+                                            struct mcc_ast_identifier *identifier)
+{
+	if (!builder || builder->failed) {
+		return;
+	}
+	assert(!builder->scope);
+
+	struct mcc_symbol_table *table = builder->table;
+	if (!identifier || (!table->head && insert_new_scope(table))) {
+		builder->failed = true;
+		return;
+	}
+
+	// The node of the row is set once the whole function definition is parsed
+	struct mcc_symbol_table_row *row =
+	    mcc_symbol_table_new_row_function(identifier->identifier_name, convert_enum(type), NULL);
+	if (!row) {
+		builder->failed = true;
+		return;
+	}
+	if (mcc_symbol_table_scope_append_row(table->head, row)) {
+		mcc_symbol_table_delete_row(row);
+		builder->failed = true;
+		return;
+	}
+
+	// Parameters and the statements of the body share one scope
+	struct mcc_symbol_table_scope *scope = mcc_symbol_table_new_scope();
+	if (!scope) {
+		builder->failed = true;
+		return;
+	}
+	mcc_symbol_table_row_append_child_scope(row, scope);
+
+	builder->function_row = row;
+	builder->scope = scope;
+}
+
+void mcc_symbol_table_builder_close_function(struct mcc_symbol_table_builder *builder,
+                                             struct mcc_ast_function_definition *function_definition)
+{
+	if (!builder || builder->failed) {
+		return;
+	}
+	if (!function_definition) {
+		builder->failed = true;
+		return;
+	}
+
+	builder->function_row->node = &function_definition->node;
+	builder->function_row = NULL;
+	builder->scope = NULL;
+}
+
+void mcc_symbol_table_builder_open_scope(struct mcc_symbol_table_builder *builder)
+{
+	if (!builder || builder->failed) {
+		return;
+	}
+
+	builder->scope = append_child_scope_to_last_row(builder->scope);
+	if (!builder->scope) {
+		builder->failed = true;
+	}
+}
+
+void mcc_symbol_table_builder_close_scope(struct mcc_symbol_table_builder *builder)
+{
+	if (!builder || builder->failed) {
+		return;
+	}
+
+	builder->scope = builder->scope->parent_row->scope;
+}
+
+void mcc_symbol_table_builder_declare(struct mcc_symbol_table_builder *builder,
+                                      struct mcc_ast_declaration *declaration)
+{
+	if (!builder || builder->failed) {
+		return;
+	}
+
+	if (!declaration || create_row_declaration(declaration, builder->scope)) {
+		builder->failed = true;
+	}
+}
+
+// Returns the last row of the innermost scope, a pseudo row if it has none yet. Returns NULL on failure.
+static struct mcc_symbol_table_row *builder_last_row(struct mcc_symbol_table_builder *builder)
+{
+	struct mcc_symbol_table_row *row = mcc_symbol_table_scope_get_last_row(builder->scope);
+	if (!row) {
+		row = create_pseudo_row(builder->scope);
+		if (!row) {
+			builder->failed = true;
+		}
+	}
+	return row;
+}
+
+void mcc_symbol_table_builder_link_assignment(struct mcc_symbol_table_builder *builder,
+                                              struct mcc_ast_assignment *assignment)
+{
+	if (!builder || builder->failed) {
+		return;
+	}
+	if (!assignment) {
+		builder->failed = true;
+		return;
+	}
+
+	assignment->row = builder_last_row(builder);
+}
+
+void mcc_symbol_table_builder_link_expression(struct mcc_symbol_table_builder *builder,
+                                              struct mcc_ast_expression *expression)
+{
+	if (!builder || builder->failed) {
+		return;
+	}
+	if (!expression) {
+		builder->failed = true;
+		return;
+	}
+
+	struct mcc_symbol_table_row *row = builder_last_row(builder);
+	switch (expression->type) {
+	case MCC_AST_EXPRESSION_TYPE_VARIABLE:
+		expression->variable_row = row;
+		break;
+	case MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT:
+		expression->array_row = row;
+		break;
+	case MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL:
+		expression->function_row = row;
+		break;
+	case MCC_AST_EXPRESSION_TYPE_LITERAL:
+	case MCC_AST_EXPRESSION_TYPE_BINARY_OP:
+	case MCC_AST_EXPRESSION_TYPE_UNARY_OP:
+		// nothing to link
+		break;
+	}
+}
+
+struct mcc_symbol_table *mcc_symbol_table_builder_finish(struct mcc_symbol_table_builder *builder, bool parsed)
+{
+	if (!builder) {
+		return NULL;
+	}
+
+	struct mcc_symbol_table *table = builder->table;
+	builder->table = NULL;
+	if (!table) {
+		return NULL;
+	}
+	if (builder->failed || !parsed) {
+		mcc_symbol_table_delete_table(table);
+		return NULL;
+	}
+
+	if (create_rows_built_ins(table)) {
+		mcc_symbol_table_delete_table(table);
+		return NULL;
+	}
+	return table;
+}
@@ -24,7 +24,7 @@ void mcc_symbol_table_print_begin(struct mcc_symbol_table_scope *scope, FILE *ou
 		        "----------------------------------------------------------------------\n"
 		        "symbol table: %s\n"
 		        "----------------------------------------------------------------------\n",
-		        node.sloc.filename);
+		        mcc_ast_get_filename(node));
 	} else {
 		fprintf(out, "----------------------------------------------------------------------\n"
 		             "symbol table:\n"
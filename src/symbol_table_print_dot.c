@@ -23,7 +23,7 @@ void mcc_symbol_table_print_dot_begin(struct mcc_symbol_table_scope *scope, FILE
 		        "label=<\n\n"
 		        "<table border='0' cellborder='0' cellspacing='0'>\n"
 		        "<tr><td>Symbol Table: %s</td></tr>\n",
-		        node.sloc.filename);
+		        mcc_ast_get_filename(node));
 	} else {
 		fprintf(out, "digraph {\n\n"
 		             "tbl [\n\n"
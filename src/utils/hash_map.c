@@ -0,0 +1,199 @@
+#include "utils/hash_map.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mcc/arena.h"
+
+#define INITIAL_CAPACITY 16
+
+// ------------------------------------------------------------------- Hash functions
+
+// FNV-1a
+size_t mcc_hash_map_hash_bytes(const void *bytes, size_t length)
+{
+	const unsigned char *b = bytes;
+	uint64_t hash = 14695981039346656037ULL;
+	for (size_t i = 0; i < length; i++) {
+		hash ^= b[i];
+		hash *= 1099511628211ULL;
+	}
+	return (size_t)hash;
+}
+
+size_t mcc_hash_map_hash_string(const void *key)
+{
+	const unsigned char *s = key;
+	uint64_t hash = 14695981039346656037ULL;
+	while (*s) {
+		hash ^= *s++;
+		hash *= 1099511628211ULL;
+	}
+	return (size_t)hash;
+}
+
+static bool equal_string(const void *key_a, const void *key_b)
+{
+	return strcmp(key_a, key_b) == 0;
+}
+
+static size_t hash_pointer(const void *key)
+{
+	// Low bits of heap addresses are mostly zero because of alignment, mix them in
+	uint64_t hash = (uint64_t)(uintptr_t)key;
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	return (size_t)hash;
+}
+
+static bool equal_pointer(const void *key_a, const void *key_b)
+{
+	return key_a == key_b;
+}
+
+// ------------------------------------------------------------------- Map
+
+struct mcc_hash_map *mcc_hash_map_new(mcc_hash_map_hash_cb hash, mcc_hash_map_equal_cb equal)
+{
+	assert(hash);
+	assert(equal);
+
+	struct mcc_hash_map *map = mcc_alloc(sizeof(*map));
+	if (!map)
+		return NULL;
+	map->entries = mcc_calloc(INITIAL_CAPACITY, sizeof(*map->entries));
+	if (!map->entries) {
+		mcc_free(map);
+		return NULL;
+	}
+	map->hash = hash;
+	map->equal = equal;
+	map->size = 0;
+	map->capacity = INITIAL_CAPACITY;
+	return map;
+}
+
+struct mcc_hash_map *mcc_hash_map_new_string(void)
+{
+	return mcc_hash_map_new(mcc_hash_map_hash_string, equal_string);
+}
+
+struct mcc_hash_map *mcc_hash_map_new_pointer(void)
+{
+	return mcc_hash_map_new(hash_pointer, equal_pointer);
+}
+
+static struct mcc_hash_map_entry *find_entry(struct mcc_hash_map *map, const void *key)
+{
+	size_t mask = map->capacity - 1;
+	size_t i = map->hash(key) & mask;
+	while (map->entries[i].key) {
+		if (map->equal(map->entries[i].key, key))
+			return &map->entries[i];
+		i = (i + 1) & mask;
+	}
+	// Free slot, key is not in the map
+	return &map->entries[i];
+}
+
+static bool grow(struct mcc_hash_map *map)
+{
+	struct mcc_hash_map_entry *old = map->entries;
+	size_t old_capacity = map->capacity;
+
+	map->entries = mcc_calloc(2 * old_capacity, sizeof(*map->entries));
+	if (!map->entries) {
+		map->entries = old;
+		return false;
+	}
+	map->capacity = 2 * old_capacity;
+	for (size_t i = 0; i < old_capacity; i++) {
+		if (old[i].key) {
+			*find_entry(map, old[i].key) = old[i];
+		}
+	}
+	mcc_free(old);
+	return true;
+}
+
+static bool insert(struct mcc_hash_map *map, const void *key, void *value, bool overwrite)
+{
+	assert(map);
+	assert(key);
+
+	// Keep load factor below 3/4
+	if (4 * (map->size + 1) > 3 * map->capacity) {
+		if (!grow(map))
+			return false;
+	}
+	struct mcc_hash_map_entry *entry = find_entry(map, key);
+	if (entry->key) {
+		if (overwrite)
+			entry->value = value;
+		return true;
+	}
+	entry->key = key;
+	entry->value = value;
+	map->size++;
+	return true;
+}
+
+bool mcc_hash_map_set(struct mcc_hash_map *map, const void *key, void *value)
+{
+	return insert(map, key, value, true);
+}
+
+bool mcc_hash_map_set_if_absent(struct mcc_hash_map *map, const void *key, void *value)
+{
+	return insert(map, key, value, false);
+}
+
+void *mcc_hash_map_get(struct mcc_hash_map *map, const void *key)
+{
+	assert(map);
+	assert(key);
+
+	return find_entry(map, key)->value;
+}
+
+bool mcc_hash_map_remove(struct mcc_hash_map *map, const void *key)
+{
+	assert(map);
+	assert(key);
+
+	struct mcc_hash_map_entry *entry = find_entry(map, key);
+	if (!entry->key)
+		return false;
+
+	// Shift following entries of the probe sequence back, so that no lookup stops early at the freed slot
+	size_t mask = map->capacity - 1;
+	size_t free_slot = (size_t)(entry - map->entries);
+	size_t i = free_slot;
+	while (true) {
+		i = (i + 1) & mask;
+		if (!map->entries[i].key)
+			break;
+		size_t home = map->hash(map->entries[i].key) & mask;
+		// Entry can move to the free slot if its home slot is not cyclically in (free_slot, i]
+		bool in_between = free_slot <= i ? (free_slot < home && home <= i) : (free_slot < home || home <= i);
+		if (!in_between) {
+			map->entries[free_slot] = map->entries[i];
+			free_slot = i;
+		}
+	}
+	map->entries[free_slot].key = NULL;
+	map->entries[free_slot].value = NULL;
+	map->size--;
+	return true;
+}
+
+void mcc_hash_map_delete(struct mcc_hash_map *map)
+{
+	if (!map)
+		return;
+	mcc_free(map->entries);
+	mcc_free(map);
+}
@@ -0,0 +1,55 @@
+#ifndef MCC_UTILS_HASH_MAP_H
+#define MCC_UTILS_HASH_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Hash map with open addressing, mapping keys to arbitrary pointers.
+// Keys are not copied, they need to stay valid as long as the map is used. NULL is not a valid value, since
+// mcc_hash_map_get returns NULL for missing keys.
+
+typedef size_t (*mcc_hash_map_hash_cb)(const void *key);
+typedef bool (*mcc_hash_map_equal_cb)(const void *key_a, const void *key_b);
+
+struct mcc_hash_map {
+	mcc_hash_map_hash_cb hash;
+	mcc_hash_map_equal_cb equal;
+	// Number of used entries and number of allocated entries (always a power of two)
+	size_t size;
+	size_t capacity;
+	struct mcc_hash_map_entry *entries;
+};
+
+struct mcc_hash_map_entry {
+	const void *key;
+	void *value;
+};
+
+struct mcc_hash_map *mcc_hash_map_new(mcc_hash_map_hash_cb hash, mcc_hash_map_equal_cb equal);
+
+// Keys are null-terminated strings, compared by content
+struct mcc_hash_map *mcc_hash_map_new_string(void);
+
+// Keys are pointers, compared by address
+struct mcc_hash_map *mcc_hash_map_new_pointer(void);
+
+// Inserts key or overwrites the value of an existing key. Returns false if memory allocation failed.
+bool mcc_hash_map_set(struct mcc_hash_map *map, const void *key, void *value);
+
+// Inserts key only if it is not yet in the map, i.e. the first value stays. Returns false if memory allocation
+// failed.
+bool mcc_hash_map_set_if_absent(struct mcc_hash_map *map, const void *key, void *value);
+
+// Returns value of key or NULL if key is not in the map
+void *mcc_hash_map_get(struct mcc_hash_map *map, const void *key);
+
+// Removes key from the map. Returns false if key was not in the map.
+bool mcc_hash_map_remove(struct mcc_hash_map *map, const void *key);
+
+void mcc_hash_map_delete(struct mcc_hash_map *map);
+
+size_t mcc_hash_map_hash_string(const void *key);
+
+size_t mcc_hash_map_hash_bytes(const void *bytes, size_t length);
+
+#endif // MCC_UTILS_HASH_MAP_H
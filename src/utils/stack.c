@@ -0,0 +1,81 @@
+#include "utils/stack.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+void mcc_stack_init(struct mcc_stack *stack, void *initial, unsigned capacity, size_t element_size)
+{
+	assert(stack);
+	assert(initial);
+	assert(capacity > 0);
+
+	stack->elements = initial;
+	stack->element_size = element_size;
+	stack->size = 0;
+	stack->capacity = capacity;
+	stack->initial = initial;
+}
+
+// Doubles the capacity, copying the elements out of the initial buffer the first time
+static bool grow(struct mcc_stack *stack)
+{
+	if (stack->capacity > UINT_MAX / 2)
+		return false;
+
+	unsigned capacity = 2 * stack->capacity;
+	char *elements = NULL;
+	if (stack->elements == stack->initial) {
+		elements = malloc(capacity * stack->element_size);
+		if (elements)
+			memcpy(elements, stack->initial, stack->size * stack->element_size);
+	} else {
+		elements = realloc(stack->elements, capacity * stack->element_size);
+	}
+	if (!elements)
+		return false;
+
+	stack->elements = elements;
+	stack->capacity = capacity;
+	return true;
+}
+
+bool mcc_stack_push(struct mcc_stack *stack, const void *element)
+{
+	assert(stack);
+	assert(element);
+
+	if (stack->size == stack->capacity && !grow(stack))
+		return false;
+	memcpy(stack->elements + stack->size * stack->element_size, element, stack->element_size);
+	stack->size++;
+	return true;
+}
+
+void mcc_stack_pop(struct mcc_stack *stack, void *element)
+{
+	assert(stack);
+	assert(element);
+	assert(stack->size > 0);
+
+	stack->size--;
+	memcpy(element, stack->elements + stack->size * stack->element_size, stack->element_size);
+}
+
+void *mcc_stack_drop(struct mcc_stack *stack, unsigned count)
+{
+	assert(stack);
+	assert(count <= stack->size);
+
+	stack->size -= count;
+	return stack->elements + stack->size * stack->element_size;
+}
+
+void mcc_stack_delete(struct mcc_stack *stack)
+{
+	assert(stack);
+
+	if (stack->elements != stack->initial)
+		free(stack->elements);
+}
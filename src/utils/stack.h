@@ -0,0 +1,38 @@
+#ifndef MCC_UTILS_STACK_H
+#define MCC_UTILS_STACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Stack of fixed-size elements. It starts out in a buffer of the caller, usually on the C stack, and moves to the heap
+// once it outgrows it. Used instead of recursion where the depth depends on the input.
+
+// Number of elements of the initial buffer
+#define MCC_STACK_INITIAL_CAPACITY 32
+
+struct mcc_stack {
+	char *elements;
+	size_t element_size;
+	// Number of elements on the stack and number of elements that fit without growing
+	unsigned size;
+	unsigned capacity;
+	// Buffer of the caller, the stack is freed only if it moved away from it
+	void *initial;
+};
+
+// initial holds capacity elements of element_size bytes
+void mcc_stack_init(struct mcc_stack *stack, void *initial, unsigned capacity, size_t element_size);
+
+// Copies element on top of the stack. Returns false if memory allocation failed, the stack is unchanged then.
+bool mcc_stack_push(struct mcc_stack *stack, const void *element);
+
+// Copies the top element to element and removes it. The stack must not be empty.
+void mcc_stack_pop(struct mcc_stack *stack, void *element);
+
+// Removes the top count elements and returns the lowest of them. The elements stay valid until the next push.
+void *mcc_stack_drop(struct mcc_stack *stack, unsigned count);
+
+// Frees the elements if they moved to the heap
+void mcc_stack_delete(struct mcc_stack *stack);
+
+#endif // MCC_UTILS_STACK_H
@@ -1,10 +1,13 @@
 #include <CuTest.h>
 
 #include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/arena.h"
 #include "mcc/asm.h"
+#include "mcc/asm_print.h"
 #include "mcc/ast.h"
 #include "mcc/ir.h"
 #include "mcc/semantic_checks.h"
@@ -21,7 +24,7 @@ void test1(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&parser_result)->program);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_asm *code = mcc_asm_generate(ir);
@@ -74,7 +77,7 @@ void stack_frame_size_int(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&parser_result)->program);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_asm *code = mcc_asm_generate(ir);
@@ -102,7 +105,7 @@ void addition_lit(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&parser_result)->program);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_asm *code = mcc_asm_generate(ir);
@@ -173,7 +176,7 @@ void div_int(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&parser_result)->program);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_asm *code = mcc_asm_generate(ir);
@@ -236,7 +239,7 @@ void strings(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&parser_result)->program);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_asm *code = mcc_asm_generate(ir);
@@ -308,7 +311,7 @@ void strings2(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&parser_result)->program);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_asm *code = mcc_asm_generate(ir);
@@ -369,6 +372,100 @@ void strings2(CuTest *tc)
 	mcc_symbol_table_delete_table(table);
 	mcc_asm_delete_asm(code);
 }
+// Two functions with the same strings and floats, which are declared once in the data section
+static const char streaming_input[] = "void f(float x){string s; s = \"test\"; print(s); x = 1.5; print_float(x);}"
+                                      "int main(){string t; float y; t = \"test\"; t = \"test2\"; y = 1.5;"
+                                      "y = 2.5; f(y); print(t); return 0;}";
+
+static char *read_all(FILE *file)
+{
+	long size = ftell(file);
+	char *buffer = calloc(size + 1, 1);
+	rewind(file);
+	if (buffer && fread(buffer, 1, size, file) != (size_t)size) {
+		free(buffer);
+		return NULL;
+	}
+	fclose(file);
+	return buffer;
+}
+
+// A string assigned to an element of an array parameter is stored through the reference
+static const char array_parameter_input[] = "void f(string[3] a){ a[1] = \"hello\"; print(a[1]); }"
+                                            "int main(){ string[3] a; a[0] = \"x\"; f(a); float g; g = 1.5;"
+                                            "return 0; }";
+
+// Assembly code of the input generated for the whole program at once, or function by function
+static char *print_assembly(CuTest *tc, const char *input, bool streaming)
+{
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
+
+	FILE *out = tmpfile();
+	CuAssertPtrNotNull(tc, out);
+	if (streaming) {
+		CuAssertTrue(tc, mcc_asm_print_program(out, (&parser_result)->program, NULL));
+	} else {
+		struct mcc_ir_function *ir = mcc_ir_generate((&parser_result)->program);
+		CuAssertPtrNotNull(tc, ir);
+		struct mcc_asm *code = mcc_asm_generate(ir);
+		CuAssertPtrNotNull(tc, code);
+		mcc_asm_print_asm(out, code);
+		mcc_asm_delete_asm(code);
+		mcc_ir_delete_ir(ir);
+	}
+	char *assembly = read_all(out);
+	CuAssertPtrNotNull(tc, assembly);
+
+	mcc_semantic_check_delete_single_check(checks);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	return assembly;
+}
+
+// The declarations of main are numbered after those of f
+void streaming(CuTest *tc)
+{
+	char *whole = print_assembly(tc, streaming_input, false);
+	char *streamed = print_assembly(tc, streaming_input, true);
+	CuAssertStrEquals(tc, whole, streamed);
+	CuAssertPtrNotNull(tc, strstr(streamed, "\ts_0:       .string \"test\"\n"));
+	CuAssertPtrNotNull(tc, strstr(streamed, "\ty_6:       .float 2.500000\n"));
+	free(whole);
+	free(streamed);
+}
+
+// The IR and assembly code of each function are allocated from the scratch region of the arena
+void streaming_arena(CuTest *tc)
+{
+	char *whole = print_assembly(tc, streaming_input, false);
+	mcc_arena_enable();
+	char *streamed = print_assembly(tc, streaming_input, true);
+	mcc_arena_release();
+	CuAssertStrEquals(tc, whole, streamed);
+	free(whole);
+	free(streamed);
+}
+
+// The array parameter is not declared in f, its elements are stored through the reference in %ecx
+void streaming_array_parameter(CuTest *tc)
+{
+	char *whole = print_assembly(tc, array_parameter_input, false);
+	char *streamed = print_assembly(tc, array_parameter_input, true);
+	CuAssertStrEquals(tc, whole, streamed);
+	CuAssertPtrNotNull(tc, strstr(streamed, "        leal    a_0, %eax\n"
+	                                        "        movl    $1, %ebx\n"
+	                                        "        movl    -4(%ebp), %ecx\n"
+	                                        "        movl    %eax, (%ecx,%ebx,4)\n"));
+	CuAssertTrue(tc, strstr(streamed, "%eax, %ebp\n") == NULL);
+	free(whole);
+	free(streamed);
+}
+
 // clang-format off
 
 #define TESTS \
@@ -377,7 +474,10 @@ void strings2(CuTest *tc)
 	TEST(addition_lit) \
 	TEST(div_int) \
 	TEST(strings) \
-	TEST(strings2)
+	TEST(strings2) \
+	TEST(streaming) \
+	TEST(streaming_arena) \
+	TEST(streaming_array_parameter)
 
 // clang-format on
 
@@ -0,0 +1,269 @@
+#include <CuTest.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mcc/arena.h"
+#include "mcc/ast.h"
+#include "mcc/ast_visit.h"
+#include "mcc/parser.h"
+
+// Far deeper than a recursive traversal can go on a default C stack
+#define DEEP 500000
+
+struct visit_userdata {
+	// Letters of the visited callbacks, in the order of the calls
+	char trace[64];
+	size_t length;
+	long count;
+	void *first;
+};
+
+static void trace(struct visit_userdata *data, char letter)
+{
+	if (data->length + 1 < sizeof(data->trace))
+		data->trace[data->length++] = letter;
+}
+
+static void cb_expression(struct mcc_ast_expression *expression, void *userdata)
+{
+	struct visit_userdata *data = userdata;
+	trace(data, 'E');
+	if (data->count++ == 0)
+		data->first = expression;
+}
+
+static void cb_binary_op(struct mcc_ast_expression *expression, void *userdata)
+{
+	(void)expression;
+	trace(userdata, 'B');
+}
+
+static void cb_unary_op(struct mcc_ast_expression *expression, void *userdata)
+{
+	(void)expression;
+	trace(userdata, 'U');
+}
+
+static void cb_variable(struct mcc_ast_expression *expression, void *userdata)
+{
+	(void)expression;
+	trace(userdata, 'V');
+}
+
+static void cb_function_call(struct mcc_ast_expression *expression, void *userdata)
+{
+	(void)expression;
+	trace(userdata, 'C');
+}
+
+static void cb_arguments(struct mcc_ast_arguments *arguments, void *userdata)
+{
+	(void)arguments;
+	trace(userdata, 'A');
+}
+
+static void cb_literal(struct mcc_ast_literal *literal, void *userdata)
+{
+	(void)literal;
+	trace(userdata, 'L');
+}
+
+static void cb_literal_int(struct mcc_ast_literal *literal, void *userdata)
+{
+	(void)literal;
+	trace(userdata, 'i');
+}
+
+static void cb_identifier(struct mcc_ast_identifier *identifier, void *userdata)
+{
+	(void)identifier;
+	trace(userdata, 'I');
+}
+
+static void cb_compound_statement(struct mcc_ast_compound_statement *compound_statement, void *userdata)
+{
+	struct visit_userdata *data = userdata;
+	if (data->count++ == 0)
+		data->first = compound_statement;
+}
+
+static struct mcc_ast_visitor tracing_visitor(enum mcc_ast_visit_order order, struct visit_userdata *data)
+{
+	return (struct mcc_ast_visitor){
+	    .order = order,
+	    .userdata = data,
+
+	    .expression = cb_expression,
+	    .expression_binary_op = cb_binary_op,
+	    .expression_unary_op = cb_unary_op,
+	    .expression_variable = cb_variable,
+	    .expression_function_call = cb_function_call,
+	    .arguments = cb_arguments,
+	    .literal = cb_literal,
+	    .literal_int = cb_literal_int,
+	    .identifier = cb_identifier,
+	};
+}
+
+void PreOrder(CuTest *tc)
+{
+	const char input[] = "a + -f(1)";
+	struct mcc_parser_result result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_EXPRESSION, "test");
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, result.status);
+
+	struct visit_userdata data = {0};
+	struct mcc_ast_visitor visitor = tracing_visitor(MCC_AST_VISIT_PRE_ORDER, &data);
+	mcc_ast_visit(result.expression, &visitor);
+
+	// Identifiers and the type specific literal callbacks are called in both orders
+	CuAssertStrEquals(tc, "EBEVIEUECIAELi", data.trace);
+	CuAssertPtrEquals(tc, result.expression, data.first);
+
+	mcc_ast_delete(result.expression);
+}
+
+void PostOrder(CuTest *tc)
+{
+	const char input[] = "a + -f(1)";
+	struct mcc_parser_result result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_EXPRESSION, "test");
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, result.status);
+
+	struct visit_userdata data = {0};
+	struct mcc_ast_visitor visitor = tracing_visitor(MCC_AST_VISIT_POST_ORDER, &data);
+	mcc_ast_visit(result.expression, &visitor);
+
+	CuAssertStrEquals(tc, "IVEIiLEACEUEBE", data.trace);
+	CuAssertPtrEquals(tc, result.expression->lhs, data.first);
+
+	mcc_ast_delete(result.expression);
+}
+
+// The deep trees below are too deep for the recursive delete functions, they are released with the region instead
+
+void DeepExpression(CuTest *tc)
+{
+	mcc_arena_enable();
+
+	// - - - ... - 1
+	struct mcc_ast_expression *innermost = mcc_ast_new_expression_literal(mcc_ast_new_literal_int(1));
+	struct mcc_ast_expression *expression = innermost;
+	for (int i = 0; i < DEEP; i++) {
+		expression = mcc_ast_new_expression_unary_op(MCC_AST_UNARY_OP_NEGATIV, expression);
+		CuAssertPtrNotNull(tc, expression);
+	}
+
+	struct visit_userdata pre = {0};
+	struct mcc_ast_visitor visitor = tracing_visitor(MCC_AST_VISIT_PRE_ORDER, &pre);
+	mcc_ast_visit(expression, &visitor);
+	CuAssertIntEquals(tc, DEEP + 1, pre.count);
+	CuAssertPtrEquals(tc, expression, pre.first);
+
+	struct visit_userdata post = {0};
+	visitor = tracing_visitor(MCC_AST_VISIT_POST_ORDER, &post);
+	mcc_ast_visit(expression, &visitor);
+	CuAssertIntEquals(tc, DEEP + 1, post.count);
+	CuAssertPtrEquals(tc, innermost, post.first);
+
+	mcc_arena_release();
+}
+
+void LongBinaryExpression(CuTest *tc)
+{
+	mcc_arena_enable();
+
+	// 1 + 1 + ... + 1 is left associative, so the tree is as deep as the expression is long
+	char *input = malloc(2 * DEEP + 2);
+	CuAssertPtrNotNull(tc, input);
+	for (int i = 0; i < DEEP; i++) {
+		memcpy(input + 2 * i, "1+", 2);
+	}
+	memcpy(input + 2 * DEEP, "1", 2);
+	struct mcc_parser_result result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_EXPRESSION, "test");
+	free(input);
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, result.status);
+
+	struct visit_userdata data = {0};
+	struct mcc_ast_visitor visitor = tracing_visitor(MCC_AST_VISIT_POST_ORDER, &data);
+	mcc_ast_visit(result.expression, &visitor);
+	CuAssertIntEquals(tc, 2 * DEEP + 1, data.count);
+
+	// The leftmost literal is the deepest node
+	struct mcc_ast_expression *leftmost = result.expression;
+	while (leftmost->type == MCC_AST_EXPRESSION_TYPE_BINARY_OP) {
+		leftmost = leftmost->lhs;
+	}
+	CuAssertPtrEquals(tc, leftmost, data.first);
+
+	mcc_arena_release();
+}
+
+void DeepCompoundStatement(CuTest *tc)
+{
+	mcc_arena_enable();
+
+	// {{{ ... { 1; } ... }}}
+	struct mcc_ast_compound_statement *innermost = mcc_ast_new_compound_stmt();
+	struct mcc_ast_expression *one = mcc_ast_new_expression_literal(mcc_ast_new_literal_int(1));
+	CuAssertPtrNotNull(tc, mcc_ast_add_statement(innermost, mcc_ast_new_statement_expression(one)));
+	struct mcc_ast_compound_statement *compound_statement = innermost;
+	for (int i = 0; i < DEEP; i++) {
+		struct mcc_ast_statement *statement = mcc_ast_new_statement_compound_stmt(compound_statement);
+		compound_statement = mcc_ast_add_statement(mcc_ast_new_compound_stmt(), statement);
+		CuAssertPtrNotNull(tc, compound_statement);
+	}
+
+	struct visit_userdata data = {0};
+	struct mcc_ast_visitor visitor = {
+	    .order = MCC_AST_VISIT_POST_ORDER,
+	    .userdata = &data,
+	    .compound_statement = cb_compound_statement,
+	};
+	mcc_ast_visit(compound_statement, &visitor);
+	CuAssertIntEquals(tc, DEEP + 1, data.count);
+	CuAssertPtrEquals(tc, innermost, data.first);
+
+	mcc_arena_release();
+}
+
+// Deeper than the visitor recurses, the nodes below are visited with the explicit stack in the same order
+void OrderBelowRecursionLimit(CuTest *tc)
+{
+	mcc_arena_enable();
+
+	const char input[] = "a + -f(1)";
+	struct mcc_parser_result result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_EXPRESSION, "test");
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, result.status);
+
+	// {{{ ... { a + -f(1); } ... }}}, the tracing visitor has no callbacks of statements
+	struct mcc_ast_compound_statement *compound_statement = mcc_ast_add_statement(
+	    mcc_ast_new_compound_stmt(), mcc_ast_new_statement_expression(result.expression));
+	for (int i = 0; i < 1000; i++) {
+		struct mcc_ast_statement *statement = mcc_ast_new_statement_compound_stmt(compound_statement);
+		compound_statement = mcc_ast_add_statement(mcc_ast_new_compound_stmt(), statement);
+		CuAssertPtrNotNull(tc, compound_statement);
+	}
+
+	struct visit_userdata pre = {0};
+	struct mcc_ast_visitor visitor = tracing_visitor(MCC_AST_VISIT_PRE_ORDER, &pre);
+	mcc_ast_visit(compound_statement, &visitor);
+	CuAssertStrEquals(tc, "EBEVIEUECIAELi", pre.trace);
+
+	struct visit_userdata post = {0};
+	visitor = tracing_visitor(MCC_AST_VISIT_POST_ORDER, &post);
+	mcc_ast_visit(compound_statement, &visitor);
+	CuAssertStrEquals(tc, "IVEIiLEACEUEBE", post.trace);
+
+	mcc_arena_release();
+}
+
+#define TESTS \
+	TEST(PreOrder) \
+	TEST(PostOrder) \
+	TEST(DeepExpression) \
+	TEST(LongBinaryExpression) \
+	TEST(DeepCompoundStatement) \
+	TEST(OrderBelowRecursionLimit)
+
+#include "main_stub.inc"
+#undef TESTS
@@ -0,0 +1,256 @@
+#include <CuTest.h>
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mcc/ast.h"
+#include "mcc/cfg.h"
+#include "mcc/cfg_analysis.h"
+#include "mcc/ir.h"
+#include "mcc/symbol_table.h"
+
+void function_cfg(CuTest *tc)
+{
+	const char input[] = "int f(int x){if (x < 0) return 0; return x;} "
+	                     "int main(){int a; a = 0; while (a < 3) a = a + 1; return a;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&parser_result)->program);
+
+	struct mcc_ir_function *function = mcc_cfg_find_function(ir, "main");
+	CuAssertPtrEquals(tc, ir->next, function);
+	CuAssertTrue(tc, !mcc_cfg_find_function(ir, "g"));
+
+	unsigned num_rows = function->num_rows;
+	struct mcc_ir_row *rows = malloc(num_rows * sizeof(*rows));
+	memcpy(rows, function->rows, num_rows * sizeof(*rows));
+
+	struct mcc_basic_block *cfg = mcc_cfg_generate_function(function);
+	CuAssertPtrNotNull(tc, cfg);
+
+	// The IR is not modified
+	CuAssertIntEquals(tc, num_rows, function->num_rows);
+	CuAssertTrue(tc, memcmp(rows, function->rows, num_rows * sizeof(*rows)) == 0);
+
+	// main, L: while condition, loop body, L: return
+	unsigned num_blocks = 0;
+	unsigned covered_rows = 0;
+	for (struct mcc_basic_block *block = cfg; block; block = block->next) {
+		CuAssertPtrEquals(tc, function, block->function);
+		CuAssertIntEquals(tc, covered_rows, block->leader);
+		covered_rows += block->num_rows;
+		num_blocks++;
+	}
+	CuAssertIntEquals(tc, 4, num_blocks);
+	CuAssertIntEquals(tc, num_rows, covered_rows);
+
+	struct mcc_basic_block *condition = cfg->next;
+	struct mcc_basic_block *body = condition->next;
+	struct mcc_basic_block *exit = body->next;
+	CuAssertPtrEquals(tc, condition, cfg->child_right);
+	CuAssertPtrEquals(tc, body, condition->child_left);
+	CuAssertPtrEquals(tc, exit, condition->child_right);
+	CuAssertPtrEquals(tc, condition, body->child_right);
+	CuAssertTrue(tc, !exit->child_left && !exit->child_right);
+
+	// Cleanup
+	free(rows);
+	mcc_delete_cfg(cfg);
+	mcc_ir_delete_ir(ir);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+void program_cfg(CuTest *tc)
+{
+	const char input[] = "int f(int x){if (x < 0) return 0; return x;} int main(){return f(1);}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&parser_result)->program);
+
+	// The CFGs of the functions follow each other
+	struct mcc_basic_block *cfg = mcc_cfg_generate(ir);
+	CuAssertPtrNotNull(tc, cfg);
+	struct mcc_basic_block *block = cfg;
+	for (struct mcc_ir_function *function = ir; function; function = function->next) {
+		struct mcc_basic_block *function_cfg = mcc_cfg_generate_function(function);
+		for (struct mcc_basic_block *expected = function_cfg; expected; expected = expected->next) {
+			CuAssertPtrNotNull(tc, block);
+			CuAssertPtrEquals(tc, function, block->function);
+			CuAssertIntEquals(tc, expected->leader, block->leader);
+			CuAssertIntEquals(tc, expected->num_rows, block->num_rows);
+			block = block->next;
+		}
+		mcc_delete_cfg(function_cfg);
+	}
+	CuAssertPtrEquals(tc, NULL, block);
+
+	// Cleanup
+	mcc_delete_cfg(cfg);
+	mcc_ir_delete_ir(ir);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+void predecessors(CuTest *tc)
+{
+	const char input[] = "int main(){int a; a = 0; if (a < 1) a = 1; else a = 2; return a;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_basic_block *cfg = mcc_cfg_generate_function(ir);
+
+	// main, then, L: else, L: return
+	struct mcc_basic_block *then_block = cfg->next;
+	struct mcc_basic_block *else_block = then_block->next;
+	struct mcc_basic_block *join = else_block->next;
+	CuAssertIntEquals(tc, 3, join->index);
+
+	CuAssertIntEquals(tc, 0, cfg->num_predecessors);
+	CuAssertIntEquals(tc, 1, then_block->num_predecessors);
+	CuAssertPtrEquals(tc, cfg, then_block->predecessors[0]);
+	CuAssertIntEquals(tc, 2, join->num_predecessors);
+	CuAssertPtrEquals(tc, then_block, join->predecessors[0]);
+	CuAssertPtrEquals(tc, else_block, join->predecessors[1]);
+
+	// Cleanup
+	mcc_delete_cfg(cfg);
+	mcc_ir_delete_ir(ir);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+void dominators_and_loops(CuTest *tc)
+{
+	const char input[] = "int main(){int i; int j; i = 0; "
+	                     "while (i < 3) { j = 0; while (j < i) { j = j + 1; } i = i + 1; } "
+	                     "if (i == 3) { i = 1; } else { i = 2; } return i;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_basic_block *cfg = mcc_cfg_generate_function(ir);
+	struct mcc_cfg_analysis *analysis = mcc_cfg_analyze(cfg);
+	CuAssertPtrNotNull(tc, analysis);
+
+	// 0 main, 1 outer condition, 2 j = 0, 3 inner condition, 4 inner body, 5 i = i + 1, 6 if condition, 7 then,
+	// 8 else, 9 return
+	CuAssertIntEquals(tc, 10, analysis->num_blocks);
+	CuAssertIntEquals(tc, 10, analysis->num_reachable);
+	struct mcc_basic_block **b = analysis->blocks;
+	CuAssertPtrEquals(tc, cfg, analysis->rpo[0]);
+
+	// Dominator tree
+	unsigned idoms[] = {0, 0, 1, 2, 3, 3, 1, 6, 6, 6};
+	CuAssertPtrEquals(tc, NULL, mcc_cfg_get_idom(analysis, b[0]));
+	for (unsigned i = 1; i < 10; i++) {
+		CuAssertPtrEquals(tc, b[idoms[i]], mcc_cfg_get_idom(analysis, b[i]));
+	}
+	CuAssertTrue(tc, mcc_cfg_dominates(analysis, b[0], b[9]));
+	CuAssertTrue(tc, mcc_cfg_dominates(analysis, b[3], b[5]));
+	CuAssertTrue(tc, mcc_cfg_dominates(analysis, b[5], b[5]));
+	CuAssertTrue(tc, !mcc_cfg_dominates(analysis, b[7], b[9]));
+	CuAssertTrue(tc, !mcc_cfg_dominates(analysis, b[4], b[5]));
+
+	// Dominance frontiers
+	struct mcc_cfg_block_info *info = analysis->info;
+	CuAssertIntEquals(tc, 0, info[0].num_frontier);
+	CuAssertIntEquals(tc, 1, info[7].num_frontier);
+	CuAssertPtrEquals(tc, b[9], info[7].frontier[0]);
+	CuAssertIntEquals(tc, 1, info[4].num_frontier);
+	CuAssertPtrEquals(tc, b[3], info[4].frontier[0]);
+	CuAssertIntEquals(tc, 2, info[3].num_frontier);
+	CuAssertPtrEquals(tc, b[1], info[3].frontier[0]);
+	CuAssertPtrEquals(tc, b[3], info[3].frontier[1]);
+
+	// Loops
+	CuAssertIntEquals(tc, 2, analysis->num_loops);
+	struct mcc_loop *outer = &analysis->loops[0];
+	struct mcc_loop *inner = &analysis->loops[1];
+	CuAssertPtrEquals(tc, b[1], outer->header);
+	CuAssertPtrEquals(tc, b[0], outer->preheader);
+	CuAssertPtrEquals(tc, NULL, outer->parent);
+	CuAssertIntEquals(tc, 1, outer->depth);
+	CuAssertIntEquals(tc, 5, outer->num_blocks);
+	CuAssertIntEquals(tc, 1, outer->num_latches);
+	CuAssertPtrEquals(tc, b[5], outer->latches[0]);
+
+	CuAssertPtrEquals(tc, b[3], inner->header);
+	CuAssertPtrEquals(tc, b[2], inner->preheader);
+	CuAssertPtrEquals(tc, outer, inner->parent);
+	CuAssertIntEquals(tc, 2, inner->depth);
+	CuAssertIntEquals(tc, 2, inner->num_blocks);
+
+	unsigned depths[] = {0, 1, 1, 2, 2, 1, 0, 0, 0, 0};
+	for (unsigned i = 0; i < 10; i++) {
+		CuAssertIntEquals(tc, depths[i], mcc_cfg_loop_depth(analysis, b[i]));
+	}
+	CuAssertTrue(tc, mcc_cfg_is_loop_header(analysis, b[1]));
+	CuAssertTrue(tc, !mcc_cfg_is_loop_header(analysis, b[2]));
+	CuAssertTrue(tc, mcc_cfg_is_back_edge(analysis, b[5], b[1]));
+	CuAssertTrue(tc, mcc_cfg_is_back_edge(analysis, b[4], b[3]));
+	CuAssertTrue(tc, !mcc_cfg_is_back_edge(analysis, b[0], b[1]));
+
+	// Cleanup
+	mcc_cfg_delete_analysis(analysis);
+	mcc_delete_cfg(cfg);
+	mcc_ir_delete_ir(ir);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+void unreachable_block(CuTest *tc)
+{
+	const char input[] = "int main(){int a; a = 1; while (true) { return a; } return 2;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_basic_block *cfg = mcc_cfg_generate_function(ir);
+	struct mcc_cfg_analysis *analysis = mcc_cfg_analyze(cfg);
+	CuAssertPtrNotNull(tc, analysis);
+
+	// 0 main, 1 loop condition, 2 return a, 3 jump back after the return, 4 return 2
+	CuAssertIntEquals(tc, 5, analysis->num_blocks);
+	CuAssertIntEquals(tc, 4, analysis->num_reachable);
+	struct mcc_basic_block *dead = analysis->blocks[3];
+	CuAssertTrue(tc, mcc_cfg_is_reachable(analysis, cfg));
+	CuAssertTrue(tc, !mcc_cfg_is_reachable(analysis, dead));
+	CuAssertPtrEquals(tc, NULL, mcc_cfg_get_idom(analysis, dead));
+	CuAssertTrue(tc, !mcc_cfg_dominates(analysis, cfg, dead));
+
+	// The jump of the unreachable block is no back edge
+	CuAssertIntEquals(tc, 2, analysis->blocks[1]->num_predecessors);
+	CuAssertTrue(tc, !mcc_cfg_is_back_edge(analysis, dead, analysis->blocks[1]));
+	CuAssertIntEquals(tc, 0, analysis->num_loops);
+
+	// Cleanup
+	mcc_cfg_delete_analysis(analysis);
+	mcc_delete_cfg(cfg);
+	mcc_ir_delete_ir(ir);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+// clang-format off
+
+#define TESTS \
+	TEST(function_cfg) \
+	TEST(program_cfg) \
+	TEST(predecessors) \
+	TEST(dominators_and_loops) \
+	TEST(unreachable_block)
+
+// clang-format on
+
+#include "main_stub.inc"
+#undef TESTS
@@ -20,27 +20,26 @@ void test1(CuTest *tc)
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
-	struct mcc_ir_row *ir_head = ir;
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir = function->rows;
 
 	CuAssertPtrNotNull(tc, ir);
 
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_FUNC_LABEL);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_FUNC_LABEL);
-	CuAssertStrEquals(tc, ir->arg1->func_label, "main");
-	CuAssertPtrEquals(tc, ir->arg2, NULL);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_FUNC_LABEL);
+	CuAssertStrEquals(tc, ir->arg1.func_label, "main");
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_NONE);
 
-	struct mcc_ir_row *ir_next = ir->next_row;
+	struct mcc_ir_row *ir_next = ir + 1;
 	CuAssertPtrNotNull(tc, ir);
 
 	CuAssertIntEquals(tc, ir_next->instr, MCC_IR_INSTR_RETURN);
-	CuAssertIntEquals(tc, ir_next->arg1->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, (int)ir_next->arg1->lit_int, 42);
-	CuAssertPtrEquals(tc, ir_next->arg2, NULL);
-	// CuAssertPtrEquals(tc, ir_next->next_row, NULL);
+	CuAssertIntEquals(tc, ir_next->arg1.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)ir_next->arg1.lit_int, 42);
+	CuAssertIntEquals(tc, ir_next->arg2.type, MCC_IR_TYPE_NONE);
 
 	// Cleanup
-	mcc_ir_delete_ir(ir_head);
+	mcc_ir_delete_ir(function);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
 	mcc_semantic_check_delete_single_check(checks);
@@ -54,29 +53,30 @@ void expression(CuTest *tc)
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
-	struct mcc_ir_row *ir_head = mcc_ir_generate((&parser_result)->program);
-	struct mcc_ir_row *ir = ir_head->next_row;
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir_head = function->rows;
+	struct mcc_ir_row *ir = ir_head + 1;
 
 	CuAssertPtrNotNull(tc, ir);
 
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_PLUS);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, (int)ir->arg1->lit_int, 0);
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, (int)ir->arg2->lit_int, 0);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)ir->arg1.lit_int, 0);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)ir->arg2.lit_int, 0);
 
-	struct mcc_ir_row *next_ir = ir->next_row;
+	struct mcc_ir_row *next_ir = ir + 1;
 	CuAssertPtrNotNull(tc, next_ir);
 
 	CuAssertIntEquals(tc, next_ir->instr, MCC_IR_INSTR_PLUS);
-	CuAssertIntEquals(tc, next_ir->arg1->type, MCC_IR_TYPE_ROW);
-	CuAssertPtrEquals(tc, next_ir->arg1->row, ir);
-	CuAssertIntEquals(tc, next_ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, (int)next_ir->arg2->lit_int, 1);
+	CuAssertIntEquals(tc, next_ir->arg1.type, MCC_IR_TYPE_ROW);
+	CuAssertPtrEquals(tc, &function->rows[next_ir->arg1.row], ir);
+	CuAssertIntEquals(tc, next_ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)next_ir->arg2.lit_int, 1);
 
 	// Cleanup
-	mcc_ir_delete_ir(ir_head);
+	mcc_ir_delete_ir(function);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
 }
@@ -89,22 +89,23 @@ void exp_plus_exp(CuTest *tc)
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
-	struct mcc_ir_row *ir_head = mcc_ir_generate((&parser_result)->program);
-	struct mcc_ir_row *ir = ir_head->next_row;
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir_head = function->rows;
+	struct mcc_ir_row *ir = ir_head + 1;
 
 	CuAssertPtrNotNull(tc, ir);
 
-	struct mcc_ir_row *exp_row = ir->next_row->next_row;
+	struct mcc_ir_row *exp_row = ir + 2;
 
 	CuAssertIntEquals(tc, exp_row->instr, MCC_IR_INSTR_MINUS);
-	CuAssertPtrNotNull(tc, exp_row->arg1);
-	CuAssertIntEquals(tc, exp_row->arg1->type, MCC_IR_TYPE_ROW);
-	CuAssertPtrEquals(tc, exp_row->arg1->row, ir);
-	CuAssertIntEquals(tc, exp_row->arg2->type, MCC_IR_TYPE_ROW);
-	CuAssertPtrEquals(tc, exp_row->arg2->row, ir->next_row);
+	CuAssertTrue(tc, exp_row->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, exp_row->arg1.type, MCC_IR_TYPE_ROW);
+	CuAssertPtrEquals(tc, &function->rows[exp_row->arg1.row], ir);
+	CuAssertIntEquals(tc, exp_row->arg2.type, MCC_IR_TYPE_ROW);
+	CuAssertPtrEquals(tc, &function->rows[exp_row->arg2.row], ir + 1);
 
 	// Cleanup
-	mcc_ir_delete_ir(ir_head);
+	mcc_ir_delete_ir(function);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
 }
@@ -117,29 +118,30 @@ void expression_var(CuTest *tc)
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
-	struct mcc_ir_row *ir_head = mcc_ir_generate((&parser_result)->program);
-	struct mcc_ir_row *ir = ir_head->next_row;
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir_head = function->rows;
+	struct mcc_ir_row *ir = ir_head + 1;
 
 	CuAssertPtrNotNull(tc, ir);
 
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_ASSIGN);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, ir->arg1->ident, "a");
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, (int)ir->arg2->lit_int, 3);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, ir->arg1.ident, "a");
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)ir->arg2.lit_int, 3);
 
-	struct mcc_ir_row *next_ir = ir->next_row;
+	struct mcc_ir_row *next_ir = ir + 1;
 	CuAssertPtrNotNull(tc, next_ir);
 
 	CuAssertIntEquals(tc, next_ir->instr, MCC_IR_INSTR_PLUS);
-	CuAssertIntEquals(tc, next_ir->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, next_ir->arg1->ident, "a");
-	CuAssertIntEquals(tc, next_ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, (int)next_ir->arg2->lit_int, 1);
+	CuAssertIntEquals(tc, next_ir->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, next_ir->arg1.ident, "a");
+	CuAssertIntEquals(tc, next_ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)next_ir->arg2.lit_int, 1);
 
 	// Cleanup
-	mcc_ir_delete_ir(ir_head);
+	mcc_ir_delete_ir(function);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
 }
@@ -152,38 +154,39 @@ void expression_arr(CuTest *tc)
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
-	struct mcc_ir_row *ir_head = mcc_ir_generate((&parser_result)->program);
-	struct mcc_ir_row *ir = ir_head->next_row;
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir_head = function->rows;
+	struct mcc_ir_row *ir = ir_head + 1;
 
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_ARRAY);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, ir->arg1->arr_ident, "arr");
-	CuAssertIntEquals(tc, (int)ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, (int)ir->arg2->lit_int, 10);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, ir->arg1.arr_ident, "arr");
+	CuAssertIntEquals(tc, (int)ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)ir->arg2.lit_int, 10);
 
-	ir = ir->next_row;
+	ir++;
 
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_ASSIGN);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_ARR_ELEM);
-	CuAssertStrEquals(tc, ir->arg1->arr_ident, "arr");
-	CuAssertIntEquals(tc, (int)ir->arg1->index->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, (int)ir->arg1->index->lit_int, 4);
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, (int)ir->arg2->lit_int, 3);
-
-	struct mcc_ir_row *next_ir = ir->next_row;
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_ARR_ELEM);
+	CuAssertStrEquals(tc, ir->arg1.arr_ident, "arr");
+	CuAssertIntEquals(tc, (int)ir->arg1.index.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)ir->arg1.index.lit_int, 4);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)ir->arg2.lit_int, 3);
+
+	struct mcc_ir_row *next_ir = ir + 1;
 	CuAssertPtrNotNull(tc, next_ir);
 
 	CuAssertIntEquals(tc, next_ir->instr, MCC_IR_INSTR_RETURN);
-	CuAssertIntEquals(tc, next_ir->arg1->type, MCC_IR_TYPE_ARR_ELEM);
-	CuAssertStrEquals(tc, ir->arg1->arr_ident, "arr");
-	CuAssertIntEquals(tc, (int)ir->arg1->index->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, (int)ir->arg1->index->lit_int, 4);
+	CuAssertIntEquals(tc, next_ir->arg1.type, MCC_IR_TYPE_ARR_ELEM);
+	CuAssertStrEquals(tc, ir->arg1.arr_ident, "arr");
+	CuAssertIntEquals(tc, (int)ir->arg1.index.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)ir->arg1.index.lit_int, 4);
 
 	// Cleanup
-	mcc_ir_delete_ir(ir_head);
+	mcc_ir_delete_ir(function);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
 }
@@ -196,66 +199,66 @@ void if_stmt(CuTest *tc)
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
-	struct mcc_ir_row *ir_head = ir;
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir = function->rows;
 	struct mcc_ir_row *tmp = ir;
 	// Skip first row
-	ir = ir->next_row;
+	ir++;
 
 	// Condition
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_EQUALS);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertIntEquals(tc, (int)ir->arg1->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, ir->arg1->lit_int, 0);
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, (int)ir->arg2->lit_int, 1);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, (int)ir->arg1.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, ir->arg1.lit_int, 0);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)ir->arg2.lit_int, 1);
 
 	// Jumpfalse L0
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_JUMPFALSE);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_ROW);
-	CuAssertPtrEquals(tc, ir->arg1->row, tmp);
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LABEL);
-	CuAssertIntEquals(tc, ir->arg2->label, 0);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_ROW);
+	CuAssertPtrEquals(tc, &function->rows[ir->arg1.row], tmp);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LABEL);
+	CuAssertIntEquals(tc, ir->arg2.label, 0);
 
 	// On true: 1*2
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_MULTIPLY);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertPtrNotNull(tc, ir->arg2);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, ir->arg1->lit_int, 1);
-	CuAssertIntEquals(tc, ir->arg2->lit_int, 2);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertTrue(tc, ir->arg2.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, ir->arg1.lit_int, 1);
+	CuAssertIntEquals(tc, ir->arg2.lit_int, 2);
 
 	// On true: x + 2
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_PLUS);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertPtrNotNull(tc, ir->arg2);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_ROW);
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertPtrEquals(tc, ir->arg1->row, tmp);
-	CuAssertIntEquals(tc, ir->arg2->lit_int, 2);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertTrue(tc, ir->arg2.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_ROW);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertPtrEquals(tc, &function->rows[ir->arg1.row], tmp);
+	CuAssertIntEquals(tc, ir->arg2.lit_int, 2);
 
 	// L0
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_LABEL);
-	CuAssertPtrEquals(tc, ir->arg2, NULL);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_LABEL);
-	CuAssertIntEquals(tc, ir->arg1->label, 0);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_LABEL);
+	CuAssertIntEquals(tc, ir->arg1.label, 0);
 
 	// Cleanup
-	mcc_ir_delete_ir(ir_head);
+	mcc_ir_delete_ir(function);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
 }
@@ -268,84 +271,84 @@ void if_else_stmt(CuTest *tc)
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
-	struct mcc_ir_row *ir_head = ir;
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir = function->rows;
 	struct mcc_ir_row *tmp = ir;
 	// Skip first row
-	ir = ir->next_row;
+	ir++;
 
 	// Condition
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_EQUALS);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertIntEquals(tc, (int)ir->arg1->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, ir->arg1->lit_int, 0);
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, (int)ir->arg2->lit_int, 1);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, (int)ir->arg1.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, ir->arg1.lit_int, 0);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)ir->arg2.lit_int, 1);
 
 	// Jumpfalse L0
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_JUMPFALSE);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_ROW);
-	CuAssertPtrEquals(tc, ir->arg1->row, tmp);
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LABEL);
-	CuAssertIntEquals(tc, ir->arg2->label, 0);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_ROW);
+	CuAssertPtrEquals(tc, &function->rows[ir->arg1.row], tmp);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LABEL);
+	CuAssertIntEquals(tc, ir->arg2.label, 0);
 
 	// On true: 1*2
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_MULTIPLY);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertPtrNotNull(tc, ir->arg2);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, ir->arg1->lit_int, 1);
-	CuAssertIntEquals(tc, ir->arg2->lit_int, 2);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertTrue(tc, ir->arg2.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, ir->arg1.lit_int, 1);
+	CuAssertIntEquals(tc, ir->arg2.lit_int, 2);
 
 	// jump L1
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_JUMP);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertPtrEquals(tc, NULL, ir->arg2);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_LABEL);
-	CuAssertIntEquals(tc, ir->arg1->label, 1);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, MCC_IR_TYPE_NONE, ir->arg2.type);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_LABEL);
+	CuAssertIntEquals(tc, ir->arg1.label, 1);
 
 	// L0
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_LABEL);
-	CuAssertPtrEquals(tc, ir->arg2, NULL);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_LABEL);
-	CuAssertIntEquals(tc, ir->arg1->label, 0);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_LABEL);
+	CuAssertIntEquals(tc, ir->arg1.label, 0);
 
 	// On false: 3+4
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_PLUS);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertPtrNotNull(tc, ir->arg2);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, ir->arg1->lit_int, 3);
-	CuAssertIntEquals(tc, ir->arg2->lit_int, 4);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertTrue(tc, ir->arg2.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, ir->arg1.lit_int, 3);
+	CuAssertIntEquals(tc, ir->arg2.lit_int, 4);
 
 	// L1
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_LABEL);
-	CuAssertPtrEquals(tc, ir->arg2, NULL);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_LABEL);
-	CuAssertIntEquals(tc, ir->arg1->label, 1);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_LABEL);
+	CuAssertIntEquals(tc, ir->arg1.label, 1);
 
 	// Cleanup
-	mcc_ir_delete_ir(ir_head);
+	mcc_ir_delete_ir(function);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
 }
@@ -358,96 +361,96 @@ void while_stmt(CuTest *tc)
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
-	struct mcc_ir_row *ir_head = ir;
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir = function->rows;
 	struct mcc_ir_row *tmp = ir;
 	// Skip first row
-	ir = ir->next_row;
+	ir++;
 
 	// a = 1
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_ASSIGN);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, ir->arg1->ident, "a");
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, ir->arg2->lit_int, 1);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, ir->arg1.ident, "a");
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, ir->arg2.lit_int, 1);
 
 	// L0
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_LABEL);
-	CuAssertPtrEquals(tc, ir->arg2, NULL);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_LABEL);
-	CuAssertIntEquals(tc, ir->arg1->label, 0);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_LABEL);
+	CuAssertIntEquals(tc, ir->arg1.label, 0);
 
 	// condition
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_SMALLER);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, ir->arg1->ident, "a");
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, ir->arg2->label, 11);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, ir->arg1.ident, "a");
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, ir->arg2.label, 11);
 
 	// Jumpfalse L1
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_JUMPFALSE);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_ROW);
-	CuAssertPtrEquals(tc, ir->arg1->row, tmp);
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LABEL);
-	CuAssertIntEquals(tc, ir->arg2->label, 1);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_ROW);
+	CuAssertPtrEquals(tc, &function->rows[ir->arg1.row], tmp);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LABEL);
+	CuAssertIntEquals(tc, ir->arg2.label, 1);
 
 	// On true: a + 1
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_PLUS);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertPtrNotNull(tc, ir->arg2);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, ir->arg1->ident, "a");
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, ir->arg2->lit_int, 1);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertTrue(tc, ir->arg2.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, ir->arg1.ident, "a");
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, ir->arg2.lit_int, 1);
 
 	// On true: a = x
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_ASSIGN);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertPtrNotNull(tc, ir->arg2);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, ir->arg1->ident, "a");
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_ROW);
-	CuAssertPtrEquals(tc, ir->arg2->row, tmp);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertTrue(tc, ir->arg2.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, ir->arg1.ident, "a");
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_ROW);
+	CuAssertPtrEquals(tc, &function->rows[ir->arg2.row], tmp);
 
 	// jump L0
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_JUMP);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertPtrEquals(tc, NULL, ir->arg2);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_LABEL);
-	CuAssertIntEquals(tc, ir->arg1->label, 0);
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, MCC_IR_TYPE_NONE, ir->arg2.type);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_LABEL);
+	CuAssertIntEquals(tc, ir->arg1.label, 0);
 
 	// L1
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_LABEL);
-	CuAssertPtrEquals(tc, ir->arg2, NULL);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_LABEL);
-	CuAssertIntEquals(tc, ir->arg1->label, 1);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_LABEL);
+	CuAssertIntEquals(tc, ir->arg1.label, 1);
 
 	// Cleanup
-	mcc_ir_delete_ir(ir_head);
+	mcc_ir_delete_ir(function);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
 }
@@ -460,60 +463,60 @@ void func_def(CuTest *tc)
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir = function->rows;
 	struct mcc_ir_row *tmp = ir;
-	struct mcc_ir_row *ir_head = ir;
 
 	// Label test
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_FUNC_LABEL);
-	CuAssertPtrNotNull(tc, ir->arg1);
-	CuAssertPtrEquals(tc, NULL, ir->arg2);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_FUNC_LABEL);
-	CuAssertStrEquals(tc, ir->arg1->func_label, "test");
+	CuAssertTrue(tc, ir->arg1.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, MCC_IR_TYPE_NONE, ir->arg2.type);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_FUNC_LABEL);
+	CuAssertStrEquals(tc, ir->arg1.func_label, "test");
 
 	// Pop and assign a
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_POP);
-	CuAssertPtrEquals(tc, NULL, ir->arg1);
-	CuAssertPtrEquals(tc, NULL, ir->arg2);
+	CuAssertIntEquals(tc, MCC_IR_TYPE_NONE, ir->arg1.type);
+	CuAssertIntEquals(tc, MCC_IR_TYPE_NONE, ir->arg2.type);
 
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_ASSIGN);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, ir->arg1->ident, "a");
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_ROW);
-	CuAssertPtrEquals(tc, ir->arg2->row, tmp);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, ir->arg1.ident, "a");
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_ROW);
+	CuAssertPtrEquals(tc, &function->rows[ir->arg2.row], tmp);
 
 	// Pop and assign b
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_POP);
-	CuAssertPtrEquals(tc, NULL, ir->arg1);
-	CuAssertPtrEquals(tc, NULL, ir->arg2);
+	CuAssertIntEquals(tc, MCC_IR_TYPE_NONE, ir->arg1.type);
+	CuAssertIntEquals(tc, MCC_IR_TYPE_NONE, ir->arg2.type);
 
 	tmp = ir;
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_ASSIGN);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, ir->arg1->ident, "b");
-	CuAssertIntEquals(tc, ir->arg2->type, MCC_IR_TYPE_ROW);
-	CuAssertPtrEquals(tc, ir->arg2->row, tmp);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, ir->arg1.ident, "b");
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_ROW);
+	CuAssertPtrEquals(tc, &function->rows[ir->arg2.row], tmp);
 
 	// Return 0
-	ir = ir->next_row;
+	ir++;
 	CuAssertPtrNotNull(tc, ir);
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_RETURN);
-	CuAssertIntEquals(tc, ir->arg1->type, MCC_IR_TYPE_LIT_INT);
-	CuAssertIntEquals(tc, ir->arg1->lit_int, 0);
-	CuAssertPtrEquals(tc, NULL, ir->arg2);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, ir->arg1.lit_int, 0);
+	CuAssertIntEquals(tc, MCC_IR_TYPE_NONE, ir->arg2.type);
 
 	// Cleanup
-	mcc_ir_delete_ir(ir_head);
+	mcc_ir_delete_ir(function);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
 }
@@ -527,46 +530,46 @@ void func_call(CuTest *tc)
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir = function->rows;
 	struct mcc_ir_row *tmp = ir;
-	struct mcc_ir_row *ir_head = ir;
 
-	tmp = tmp->next_row->next_row->next_row->next_row;
+	tmp += 4;
 
 	CuAssertPtrNotNull(tc, tmp);
 	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_PUSH);
-	CuAssertIntEquals(tc, tmp->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, tmp->arg1->ident, "b");
-	CuAssertPtrEquals(tc, NULL, tmp->arg2);
+	CuAssertIntEquals(tc, tmp->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "b");
+	CuAssertIntEquals(tc, MCC_IR_TYPE_NONE, tmp->arg2.type);
 
-	tmp = tmp->next_row;
+	tmp++;
 
 	CuAssertPtrNotNull(tc, tmp);
 	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_PUSH);
-	CuAssertIntEquals(tc, tmp->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, tmp->arg1->ident, "a");
-	CuAssertPtrEquals(tc, NULL, tmp->arg2);
+	CuAssertIntEquals(tc, tmp->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "a");
+	CuAssertIntEquals(tc, MCC_IR_TYPE_NONE, tmp->arg2.type);
 
-	tmp = tmp->next_row;
+	tmp++;
 
 	CuAssertPtrNotNull(tc, tmp);
 	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_CALL);
-	CuAssertIntEquals(tc, tmp->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, tmp->arg1->ident, "test");
-	CuAssertPtrEquals(tc, NULL, tmp->arg2);
+	CuAssertIntEquals(tc, tmp->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "test");
+	CuAssertIntEquals(tc, MCC_IR_TYPE_NONE, tmp->arg2.type);
 
-	struct mcc_ir_row *ass = tmp->next_row;
+	struct mcc_ir_row *ass = tmp + 1;
 
 	CuAssertPtrNotNull(tc, ass);
 	CuAssertIntEquals(tc, ass->instr, MCC_IR_INSTR_ASSIGN);
-	CuAssertIntEquals(tc, ass->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, ass->arg1->ident, "c");
-	CuAssertPtrNotNull(tc, ass->arg2);
-	CuAssertIntEquals(tc, ass->arg2->type, MCC_IR_TYPE_ROW);
-	CuAssertPtrEquals(tc, ass->arg2->row, tmp);
+	CuAssertIntEquals(tc, ass->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, ass->arg1.ident, "c");
+	CuAssertTrue(tc, ass->arg2.type != MCC_IR_TYPE_NONE);
+	CuAssertIntEquals(tc, ass->arg2.type, MCC_IR_TYPE_ROW);
+	CuAssertPtrEquals(tc, &function->rows[ass->arg2.row], tmp);
 
 	// Cleanup
-	mcc_ir_delete_ir(ir_head);
+	mcc_ir_delete_ir(function);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
 }
@@ -580,52 +583,90 @@ void variable_shadowing(CuTest *tc)
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
-	struct mcc_ir_row *ir_head = ir;
-	struct mcc_ir_row *tmp = ir->next_row;
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir = function->rows;
+	struct mcc_ir_row *tmp = ir + 1;
 
 	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_ASSIGN);
-	CuAssertIntEquals(tc, tmp->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, tmp->arg1->ident, "a");
+	CuAssertIntEquals(tc, tmp->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "a");
 
-	tmp = tmp->next_row->next_row->next_row;
+	tmp += 3;
 
 	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_ASSIGN);
-	CuAssertIntEquals(tc, tmp->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, tmp->arg1->ident, "$r1");
+	CuAssertIntEquals(tc, tmp->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "$r1");
 
-	tmp = tmp->next_row->next_row;
+	tmp += 2;
 
 	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_ASSIGN);
-	CuAssertIntEquals(tc, tmp->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, tmp->arg1->ident, "$r0");
+	CuAssertIntEquals(tc, tmp->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "$r0");
 
-	tmp = tmp->next_row;
+	tmp++;
 
 	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_PLUS);
-	CuAssertIntEquals(tc, tmp->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, tmp->arg1->ident, "$r0");
+	CuAssertIntEquals(tc, tmp->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "$r0");
 
-	tmp = tmp->next_row;
+	tmp++;
 
 	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_ASSIGN);
-	CuAssertIntEquals(tc, tmp->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, tmp->arg1->ident, "$r0");
+	CuAssertIntEquals(tc, tmp->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "$r0");
 
-	tmp = tmp->next_row->next_row->next_row;
+	tmp += 3;
 
 	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_ASSIGN);
-	CuAssertIntEquals(tc, tmp->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, tmp->arg1->ident, "$r1");
+	CuAssertIntEquals(tc, tmp->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "$r1");
 
-	tmp = tmp->next_row->next_row->next_row->next_row;
+	tmp += 4;
 
 	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_ASSIGN);
-	CuAssertIntEquals(tc, tmp->arg1->type, MCC_IR_TYPE_IDENTIFIER);
-	CuAssertStrEquals(tc, tmp->arg1->ident, "a");
+	CuAssertIntEquals(tc, tmp->arg1.type, MCC_IR_TYPE_IDENTIFIER);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "a");
 
 	// Cleanup
-	mcc_ir_delete_ir(ir_head);
+	mcc_ir_delete_ir(function);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+void variable_shadowing_use_before_declaration(CuTest *tc)
+{
+	const char input[] = "int main(){int a; a = 1; {a = 2; int a; a = 3;} a = 4; return 0;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir = function->rows;
+	struct mcc_ir_row *tmp = ir + 1;
+
+	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_ASSIGN);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "a");
+
+	// a = 2 still refers to the outer a
+	tmp++;
+	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_ASSIGN);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "a");
+
+	tmp++;
+	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_ASSIGN);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "$r0");
+
+	tmp++;
+	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_ASSIGN);
+	CuAssertStrEquals(tc, tmp->arg1.ident, "a");
+
+	// the symbol table row of the inner declaration is renamed as well
+	struct mcc_symbol_table_row *row = table->head->head->child_scope->head->child_scope->head;
+	CuAssertStrEquals(tc, "$r0", row->next_row->name);
+
+	// Cleanup
+	mcc_ir_delete_ir(function);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
 }
@@ -639,35 +680,35 @@ void type_test(CuTest *tc)
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
-	struct mcc_ir_row *ir_head = ir;
-	struct mcc_ir_row *tmp = ir->next_row;
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir = function->rows;
+	struct mcc_ir_row *tmp = ir + 1;
 
-	CuAssertIntEquals(tc, tmp->type->type, MCC_IR_ROW_INT);
-	CuAssertIntEquals(tc, tmp->type->array_size, -1);
+	CuAssertIntEquals(tc, tmp->type.type, MCC_IR_ROW_INT);
+	CuAssertIntEquals(tc, tmp->type.array_size, -1);
 
-	tmp = tmp->next_row;
+	tmp++;
 
-	CuAssertIntEquals(tc, tmp->type->type, MCC_IR_ROW_BOOL);
-	CuAssertIntEquals(tc, tmp->type->array_size, -1);
+	CuAssertIntEquals(tc, tmp->type.type, MCC_IR_ROW_BOOL);
+	CuAssertIntEquals(tc, tmp->type.array_size, -1);
 
-	tmp = tmp->next_row;
+	tmp++;
 
-	CuAssertIntEquals(tc, tmp->type->type, MCC_IR_ROW_FLOAT);
-	CuAssertIntEquals(tc, tmp->type->array_size, -1);
+	CuAssertIntEquals(tc, tmp->type.type, MCC_IR_ROW_FLOAT);
+	CuAssertIntEquals(tc, tmp->type.array_size, -1);
 
-	tmp = tmp->next_row;
+	tmp++;
 
-	CuAssertIntEquals(tc, tmp->type->type, MCC_IR_ROW_FLOAT);
-	CuAssertIntEquals(tc, tmp->type->array_size, -1);
+	CuAssertIntEquals(tc, tmp->type.type, MCC_IR_ROW_FLOAT);
+	CuAssertIntEquals(tc, tmp->type.array_size, -1);
 
-	tmp = tmp->next_row;
+	tmp++;
 
-	CuAssertIntEquals(tc, tmp->type->type, MCC_IR_ROW_STRING);
-	CuAssertIntEquals(tc, tmp->type->array_size, -1);
+	CuAssertIntEquals(tc, tmp->type.type, MCC_IR_ROW_STRING);
+	CuAssertIntEquals(tc, tmp->type.array_size, -1);
 
 	// Cleanup
-	mcc_ir_delete_ir(ir_head);
+	mcc_ir_delete_ir(function);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
 }
@@ -681,30 +722,61 @@ void type_array_test(CuTest *tc)
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
-	struct mcc_ir_row *ir_head = ir;
-	struct mcc_ir_row *tmp = ir->next_row;
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir = function->rows;
+	struct mcc_ir_row *tmp = ir + 1;
+
+	CuAssertIntEquals(tc, tmp->type.type, MCC_IR_ROW_INT);
+	CuAssertIntEquals(tc, tmp->type.array_size, 42);
+
+	tmp += 2;
+
+	CuAssertIntEquals(tc, tmp->type.type, MCC_IR_ROW_BOOL);
+	CuAssertIntEquals(tc, tmp->type.array_size, 42);
+
+	tmp += 2;
+
+	CuAssertIntEquals(tc, tmp->type.type, MCC_IR_ROW_FLOAT);
+	CuAssertIntEquals(tc, tmp->type.array_size, 32);
+
+	tmp += 2;
+
+	CuAssertIntEquals(tc, tmp->type.type, MCC_IR_ROW_STRING);
+	CuAssertIntEquals(tc, tmp->type.array_size, 12);
 
-	CuAssertIntEquals(tc, tmp->type->type, MCC_IR_ROW_INT);
-	CuAssertIntEquals(tc, tmp->type->array_size, 42);
+	// Cleanup
+	mcc_ir_delete_ir(function);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
 
-	tmp = tmp->next_row->next_row;
+void arg_equal(CuTest *tc)
+{
+	const char input[] = "int main(){string a; string b; a = \"x\"; b = \"x\"; a = \"y\"; return 0;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
-	CuAssertIntEquals(tc, tmp->type->type, MCC_IR_ROW_BOOL);
-	CuAssertIntEquals(tc, tmp->type->array_size, 42);
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_row *ir = function->rows + 1;
 
-	tmp = tmp->next_row->next_row;
+	// Equal string literals share one string
+	CuAssertPtrEquals(tc, ir[0].arg2.lit_string, ir[1].arg2.lit_string);
+	CuAssertTrue(tc, mcc_ir_arg_equal(&ir[0].arg2, &ir[1].arg2));
+	CuAssertTrue(tc, !mcc_ir_arg_equal(&ir[0].arg2, &ir[2].arg2));
 
-	CuAssertIntEquals(tc, tmp->type->type, MCC_IR_ROW_FLOAT);
-	CuAssertIntEquals(tc, tmp->type->array_size, 32);
+	CuAssertTrue(tc, mcc_ir_arg_equal(&ir[0].arg1, &ir[2].arg1));
+	CuAssertTrue(tc, !mcc_ir_arg_equal(&ir[0].arg1, &ir[1].arg1));
 
-	tmp = tmp->next_row->next_row;
+	// Arguments of different types are never equal
+	CuAssertTrue(tc, !mcc_ir_arg_equal(&ir[0].arg1, &ir[0].arg2));
 
-	CuAssertIntEquals(tc, tmp->type->type, MCC_IR_ROW_STRING);
-	CuAssertIntEquals(tc, tmp->type->array_size, 12);
+	// Absent arguments are equal
+	CuAssertTrue(tc, mcc_ir_arg_equal(&ir[3].arg2, &function->rows[0].arg2));
 
 	// Cleanup
-	mcc_ir_delete_ir(ir_head);
+	mcc_ir_delete_ir(function);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
 }
@@ -723,8 +795,10 @@ void type_array_test(CuTest *tc)
 	TEST(func_def) \
 	TEST(func_call)\
 	TEST(variable_shadowing) \
+	TEST(variable_shadowing_use_before_declaration) \
 	TEST(type_test) \
-	TEST(type_array_test)
+	TEST(type_array_test) \
+	TEST(arg_equal)
 
 // clang-format on
 
@@ -0,0 +1,224 @@
+#include <CuTest.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mcc/asm.h"
+#include "mcc/ast.h"
+#include "mcc/ir.h"
+#include "mcc/optimize.h"
+#include "mcc/pass_manager.h"
+#include "mcc/semantic_checks.h"
+#include "mcc/symbol_table.h"
+
+void fold_constants(CuTest *tc)
+{
+	const char input[] = "int main(){return 1 + 2 * 3;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	CuAssertIntEquals(tc, 4, function->num_rows);
+
+	CuAssertTrue(tc, mcc_optimize_fold_constants(function));
+
+	// The multiplication and the addition are removed
+	CuAssertIntEquals(tc, 2, function->num_rows);
+	struct mcc_ir_row *ir = function->rows + 1;
+	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_RETURN);
+	CuAssertIntEquals(tc, ir->arg1.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)ir->arg1.lit_int, 7);
+
+	// Cleanup
+	mcc_ir_delete_ir(function);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+void fold_constants_renumber(CuTest *tc)
+{
+	const char input[] = "int main(){int a; a = 2 * 3; return a + 1;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	CuAssertIntEquals(tc, 5, function->num_rows);
+
+	CuAssertTrue(tc, mcc_optimize_fold_constants(function));
+	CuAssertIntEquals(tc, 4, function->num_rows);
+
+	// a = 6
+	struct mcc_ir_row *ir = function->rows + 1;
+	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_ASSIGN);
+	CuAssertIntEquals(tc, ir->arg2.type, MCC_IR_TYPE_LIT_INT);
+	CuAssertIntEquals(tc, (int)ir->arg2.lit_int, 6);
+
+	// a + 1 is not constant, the return refers to the moved row
+	CuAssertIntEquals(tc, ir[1].instr, MCC_IR_INSTR_PLUS);
+	CuAssertIntEquals(tc, ir[2].instr, MCC_IR_INSTR_RETURN);
+	CuAssertIntEquals(tc, ir[2].arg1.type, MCC_IR_TYPE_ROW);
+	CuAssertPtrEquals(tc, &function->rows[ir[2].arg1.row], &ir[1]);
+
+	// Cleanup
+	mcc_ir_delete_ir(function);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+void fold_constants_division_by_zero(CuTest *tc)
+{
+	const char input[] = "int main(){return 1 / 0;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+	CuAssertTrue(tc, mcc_optimize_fold_constants(function));
+
+	CuAssertIntEquals(tc, 3, function->num_rows);
+	CuAssertIntEquals(tc, function->rows[1].instr, MCC_IR_INSTR_DIVIDE);
+
+	// Cleanup
+	mcc_ir_delete_ir(function);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+void simplify(CuTest *tc)
+{
+	const char input[] = "int f(int x){return (x * 2) * 1;} int main(){if (true) return 1; return 0;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+
+	// f: the multiplication with 1 is removed, the return refers to x * 2
+	CuAssertIntEquals(tc, 6, function->num_rows);
+	CuAssertTrue(tc, mcc_optimize_simplify(function));
+	CuAssertIntEquals(tc, 5, function->num_rows);
+	struct mcc_ir_row *ir = function->rows + 3;
+	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_MULTIPLY);
+	CuAssertIntEquals(tc, (int)ir->arg2.lit_int, 2);
+	CuAssertIntEquals(tc, ir[1].instr, MCC_IR_INSTR_RETURN);
+	CuAssertIntEquals(tc, ir[1].arg1.type, MCC_IR_TYPE_ROW);
+	CuAssertPtrEquals(tc, &function->rows[ir[1].arg1.row], ir);
+
+	// main: the jump on true is removed
+	struct mcc_ir_function *main_function = function->next;
+	CuAssertIntEquals(tc, main_function->rows[1].instr, MCC_IR_INSTR_JUMPFALSE);
+	CuAssertTrue(tc, mcc_optimize_simplify(main_function));
+	CuAssertIntEquals(tc, main_function->rows[1].instr, MCC_IR_INSTR_RETURN);
+	CuAssertIntEquals(tc, (int)main_function->rows[1].arg1.lit_int, 1);
+
+	// Cleanup
+	mcc_ir_delete_ir(function);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+// movl %eax, -8(%ebp) followed by movl -8(%ebp), %eax
+static bool is_store_and_load(struct mcc_asm_line *line)
+{
+	struct mcc_asm_line *next = line->next;
+	return next && line->opcode == MCC_ASM_MOVL && next->opcode == MCC_ASM_MOVL &&
+	       line->first->type == MCC_ASM_OPERAND_REGISTER && line->first->offset == 0 &&
+	       next->second->type == MCC_ASM_OPERAND_REGISTER && next->second->offset == 0 &&
+	       line->first->reg == next->second->reg && line->second->type == MCC_ASM_OPERAND_REGISTER &&
+	       next->first->type == MCC_ASM_OPERAND_REGISTER && line->second->reg == next->first->reg &&
+	       line->second->offset != 0 && line->second->offset == next->first->offset;
+}
+
+void peephole(CuTest *tc)
+{
+	const char input[] = "int main(){int a; int b; a = 1; b = a + 2; return b;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_ir_function *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_asm *code = mcc_asm_generate(ir);
+	CuAssertPtrNotNull(tc, code);
+	struct mcc_asm_function *function = code->text_section->function;
+
+	unsigned loads_before = 0;
+	for (struct mcc_asm_line *line = function->head; line; line = line->next) {
+		if (is_store_and_load(line))
+			loads_before++;
+	}
+	CuAssertTrue(tc, loads_before > 0);
+
+	CuAssertTrue(tc, mcc_optimize_peephole(function));
+
+	for (struct mcc_asm_line *line = function->head; line; line = line->next) {
+		CuAssertTrue(tc, !is_store_and_load(line));
+	}
+
+	// Cleanup
+	mcc_asm_delete_asm(code);
+	mcc_ir_delete_ir(ir);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+void pass_manager(CuTest *tc)
+{
+	CuAssertPtrNotNull(tc, mcc_pass_find("fold-constants"));
+	CuAssertTrue(tc, !mcc_pass_find("unknown"));
+
+	struct mcc_pass_manager manager;
+	CuAssertTrue(tc, !mcc_pass_manager_init(&manager, MCC_PASS_MANAGER_MAX_LEVEL + 1, NULL, NULL, false));
+	CuAssertTrue(tc, !mcc_pass_manager_init(&manager, 1, "unknown", stderr, false));
+	CuAssertTrue(tc, mcc_pass_manager_init(&manager, 0, NULL, NULL, false));
+
+	const char input[] = "int main(){return 1 + 2;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_ir_function *function = mcc_ir_generate((&parser_result)->program);
+
+	// -O0 and no pass manager leave the function as it is
+	CuAssertTrue(tc, mcc_pass_manager_run_ir(NULL, function));
+	CuAssertTrue(tc, mcc_pass_manager_run_ir(&manager, function));
+	CuAssertIntEquals(tc, 3, function->num_rows);
+
+	CuAssertTrue(tc, mcc_pass_manager_init(&manager, 1, NULL, NULL, true));
+	CuAssertTrue(tc, mcc_pass_manager_run_ir(&manager, function));
+	CuAssertIntEquals(tc, 2, function->num_rows);
+
+	unsigned count;
+	const struct mcc_pass *passes = mcc_pass_get_passes(&count);
+	for (unsigned i = 0; i < count; i++) {
+		bool runs = passes[i].kind == MCC_PASS_KIND_IR && passes[i].level <= 1;
+		CuAssertIntEquals(tc, runs ? 1 : 0, manager.timings[i].runs);
+	}
+
+	// Cleanup
+	mcc_ir_delete_ir(function);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+// clang-format off
+
+#define TESTS \
+	TEST(fold_constants) \
+	TEST(fold_constants_renumber) \
+	TEST(fold_constants_division_by_zero) \
+	TEST(simplify) \
+	TEST(peephole) \
+	TEST(pass_manager)
+
+// clang-format on
+
+#include "main_stub.inc"
+#undef TESTS
@@ -2,6 +2,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "mcc/ast.h"
 #include "mcc/parser.h"
@@ -9,6 +10,30 @@
 // Threshold for floating point comparisions.
 static const double EPS = 1e-3;
 
+// Longer than the default maximum depth of the bison parse stack, which right recursive list rules exceeded
+#define LONG_LIST 25000
+
+// Returns begin, followed by count elements formatted with their index and separated by separator, followed by end
+static char *generate_list(const char *begin, const char *element, const char *separator, const char *end, int count)
+{
+	size_t size = strlen(begin) + strlen(end) + 1;
+	for (int i = 0; i < count; i++) {
+		size += snprintf(NULL, 0, element, i) + strlen(separator);
+	}
+	char *input = malloc(size);
+	if (!input)
+		return NULL;
+
+	char *pos = input + sprintf(input, "%s", begin);
+	for (int i = 0; i < count; i++) {
+		pos += sprintf(pos, element, i);
+		if (i + 1 < count)
+			pos += sprintf(pos, "%s", separator);
+	}
+	sprintf(pos, "%s", end);
+	return input;
+}
+
 void BinaryOp_1(CuTest *tc)
 {
 	const char input[] = "192 + 3.14";
@@ -112,29 +137,24 @@ void BinaryOp_4(CuTest *tc)
 	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_BINARY_OP, expr->type);
 	CuAssertIntEquals(tc, MCC_AST_BINARY_OP_EQUAL, expr->op);
 
-	// root -> lhs
-	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_PARENTH, expr->lhs->type);
-
 	// root -> rhs
 	CuAssertIntEquals(tc, MCC_AST_LITERAL_TYPE_BOOL, expr->rhs->literal->type);
 	CuAssertTrue(tc, expr->rhs->literal->bool_value);
 
-	struct mcc_ast_expression *subexpr1 = expr->lhs->expression;
+	// Parentheses do not get a node of their own
+	struct mcc_ast_expression *subexpr1 = expr->lhs;
 
 	// root -> lhs -> subexpr1
 	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_BINARY_OP, subexpr1->type);
 	CuAssertIntEquals(tc, MCC_AST_BINARY_OP_CONJ, subexpr1->op);
 
-	// root -> lhs -> subexpr1 -> lhs
-	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_PARENTH, subexpr1->lhs->type);
-
-	struct mcc_ast_expression *subexpr2 = subexpr1->lhs->expression;
+	struct mcc_ast_expression *subexpr2 = subexpr1->lhs;
 
 	// subexpr2
 	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_BINARY_OP, subexpr2->type);
 	CuAssertIntEquals(tc, MCC_AST_BINARY_OP_DISJ, subexpr2->op);
 
-	struct mcc_ast_expression *subexpr3 = subexpr1->rhs->expression;
+	struct mcc_ast_expression *subexpr3 = subexpr1->rhs;
 
 	// subexpr3
 	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_BINARY_OP, subexpr3->type);
@@ -325,10 +345,7 @@ void NestedExpression_1(CuTest *tc)
 	CuAssertIntEquals(tc, MCC_AST_LITERAL_TYPE_INT, expr->lhs->literal->type);
 	CuAssertIntEquals(tc, 42, expr->lhs->literal->i_value);
 
-	// root -> rhs
-	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_PARENTH, expr->rhs->type);
-
-	struct mcc_ast_expression *subexpr = expr->rhs->expression;
+	struct mcc_ast_expression *subexpr = expr->rhs;
 
 	// subexpr
 	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_BINARY_OP, subexpr->type);
@@ -443,13 +460,11 @@ void if_compound_stmt(CuTest *tc)
 
 	// root -> on_true
 	CuAssertIntEquals(tc, MCC_AST_STATEMENT_TYPE_COMPOUND_STMT, stmt->if_on_true->type);
-	CuAssertTrue(tc, !stmt->if_on_true->compound_statement->is_empty);
-	CuAssertTrue(tc, !stmt->if_on_true->compound_statement->has_next_statement);
-	CuAssertTrue(tc, stmt->if_on_true->compound_statement->next_compound_statement == NULL);
+	CuAssertIntEquals(tc, 1, stmt->if_on_true->compound_statement->num_statements);
 
-	struct mcc_ast_statement *stmt2 = stmt->if_on_true->compound_statement->statement;
+	struct mcc_ast_statement *stmt2 = stmt->if_on_true->compound_statement->statements[0];
 
-	// root->on_true->compound_statement->statement
+	// root->on_true->compound_statement->statements[0]
 	CuAssertIntEquals(tc, MCC_AST_STATEMENT_TYPE_EXPRESSION, stmt2->type);
 	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_LITERAL, stmt2->stmt_expression->type);
 	CuAssertIntEquals(tc, 3, stmt2->stmt_expression->literal->i_value);
@@ -526,29 +541,24 @@ void SourceLocation_SingleLineColumn(CuTest *tc)
 
 	struct mcc_ast_expression *expr = result.expression;
 
-	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_PARENTH, expr->type);
+	// The parentheses are not part of the expression
+	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_BINARY_OP, expr->type);
 	CuAssertIntEquals(tc, 1, expr->node.sloc.start_line);
-	CuAssertIntEquals(tc, 1, expr->node.sloc.start_col);
+	CuAssertIntEquals(tc, 2, expr->node.sloc.start_col);
 	CuAssertIntEquals(tc, 1, expr->node.sloc.end_line);
-	CuAssertIntEquals(tc, 11, expr->node.sloc.end_col);
-
-	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_BINARY_OP, expr->expression->type);
-	CuAssertIntEquals(tc, 1, expr->expression->node.sloc.start_line);
-	CuAssertIntEquals(tc, 2, expr->expression->node.sloc.start_col);
-	CuAssertIntEquals(tc, 1, expr->expression->node.sloc.end_line);
-	CuAssertIntEquals(tc, 10, expr->expression->node.sloc.end_col);
-
-	CuAssertIntEquals(tc, MCC_AST_LITERAL_TYPE_INT, expr->expression->lhs->literal->type);
-	CuAssertIntEquals(tc, 1, expr->expression->lhs->literal->node.sloc.start_line);
-	CuAssertIntEquals(tc, 2, expr->expression->lhs->literal->node.sloc.start_col);
-	CuAssertIntEquals(tc, 1, expr->expression->lhs->literal->node.sloc.end_line);
-	CuAssertIntEquals(tc, 4, expr->expression->lhs->literal->node.sloc.end_col);
-
-	CuAssertIntEquals(tc, MCC_AST_LITERAL_TYPE_INT, expr->expression->rhs->literal->type);
-	CuAssertIntEquals(tc, 1, expr->expression->rhs->literal->node.sloc.start_line);
-	CuAssertIntEquals(tc, 7, expr->expression->rhs->literal->node.sloc.start_col);
-	CuAssertIntEquals(tc, 1, expr->expression->rhs->literal->node.sloc.end_line);
-	CuAssertIntEquals(tc, 10, expr->expression->rhs->literal->node.sloc.end_col);
+	CuAssertIntEquals(tc, 10, expr->node.sloc.end_col);
+
+	CuAssertIntEquals(tc, MCC_AST_LITERAL_TYPE_INT, expr->lhs->literal->type);
+	CuAssertIntEquals(tc, 1, expr->lhs->literal->node.sloc.start_line);
+	CuAssertIntEquals(tc, 2, expr->lhs->literal->node.sloc.start_col);
+	CuAssertIntEquals(tc, 1, expr->lhs->literal->node.sloc.end_line);
+	CuAssertIntEquals(tc, 4, expr->lhs->literal->node.sloc.end_col);
+
+	CuAssertIntEquals(tc, MCC_AST_LITERAL_TYPE_INT, expr->rhs->literal->type);
+	CuAssertIntEquals(tc, 1, expr->rhs->literal->node.sloc.start_line);
+	CuAssertIntEquals(tc, 7, expr->rhs->literal->node.sloc.start_col);
+	CuAssertIntEquals(tc, 1, expr->rhs->literal->node.sloc.end_line);
+	CuAssertIntEquals(tc, 10, expr->rhs->literal->node.sloc.end_col);
 
 	mcc_ast_delete(expr);
 }
@@ -633,7 +643,7 @@ void multiline_comment_and_program(CuTest *tc)
 	CuAssertIntEquals(tc, 6, function->node.sloc.end_line);
 	CuAssertIntEquals(tc, 2, function->node.sloc.end_col);
 
-	struct mcc_ast_statement *statement = function->compound_stmt->statement;
+	struct mcc_ast_statement *statement = function->compound_stmt->statements[0];
 
 	CuAssertIntEquals(tc, 4, statement->node.sloc.start_line);
 	CuAssertIntEquals(tc, 5, statement->node.sloc.start_col);
@@ -768,38 +778,25 @@ void CompoundStatement(CuTest *tc)
 
 	struct mcc_ast_compound_statement *compound_statement = result.compound_statement;
 
-	// root -> statement
-	CuAssertIntEquals(tc, compound_statement->statement->type, MCC_AST_STATEMENT_TYPE_DECLARATION);
-	CuAssertIntEquals(tc, compound_statement->statement->declaration->declaration_type,
-	                  MCC_AST_DECLARATION_TYPE_VARIABLE);
-	CuAssertIntEquals(tc, compound_statement->statement->declaration->variable_type->type_value, INT);
-	CuAssertStrEquals(tc, compound_statement->statement->declaration->variable_identifier->identifier_name, "a");
-
-	// root -> next_compound_statement
-
-	CuAssertTrue(tc, compound_statement->has_next_statement);
-	CuAssertIntEquals(tc, compound_statement->next_compound_statement->statement->type,
-	                  MCC_AST_STATEMENT_TYPE_ASSIGNMENT);
-	CuAssertIntEquals(tc, compound_statement->next_compound_statement->statement->assignment->assignment_type,
-	                  MCC_AST_ASSIGNMENT_TYPE_VARIABLE);
-	CuAssertStrEquals(
-	    tc,
-	    compound_statement->next_compound_statement->statement->assignment->variable_identifier->identifier_name,
-	    "a");
-
-	// root -> next_compound_statement -> assignment -> assigned_value
-
-	CuAssertIntEquals(
-	    tc, compound_statement->next_compound_statement->statement->assignment->variable_assigned_value->type,
-	    MCC_AST_EXPRESSION_TYPE_LITERAL);
-	CuAssertIntEquals(
-	    tc,
-	    compound_statement->next_compound_statement->statement->assignment->variable_assigned_value->literal->type,
-	    MCC_AST_LITERAL_TYPE_INT);
-	CuAssertIntEquals(tc,
-	                  compound_statement->next_compound_statement->statement->assignment->variable_assigned_value
-	                      ->literal->i_value,
-	                  1);
+	CuAssertIntEquals(tc, 2, compound_statement->num_statements);
+
+	// root -> statements[0]
+	struct mcc_ast_statement *first = compound_statement->statements[0];
+	CuAssertIntEquals(tc, first->type, MCC_AST_STATEMENT_TYPE_DECLARATION);
+	CuAssertIntEquals(tc, first->declaration->declaration_type, MCC_AST_DECLARATION_TYPE_VARIABLE);
+	CuAssertIntEquals(tc, first->declaration->variable_type->type_value, INT);
+	CuAssertStrEquals(tc, first->declaration->variable_identifier->identifier_name, "a");
+
+	// root -> statements[1]
+	struct mcc_ast_statement *second = compound_statement->statements[1];
+	CuAssertIntEquals(tc, second->type, MCC_AST_STATEMENT_TYPE_ASSIGNMENT);
+	CuAssertIntEquals(tc, second->assignment->assignment_type, MCC_AST_ASSIGNMENT_TYPE_VARIABLE);
+	CuAssertStrEquals(tc, second->assignment->variable_identifier->identifier_name, "a");
+
+	// root -> statements[1] -> assignment -> assigned_value
+	CuAssertIntEquals(tc, second->assignment->variable_assigned_value->type, MCC_AST_EXPRESSION_TYPE_LITERAL);
+	CuAssertIntEquals(tc, second->assignment->variable_assigned_value->literal->type, MCC_AST_LITERAL_TYPE_INT);
+	CuAssertIntEquals(tc, second->assignment->variable_assigned_value->literal->i_value, 1);
 
 	mcc_ast_delete(compound_statement);
 }
@@ -822,19 +819,16 @@ void FunctionCallArguments(CuTest *tc)
 
 	// root -> arguments
 
-	CuAssertTrue(tc, !function_call->arguments->is_empty);
-	CuAssertTrue(tc, function_call->arguments->has_next_expression);
+	CuAssertIntEquals(tc, 2, function_call->arguments->num_arguments);
 
-	// root -> arguments -> expression
+	// root -> arguments -> expressions[0]
 
-	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_VARIABLE, function_call->arguments->expression->type);
-	CuAssertStrEquals(tc, "a", function_call->arguments->expression->identifier->identifier_name);
+	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_VARIABLE, function_call->arguments->expressions[0]->type);
+	CuAssertStrEquals(tc, "a", function_call->arguments->expressions[0]->identifier->identifier_name);
 
-	// root -> arguments -> next_arguments
+	// root -> arguments -> expressions[1]
 
-	CuAssertPtrEquals(tc, NULL, function_call->arguments->next_arguments->next_arguments);
-	CuAssertTrue(tc, !(function_call->arguments->next_arguments->has_next_expression));
-	CuAssertStrEquals(tc, "h", function_call->arguments->next_arguments->expression->identifier->identifier_name);
+	CuAssertStrEquals(tc, "h", function_call->arguments->expressions[1]->identifier->identifier_name);
 
 	mcc_ast_delete(function_call);
 }
@@ -859,40 +853,31 @@ void FunctionDefParameters(CuTest *tc)
 
 	// root -> parameters
 
-	CuAssertTrue(tc, !(function_definition->parameters->is_empty));
-	CuAssertTrue(tc, !(function_definition->parameters->has_next_parameter));
-	CuAssertPtrEquals(tc, function_definition->parameters->next_parameters, NULL);
+	CuAssertIntEquals(tc, 1, function_definition->parameters->num_parameters);
 
-	// root -> parameters -> declaration
+	// root -> parameters -> declarations[0]
 
-	CuAssertIntEquals(tc, function_definition->parameters->declaration->declaration_type,
-	                  MCC_AST_DECLARATION_TYPE_VARIABLE);
-	CuAssertIntEquals(tc, function_definition->parameters->declaration->variable_type->type_value, BOOL);
-	CuAssertStrEquals(tc, function_definition->parameters->declaration->variable_identifier->identifier_name, "a");
+	struct mcc_ast_declaration *parameter = function_definition->parameters->declarations[0];
+	CuAssertIntEquals(tc, parameter->declaration_type, MCC_AST_DECLARATION_TYPE_VARIABLE);
+	CuAssertIntEquals(tc, parameter->variable_type->type_value, BOOL);
+	CuAssertStrEquals(tc, parameter->variable_identifier->identifier_name, "a");
 
 	// root -> compound_stmt
 
-	CuAssertTrue(tc, !(function_definition->compound_stmt->has_next_statement));
-	CuAssertPtrEquals(tc, function_definition->compound_stmt->next_compound_statement, NULL);
+	CuAssertIntEquals(tc, 1, function_definition->compound_stmt->num_statements);
 
-	// root -> compound_stmt -> statement
+	// root -> compound_stmt -> statements[0]
 
-	CuAssertIntEquals(tc, function_definition->compound_stmt->statement->type, MCC_AST_STATEMENT_TYPE_ASSIGNMENT);
-	CuAssertIntEquals(tc, function_definition->compound_stmt->statement->assignment->assignment_type,
-	                  MCC_AST_ASSIGNMENT_TYPE_VARIABLE);
-	CuAssertStrEquals(
-	    tc, function_definition->compound_stmt->statement->assignment->variable_identifier->identifier_name, "a");
+	struct mcc_ast_statement *statement = function_definition->compound_stmt->statements[0];
+	CuAssertIntEquals(tc, statement->type, MCC_AST_STATEMENT_TYPE_ASSIGNMENT);
+	CuAssertIntEquals(tc, statement->assignment->assignment_type, MCC_AST_ASSIGNMENT_TYPE_VARIABLE);
+	CuAssertStrEquals(tc, statement->assignment->variable_identifier->identifier_name, "a");
 
-	// root -> compound_stmt -> statement -> assignment -> variable_assigned_value
+	// root -> compound_stmt -> statements[0] -> assignment -> variable_assigned_value
 
-	CuAssertIntEquals(tc, function_definition->compound_stmt->statement->assignment->variable_assigned_value->type,
-	                  MCC_AST_EXPRESSION_TYPE_LITERAL);
-	CuAssertIntEquals(
-	    tc, function_definition->compound_stmt->statement->assignment->variable_assigned_value->literal->type,
-	    MCC_AST_LITERAL_TYPE_INT);
-	CuAssertIntEquals(
-	    tc, function_definition->compound_stmt->statement->assignment->variable_assigned_value->literal->i_value,
-	    2);
+	CuAssertIntEquals(tc, statement->assignment->variable_assigned_value->type, MCC_AST_EXPRESSION_TYPE_LITERAL);
+	CuAssertIntEquals(tc, statement->assignment->variable_assigned_value->literal->type, MCC_AST_LITERAL_TYPE_INT);
+	CuAssertIntEquals(tc, statement->assignment->variable_assigned_value->literal->i_value, 2);
 
 	mcc_ast_delete(function_definition);
 }
@@ -948,7 +933,7 @@ void EmptyFunctionCall(CuTest *tc)
 
 	// root -> arguments
 
-	CuAssertTrue(tc, expression->arguments->is_empty);
+	CuAssertIntEquals(tc, 0, expression->arguments->num_arguments);
 
 	mcc_ast_delete(expression);
 }
@@ -964,7 +949,7 @@ void EmptyParameters(CuTest *tc)
 
 	struct mcc_ast_function_definition *function_definition = result.function_definition;
 
-	CuAssertTrue(tc, function_definition->parameters->is_empty);
+	CuAssertIntEquals(tc, 0, function_definition->parameters->num_parameters);
 
 	mcc_ast_delete(function_definition);
 }
@@ -979,17 +964,101 @@ void DanglingElse(CuTest *tc)
 
 	struct mcc_ast_compound_statement *stmt = result.compound_statement;
 
-	CuAssertIntEquals(tc, MCC_AST_STATEMENT_TYPE_IF_STMT, stmt->statement->type);
+	CuAssertIntEquals(tc, 2, stmt->num_statements);
+	CuAssertIntEquals(tc, MCC_AST_STATEMENT_TYPE_IF_STMT, stmt->statements[0]->type);
 
-	// root -> next_stmt -> stmt -> on_false -> expression
-	CuAssertIntEquals(tc, MCC_AST_STATEMENT_TYPE_IF_ELSE_STMT, stmt->next_compound_statement->statement->type);
+	// root -> statements[1] -> on_false -> expression
+	CuAssertIntEquals(tc, MCC_AST_STATEMENT_TYPE_IF_ELSE_STMT, stmt->statements[1]->type);
 	CuAssertStrEquals(tc, "b",
-	                  stmt->next_compound_statement->statement->if_else_on_false->assignment->variable_identifier
-	                      ->identifier_name);
+	                  stmt->statements[1]->if_else_on_false->assignment->variable_identifier->identifier_name);
 
 	mcc_ast_delete(stmt);
 }
 
+void LongStatementList(CuTest *tc)
+{
+	char *input = generate_list("{", "a = %d;", "\n", "}", LONG_LIST);
+	CuAssertPtrNotNull(tc, input);
+	struct mcc_parser_result result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_COMPOUND_STATEMENT, "test");
+	free(input);
+
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, result.status);
+	CuAssertIntEquals(tc, MCC_PARSER_ENTRY_POINT_COMPOUND_STATEMENT, result.entry_point);
+
+	struct mcc_ast_compound_statement *compound_statement = result.compound_statement;
+	CuAssertIntEquals(tc, LONG_LIST, compound_statement->num_statements);
+	for (int i = 0; i < LONG_LIST; i++) {
+		struct mcc_ast_statement *statement = compound_statement->statements[i];
+		CuAssertIntEquals(tc, MCC_AST_STATEMENT_TYPE_ASSIGNMENT, statement->type);
+		CuAssertIntEquals(tc, i, statement->assignment->variable_assigned_value->literal->i_value);
+		CuAssertIntEquals(tc, i + 1, statement->node.sloc.start_line);
+	}
+
+	mcc_ast_delete(compound_statement);
+}
+
+void LongArgumentList(CuTest *tc)
+{
+	char *input = generate_list("f(", "%d", ", ", ")", LONG_LIST);
+	CuAssertPtrNotNull(tc, input);
+	struct mcc_parser_result result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_EXPRESSION, "test");
+	free(input);
+
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, result.status);
+
+	struct mcc_ast_expression *function_call = result.expression;
+	CuAssertIntEquals(tc, MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL, function_call->type);
+	CuAssertIntEquals(tc, LONG_LIST, function_call->arguments->num_arguments);
+	for (int i = 0; i < LONG_LIST; i++) {
+		CuAssertIntEquals(tc, i, function_call->arguments->expressions[i]->literal->i_value);
+	}
+
+	mcc_ast_delete(function_call);
+}
+
+void LongParameterList(CuTest *tc)
+{
+	char *input = generate_list("int f(", "int p%d", ", ", "){}", LONG_LIST);
+	CuAssertPtrNotNull(tc, input);
+	struct mcc_parser_result result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_FUNCTION_DEFINITION, "test");
+	free(input);
+
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, result.status);
+
+	struct mcc_ast_function_definition *function_definition = result.function_definition;
+	CuAssertIntEquals(tc, LONG_LIST, function_definition->parameters->num_parameters);
+	CuAssertStrEquals(tc, "p0", function_definition->parameters->declarations[0]->variable_identifier->identifier_name);
+	CuAssertStrEquals(tc, "p24999",
+	                  function_definition->parameters->declarations[LONG_LIST - 1]->variable_identifier->identifier_name);
+
+	mcc_ast_delete(function_definition);
+}
+
+void ManyFunctionDefinitions(CuTest *tc)
+{
+	char *input = generate_list("", "void f%d(){}", "\n", "", LONG_LIST);
+	CuAssertPtrNotNull(tc, input);
+	struct mcc_parser_result result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	free(input);
+
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, result.status);
+	CuAssertIntEquals(tc, MCC_PARSER_ENTRY_POINT_PROGRAM, result.entry_point);
+
+	// Functions stay in source order
+	int num = 0;
+	char name[16];
+	for (struct mcc_ast_program *program = result.program; program; program = program->next_function, num++) {
+		snprintf(name, sizeof(name), "f%d", num);
+		CuAssertStrEquals(tc, name, program->function->identifier->identifier_name);
+		CuAssertTrue(tc, program->has_next_function == (program->next_function != NULL));
+	}
+	CuAssertIntEquals(tc, LONG_LIST, num);
+	CuAssertIntEquals(tc, 1, result.program->node.sloc.start_line);
+	CuAssertIntEquals(tc, LONG_LIST, result.program->node.sloc.end_line);
+
+	mcc_ast_delete(result.program);
+}
+
 #define TESTS \
 	TEST(ArrayAssignment) \
 	TEST(BinaryOp_1) \
@@ -1023,7 +1092,11 @@ void DanglingElse(CuTest *tc)
 	TEST(EmptyCompound) \
 	TEST(EmptyFunctionCall) \
 	TEST(EmptyParameters) \
-	TEST(DanglingElse)
+	TEST(DanglingElse) \
+	TEST(LongStatementList) \
+	TEST(LongArgumentList) \
+	TEST(LongParameterList) \
+	TEST(ManyFunctionDefinitions)
 
 #include "main_stub.inc"
 #undef TESTS
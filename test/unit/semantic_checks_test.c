@@ -812,6 +812,33 @@ void multiple_function_definitions3(CuTest *tc)
 	mcc_semantic_check_delete_single_check(check);
 }
 
+void multiple_function_definitions4(CuTest *tc)
+{
+
+	// Define test input and create symbol table
+	const char input[] = "int a(){} int b(){} int b(){} int a(){} int main(){return 0;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *check = mcc_semantic_check_initialize_check();
+	CuAssertPtrNotNull(tc, check);
+	enum mcc_semantic_check_error_code error =
+	    mcc_semantic_check_run_multiple_function_definitions((&parser_result)->program, table, check);
+	CuAssertIntEquals(tc, MCC_SEMANTIC_CHECK_ERROR_OK, error);
+
+	CuAssertPtrNotNull(tc, check->error_buffer);
+	CuAssertPtrNotNull(tc, check);
+	CuAssertIntEquals(tc, check->status, MCC_SEMANTIC_CHECK_FAIL);
+	// The first function that is defined again is reported
+	CuAssertTrue(tc, strstr(check->error_buffer, "redefinition of 'a'") != NULL);
+
+	// Cleanup
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(check);
+}
+
 // A variable is declared more than once in the same scope
 void multiple_variable_declarations(CuTest *tc)
 {
@@ -864,6 +891,31 @@ void multiple_variable_declarations2(CuTest *tc)
 	mcc_semantic_check_delete_single_check(check);
 }
 
+void multiple_variable_declarations3(CuTest *tc)
+{
+
+	// Define test input and create symbol table
+	const char input[] = "int main(){ int a; int b; {int c; int c;} int d;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *check = mcc_semantic_check_initialize_check();
+	CuAssertPtrNotNull(tc, check);
+	enum mcc_semantic_check_error_code error =
+	    mcc_semantic_check_run_multiple_variable_declarations((&parser_result)->program, table, check);
+	CuAssertIntEquals(tc, MCC_SEMANTIC_CHECK_ERROR_OK, error);
+
+	CuAssertPtrNotNull(tc, check);
+	CuAssertPtrNotNull(tc, check->error_buffer);
+	CuAssertIntEquals(tc, check->status, MCC_SEMANTIC_CHECK_FAIL);
+
+	// Cleanup
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(check);
+}
+
 // An undeclared variable is used
 void use_undeclared_variable(CuTest *tc)
 {
@@ -1398,6 +1450,86 @@ void empty(CuTest *tc)
 	mcc_semantic_check_delete_single_check(check);
 }
 
+// The fused checks fail on the same programs as the checks that run one after another and report the same error, also
+// if a program has several errors
+void fused_checks_first_error(CuTest *tc)
+{
+	const char *inputs[] = {
+	    "int main(){int a; a = f(1.0, g()); return a;} int f(int x){return x;}",
+	    "int main(){return 1.0;} int f(int x){x = true; return x;}",
+	    "int f(){} int main(){f(1); return 0;}",
+	    "int main(){int a; int a; return h();}",
+	    "int main(){if (1) {} return 0;} void main(){}",
+	    "int main(){f(g(1), h()); return 0;} int f(int a, int b){return a;} int g(){return 1;}",
+	    "int main(){return f(f(f(true)));} int f(int a){return a;}",
+	    "void g(){return 1;} int main(){int x; x = 1.5; return 0;}",
+	    "int main(){int x; x = y; return 0;} int k(){float z; z = 1;}",
+	    "int main(){int a; a = 1; return a;}",
+	    "int main(){print(\"a\"); print_nl(); print_int(read_int()); print_float(read_float()); return 0;}",
+	    "int main(){print_int(1.0); return 0;}",
+	    "int main(){print_nl(1); return 0;}",
+	    "int main(){return 0;} float read_float(){return 1.0;}",
+	    // Return values are type checked before the other statements of a function
+	    "int main(){int x; x = 1.5; return true;}",
+	    // Type errors precede the nonvoid check, also in a later function
+	    "int f(){} int main(){int x; x = true; return 0;}",
+	    // Calls are checked in post order
+	    "int main(){return f(f(1, 2));} int f(int a){return a;}",
+	    "int main(){f(1.0, g(h(true), 1)); return 0;} int f(int a, int b){return a;} int g(int a){return a;}",
+	    // Missing main precedes wrong calls
+	    "int f(int a){return f(true);}",
+	};
+
+	for (size_t i = 0; i < sizeof(inputs) / sizeof(*inputs); i++) {
+		struct mcc_parser_result parser_result;
+		parser_result = mcc_parse_string(inputs[i], MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+		CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+		struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+		struct mcc_semantic_check *separate =
+		    mcc_semantic_check_run_all_separately((&parser_result)->program, table);
+		struct mcc_semantic_check *fused = mcc_semantic_check_initialize_check();
+		CuAssertPtrNotNull(tc, separate);
+		CuAssertPtrNotNull(tc, fused);
+
+		enum mcc_semantic_check_error_code error =
+		    mcc_semantic_check_run_fused((&parser_result)->program, table, fused);
+		CuAssertIntEquals(tc, MCC_SEMANTIC_CHECK_ERROR_OK, error);
+		CuAssertIntEquals(tc, separate->status, fused->status);
+		if (separate->error_buffer) {
+			CuAssertStrEquals(tc, separate->error_buffer, fused->error_buffer);
+		} else {
+			CuAssertPtrEquals(tc, NULL, fused->error_buffer);
+		}
+
+		// Cleanup
+		mcc_ast_delete(parser_result.program);
+		mcc_symbol_table_delete_table(table);
+		mcc_semantic_check_delete_single_check(fused);
+		mcc_semantic_check_delete_single_check(separate);
+	}
+}
+
+// The AST of an empty program has no function, but the built_ins are still known
+void empty_all_checks(CuTest *tc)
+{
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string("", MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	CuAssertPtrNotNull(tc, table);
+	CuAssertStrEquals(tc, "print", table->head->head->name);
+
+	struct mcc_semantic_check *check = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertPtrNotNull(tc, check);
+	CuAssertIntEquals(tc, MCC_SEMANTIC_CHECK_FAIL, check->status);
+	CuAssertPtrNotNull(tc, strstr(check->error_buffer, "No main function defined."));
+
+	// Cleanup
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(check);
+}
+
 #define TESTS \
 	TEST(positive) \
 	TEST(ensure_variable_shadowing) \
@@ -1430,8 +1562,10 @@ void empty(CuTest *tc)
 	TEST(multiple_function_definitions) \
 	TEST(multiple_function_definitions2) \
 	TEST(multiple_function_definitions3) \
+	TEST(multiple_function_definitions4) \
 	TEST(multiple_variable_declarations) \
 	TEST(multiple_variable_declarations2) \
+	TEST(multiple_variable_declarations3) \
 	TEST(use_undeclared_variable) \
 	TEST(use_undeclared_variable2) \
 	TEST(use_undeclared_variable3) \
@@ -1452,7 +1586,9 @@ void empty(CuTest *tc)
 	TEST(invalid_array_operation3) \
 	TEST(invalid_array_operation4) \
 	TEST(invalid_array_operation5) \
-	TEST(empty)
+	TEST(empty) \
+	TEST(fused_checks_first_error) \
+	TEST(empty_all_checks)
 #include "main_stub.inc"
 #undef TESTS
 
@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "mcc/ast.h"
+#include "mcc/ast_visit.h"
 #include "mcc/parser.h"
 #include "mcc/symbol_table.h"
 
@@ -602,8 +603,8 @@ void assignment_linking(CuTest *tc)
 	struct mcc_symbol_table_row *row = table->head->head->child_scope->head->child_scope->head;
 
 	struct mcc_ast_program *program = parser_result.program;
-	struct mcc_ast_statement *statement = program->function->compound_stmt->next_compound_statement->statement;
-	struct mcc_ast_assignment *assignment = statement->if_on_true->compound_statement->statement->assignment;
+	struct mcc_ast_statement *statement = program->function->compound_stmt->statements[1];
+	struct mcc_ast_assignment *assignment = statement->if_on_true->compound_statement->statements[0]->assignment;
 
 	CuAssertTrue(tc, assignment->row == row);
 
@@ -656,6 +657,42 @@ void check_upward_same_scope(CuTest *tc)
 	mcc_symbol_table_delete_table(table);
 }
 
+void check_upward_redefinition(CuTest *tc)
+{
+	// Define test input and create symbol table
+	const char input[] = "int func(){int a; int b; int a; int c;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+
+	struct mcc_symbol_table_row *row_a1 = table->head->head->child_scope->head;
+	struct mcc_symbol_table_row *row_b = row_a1->next_row;
+	struct mcc_symbol_table_row *row_a2 = row_b->next_row;
+	struct mcc_symbol_table_row *row_c = row_a2->next_row;
+
+	// redefinition is linked while inserting
+	CuAssertPtrEquals(tc, NULL, row_a1->prev_declaration);
+	CuAssertPtrEquals(tc, NULL, row_b->prev_declaration);
+	CuAssertPtrEquals(tc, row_a1, row_a2->prev_declaration);
+	CuAssertIntEquals(tc, 3, row_c->position);
+
+	// only rows up to the start row are visible
+	CuAssertPtrEquals(tc, row_a1, mcc_symbol_table_check_upwards_for_declaration("a", row_b));
+	CuAssertPtrEquals(tc, row_a2, mcc_symbol_table_check_upwards_for_declaration("a", row_c));
+	CuAssertPtrEquals(tc, NULL, mcc_symbol_table_check_upwards_for_declaration("c", row_b));
+	CuAssertPtrEquals(tc, NULL, mcc_symbol_table_check_upwards_for_declaration("never_declared", row_c));
+
+	// renaming keeps the index up to date
+	CuAssertIntEquals(tc, 0, mcc_symbol_table_rename_row(row_a1, "$r0"));
+	CuAssertPtrEquals(tc, NULL, row_a2->prev_declaration);
+	CuAssertPtrEquals(tc, NULL, mcc_symbol_table_check_upwards_for_declaration("a", row_b));
+	CuAssertPtrEquals(tc, row_a1, mcc_symbol_table_check_upwards_for_declaration("$r0", row_c));
+
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
 void variable_expression_linking(CuTest *tc)
 {
 
@@ -667,9 +704,8 @@ void variable_expression_linking(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
 	struct mcc_symbol_table_row *row = table->head->head->child_scope->head;
-	struct mcc_ast_compound_statement *stmt =
-	    (&parser_result)->program->function->compound_stmt->next_compound_statement;
-	struct mcc_ast_expression *expr = stmt->statement->assignment->variable_assigned_value->lhs;
+	struct mcc_ast_statement *stmt = (&parser_result)->program->function->compound_stmt->statements[1];
+	struct mcc_ast_expression *expr = stmt->assignment->variable_assigned_value->lhs;
 
 	CuAssertPtrNotNull(tc, row);
 	CuAssertPtrNotNull(tc, expr);
@@ -691,9 +727,8 @@ void if_condition_expression(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 
 	struct mcc_symbol_table_row *row = table->head->head->child_scope->head;
-	struct mcc_ast_compound_statement *stmt =
-	    (&parser_result)->program->function->compound_stmt->next_compound_statement;
-	struct mcc_ast_expression *expr = stmt->statement->if_condition->lhs;
+	struct mcc_ast_statement *stmt = (&parser_result)->program->function->compound_stmt->statements[1];
+	struct mcc_ast_expression *expr = stmt->if_condition->lhs;
 
 	CuAssertPtrNotNull(tc, row);
 	CuAssertPtrNotNull(tc, expr);
@@ -884,6 +919,144 @@ void built_ins(CuTest *tc)
 	mcc_symbol_table_delete_table(table);
 }
 
+// Rows that are equal in two tables have equal names and positions, also in all enclosing scopes
+static void assert_same_row(CuTest *tc, struct mcc_symbol_table_row *a, struct mcc_symbol_table_row *b)
+{
+	while (a && b) {
+		CuAssertPtrEquals(tc, a->name, b->name);
+		CuAssertIntEquals(tc, a->position, b->position);
+		CuAssertIntEquals(tc, a->row_type, b->row_type);
+		CuAssertIntEquals(tc, a->row_structure, b->row_structure);
+		CuAssertIntEquals(tc, a->array_size, b->array_size);
+		CuAssertIntEquals(tc, a->node != NULL, b->node != NULL);
+		a = a->scope->parent_row;
+		b = b->scope->parent_row;
+	}
+	CuAssertPtrEquals(tc, NULL, a);
+	CuAssertPtrEquals(tc, NULL, b);
+}
+
+static void assert_same_scopes(CuTest *tc, struct mcc_symbol_table_scope *a, struct mcc_symbol_table_scope *b)
+{
+	for (; a && b; a = a->next_scope, b = b->next_scope) {
+		struct mcc_symbol_table_row *row_a = a->head;
+		struct mcc_symbol_table_row *row_b = b->head;
+		for (; row_a && row_b; row_a = row_a->next_row, row_b = row_b->next_row) {
+			assert_same_row(tc, row_a, row_b);
+			assert_same_scopes(tc, row_a->child_scope, row_b->child_scope);
+		}
+		CuAssertPtrEquals(tc, NULL, row_a);
+		CuAssertPtrEquals(tc, NULL, row_b);
+	}
+	CuAssertPtrEquals(tc, NULL, a);
+	CuAssertPtrEquals(tc, NULL, b);
+}
+
+struct linked_rows {
+	struct mcc_symbol_table_row *rows[64];
+	int count;
+};
+
+static void add_linked_row(struct linked_rows *linked, struct mcc_symbol_table_row *row)
+{
+	if (linked->count < 64)
+		linked->rows[linked->count++] = row;
+}
+
+static void cb_link_expression(struct mcc_ast_expression *expression, void *userdata)
+{
+	switch (expression->type) {
+	case MCC_AST_EXPRESSION_TYPE_VARIABLE:
+		add_linked_row(userdata, expression->variable_row);
+		break;
+	case MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT:
+		add_linked_row(userdata, expression->array_row);
+		break;
+	case MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL:
+		add_linked_row(userdata, expression->function_row);
+		break;
+	default:
+		break;
+	}
+}
+
+static void cb_link_assignment(struct mcc_ast_assignment *assignment, void *userdata)
+{
+	add_linked_row(userdata, assignment->row);
+}
+
+static void cb_link_declaration(struct mcc_ast_declaration *declaration, void *userdata)
+{
+	add_linked_row(userdata, declaration->row);
+}
+
+static struct linked_rows get_linked_rows(struct mcc_ast_program *program)
+{
+	struct linked_rows linked = {.count = 0};
+	struct mcc_ast_visitor visitor = {
+	    .order = MCC_AST_VISIT_PRE_ORDER,
+	    .userdata = &linked,
+	    .expression = cb_link_expression,
+	    .variable_assignment = cb_link_assignment,
+	    .array_assignment = cb_link_assignment,
+	    .variable_declaration = cb_link_declaration,
+	    .array_declaration = cb_link_declaration,
+	};
+	mcc_ast_visit(program, &visitor);
+	return linked;
+}
+
+void built_while_parsing(CuTest *tc)
+{
+	// Pseudo rows, parameters, nested and sibling scopes, shadowing and arrays
+	const char input[] = "int f(int a, float[3] b){{a = 1;} int c; c = a; {int a; a = c; {}} if (a > 0) {a = 2;} "
+	                     "else {int d; d = f(a, b);} b[a] = 1.0; return a;} void g(){} "
+	                     "int main(){while (f(1, 2.0) < 3) {int x;} return 0;}";
+
+	struct mcc_parser_result created = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, created.status);
+	CuAssertPtrEquals(tc, NULL, created.symbol_table);
+	struct mcc_symbol_table *table = mcc_symbol_table_create(created.program);
+	CuAssertPtrNotNull(tc, table);
+
+	struct mcc_parser_result parsed =
+	    mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM_WITH_SYMBOL_TABLE, "test");
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, parsed.status);
+	CuAssertIntEquals(tc, MCC_PARSER_ENTRY_POINT_PROGRAM, parsed.entry_point);
+	CuAssertPtrNotNull(tc, parsed.symbol_table);
+
+	// Same rows, including the builtin functions, and the same rows linked from the AST
+	assert_same_scopes(tc, table->head, parsed.symbol_table->head);
+	CuAssertPtrEquals(tc, &parsed.program->function->node, parsed.symbol_table->head->head->node);
+
+	struct linked_rows linked_created = get_linked_rows(created.program);
+	struct linked_rows linked_parsed = get_linked_rows(parsed.program);
+	CuAssertIntEquals(tc, linked_created.count, linked_parsed.count);
+	CuAssertIntEquals(tc, 21, linked_created.count);
+	for (int i = 0; i < linked_created.count; i++) {
+		CuAssertPtrNotNull(tc, linked_parsed.rows[i]);
+		assert_same_row(tc, linked_created.rows[i], linked_parsed.rows[i]);
+	}
+
+	// Cleanup
+	mcc_ast_delete(created.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_ast_delete(parsed.program);
+	mcc_symbol_table_delete_table(parsed.symbol_table);
+}
+
+void built_while_parsing_error(CuTest *tc)
+{
+	const char input[] = "int f(){int a; {a = 1;}";
+
+	struct mcc_parser_result result =
+	    mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM_WITH_SYMBOL_TABLE, "test");
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_UNKNOWN_ERROR, result.status);
+	CuAssertPtrEquals(tc, NULL, result.symbol_table);
+
+	free(result.error_buffer);
+}
+
 #define TESTS \
 	TEST(empty_table) \
 	TEST(multiple_rows) \
@@ -904,9 +1077,12 @@ void built_ins(CuTest *tc)
 	TEST(assignment_linking) \
 	TEST(check_upward) \
 	TEST(check_upward_same_scope) \
+	TEST(check_upward_redefinition) \
 	TEST(variable_expression_linking) \
 	TEST(if_condition_expression) \
-	TEST(built_ins)
+	TEST(built_ins) \
+	TEST(built_while_parsing) \
+	TEST(built_while_parsing_error)
 #include "main_stub.inc"
 #undef TESTS
 